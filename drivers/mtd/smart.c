@@ -137,6 +137,19 @@
 
 #define SMART_MAX_ALLOCS        10
 
+/* Sector map checkpoint definitions */
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+#  define SMART_CP_SIG1         'S'
+#  define SMART_CP_SIG2         'M'
+#  define SMART_CP_SIG3         'C'
+#  define SMART_CP_SIG4         'P'
+#  define SMART_CP_VERSION      1
+
+#  define SMART_CP_INVALID      0     /* No current checkpoint on the device */
+#  define SMART_CP_VALID        1     /* Checkpoint matches the RAM map */
+#endif
+
 #ifndef CONFIG_MTD_SMART_ALLOC_DEBUG
 #define smart_malloc(d, b, n)   kmm_malloc(b)
 #define smart_zalloc(d, b, n)   kmm_zalloc(b)
@@ -217,6 +230,33 @@ struct smart_allocsector_s
 };
 #endif
 
+/* The sector map checkpoint is kept in erase blocks reserved at the end of
+ * the device.  The first MTD block of the area holds this header; the
+ * sector map followed by the release and free count arrays start at the
+ * second MTD block.  The header is written last, so a checkpoint is only
+ * considered when its CRC is good and the dirty byte is still erased.  The
+ * dirty byte is programmed before the volume is first modified after the
+ * checkpoint was written or loaded.
+ */
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+struct smart_checkpoint_s
+{
+  uint8_t               sig[4];           /* Checkpoint signature */
+  uint8_t               dirty;            /* Erased while the checkpoint is current */
+  uint8_t               version;          /* Checkpoint layout version */
+  uint8_t               availsectperblk;  /* Usable sectors per erase block */
+  uint8_t               formatversion;    /* Format version on the device */
+  uint16_t              sectorsize;       /* Sector size on device */
+  uint16_t              totalsectors;     /* Total number of sectors on device */
+  uint16_t              neraseblocks;     /* Number of erase blocks mapped */
+  uint16_t              freesectors;      /* Total number of free sectors */
+  uint16_t              releasesectors;   /* Total number of released sectors */
+  uint16_t              reserved;         /* Pad to a 32-bit boundary */
+  uint32_t              crc;              /* CRC-32 of header and map data */
+};
+#endif
+
 struct smart_struct_s
 {
   FAR struct mtd_dev_s *mtd;              /* Contained MTD interface */
@@ -271,6 +311,11 @@ struct smart_struct_s
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
   FAR uint8_t          *erasecounts;      /* Number of erases for each erase block */
 #endif
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  uint16_t              cpblock;          /* First erase block of the checkpoint area */
+  uint16_t              cpnblocks;        /* Number of erase blocks in the checkpoint area */
+  uint8_t               cpstate;          /* State of the checkpoint on the device */
+#endif
 #ifdef CONFIG_MTD_SMART_ALLOC_DEBUG
   size_t                bytesalloc;
   struct smart_alloc_s  alloc[SMART_MAX_ALLOCS];   /* Array of memory allocations */
@@ -388,6 +433,11 @@ static int smart_read_wearstatus(FAR struct smart_struct_s *dev);
 static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t block);
 #endif
 
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+static int smart_cpinvalidate(FAR struct smart_struct_s *dev);
+static int smart_cpwrite(FAR struct smart_struct_s *dev);
+#endif
+
 static int smart_relocate_sector(FAR struct smart_struct_s *dev,
                  uint16_t oldsector, uint16_t newsector);
 
@@ -458,8 +508,27 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+  FAR struct smart_struct_s *dev;
+#endif
+
   finfo("Entry\n");
+
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+  DEBUGASSERT(inode && inode->i_private);
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+  dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+  /* Save the sector map so the next scan can be skipped */
+
+  return smart_cpwrite(dev);
+#else
   return OK;
+#endif
 }
 
 /****************************************************************************
@@ -877,6 +946,16 @@ static ssize_t smart_write(FAR struct inode *inode,
 
   /* I think maybe we need to lock on a mutex here */
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  /* Raw writes bypass the sector map, so the checkpoint becomes stale */
+
+  ret = smart_cpinvalidate(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
    * alignment.
@@ -1823,6 +1902,418 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev, uint16_t block,
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_readformat
+ *
+ * Description: Reads the format signature from the physical sector holding
+ *              logical sector zero and, if it is valid, sets the volume
+ *              format information.  Returns -EINVAL if the signature is not
+ *              valid.
+ *
+ ****************************************************************************/
+
+static int smart_readformat(FAR struct smart_struct_s *dev,
+                            uint32_t readaddress)
+{
+  int       ret;
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  int       x;
+  char      devname[22];
+  FAR struct smart_multiroot_device_s *rootdirdev;
+#endif
+
+  /* Read the sector data */
+
+  ret = MTD_READ(dev->mtd, readaddress, 32, (FAR uint8_t *)dev->rwbuffer);
+  if (ret != 32)
+    {
+      ferr("ERROR: Error reading physical sector at %lu.\n",
+           (unsigned long)readaddress);
+      return ret < 0 ? ret : -EIO;
+    }
+
+  /* Validate the format signature */
+
+  if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
+      dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
+      dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
+      dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+    {
+      return -EINVAL;
+    }
+
+  /* Mark the volume as formatted and set the sector size */
+
+  dev->formatstatus = SMART_FMT_STAT_FORMATTED;
+  dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
+  dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
+
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+  dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
+
+  /* If rootdirentries is greater than 1, then we need to register
+   * additional block devices.
+   */
+
+  for (x = 1; x < dev->rootdirentries; x++)
+    {
+      if (dev->partname[0] != '\0')
+        {
+          snprintf(dev->rwbuffer, sizeof(devname), "/dev/smart%d%sd%d",
+                  dev->minor, dev->partname, x+1);
+        }
+      else
+        {
+          snprintf(devname, sizeof(devname), "/dev/smart%dd%d", dev->minor,
+                   x + 1);
+        }
+
+      /* Inode private data is a reference to a struct containing
+       * the SMART device structure and the root directory number.
+       */
+
+      rootdirdev = (struct smart_multiroot_device_s *)
+        smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
+      if (rootdirdev == NULL)
+        {
+          ferr("ERROR: Memory alloc failed\n");
+          return -ENOMEM;
+        }
+
+      /* Populate the rootdirdev */
+
+      rootdirdev->dev = dev;
+      rootdirdev->rootdirnum = x;
+      ret = register_blockdriver(dev->rwbuffer, &g_bops, 0, rootdirdev);
+
+      /* Inode private data is a reference to the SMART device structure */
+
+      ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: smart_cpreserve
+ *
+ * Description: Reserves erase blocks at the end of the device for the
+ *              sector map checkpoint.  The area is sized for a volume using
+ *              CONFIG_MTD_SMART_SECTOR_SIZE sectors and is removed from the
+ *              geometry used by the rest of the driver.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static void smart_cpreserve(FAR struct smart_struct_s *dev)
+{
+  uint32_t  nsectors;
+  uint32_t  cpsize;
+  uint32_t  nblocks;
+
+  dev->cpnblocks = 0;
+  dev->cpstate   = SMART_CP_INVALID;
+
+  if (dev->geo.erasesize < CONFIG_MTD_SMART_SECTOR_SIZE ||
+      dev->geo.blocksize == 0)
+    {
+      return;
+    }
+
+  nsectors = dev->geo.erasesize / CONFIG_MTD_SMART_SECTOR_SIZE *
+             dev->geo.neraseblocks;
+  if (nsectors > 65536)
+    {
+      nsectors = 65536;
+    }
+
+  cpsize  = dev->geo.blocksize + (nsectors << 1) +
+            (dev->geo.neraseblocks << 1);
+  nblocks = (cpsize + dev->geo.erasesize - 1) / dev->geo.erasesize;
+
+  /* Keep an even number of erase blocks for the wear level bit array */
+
+  if (((dev->geo.neraseblocks - nblocks) & 1) != 0)
+    {
+      nblocks++;
+    }
+
+  /* Don't give more than 1/8th of a small device to the checkpoint */
+
+  if (nblocks > (dev->geo.neraseblocks >> 3))
+    {
+      finfo("Device too small for a map checkpoint\n");
+      return;
+    }
+
+  dev->cpnblocks         = nblocks;
+  dev->cpblock           = dev->geo.neraseblocks - nblocks;
+  dev->geo.neraseblocks -= nblocks;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cpinvalidate
+ *
+ * Description: Marks the sector map checkpoint on the device as stale.
+ *              This must be done before anything on the volume is
+ *              modified.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+static int smart_cpinvalidate(FAR struct smart_struct_s *dev)
+{
+  uint8_t   dirty;
+  int       ret;
+
+  if (dev->cpstate != SMART_CP_VALID)
+    {
+      return OK;
+    }
+
+  dirty = (uint8_t)~CONFIG_SMARTFS_ERASEDSTATE;
+  ret = smart_bytewrite(dev, dev->cpblock * dev->geo.erasesize +
+                        offsetof(struct smart_checkpoint_s, dirty), 1, &dirty);
+  if (ret < 0)
+    {
+      ferr("ERROR: Error %d invalidating map checkpoint\n", -ret);
+      return ret;
+    }
+
+  dev->cpstate = SMART_CP_INVALID;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cpwrite
+ *
+ * Description: Writes the logical sector map, free and release counts to
+ *              the checkpoint area so the next scan can skip reading every
+ *              sector header.  Called when the device is closed or flushed.
+ *              A read-only driver never writes the checkpoint.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+static int smart_cpwrite(FAR struct smart_struct_s *dev)
+{
+  struct smart_checkpoint_s cp;
+  FAR const uint8_t *map;
+  uint32_t  mapsize;
+  off_t     startblock;
+  size_t    nblocks;
+  size_t    remaining;
+  int       ret;
+
+  /* Nothing to do if the checkpoint is already current or the volume
+   * isn't formatted.
+   */
+
+  if (dev->cpnblocks == 0 || dev->cpstate == SMART_CP_VALID ||
+      dev->formatstatus != SMART_FMT_STAT_FORMATTED)
+    {
+      return OK;
+    }
+
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+  /* Sectors allocated in RAM only would not survive a restart */
+
+  if (dev->allocsector != NULL)
+    {
+      return OK;
+    }
+#endif
+
+  /* The map, release and free counts are allocated as a single block */
+
+  map     = (FAR const uint8_t *)dev->sMap;
+  mapsize = (dev->totalsectors << 1) + (dev->neraseblocks << 1);
+
+  if (dev->geo.blocksize + mapsize > dev->cpnblocks * dev->geo.erasesize)
+    {
+      finfo("Sector map too large for checkpoint area\n");
+      return OK;
+    }
+
+  /* Build the header and compute the CRC with the dirty byte erased */
+
+  cp.sig[0]          = SMART_CP_SIG1;
+  cp.sig[1]          = SMART_CP_SIG2;
+  cp.sig[2]          = SMART_CP_SIG3;
+  cp.sig[3]          = SMART_CP_SIG4;
+  cp.dirty           = CONFIG_SMARTFS_ERASEDSTATE;
+  cp.version         = SMART_CP_VERSION;
+  cp.availsectperblk = dev->availSectPerBlk;
+  cp.formatversion   = dev->formatversion;
+  cp.sectorsize      = dev->sectorsize;
+  cp.totalsectors    = dev->totalsectors;
+  cp.neraseblocks    = dev->neraseblocks;
+  cp.freesectors     = dev->freesectors;
+  cp.releasesectors  = dev->releasesectors;
+  cp.reserved        = 0;
+  cp.crc             = 0;
+  cp.crc             = crc32part(map, mapsize,
+                                 crc32((FAR const uint8_t *)&cp, sizeof(cp)));
+
+  /* Erase the checkpoint area */
+
+  ret = MTD_ERASE(dev->mtd, dev->cpblock, dev->cpnblocks);
+  if (ret < 0)
+    {
+      ferr("ERROR: Error %d erasing map checkpoint\n", -ret);
+      return ret;
+    }
+
+  /* Write the map data starting at the second MTD block of the area */
+
+  startblock = dev->cpblock * (dev->geo.erasesize / dev->geo.blocksize) + 1;
+  nblocks    = mapsize / dev->geo.blocksize;
+  remaining  = mapsize - nblocks * dev->geo.blocksize;
+
+  if (nblocks > 0)
+    {
+      ret = MTD_BWRITE(dev->mtd, startblock, nblocks, map);
+      if (ret != (int)nblocks)
+        {
+          goto errout;
+        }
+    }
+
+  if (remaining > 0)
+    {
+      memcpy(dev->rwbuffer, &map[nblocks * dev->geo.blocksize], remaining);
+      memset(&dev->rwbuffer[remaining], CONFIG_SMARTFS_ERASEDSTATE,
+             dev->geo.blocksize - remaining);
+
+      ret = MTD_BWRITE(dev->mtd, startblock + nblocks, 1,
+                       (FAR uint8_t *)dev->rwbuffer);
+      if (ret != 1)
+        {
+          goto errout;
+        }
+    }
+
+  /* Write the header last */
+
+  memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->geo.blocksize);
+  memcpy(dev->rwbuffer, &cp, sizeof(cp));
+
+  ret = MTD_BWRITE(dev->mtd, startblock - 1, 1, (FAR uint8_t *)dev->rwbuffer);
+  if (ret != 1)
+    {
+      goto errout;
+    }
+
+  finfo("Wrote map checkpoint: %d sectors\n", dev->totalsectors);
+  dev->cpstate = SMART_CP_VALID;
+  return OK;
+
+errout:
+  ferr("ERROR: Error %d writing map checkpoint\n", ret);
+  return ret < 0 ? ret : -EIO;
+}
+#endif
+
+/****************************************************************************
+ * Name: smart_cpload
+ *
+ * Description: Restores the logical sector map, free and release counts
+ *              from the checkpoint area.  Returns -ENOENT if there is no
+ *              current checkpoint matching the volume geometry, in which
+ *              case the caller must initialize the map and perform a full
+ *              scan.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+static int smart_cpload(FAR struct smart_struct_s *dev)
+{
+  struct smart_checkpoint_s cp;
+  uint32_t  crc;
+  uint32_t  mapsize;
+  uint32_t  offset;
+  int       ret;
+
+  if (dev->cpnblocks == 0)
+    {
+      return -ENOENT;
+    }
+
+  offset = dev->cpblock * dev->geo.erasesize;
+  ret    = MTD_READ(dev->mtd, offset, sizeof(cp), (FAR uint8_t *)&cp);
+  if (ret != sizeof(cp))
+    {
+      return ret < 0 ? ret : -EIO;
+    }
+
+  /* Validate the header against the volume geometry */
+
+  if (cp.sig[0] != SMART_CP_SIG1 || cp.sig[1] != SMART_CP_SIG2 ||
+      cp.sig[2] != SMART_CP_SIG3 || cp.sig[3] != SMART_CP_SIG4 ||
+      cp.dirty != CONFIG_SMARTFS_ERASEDSTATE ||
+      cp.version != SMART_CP_VERSION ||
+      cp.availsectperblk != dev->availSectPerBlk ||
+      cp.sectorsize != dev->sectorsize ||
+      cp.totalsectors != dev->totalsectors ||
+      cp.neraseblocks != dev->neraseblocks)
+    {
+      return -ENOENT;
+    }
+
+  mapsize = (dev->totalsectors << 1) + (dev->neraseblocks << 1);
+  if (dev->geo.blocksize + mapsize > dev->cpnblocks * dev->geo.erasesize)
+    {
+      return -ENOENT;
+    }
+
+  /* Read the map data directly into the map and count arrays */
+
+  ret = MTD_READ(dev->mtd, offset + dev->geo.blocksize, mapsize,
+                 (FAR uint8_t *)dev->sMap);
+  if (ret != (int)mapsize)
+    {
+      return ret < 0 ? ret : -EIO;
+    }
+
+  crc    = cp.crc;
+  cp.crc = 0;
+  if (crc32part((FAR const uint8_t *)dev->sMap, mapsize,
+                crc32((FAR const uint8_t *)&cp, sizeof(cp))) != crc)
+    {
+      ferr("ERROR: Map checkpoint CRC mismatch\n");
+      return -ENOENT;
+    }
+
+  dev->freesectors    = cp.freesectors;
+  dev->releasesectors = cp.releasesectors;
+
+  /* Restore the format information from logical sector zero */
+
+  dev->formatstatus   = SMART_FMT_STAT_NOFMT;
+  if (dev->sMap[0] != 0xffff)
+    {
+      ret = smart_readformat(dev, dev->sMap[0] * dev->mtdBlksPerSector *
+                             dev->geo.blocksize);
+      if (ret < 0)
+        {
+          return ret == -EINVAL ? -ENOENT : ret;
+        }
+
+      if (dev->formatversion != cp.formatversion)
+        {
+          return -ENOENT;
+        }
+    }
+
+  finfo("Loaded map checkpoint: %d sectors\n", dev->totalsectors);
+  dev->cpstate = SMART_CP_VALID;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_scan
  *
@@ -1848,11 +2339,6 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
   int       dupsector;
   uint16_t  duplogsector;
-#endif
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-  int       x;
-  char      devname[22];
-  FAR struct smart_multiroot_device_s *rootdirdev;
 #endif
   static const short sizetbl[8] =
   {
@@ -1921,6 +2407,22 @@ static int smart_scan(FAR struct smart_struct_s *dev)
       goto err_out;
     }
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+  /* If the volume was cleanly closed, restore the map from the checkpoint
+   * instead of reading every sector header.
+   */
+
+  ret = smart_cpload(dev);
+  if (ret == OK)
+    {
+      goto scan_done;
+    }
+  else if (ret != -ENOENT)
+    {
+      goto err_out;
+    }
+#endif
+
   /* Initialize the device variables */
 
   totalsectors        = dev->totalsectors;
@@ -2053,22 +2555,8 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
       if (logicalsector == 0)
         {
-          /* Read the sector data */
-
-          ret = MTD_READ(dev->mtd, readaddress, 32,
-                         (FAR uint8_t *)dev->rwbuffer);
-          if (ret != 32)
-            {
-              ferr("ERROR: Error reading physical sector %d.\n", sector);
-              goto err_out;
-            }
-
-          /* Validate the format signature */
-
-          if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
-              dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
-              dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
-              dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4)
+          ret = smart_readformat(dev, readaddress);
+          if (ret == -EINVAL)
             {
               /* Invalid signature on a sector claiming to be sector 0!
                * What should we do?  Release it?
@@ -2076,57 +2564,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
               continue;
             }
-
-          /* Mark the volume as formatted and set the sector size */
-
-          dev->formatstatus = SMART_FMT_STAT_FORMATTED;
-          dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
-          dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
-
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-          dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
-
-          /* If rootdirentries is greater than 1, then we need to register
-           * additional block devices.
-           */
-
-          for (x = 1; x < dev->rootdirentries; x++)
+          else if (ret < 0)
             {
-              if (dev->partname[0] != '\0')
-                {
-                  snprintf(dev->rwbuffer, sizeof(devname), "/dev/smart%d%sd%d",
-                          dev->minor, dev->partname, x+1);
-                }
-              else
-                {
-                  snprintf(devname, sizeof(devname), "/dev/smart%dd%d", dev->minor,
-                           x + 1);
-                }
-
-              /* Inode private data is a reference to a struct containing
-               * the SMART device structure and the root directory number.
-               */
-
-              rootdirdev = (struct smart_multiroot_device_s *)
-                smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
-              if (rootdirdev == NULL)
-                {
-                  ferr("ERROR: Memory alloc failed\n");
-                  ret = -ENOMEM;
-                  goto err_out;
-                }
-
-              /* Populate the rootdirdev */
-
-              rootdirdev->dev = dev;
-              rootdirdev->rootdirnum = x;
-              ret = register_blockdriver(dev->rwbuffer, &g_bops, 0, rootdirdev);
-
-              /* Inode private data is a reference to the SMART device structure */
-
-              ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+              goto err_out;
             }
-#endif
         }
 
       /* Test for duplicate logical sectors on the device */
@@ -2300,6 +2741,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #endif
     }
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+scan_done:
+#endif
+
 #if defined (CONFIG_MTD_SMART_WEAR_LEVEL) && (SMART_STATUS_VERSION == 1)
 #ifdef CONFIG_MTD_SMART_CONVERT_WEAR_FORMAT
 
@@ -5194,6 +5639,20 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+  /* Mark the map checkpoint stale before anything on the volume changes */
+
+  if (cmd == BIOC_LLFORMAT || cmd == BIOC_ALLOCSECT ||
+      cmd == BIOC_FREESECT || cmd == BIOC_WRITESECT)
+    {
+      ret = smart_cpinvalidate(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
   /* Process the ioctl's we care about first, pass any we don't respond
    * to directly to the underlying MTD device.
    */
@@ -5284,6 +5743,20 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       goto ok_out;
 #endif /* CONFIG_FS_WRITABLE */
 
+#if defined(CONFIG_MTD_SMART_MAP_CHECKPOINT) && defined(CONFIG_FS_WRITABLE)
+    case BIOC_FLUSH:
+
+      /* Save the sector map, then let the MTD driver flush its buffers */
+
+      ret = smart_cpwrite(dev);
+      if (ret < 0)
+        {
+          goto ok_out;
+        }
+
+      break;
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
     case BIOC_GETPROCFSD:
 
@@ -5414,6 +5887,12 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
           goto errout;
         }
 
+#ifdef CONFIG_MTD_SMART_MAP_CHECKPOINT
+      /* Reserve the erase blocks used for the sector map checkpoint */
+
+      smart_cpreserve(dev);
+#endif
+
       /* Set the sector size to the default for now */
 
       dev->sectorsize = 0;
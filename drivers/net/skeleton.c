@@ -183,6 +183,9 @@ static int  skel_ifdown(FAR struct net_driver_s *dev);
 
 static void skel_txavail_work(FAR void *arg);
 static int  skel_txavail(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+static int  skel_fwdtransmit(FAR struct net_driver_s *dev);
+#endif
 
 #if defined(CONFIG_NET_MCASTGROUP) || defined(CONFIG_NET_ICMPv6)
 static int  skel_addmac(FAR struct net_driver_s *dev,
@@ -958,6 +961,43 @@ static int skel_txavail(FAR struct net_driver_s *dev)
   return OK;
 }
 
+/****************************************************************************
+ * Name: skel_fwdtransmit
+ *
+ * Description:
+ *   Driver callback used by the IP forwarding fast path to send a packet
+ *   immediately.  d_buf refers to the buffer of the receiving device and is
+ *   valid only until this function returns, so the packet must be sent or
+ *   copied into a TX buffer before returning.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   OK on success; -EBUSY if there is no TX capacity.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+static int skel_fwdtransmit(FAR struct net_driver_s *dev)
+{
+  FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)dev->d_private;
+
+  /* Check if the hardware is ready to send another packet.  If not, return
+   * -EBUSY and the packet will be queued for the next poll instead.
+   */
+
+  /* Copy the packet into a free TX buffer (or hand it directly to the
+   * hardware if the transfer completes before returning).
+   */
+
+  return skel_transmit(priv);
+}
+#endif
+
 /****************************************************************************
  * Name: skel_addmac
  *
@@ -1174,6 +1214,9 @@ int skel_initialize(int intf)
   priv->sk_dev.d_ifup    = skel_ifup;     /* I/F up (new IP address) callback */
   priv->sk_dev.d_ifdown  = skel_ifdown;   /* I/F down callback */
   priv->sk_dev.d_txavail = skel_txavail;  /* New TX data callback */
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+  priv->sk_dev.d_transmit = skel_fwdtransmit; /* Forwarding fast path */
+#endif
 #ifdef CONFIG_NET_MCASTGROUP
   priv->sk_dev.d_addmac  = skel_addmac;   /* Add multicast MAC address */
   priv->sk_dev.d_rmmac   = skel_rmmac;    /* Remove multicast MAC address */
@@ -61,6 +61,9 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#ifdef CONFIG_SMP
+#  include <nuttx/spinlock.h>
+#endif
 
 #include "pipe_common.h"
 
@@ -80,6 +83,26 @@
 #  define pipe_dumpbuffer(m,a,n)
 #endif
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+/* In SPSC mode the reader and the writer access the ring indices without
+ * holding d_bfsem.  Each index is written by only one side; the other side
+ * must see the index update only after the data itself is visible.
+ */
+
+#  define PIPE_LOAD(n)      (*(FAR volatile pipe_ndx_t *)&(n))
+#  define PIPE_STORE(n,v)   do { *(FAR volatile pipe_ndx_t *)&(n) = (v); } while (0)
+
+#  if defined(CONFIG_SMP)
+#    define pipe_barrier()  SP_DSB()
+#  elif defined(__GNUC__)
+#    define pipe_barrier()  __asm__ __volatile__ ("" : : : "memory")
+#  else
+#    define pipe_barrier()
+#  endif
+#else
+#  define pipe_barrier()
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -155,6 +178,322 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
 #  define pipecommon_pollnotify(dev,event)
 #endif
 
+/****************************************************************************
+ * Name: pipecommon_nbytes
+ *
+ * Description:
+ *   Return the number of bytes held in the circular buffer for the given
+ *   write and read indices.
+ *
+ ****************************************************************************/
+
+static inline size_t pipecommon_nbytes(FAR struct pipe_dev_s *dev,
+                                       pipe_ndx_t wrndx, pipe_ndx_t rdndx)
+{
+  if (wrndx >= rdndx)
+    {
+      return wrndx - rdndx;
+    }
+  else
+    {
+      return (size_t)dev->d_bufsize - rdndx + wrndx;
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_advance
+ *
+ * Description:
+ *   Advance a circular buffer index by nbytes (which must not exceed the
+ *   buffer size).
+ *
+ ****************************************************************************/
+
+static inline pipe_ndx_t pipecommon_advance(FAR struct pipe_dev_s *dev,
+                                            pipe_ndx_t ndx, size_t nbytes)
+{
+  size_t newndx = (size_t)ndx + nbytes;
+
+  if (newndx >= dev->d_bufsize)
+    {
+      newndx -= dev->d_bufsize;
+    }
+
+  return (pipe_ndx_t)newndx;
+}
+
+/****************************************************************************
+ * Name: pipecommon_copyin
+ *
+ * Description:
+ *   Copy nbytes from the user buffer into the circular buffer beginning at
+ *   wrndx.  At most two memcpy() calls are needed to handle the wrap-around.
+ *
+ ****************************************************************************/
+
+static void pipecommon_copyin(FAR struct pipe_dev_s *dev, pipe_ndx_t wrndx,
+                              FAR const char *buffer, size_t nbytes)
+{
+  size_t ncopy = dev->d_bufsize - wrndx;
+
+  if (ncopy > nbytes)
+    {
+      ncopy = nbytes;
+    }
+
+  memcpy(&dev->d_buffer[wrndx], buffer, ncopy);
+  if (ncopy < nbytes)
+    {
+      memcpy(dev->d_buffer, &buffer[ncopy], nbytes - ncopy);
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_copyout
+ *
+ * Description:
+ *   Copy nbytes from the circular buffer beginning at rdndx into the user
+ *   buffer.
+ *
+ ****************************************************************************/
+
+static void pipecommon_copyout(FAR struct pipe_dev_s *dev, pipe_ndx_t rdndx,
+                               FAR char *buffer, size_t nbytes)
+{
+  size_t ncopy = dev->d_bufsize - rdndx;
+
+  if (ncopy > nbytes)
+    {
+      ncopy = nbytes;
+    }
+
+  memcpy(buffer, &dev->d_buffer[rdndx], ncopy);
+  if (ncopy < nbytes)
+    {
+      memcpy(&buffer[ncopy], dev->d_buffer, nbytes - ncopy);
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_spsc_wakeup
+ *
+ * Description:
+ *   Wake up the peer of a single-producer/single-consumer pipe after an
+ *   empty-to-not-empty or full-to-not-full transition.  At most one thread
+ *   waits on each semaphore so the count is never allowed to exceed one;
+ *   a stale count only causes the peer to re-check the indices once.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+static void pipecommon_spsc_wakeup(FAR struct pipe_dev_s *dev,
+                                   FAR sem_t *sem, pollevent_t eventset)
+{
+  int sval;
+#ifndef CONFIG_DISABLE_POLL
+  int i;
+#endif
+
+  if (nxsem_getvalue(sem, &sval) == 0 && sval <= 0)
+    {
+      nxsem_post(sem);
+    }
+
+#ifndef CONFIG_DISABLE_POLL
+  /* The poll slots are only modified with d_bfsem held.  Take it only if
+   * someone is actually polling.
+   */
+
+  for (i = 0; i < CONFIG_DEV_PIPE_NPOLLWAITERS; i++)
+    {
+      if (*(FAR struct pollfd * volatile *)&dev->d_fds[i] != NULL)
+        {
+          pipecommon_semtake(&dev->d_bfsem);
+          pipecommon_pollnotify(dev, eventset);
+          nxsem_post(&dev->d_bfsem);
+          break;
+        }
+    }
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: pipecommon_spsc_read
+ *
+ * Description:
+ *   Lock-free read used when the pipe is in SPSC mode.  Only the reader
+ *   modifies d_rdndx.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+static ssize_t pipecommon_spsc_read(FAR struct file *filep,
+                                    FAR struct pipe_dev_s *dev,
+                                    FAR char *buffer, size_t len)
+{
+  pipe_ndx_t wrndx;
+  pipe_ndx_t rdndx;
+  pipe_ndx_t nxtrdndx;
+  size_t nread;
+  int ret;
+
+  /* If the pipe is empty, then wait for something to be written to it */
+
+  rdndx = dev->d_rdndx;
+  for (; ; )
+    {
+      wrndx = PIPE_LOAD(dev->d_wrndx);
+      if (wrndx != rdndx)
+        {
+          break;
+        }
+
+      /* If O_NONBLOCK was set, then return EGAIN */
+
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          return -EAGAIN;
+        }
+
+      /* If there are no writers on the pipe, then return end of file */
+
+      if (dev->d_nwriters <= 0)
+        {
+          return 0;
+        }
+
+      /* Wait for the writer to report the empty-to-not-empty transition */
+
+      ret = nxsem_wait(&dev->d_rdsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Do not read the data before the write index that published it */
+
+  pipe_barrier();
+
+  nread = pipecommon_nbytes(dev, wrndx, rdndx);
+  if (nread > len)
+    {
+      nread = len;
+    }
+
+  pipecommon_copyout(dev, rdndx, buffer, nread);
+  nxtrdndx = pipecommon_advance(dev, rdndx, nread);
+
+  /* Release the space only after the data has been copied out and re-read
+   * the write index only after the release is visible to the writer.
+   */
+
+  pipe_barrier();
+  PIPE_STORE(dev->d_rdndx, nxtrdndx);
+  pipe_barrier();
+
+  /* Was the pipe full before this read?  If so, the writer may be waiting */
+
+  if (pipecommon_advance(dev, PIPE_LOAD(dev->d_wrndx), 1) == rdndx)
+    {
+      pipecommon_spsc_wakeup(dev, &dev->d_wrsem, POLLOUT);
+    }
+
+  pipe_dumpbuffer("From PIPE:", (FAR uint8_t *)buffer, nread);
+  return nread;
+}
+#endif
+
+/****************************************************************************
+ * Name: pipecommon_spsc_write
+ *
+ * Description:
+ *   Lock-free write used when the pipe is in SPSC mode.  Only the writer
+ *   modifies d_wrndx.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+static ssize_t pipecommon_spsc_write(FAR struct file *filep,
+                                     FAR struct pipe_dev_s *dev,
+                                     FAR const char *buffer, size_t len)
+{
+  pipe_ndx_t wrndx;
+  pipe_ndx_t rdndx;
+  pipe_ndx_t nxtwrndx;
+  size_t nwritten = 0;
+  size_t nspace;
+  int ret;
+
+  wrndx = dev->d_wrndx;
+  for (; ; )
+    {
+      /* One slot is always left empty to distinguish full from empty */
+
+      rdndx  = PIPE_LOAD(dev->d_rdndx);
+      nspace = dev->d_bufsize - 1 - pipecommon_nbytes(dev, wrndx, rdndx);
+
+      if (nspace == 0)
+        {
+          /* If O_NONBLOCK was set, then return partial bytes written or
+           * EGAIN
+           */
+
+          if (filep->f_oflags & O_NONBLOCK)
+            {
+              return nwritten > 0 ? (ssize_t)nwritten : -EAGAIN;
+            }
+
+          /* Wait for the reader to report the full-to-not-full
+           * transition.
+           */
+
+          ret = nxsem_wait(&dev->d_wrsem);
+          if (ret < 0)
+            {
+              return nwritten > 0 ? (ssize_t)nwritten : ret;
+            }
+
+          continue;
+        }
+
+      if (nspace > len - nwritten)
+        {
+          nspace = len - nwritten;
+        }
+
+      pipecommon_copyin(dev, wrndx, &buffer[nwritten], nspace);
+      nxtwrndx = pipecommon_advance(dev, wrndx, nspace);
+
+      /* Publish the data before the index and re-read the read index only
+       * after the new write index is visible to the reader.
+       */
+
+      pipe_barrier();
+      PIPE_STORE(dev->d_wrndx, nxtwrndx);
+      pipe_barrier();
+
+      /* Was the pipe empty before this write?  If so, the reader may be
+       * waiting.
+       */
+
+      if (PIPE_LOAD(dev->d_rdndx) == wrndx)
+        {
+          pipecommon_spsc_wakeup(dev, &dev->d_rdsem, POLLIN);
+        }
+
+      wrndx     = nxtwrndx;
+      nwritten += nspace;
+
+      if (nwritten >= len)
+        {
+          return len;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -230,6 +569,18 @@ int pipecommon_open(FAR struct file *filep)
       return ret;
     }
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+  /* A pipe in SPSC mode supports only one reader and one writer */
+
+  if (PIPE_IS_SPSC(dev->d_flags) &&
+      (((filep->f_oflags & O_WROK) != 0 && dev->d_nwriters > 0) ||
+       ((filep->f_oflags & O_RDOK) != 0 && dev->d_nreaders > 0)))
+    {
+      (void)nxsem_post(&dev->d_bfsem);
+      return -EBUSY;
+    }
+
+#endif
   /* If this the first reference on the device, then allocate the buffer.
    * In the case of policy 1, the buffer already be present when the pipe
    * is first opened.
@@ -359,6 +710,17 @@ int pipecommon_close(FAR struct file *filep)
                   nxsem_post(&dev->d_rdsem);
                 }
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+              /* An SPSC reader does not hold d_bfsem and may be just about
+               * to wait.  Leave a count so that it cannot miss end-of-file.
+               */
+
+              if (PIPE_IS_SPSC(dev->d_flags) && sval == 0)
+                {
+                  nxsem_post(&dev->d_rdsem);
+                }
+
+#endif
               /* Inform poll readers that other end closed. */
 
               pipecommon_pollnotify(dev, POLLHUP);
@@ -443,6 +805,13 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
       return 0;
     }
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+  if (PIPE_IS_SPSC(dev->d_flags))
+    {
+      return pipecommon_spsc_read(filep, dev, buffer, len);
+    }
+#endif
+
   /* Make sure that we have exclusive access to the device structure */
 
   ret = nxsem_wait(&dev->d_bfsem);
@@ -486,18 +855,15 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   /* Then return whatever is available in the pipe (which is at least one byte) */
 
-  nread = 0;
-  while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
+  nread = pipecommon_nbytes(dev, dev->d_wrndx, dev->d_rdndx);
+  if ((size_t)nread > len)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
-        {
-          dev->d_rdndx = 0;
-        }
-
-      nread++;
+      nread = len;
     }
 
+  pipecommon_copyout(dev, dev->d_rdndx, buffer, nread);
+  dev->d_rdndx = pipecommon_advance(dev, dev->d_rdndx, nread);
+
   /* Notify all waiting writers that bytes have been removed from the buffer */
 
   while (nxsem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0)
@@ -525,7 +891,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
-  int                    nxtwrndx;
+  size_t                 nspace;
   int                    sval;
   int                    ret;
 
@@ -565,6 +931,13 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
 
   DEBUGASSERT(up_interrupt_context() == false);
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+  if (PIPE_IS_SPSC(dev->d_flags))
+    {
+      return pipecommon_spsc_write(filep, dev, buffer, len);
+    }
+#endif
+
   /* Make sure that we have exclusive access to the device structure */
 
   ret = nxsem_wait(&dev->d_bfsem);
@@ -578,26 +951,28 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   last = 0;
   for (; ; )
     {
-      /* Calculate the write index AFTER the next byte is written */
-
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
-        {
-          nxtwrndx = 0;
-        }
+      /* How much space is left in the circular buffer?  One slot is always
+       * left empty to distinguish full from empty.
+       */
 
-      /* Would the next write overflow the circular buffer? */
+      nspace = dev->d_bufsize - 1 -
+               pipecommon_nbytes(dev, dev->d_wrndx, dev->d_rdndx);
 
-      if (nxtwrndx != dev->d_rdndx)
+      if (nspace > 0)
         {
-          /* No... copy the byte */
+          /* Copy as much as will fit */
+
+          if (nspace > len - (size_t)nwritten)
+            {
+              nspace = len - (size_t)nwritten;
+            }
 
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
+          pipecommon_copyin(dev, dev->d_wrndx, &buffer[nwritten], nspace);
+          dev->d_wrndx = pipecommon_advance(dev, dev->d_wrndx, nspace);
 
           /* Is the write complete? */
 
-          nwritten++;
+          nwritten += nspace;
           if ((size_t)nwritten >= len)
             {
               /* Yes.. Notify all of the waiting readers that more data is available */
@@ -619,7 +994,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
         }
       else
         {
-          /* There is not enough room for the next byte.  Was anything written in this pass? */
+          /* The buffer is full.  Was anything written in this pass? */
 
           if (last < nwritten)
             {
@@ -697,6 +1072,12 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
               dev->d_fds[i] = fds;
               fds->priv     = &dev->d_fds[i];
+
+              /* An SPSC peer checks the slot without d_bfsem.  Make it
+               * visible before the indices are sampled below.
+               */
+
+              pipe_barrier();
               break;
             }
         }
@@ -823,6 +1204,88 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      case PIPEIOC_SETSIZE:
+        {
+          FAR uint8_t *buffer;
+
+          /* The size is bounded by the width of pipe_ndx_t.  At least two
+           * bytes are needed because one slot is always left empty.
+           */
+
+          if (arg < 2 || arg > CONFIG_DEV_PIPE_MAXSIZE)
+            {
+              break;
+            }
+
+          /* The buffer cannot be replaced while it holds data or while an
+           * SPSC reader or writer may be accessing it without d_bfsem.
+           */
+
+          if (dev->d_wrndx != dev->d_rdndx ||
+              (PIPE_IS_SPSC(dev->d_flags) && dev->d_refs > 0))
+            {
+              ret = -EBUSY;
+              break;
+            }
+
+          if (dev->d_buffer != NULL && arg != dev->d_bufsize)
+            {
+              buffer = (FAR uint8_t *)kmm_malloc(arg);
+              if (buffer == NULL)
+                {
+                  ret = -ENOMEM;
+                  break;
+                }
+
+              kmm_free(dev->d_buffer);
+              dev->d_buffer = buffer;
+            }
+
+          /* Otherwise the buffer is allocated with the new size on the next
+           * open.
+           */
+
+          dev->d_bufsize = (pipe_ndx_t)arg;
+          dev->d_wrndx   = 0;
+          dev->d_rdndx   = 0;
+          ret            = OK;
+        }
+        break;
+
+      case PIPEIOC_GETSIZE:
+        {
+          ret = dev->d_bufsize;
+        }
+        break;
+
+#ifdef CONFIG_DEV_PIPE_SPSC
+      case PIPEIOC_SPSC:
+        {
+          /* SPSC mode may be enabled only if there is at most one reader and
+           * one writer.  The mode change is serialized with the locked
+           * read/write paths by d_bfsem.
+           */
+
+          if (arg != 0)
+            {
+              if (dev->d_nreaders > 1 || dev->d_nwriters > 1)
+                {
+                  ret = -EBUSY;
+                  break;
+                }
+
+              PIPE_SPSC_ON(dev->d_flags);
+            }
+          else
+            {
+              PIPE_SPSC_OFF(dev->d_flags);
+            }
+
+          ret = OK;
+        }
+        break;
+#endif
+
       case FIONWRITE:  /* Number of bytes waiting in send queue */
       case FIONREAD:   /* Number of bytes available for reading */
         {
@@ -98,6 +98,7 @@
 
 #define PIPE_FLAG_POLICY    (1 << 0) /* Bit 0: Policy=Free buffer when empty */
 #define PIPE_FLAG_UNLINKED  (1 << 1) /* Bit 1: The driver has been unlinked */
+#define PIPE_FLAG_SPSC      (1 << 2) /* Bit 2: Single-producer/single-consumer */
 
 #define PIPE_POLICY_0(f)    do { (f) &= ~PIPE_FLAG_POLICY; } while (0)
 #define PIPE_POLICY_1(f)    do { (f) |= PIPE_FLAG_POLICY; } while (0)
@@ -107,6 +108,13 @@
 #define PIPE_UNLINK(f)      do { (f) |= PIPE_FLAG_UNLINKED; } while (0)
 #define PIPE_IS_UNLINKED(f) (((f) & PIPE_FLAG_UNLINKED) != 0)
 
+#ifdef CONFIG_DEV_PIPE_SPSC
+#  define PIPE_SPSC_ON(f)   do { (f) |= PIPE_FLAG_SPSC; } while (0)
+#  define PIPE_SPSC_OFF(f)  do { (f) &= ~PIPE_FLAG_SPSC; } while (0)
+#  define PIPE_IS_SPSC(f)   (((f) & PIPE_FLAG_SPSC) != 0)
+#else
+#  define PIPE_IS_SPSC(f)   (0)
+#endif
 
 /****************************************************************************
  * Public Types
@@ -40,10 +40,15 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
 #include <sched.h>
+#include <time.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/sched_note.h>
 #include <nuttx/fs/fs.h>
 
@@ -81,6 +86,52 @@ static const struct file_operations note_fops =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: note_header
+ *
+ * Description:
+ *   Format the header that describes the stream of notes.
+ *
+ ****************************************************************************/
+
+static void note_header(FAR struct note_stream_s *hdr)
+{
+  uint64_t tickfs;
+  int i;
+#ifdef CONFIG_SCHED_NOTE_HIRES
+  struct timespec ts;
+
+  /* The units of the high resolution counter are unknown.  Convert a large
+   * count to get the duration of one count with reasonable precision.
+   */
+
+  up_critmon_convert(1 << 20, &ts);
+  tickfs = ((uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec) * 1000000;
+  tickfs >>= 20;
+#else
+  tickfs = (uint64_t)NSEC_PER_TICK * 1000000;
+#endif
+
+  memcpy(hdr->nsh_magic, NOTE_STREAM_MAGIC, 4);
+  hdr->nsh_version = NOTE_STREAM_VERSION;
+  hdr->nsh_flags   = 0;
+#ifdef CONFIG_SMP
+  hdr->nsh_flags  |= NOTE_STREAM_SMP;
+  hdr->nsh_ncpus   = CONFIG_SMP_NCPUS;
+#else
+  hdr->nsh_ncpus   = 1;
+#endif
+#ifdef CONFIG_ENDIAN_BIG
+  hdr->nsh_flags  |= NOTE_STREAM_BIGENDIAN;
+#endif
+  hdr->nsh_ptrsize = sizeof(FAR void *);
+
+  for (i = 0; i < 8; i++)
+    {
+      hdr->nsh_tickfs[i] = (uint8_t)(tickfs >> (8 * i));
+    }
+}
+
 /****************************************************************************
  * Name: note_read
  ****************************************************************************/
@@ -93,9 +144,33 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
 
   DEBUGASSERT(filep != 0 && buffer != NULL && buflen > 0);
 
+  retlen = 0;
+
+  /* The stream begins with a header that describes the notes */
+
+  if (filep->f_pos == 0)
+    {
+      if (buflen < sizeof(struct note_stream_s))
+        {
+          return -EFBIG;
+        }
+
+      note_header((FAR struct note_stream_s *)buffer);
+      retlen += sizeof(struct note_stream_s);
+      buffer += sizeof(struct note_stream_s);
+      buflen -= sizeof(struct note_stream_s);
+
+      /* Don't lose the next note if there is no room left for it */
+
+      if (buflen == 0)
+        {
+          filep->f_pos += retlen;
+          return retlen;
+        }
+    }
+
   /* Then loop, adding as many notes as possible to the user buffer. */
 
-  retlen = 0;
   sched_lock();
   do
     {
@@ -138,6 +213,12 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
   while (notelen > 0 && notelen <= buflen);
 
   sched_unlock();
+
+  if (retlen > 0)
+    {
+      filep->f_pos += retlen;
+    }
+
   return retlen;
 }
 
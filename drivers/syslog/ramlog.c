@@ -99,6 +99,9 @@ struct ramlog_dev_s
 
 #ifdef CONFIG_RAMLOG_SYSLOG
 static int ramlog_flush(void);
+#ifdef CONFIG_SYSLOG_WRITE
+static ssize_t ramlog_syslog_write(FAR const char *buffer, size_t buflen);
+#endif
 #endif
 
 /* Helper functions */
@@ -108,6 +111,8 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                               pollevent_t eventset);
 #endif
 static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+static size_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                            FAR const char *buffer, size_t buflen);
 
 /* Character driver methods */
 
@@ -129,7 +134,10 @@ static const struct syslog_channel_s g_ramlog_syslog_channel =
 {
   ramlog_putc,
   ramlog_putc,
-  ramlog_flush
+  ramlog_flush,
+#ifdef CONFIG_SYSLOG_WRITE
+  ramlog_syslog_write,
+#endif
 };
 #endif
 
@@ -196,6 +204,23 @@ static int ramlog_flush(void)
 }
 #endif
 
+/****************************************************************************
+ * Name: ramlog_syslog_write
+ *
+ * Description:
+ *   SYSLOG channel write method.  The whole buffer is added to the RAM log
+ *   under a single critical section rather than one per character.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_RAMLOG_SYSLOG) && defined(CONFIG_SYSLOG_WRITE)
+static ssize_t ramlog_syslog_write(FAR const char *buffer, size_t buflen)
+{
+  (void)ramlog_addbuf(&g_sysdev, buffer, buflen);
+  return buflen;
+}
+#endif
+
 /****************************************************************************
  * Name: ramlog_pollnotify
  ****************************************************************************/
@@ -268,6 +293,91 @@ static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
   return OK;
 }
 
+/****************************************************************************
+ * Name: ramlog_addbuf
+ *
+ * Description:
+ *   Add a buffer of characters to the circular buffer, performing the same
+ *   CR/LF processing as ramlog_addchar() for each character, but entering
+ *   the critical section only once.  Returns the number of bytes from the
+ *   buffer that were consumed; this is less than buflen only if the
+ *   circular buffer became full.
+ *
+ ****************************************************************************/
+
+static size_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                            FAR const char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+  size_t nwritten;
+  size_t nfree;
+  size_t head;
+  char ch;
+
+  flags = enter_critical_section();
+
+  /* Get the number of bytes that can be added without overflowing the
+   * circular buffer.  One byte is always left unused so that a full
+   * buffer can be distinguished from an empty one.
+   */
+
+  head  = priv->rl_head;
+  nfree = priv->rl_tail + priv->rl_bufsize - head - 1;
+  if (nfree >= priv->rl_bufsize)
+    {
+      nfree -= priv->rl_bufsize;
+    }
+
+  for (nwritten = 0; nwritten < buflen; nwritten++)
+    {
+      ch = buffer[nwritten];
+
+#ifdef CONFIG_RAMLOG_CRLF
+      /* Ignore carriage returns */
+
+      if (ch == '\r')
+        {
+          continue;
+        }
+
+      /* Pre-pend a carriage return before a linefeed */
+
+      if (ch == '\n')
+        {
+          if (nfree < 2)
+            {
+              break;
+            }
+
+          priv->rl_buffer[head] = '\r';
+          if (++head >= priv->rl_bufsize)
+            {
+              head = 0;
+            }
+
+          nfree--;
+        }
+#endif
+
+      if (nfree < 1)
+        {
+          break;
+        }
+
+      priv->rl_buffer[head] = ch;
+      if (++head >= priv->rl_bufsize)
+        {
+          head = 0;
+        }
+
+      nfree--;
+    }
+
+  priv->rl_head = head;
+  leave_critical_section(flags);
+  return nwritten;
+}
+
 /****************************************************************************
  * Name: ramlog_read
  ****************************************************************************/
@@ -447,67 +557,25 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
   ssize_t nwritten;
-  char ch;
-  int ret;
 
   /* Some sanity checking */
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct ramlog_dev_s *)inode->i_private;
 
-  /* Loop until all of the bytes have been written.  This function may be
-   * called from an interrupt handler!  Semaphores cannot be used!
+  /* Add all of the bytes under a single critical section.  This function
+   * may be called from an interrupt handler!  Semaphores cannot be used!
    *
    * The write logic only needs to modify the rl_head index.  Therefore,
    * there is a difference in the way that rl_head and rl_tail are protected:
    * rl_tail is protected with a semaphore; rl_tail is protected by disabling
    * interrupts.
+   *
+   * If the buffer becomes full, the remaining data is dropped on the
+   * floor.
    */
 
-  for (nwritten = 0; (size_t)nwritten < len; nwritten++)
-    {
-      /* Get the next character to output */
-
-      ch = buffer[nwritten];
-
-      /* Ignore carriage returns */
-
-#ifdef CONFIG_RAMLOG_CRLF
-      if (ch == '\r')
-        {
-          continue;
-        }
-
-      /* Pre-pend a carriage before a linefeed */
-
-      if (ch == '\n')
-        {
-          ret = ramlog_addchar(priv, '\r');
-          if (ret < 0)
-            {
-              /* The buffer is full and nothing was saved. Break out of the
-               * loop to return the number of bytes written up to this point.
-               * The data to be written is dropped on the floor.
-               */
-
-              break;
-            }
-        }
-#endif
-
-      /* Then output the character */
-
-      ret = ramlog_addchar(priv, ch);
-      if (ret < 0)
-        {
-          /* The buffer is full and nothing was saved. Break out of the
-           * loop to return the number of bytes written up to this point.
-           * The data to be written is dropped on the floor.
-           */
-
-          break;
-        }
-    }
+  nwritten = (ssize_t)ramlog_addbuf(priv, buffer, len);
 
   /* Was anything written? */
 
@@ -43,6 +43,8 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdarg.h>
+#include <time.h>
 
 /****************************************************************************
  * Public Data
@@ -252,6 +254,51 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
                            bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_deferred_add
+ *
+ * Description:
+ *   Save the format string pointer and the raw arguments of a SYSLOG
+ *   message in the deferred buffer of the current CPU.  The message will be
+ *   formatted later by the low-priority work queue.
+ *
+ * Input Parameters:
+ *   ts  - The time stamp of the message (NULL if CONFIG_SYSLOG_TIMESTAMP
+ *         is not enabled).
+ *   fmt - The format string.  This must be a string constant.
+ *   ap  - The argument list.  This is not modified.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the message was deferred (or discarded
+ *   because the buffer is full).  A negated errno value is returned if the
+ *   message must be formatted in place.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_deferred_add(FAR const struct timespec *ts,
+                        FAR const IPTR char *fmt, FAR va_list *ap);
+#endif
+
+/****************************************************************************
+ * Name: syslog_deferred_flush
+ *
+ * Description:
+ *   Format all deferred SYSLOG messages and write them to the SYSLOG
+ *   channel.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is always returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_deferred_flush(void);
+#endif
+
 /****************************************************************************
  * Name: syslog_putc
  *
@@ -0,0 +1,1019 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/init.h>
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/streams.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define SYSLOG_NCPUS     CONFIG_SMP_NCPUS
+#  define SYSLOG_DMB()     SP_DMB()
+#else
+#  define SYSLOG_NCPUS     1
+#  define SYSLOG_DMB()
+#endif
+
+#define SYSLOG_BUFSIZE     CONFIG_SYSLOG_DEFERRED_BUFSIZE
+
+/* The longest conversion specification (not including the '%') that will
+ * be deferred.  Longer specifications are formatted in place.
+ */
+
+#define SYSLOG_SPEC_MAX    16
+
+/* Size of the buffer used to batch formatted output before it is passed to
+ * syslog_write().
+ */
+
+#define SYSLOG_OUTBUF_SIZE 128
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The type of the argument consumed by one conversion specification */
+
+enum syslog_argtype_e
+{
+  SYSLOG_ARG_NONE = 0,            /* "%%", no argument */
+  SYSLOG_ARG_INT,                 /* int (including promoted char/short) */
+  SYSLOG_ARG_LONG,                /* long */
+#ifdef CONFIG_HAVE_LONG_LONG
+  SYSLOG_ARG_LLONG,               /* long long */
+#endif
+  SYSLOG_ARG_PTR,                 /* void pointer */
+  SYSLOG_ARG_DOUBLE,              /* double */
+  SYSLOG_ARG_STRING,              /* NUL-terminated string, copied */
+  SYSLOG_ARG_INVALID              /* Cannot be deferred */
+};
+
+/* A parsed conversion specification */
+
+struct syslog_spec_s
+{
+  uint8_t type;                   /* See enum syslog_argtype_e */
+  uint8_t len;                    /* Length of the specification after '%' */
+  uint8_t nflags;                 /* Number of flag characters */
+  uint8_t modndx;                 /* Offset to the length modifier */
+  bool    wstar;                  /* Width is provided as an argument */
+  bool    pstar;                  /* Precision is provided as an argument */
+  int     width;                  /* Literal field width (-1 if none) */
+  int     prec;                   /* Literal precision (-1 if none) */
+};
+
+/* Each message is saved in the ring as this header followed by the raw
+ * argument values in the order that they are consumed by the format.
+ * Strings are copied into the ring, including the NUL terminator.
+ */
+
+struct syslog_rechdr_s
+{
+  uint16_t len;                   /* Total record length, including header */
+  FAR const char *fmt;            /* Format string (must be static) */
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  struct timespec ts;             /* Time that the message was generated */
+#endif
+};
+
+/* One single-producer, single-consumer ring per CPU.  The producer is
+ * whatever runs on that CPU with local interrupts disabled; the consumer
+ * is the low-priority worker.
+ */
+
+struct syslog_ring_s
+{
+  volatile size_t head;           /* Producer index */
+  volatile size_t tail;           /* Consumer index */
+  volatile uint32_t dropped;      /* Messages lost because the ring was full */
+  uint32_t reported;              /* Lost messages already reported */
+  uint8_t buffer[SYSLOG_BUFSIZE];
+};
+
+/* Producer write context */
+
+struct syslog_wrctx_s
+{
+  FAR struct syslog_ring_s *ring;
+  size_t index;                   /* Next byte to write */
+  size_t avail;                   /* Bytes that may still be written */
+};
+
+/* Output stream that batches formatted characters into syslog_write() */
+
+struct syslog_ostream_s
+{
+  struct lib_outstream_s public;
+  size_t nbuf;
+  char buffer[SYSLOG_OUTBUF_SIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_ring_s g_syslog_ring[SYSLOG_NCPUS];
+static struct work_s g_syslog_work;
+static bool g_syslog_flushing;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred_parse
+ *
+ * Description:
+ *   Parse the conversion specification that follows a '%' in the format
+ *   string.  Only the subset of lib_vsprintf() that can be reproduced from
+ *   raw argument values is accepted; anything else is reported as
+ *   SYSLOG_ARG_INVALID and the message is formatted in place instead.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_parse(FAR const char *fmt,
+                                  FAR struct syslog_spec_s *spec)
+{
+  FAR const char *ptr = fmt;
+  int nlong = 0;
+
+  spec->type   = SYSLOG_ARG_INVALID;
+  spec->len    = 1;
+  spec->nflags = 0;
+  spec->modndx = 0;
+  spec->wstar  = false;
+  spec->pstar  = false;
+  spec->width  = -1;
+  spec->prec   = -1;
+
+  if (*ptr == '%')
+    {
+      spec->type = SYSLOG_ARG_NONE;
+      return;
+    }
+
+  /* Flags */
+
+  while (*ptr == '-' || *ptr == '+' || *ptr == ' ' || *ptr == '#' ||
+         *ptr == '0')
+    {
+      ptr++;
+    }
+
+  spec->nflags = ptr - fmt;
+
+  /* Field width */
+
+  if (*ptr == '*')
+    {
+      spec->wstar = true;
+      ptr++;
+    }
+  else if (*ptr >= '0' && *ptr <= '9')
+    {
+      spec->width = 0;
+      while (*ptr >= '0' && *ptr <= '9')
+        {
+          spec->width = 10 * spec->width + (*ptr++ - '0');
+        }
+    }
+
+  /* Precision */
+
+  if (*ptr == '.')
+    {
+      ptr++;
+      if (*ptr == '*')
+        {
+          spec->pstar = true;
+          ptr++;
+        }
+      else
+        {
+          spec->prec = 0;
+          while (*ptr >= '0' && *ptr <= '9')
+            {
+              spec->prec = 10 * spec->prec + (*ptr++ - '0');
+            }
+        }
+    }
+
+  /* Length modifier.  'h' only affects how the promoted int is printed. */
+
+  spec->modndx = ptr - fmt;
+  while (*ptr == 'l' || *ptr == 'h')
+    {
+      if (*ptr++ == 'l')
+        {
+          nlong++;
+        }
+    }
+
+  /* Conversion */
+
+  switch (*ptr)
+    {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+      case 'c':
+        if (nlong == 0)
+          {
+            spec->type = SYSLOG_ARG_INT;
+          }
+        else if (nlong == 1)
+          {
+            spec->type = SYSLOG_ARG_LONG;
+          }
+#ifdef CONFIG_HAVE_LONG_LONG
+        else if (nlong == 2)
+          {
+            spec->type = SYSLOG_ARG_LLONG;
+          }
+#endif
+        break;
+
+      case 'p':
+        spec->type = SYSLOG_ARG_PTR;
+        break;
+
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+        spec->type = SYSLOG_ARG_DOUBLE;
+        break;
+
+      case 's':
+      case 'S':
+        spec->type = SYSLOG_ARG_STRING;
+        break;
+
+      default:
+        return;
+    }
+
+  if (ptr - fmt >= SYSLOG_SPEC_MAX)
+    {
+      spec->type = SYSLOG_ARG_INVALID;
+      return;
+    }
+
+  spec->len = ptr - fmt + 1;
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_copyin and syslog_deferred_copyout
+ *
+ * Description:
+ *   Copy data into or out of a ring at the provided index, handling the
+ *   wrap at the end of the buffer.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_copyin(FAR struct syslog_ring_s *ring,
+                                   size_t index, FAR const void *src,
+                                   size_t len)
+{
+  size_t chunk = SYSLOG_BUFSIZE - index;
+
+  if (chunk > len)
+    {
+      chunk = len;
+    }
+
+  memcpy(&ring->buffer[index], src, chunk);
+  if (len > chunk)
+    {
+      memcpy(ring->buffer, (FAR const uint8_t *)src + chunk, len - chunk);
+    }
+}
+
+static void syslog_deferred_copyout(FAR struct syslog_ring_s *ring,
+                                    FAR size_t *index, FAR void *dest,
+                                    size_t len)
+{
+  size_t chunk = SYSLOG_BUFSIZE - *index;
+
+  if (chunk > len)
+    {
+      chunk = len;
+    }
+
+  memcpy(dest, &ring->buffer[*index], chunk);
+  if (len > chunk)
+    {
+      memcpy((FAR uint8_t *)dest + chunk, ring->buffer, len - chunk);
+    }
+
+  *index += len;
+  if (*index >= SYSLOG_BUFSIZE)
+    {
+      *index -= SYSLOG_BUFSIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_put
+ *
+ * Description:
+ *   Append data to the record being built.  If src is NULL, the space is
+ *   only reserved.  Returns false if the ring does not have enough space.
+ *
+ ****************************************************************************/
+
+static bool syslog_deferred_put(FAR struct syslog_wrctx_s *ctx,
+                                FAR const void *src, size_t len)
+{
+  if (len > ctx->avail)
+    {
+      return false;
+    }
+
+  if (src != NULL)
+    {
+      syslog_deferred_copyin(ctx->ring, ctx->index, src, len);
+    }
+
+  ctx->avail -= len;
+  ctx->index += len;
+  if (ctx->index >= SYSLOG_BUFSIZE)
+    {
+      ctx->index -= SYSLOG_BUFSIZE;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_record
+ *
+ * Description:
+ *   Copy the raw argument values consumed by 'fmt' into the ring.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSPC if the ring is too full to hold the
+ *   record; -ENOSYS if the format cannot be deferred.
+ *
+ ****************************************************************************/
+
+static int syslog_deferred_record(FAR struct syslog_wrctx_s *ctx,
+                                  FAR const char *fmt, va_list ap)
+{
+  struct syslog_spec_s spec;
+  FAR const char *ptr;
+  size_t len;
+  bool ok = true;
+  int prec;
+
+  for (ptr = fmt; *ptr != '\0' && ok; ptr++)
+    {
+      if (*ptr != '%')
+        {
+          continue;
+        }
+
+      syslog_deferred_parse(++ptr, &spec);
+      if (spec.type == SYSLOG_ARG_INVALID)
+        {
+          return -ENOSYS;
+        }
+
+      ptr += spec.len - 1;
+      prec = spec.prec;
+
+      if (spec.wstar)
+        {
+          int width = va_arg(ap, int);
+          ok = syslog_deferred_put(ctx, &width, sizeof(int));
+        }
+
+      if (spec.pstar)
+        {
+          prec = va_arg(ap, int);
+          ok = ok && syslog_deferred_put(ctx, &prec, sizeof(int));
+        }
+
+      switch (spec.type)
+        {
+          case SYSLOG_ARG_INT:
+            {
+              int value = va_arg(ap, int);
+              ok = ok && syslog_deferred_put(ctx, &value, sizeof(int));
+            }
+            break;
+
+          case SYSLOG_ARG_LONG:
+            {
+              long value = va_arg(ap, long);
+              ok = ok && syslog_deferred_put(ctx, &value, sizeof(long));
+            }
+            break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+          case SYSLOG_ARG_LLONG:
+            {
+              long long value = va_arg(ap, long long);
+              ok = ok && syslog_deferred_put(ctx, &value, sizeof(long long));
+            }
+            break;
+#endif
+
+          case SYSLOG_ARG_PTR:
+            {
+              FAR void *value = va_arg(ap, FAR void *);
+              ok = ok && syslog_deferred_put(ctx, &value, sizeof(FAR void *));
+            }
+            break;
+
+          case SYSLOG_ARG_DOUBLE:
+            {
+              double value = va_arg(ap, double);
+              ok = ok && syslog_deferred_put(ctx, &value, sizeof(double));
+            }
+            break;
+
+          case SYSLOG_ARG_STRING:
+            {
+              /* The string may not outlive the caller, so its content
+               * (limited by the precision) is copied into the ring.
+               */
+
+              FAR const char *str = va_arg(ap, FAR const char *);
+              if (str == NULL)
+                {
+                  str = "(null)";
+                }
+
+              len = strnlen(str, prec >= 0 ? (size_t)prec : SIZE_MAX);
+              ok = ok && syslog_deferred_put(ctx, str, len) &&
+                   syslog_deferred_put(ctx, "", 1);
+            }
+            break;
+
+          default:
+            break;
+        }
+    }
+
+  return ok ? OK : -ENOSPC;
+}
+
+/****************************************************************************
+ * Name: syslog_ostream_putc and syslog_ostream_flush
+ *
+ * Description:
+ *   Batch formatted output so that the SYSLOG channel sees one
+ *   syslog_write() per buffer rather than one call per character.
+ *
+ ****************************************************************************/
+
+static int syslog_ostream_flush(FAR struct lib_outstream_s *this)
+{
+  FAR struct syslog_ostream_s *stream = (FAR struct syslog_ostream_s *)this;
+
+  if (stream->nbuf > 0)
+    {
+      (void)syslog_write(stream->buffer, stream->nbuf);
+      stream->nbuf = 0;
+    }
+
+  return OK;
+}
+
+static void syslog_ostream_putc(FAR struct lib_outstream_s *this, int ch)
+{
+  FAR struct syslog_ostream_s *stream = (FAR struct syslog_ostream_s *)this;
+
+  if (stream->nbuf >= SYSLOG_OUTBUF_SIZE)
+    {
+      (void)syslog_ostream_flush(this);
+    }
+
+  stream->buffer[stream->nbuf++] = ch;
+  this->nput++;
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_putstr
+ *
+ * Description:
+ *   Output a string argument that was copied into the ring, applying the
+ *   field width.  A width of zero means that there is no field width; a
+ *   negative width (from a '*' argument) means that the string is left
+ *   justified.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_putstr(FAR struct syslog_ostream_s *stream,
+                                   FAR struct syslog_ring_s *ring,
+                                   FAR size_t *index, int width, bool left)
+{
+  size_t ndx = *index;
+  int len = 0;
+
+  while (ring->buffer[ndx] != '\0')
+    {
+      len++;
+      if (++ndx >= SYSLOG_BUFSIZE)
+        {
+          ndx = 0;
+        }
+    }
+
+  if (width < 0)
+    {
+      width = -width;
+      left  = true;
+    }
+
+  for (; !left && len < width; width--)
+    {
+      syslog_ostream_putc(&stream->public, ' ');
+    }
+
+  ndx = *index;
+  while (ring->buffer[ndx] != '\0')
+    {
+      syslog_ostream_putc(&stream->public, ring->buffer[ndx]);
+      if (++ndx >= SYSLOG_BUFSIZE)
+        {
+          ndx = 0;
+        }
+    }
+
+  for (; len < width; width--)
+    {
+      syslog_ostream_putc(&stream->public, ' ');
+    }
+
+  *index = ndx + 1 < SYSLOG_BUFSIZE ? ndx + 1 : 0;
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_format
+ *
+ * Description:
+ *   Format one record from the ring, reproducing the output that
+ *   nx_vsyslog() would have generated in place.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_format(FAR struct syslog_ostream_s *stream,
+                                   FAR struct syslog_ring_s *ring,
+                                   FAR const struct syslog_rechdr_s *hdr,
+                                   size_t index)
+{
+  struct syslog_spec_s spec;
+  FAR const char *ptr;
+  char specbuf[SYSLOG_SPEC_MAX + 24];
+  int width;
+  int prec;
+  int n;
+
+#if defined(CONFIG_SYSLOG_TIMESTAMP)
+  (void)lib_sprintf(&stream->public, "[%5d.%06d] ",
+                    hdr->ts.tv_sec, hdr->ts.tv_nsec/1000);
+#endif
+
+#if defined(CONFIG_SYSLOG_PREFIX)
+  (void)lib_sprintf(&stream->public, "%s", CONFIG_SYSLOG_PREFIX_STRING);
+#endif
+
+  for (ptr = hdr->fmt; *ptr != '\0'; ptr++)
+    {
+      if (*ptr != '%')
+        {
+          syslog_ostream_putc(&stream->public, *ptr);
+          continue;
+        }
+
+      syslog_deferred_parse(++ptr, &spec);
+      if (spec.type == SYSLOG_ARG_INVALID)
+        {
+          /* The format was accepted when the record was added, so the
+           * format string must have been modified since.
+           */
+
+          break;
+        }
+      else if (spec.type == SYSLOG_ARG_NONE)
+        {
+          syslog_ostream_putc(&stream->public, '%');
+          continue;
+        }
+
+      width = spec.width;
+      prec  = spec.prec;
+
+      if (spec.wstar)
+        {
+          syslog_deferred_copyout(ring, &index, &width, sizeof(int));
+        }
+
+      if (spec.pstar)
+        {
+          syslog_deferred_copyout(ring, &index, &prec, sizeof(int));
+        }
+
+      if (spec.type == SYSLOG_ARG_STRING)
+        {
+          /* A literal width of -1 means that there is no field width.  Only
+           * a width provided by a '*' argument may be negative.
+           */
+
+          if (!spec.wstar && width < 0)
+            {
+              width = 0;
+            }
+
+          syslog_deferred_putstr(stream, ring, &index, width,
+                                 memchr(ptr, '-', spec.nflags) != NULL);
+          ptr += spec.len - 1;
+          continue;
+        }
+
+      /* Rebuild the specification with any '*' replaced by its value */
+
+      if (!spec.wstar && !spec.pstar)
+        {
+          specbuf[0] = '%';
+          memcpy(&specbuf[1], ptr, spec.len);
+          specbuf[spec.len + 1] = '\0';
+        }
+      else
+        {
+          n = snprintf(specbuf, sizeof(specbuf), "%%%.*s", spec.nflags, ptr);
+          if (width >= 0 || spec.wstar)
+            {
+              n += snprintf(&specbuf[n], sizeof(specbuf) - n, "%d", width);
+            }
+
+          if (prec >= 0)
+            {
+              n += snprintf(&specbuf[n], sizeof(specbuf) - n, ".%d", prec);
+            }
+
+          (void)snprintf(&specbuf[n], sizeof(specbuf) - n, "%.*s",
+                         spec.len - spec.modndx, &ptr[spec.modndx]);
+        }
+
+      ptr += spec.len - 1;
+
+      switch (spec.type)
+        {
+          case SYSLOG_ARG_INT:
+            {
+              int value;
+              syslog_deferred_copyout(ring, &index, &value, sizeof(int));
+              (void)lib_sprintf(&stream->public, specbuf, value);
+            }
+            break;
+
+          case SYSLOG_ARG_LONG:
+            {
+              long value;
+              syslog_deferred_copyout(ring, &index, &value, sizeof(long));
+              (void)lib_sprintf(&stream->public, specbuf, value);
+            }
+            break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+          case SYSLOG_ARG_LLONG:
+            {
+              long long value;
+              syslog_deferred_copyout(ring, &index, &value,
+                                      sizeof(long long));
+              (void)lib_sprintf(&stream->public, specbuf, value);
+            }
+            break;
+#endif
+
+          case SYSLOG_ARG_PTR:
+            {
+              FAR void *value;
+              syslog_deferred_copyout(ring, &index, &value,
+                                      sizeof(FAR void *));
+              (void)lib_sprintf(&stream->public, specbuf, value);
+            }
+            break;
+
+          case SYSLOG_ARG_DOUBLE:
+            {
+              double value;
+              syslog_deferred_copyout(ring, &index, &value, sizeof(double));
+              (void)lib_sprintf(&stream->public, specbuf, value);
+            }
+            break;
+
+          default:
+            break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_worker
+ *
+ * Description:
+ *   Low-priority work queue handler that drains the deferred buffers.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_worker(FAR void *arg)
+{
+  (void)syslog_deferred_flush();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred_add
+ *
+ * Description:
+ *   Save the format string pointer and the raw argument values of a SYSLOG
+ *   message in the ring of the current CPU and schedule the low-priority
+ *   worker to format it.  Only local interrupts are disabled while the
+ *   record is built; no lock is shared with the other CPUs or with the
+ *   worker.
+ *
+ *   If the ring is full, the message is discarded and counted.  The number
+ *   of discarded messages is reported in the output by the worker.
+ *
+ * Input Parameters:
+ *   ts  - The time stamp of the message (NULL if CONFIG_SYSLOG_TIMESTAMP
+ *         is not enabled).
+ *   fmt - The format string.  This must remain valid until the message
+ *         is formatted, i.e., it must be a string constant.
+ *   ap  - The argument list.  This is not modified.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the message was deferred or discarded.  A
+ *   negated errno value is returned if the message must be formatted in
+ *   place instead:  -EAGAIN if the OS is not yet fully initialized,
+ *   -ENOSYS if the format uses a conversion that cannot be deferred, or
+ *   -E2BIG if the message is larger than the ring.
+ *
+ ****************************************************************************/
+
+int syslog_deferred_add(FAR const struct timespec *ts,
+                        FAR const IPTR char *fmt, FAR va_list *ap)
+{
+  FAR struct syslog_ring_s *ring;
+  struct syslog_rechdr_s hdr;
+  struct syslog_wrctx_s ctx;
+  irqstate_t flags;
+  size_t avail;
+  size_t head;
+  va_list copy;
+  int ret;
+
+  /* The worker cannot run until the OS is fully initialized */
+
+  if (!OSINIT_OS_READY())
+    {
+      return -EAGAIN;
+    }
+
+  va_copy(copy, *ap);
+
+  /* Disabling local interrupts makes this the only producer for the ring
+   * of this CPU.
+   */
+
+  flags = up_irq_save();
+  ring  = &g_syslog_ring[up_cpu_index()];
+  head  = ring->head;
+
+  avail = ring->tail + SYSLOG_BUFSIZE - head - 1;
+  if (avail >= SYSLOG_BUFSIZE)
+    {
+      avail -= SYSLOG_BUFSIZE;
+    }
+
+  ctx.ring  = ring;
+  ctx.index = head;
+  ctx.avail = avail;
+
+  /* Reserve space for the header, then add the arguments */
+
+  ret = syslog_deferred_put(&ctx, NULL, sizeof(hdr)) ?
+        syslog_deferred_record(&ctx, fmt, copy) : -ENOSPC;
+
+  if (ret == -ENOSPC)
+    {
+      /* A message that does not fit in an empty ring will never fit */
+
+      if (avail == SYSLOG_BUFSIZE - 1)
+        {
+          ret = -E2BIG;
+        }
+      else
+        {
+          ring->dropped++;
+          ret = OK;
+        }
+    }
+  else if (ret == OK)
+    {
+      hdr.len = (uint16_t)(avail - ctx.avail);
+      hdr.fmt = fmt;
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+      hdr.ts  = *ts;
+#endif
+
+      syslog_deferred_copyin(ring, head, &hdr, sizeof(hdr));
+
+      /* Make sure that the record is visible before it is published */
+
+      SYSLOG_DMB();
+      ring->head = ctx.index;
+    }
+
+  up_irq_restore(flags);
+  va_end(copy);
+
+  /* Wake up the worker if it is not already pending.  The unlocked test
+   * avoids the critical section while a burst of messages is queued.
+   */
+
+  if (ret == OK && work_available(&g_syslog_work))
+    {
+      flags = enter_critical_section();
+      if (work_available(&g_syslog_work))
+        {
+          (void)work_queue(LPWORK, &g_syslog_work, syslog_deferred_worker,
+                           NULL, 0);
+        }
+
+      leave_critical_section(flags);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_flush
+ *
+ * Description:
+ *   Format all messages in the deferred buffers and write them to the
+ *   SYSLOG channel.  This is normally done by the low-priority worker, but
+ *   it is also called by syslog_flush() so that deferred messages are not
+ *   lost on a crash.
+ *
+ *   The rings are drained one CPU at a time, so messages generated on
+ *   different CPUs may be out of order; the time stamps, if enabled, give
+ *   the actual order.
+ *
+ *   Only one context may drain the rings at a time.  If the rings are
+ *   already being drained, e.g., syslog_flush() is called while the worker
+ *   is running, this function returns immediately.  It cannot wait here
+ *   because syslog_flush() may be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is always returned.
+ *
+ ****************************************************************************/
+
+int syslog_deferred_flush(void)
+{
+  FAR struct syslog_ring_s *ring;
+  struct syslog_rechdr_s hdr;
+  struct syslog_ostream_s stream;
+  uint32_t dropped;
+  size_t head;
+  size_t tail;
+  size_t index;
+  irqstate_t flags;
+  bool busy;
+  int cpu;
+  int ret;
+
+  flags = enter_critical_section();
+  busy  = g_syslog_flushing;
+  g_syslog_flushing = true;
+  leave_critical_section(flags);
+
+  if (busy)
+    {
+      return OK;
+    }
+
+  stream.public.put   = syslog_ostream_putc;
+  stream.public.flush = syslog_ostream_flush;
+  stream.public.nput  = 0;
+  stream.nbuf         = 0;
+
+  for (cpu = 0; cpu < SYSLOG_NCPUS; cpu++)
+    {
+      ring = &g_syslog_ring[cpu];
+
+      head = ring->head;
+      SYSLOG_DMB();
+
+      for (tail = ring->tail; tail != head; )
+        {
+          index = tail;
+          syslog_deferred_copyout(ring, &index, &hdr, sizeof(hdr));
+          syslog_deferred_format(&stream, ring, &hdr, index);
+
+          /* Release the space only after the record has been formatted */
+
+          tail += hdr.len;
+          if (tail >= SYSLOG_BUFSIZE)
+            {
+              tail -= SYSLOG_BUFSIZE;
+            }
+
+          SYSLOG_DMB();
+          ring->tail = tail;
+        }
+
+      /* Messages are dropped only when the ring is full, i.e., after the
+       * messages just output.
+       */
+
+      dropped = ring->dropped;
+      if (dropped != ring->reported)
+        {
+          (void)lib_sprintf(&stream.public,
+                            "[%lu syslog messages dropped]\n",
+                            (unsigned long)(dropped - ring->reported));
+          ring->reported = dropped;
+        }
+    }
+
+  ret = syslog_ostream_flush(&stream.public);
+  g_syslog_flushing = false;
+  return ret;
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
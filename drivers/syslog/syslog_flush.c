@@ -81,6 +81,14 @@ int syslog_flush(void)
 {
   DEBUGASSERT(g_syslog_channel != NULL);
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Format any messages that are still waiting for the low-priority work
+   * queue.
+   */
+
+  (void)syslog_deferred_flush();
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
   /* Flush any characters that may have been added to the interrupt
    * buffer.
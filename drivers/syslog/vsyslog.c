@@ -49,6 +49,8 @@
 #include <nuttx/streams.h>
 #include <nuttx/syslog/syslog.h>
 
+#include "syslog.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -110,6 +112,26 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
     }
 #endif
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Leave the formatting of all but emergency output to the low-priority
+   * work queue.  Nothing has been output yet, so zero is returned.  If the
+   * message cannot be deferred, fall through and format it in place.
+   */
+
+  if (priority != LOG_EMERG)
+    {
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+      ret = syslog_deferred_add(&ts, fmt, ap);
+#else
+      ret = syslog_deferred_add(NULL, fmt, ap);
+#endif
+      if (ret >= 0)
+        {
+          return 0;
+        }
+    }
+#endif
+
   /* Wrap the low-level output in a stream object and let lib_vsprintf
    * do the work.  NOTE that emergency priority output is handled
    * differently.. it will use the SYSLOG emergency stream.
@@ -43,6 +43,21 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* File data is held in a sequence of blocks, each beginning with one of the
+ * LZF headers of include/lzf.h:  LZF_TYPE0_HDR (uncompressed) or
+ * LZF_TYPE1_HDR (LZF compressed).  In addition, a block may be compressed
+ * in the LZ4 block format.  That block has the same header layout as a
+ * LZF_TYPE1_HDR block, 'Z', 'V', type, clen[2], ulen[2], but with the type
+ * CROMFS_LZ4_HDR.
+ */
+
+#define CROMFS_LZ4_HDR       2
+#define CROMFS_LZ4_HDR_SIZE  7
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
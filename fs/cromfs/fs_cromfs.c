@@ -62,18 +62,40 @@
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_CROMFS)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CROMFS_HASH_NONE       0xffff /* Marks the end of a hash chain */
+#define CROMFS_HASH_MINBUCKETS 16     /* Minimum number of hash buckets */
+
+#ifndef CONFIG_FS_CROMFS_NCACHED_BLOCKS
+#  define CONFIG_FS_CROMFS_NCACHED_BLOCKS 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* This structure describes one decompressed block in the file's block
+ * cache.
+ */
+
+struct cromfs_cache_s
+{
+  uint32_t cb_offset;                       /* Cached block offset (zero means none) */
+  uint32_t cb_stamp;                        /* Time of last use for LRU replacement */
+  FAR uint8_t *cb_buffer;                   /* Cached, decompressed data */
+};
+
 /* This structure represents an open, regular file */
 
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
-  uint32_t ff_offset;                       /* Cached block offset (zero means none) */
-  uint16_t ff_ulen;                         /* Length of decompressed data in cache */
-  FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+  uint32_t ff_stamp;                        /* Incremented on each cache access */
+  FAR uint8_t *ff_buffer;                   /* Memory for all cached blocks */
+  struct cromfs_cache_s ff_cache[CONFIG_FS_CROMFS_NCACHED_BLOCKS];
 };
 
 /* This is the form of the callback from cromfs_foreach_node(): */
@@ -95,6 +117,33 @@ struct cromfs_comparenode_s
   uint16_t seglen;                         /* Length of the next path segment */
 };
 
+/* This structure describes one node in the directory hash index.  Entries
+ * are keyed by the offset of the first node in the containing directory
+ * and the node name.
+ */
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+struct cromfs_hashent_s
+{
+  uint32_t he_parent;                       /* Offset to the first node of the directory */
+  uint32_t he_node;                         /* Offset to the node */
+  uint32_t he_hash;                         /* Hash of he_parent and the node name */
+  uint16_t he_next;                         /* Index of the next entry in the hash chain */
+};
+
+/* The directory hash index of the CROMFS image.  It is built by the first
+ * mount and released by the last unmount.
+ */
+
+struct cromfs_dirhash_s
+{
+  FAR struct cromfs_hashent_s *dh_ents;     /* Hash entries, at most one per node */
+  FAR uint16_t *dh_buckets;                 /* Heads of the hash chains */
+  uint16_t dh_mask;                         /* Number of hash buckets - 1 */
+  uint16_t dh_nrefs;                        /* Number of mounts using the index */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -112,9 +161,34 @@ static uint16_t cromfs_seglen(FAR const char *relpath);
 static int      cromfs_comparenode(FAR const struct cromfs_volume_s *fs,
                                    FAR const struct cromfs_node_s *node,
                                    FAR void *arg);
+static int      cromfs_allocbuffer(FAR const struct cromfs_volume_s *fs,
+                                   FAR struct cromfs_file_s *ff);
+static FAR struct cromfs_cache_s *
+                cromfs_cacheblock(FAR struct cromfs_file_s *ff,
+                                  uint32_t voloffs, bool alloc);
+#ifdef CONFIG_FS_CROMFS_LZ4
+static unsigned int cromfs_lz4_decompress(FAR const uint8_t *src,
+                                          unsigned int srclen,
+                                          FAR uint8_t *dest,
+                                          unsigned int destlen);
+#endif
+static int      cromfs_decompress(uint8_t type, FAR const uint8_t *src,
+                                  uint16_t clen, FAR uint8_t *dest,
+                                  uint16_t ulen);
+static int      cromfs_searchdir(FAR const struct cromfs_volume_s *fs,
+                                 FAR const struct cromfs_node_s *node,
+                                 FAR struct cromfs_comparenode_s *cpnode);
 static int      cromfs_findnode(FAR const struct cromfs_volume_s *fs,
                                 FAR const struct cromfs_node_s **node,
                                 FAR const char *relpath);
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+static uint32_t cromfs_namehash(uint32_t seed, FAR const char *name,
+                                int len);
+static int      cromfs_hashdir(FAR const struct cromfs_volume_s *fs,
+                               uint32_t diroffset, uint16_t *pnents);
+static int      cromfs_buildhash(FAR const struct cromfs_volume_s *fs);
+static void     cromfs_freehash(void);
+#endif
 
 /* Common file system methods */
 
@@ -194,6 +268,14 @@ const struct mountpt_operations cromfs_operations =
 
 extern const struct cromfs_volume_s g_cromfs_image;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+static struct cromfs_dirhash_s g_cromfs_dirhash;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -414,7 +496,7 @@ static int cromfs_comparenode(FAR const struct cromfs_volume_s *fs,
 
       /* Then recurse */
 
-      return cromfs_foreach_node(fs, child, cromfs_comparenode, cpnode);
+      return cromfs_searchdir(fs, child, cpnode);
     }
   else
     {
@@ -422,6 +504,296 @@ static int cromfs_comparenode(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_allocbuffer
+ *
+ * Description:
+ *   Allocate the decompression buffers for a newly opened file
+ *
+ ****************************************************************************/
+
+static int cromfs_allocbuffer(FAR const struct cromfs_volume_s *fs,
+                              FAR struct cromfs_file_s *ff)
+{
+  int i;
+
+  ff->ff_buffer = (FAR uint8_t *)
+    kmm_malloc(CONFIG_FS_CROMFS_NCACHED_BLOCKS * fs->cv_bsize);
+  if (ff->ff_buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CONFIG_FS_CROMFS_NCACHED_BLOCKS; i++)
+    {
+      ff->ff_cache[i].cb_offset = 0;
+      ff->ff_cache[i].cb_stamp  = 0;
+      ff->ff_cache[i].cb_buffer = &ff->ff_buffer[i * fs->cv_bsize];
+    }
+
+  ff->ff_stamp = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cromfs_cacheblock
+ *
+ * Description:
+ *   Return the cache entry holding the decompressed data for the compressed
+ *   block at voloffs.  If the block is not cached and alloc is true, return
+ *   the least recently used entry (which the caller must refill),
+ *   otherwise return NULL.
+ *
+ ****************************************************************************/
+
+static FAR struct cromfs_cache_s *
+cromfs_cacheblock(FAR struct cromfs_file_s *ff, uint32_t voloffs, bool alloc)
+{
+  FAR struct cromfs_cache_s *victim;
+  FAR struct cromfs_cache_s *blk;
+  int i;
+
+  victim = &ff->ff_cache[0];
+  for (i = 0; i < CONFIG_FS_CROMFS_NCACHED_BLOCKS; i++)
+    {
+      blk = &ff->ff_cache[i];
+      if (blk->cb_offset == voloffs)
+        {
+          blk->cb_stamp = ++ff->ff_stamp;
+          return blk;
+        }
+
+      if ((int32_t)(blk->cb_stamp - victim->cb_stamp) < 0)
+        {
+          victim = blk;
+        }
+    }
+
+  if (!alloc)
+    {
+      return NULL;
+    }
+
+  victim->cb_offset = 0;
+  victim->cb_stamp  = ++ff->ff_stamp;
+  return victim;
+}
+
+/****************************************************************************
+ * Name: cromfs_lz4_decompress
+ *
+ * Description:
+ *   Decompress one block in the LZ4 block format.  Returns the number of
+ *   decompressed bytes or zero if the data is corrupted or would overrun
+ *   the output buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_LZ4
+static unsigned int cromfs_lz4_decompress(FAR const uint8_t *src,
+                                          unsigned int srclen,
+                                          FAR uint8_t *dest,
+                                          unsigned int destlen)
+{
+  FAR const uint8_t *iend = src + srclen;
+  FAR const uint8_t *match;
+  FAR uint8_t *op = dest;
+  FAR uint8_t *oend = dest + destlen;
+  unsigned int offset;
+  size_t len;
+  uint8_t token;
+  uint8_t ext;
+
+  while (src < iend)
+    {
+      /* Get the literal length from the token */
+
+      token = *src++;
+      len   = token >> 4;
+      if (len == 15)
+        {
+          do
+            {
+              if (src >= iend)
+                {
+                  return 0;
+                }
+
+              ext  = *src++;
+              len += ext;
+            }
+          while (ext == 255);
+        }
+
+      /* Copy the literals */
+
+      if (len > (size_t)(iend - src) || len > (size_t)(oend - op))
+        {
+          return 0;
+        }
+
+      memcpy(op, src, len);
+      op  += len;
+      src += len;
+
+      /* The last sequence holds only literals */
+
+      if (src >= iend)
+        {
+          break;
+        }
+
+      /* Get the match offset (little-endian) and length */
+
+      if (iend - src < 2)
+        {
+          return 0;
+        }
+
+      offset = (unsigned int)src[0] | ((unsigned int)src[1] << 8);
+      src   += 2;
+
+      if (offset == 0 || offset > (unsigned int)(op - dest))
+        {
+          return 0;
+        }
+
+      len = token & 15;
+      if (len == 15)
+        {
+          do
+            {
+              if (src >= iend)
+                {
+                  return 0;
+                }
+
+              ext  = *src++;
+              len += ext;
+            }
+          while (ext == 255);
+        }
+
+      len += 4;
+      if (len > (size_t)(oend - op))
+        {
+          return 0;
+        }
+
+      /* Copy the match.  The source and destination may overlap when the
+       * offset is less than the length.
+       */
+
+      match = op - offset;
+      if (offset >= len)
+        {
+          memcpy(op, match, len);
+          op += len;
+        }
+      else
+        {
+          while (len-- > 0)
+            {
+              *op++ = *match++;
+            }
+        }
+    }
+
+  return (unsigned int)(op - dest);
+}
+#endif
+
+/****************************************************************************
+ * Name: cromfs_decompress
+ *
+ * Description:
+ *   Decompress one compressed block of type LZF_TYPE1_HDR or
+ *   CROMFS_LZ4_HDR into dest.
+ *
+ ****************************************************************************/
+
+static int cromfs_decompress(uint8_t type, FAR const uint8_t *src,
+                             uint16_t clen, FAR uint8_t *dest, uint16_t ulen)
+{
+  unsigned int decomplen;
+
+  switch (type)
+    {
+      case LZF_TYPE1_HDR:
+        decomplen = lzf_decompress(src, clen, dest, ulen);
+        break;
+
+#ifdef CONFIG_FS_CROMFS_LZ4
+      case CROMFS_LZ4_HDR:
+        decomplen = cromfs_lz4_decompress(src, clen, dest, ulen);
+        break;
+#endif
+
+      default:
+        ferr("ERROR: Unsupported block type %u\n", type);
+        return -ENOSYS;
+    }
+
+  if (decomplen != ulen)
+    {
+      ferr("ERROR: Corrupted block: ulen=%u decomplen=%u\n", ulen, decomplen);
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cromfs_searchdir
+ *
+ * Description:
+ *   Search the directory whose first node is 'node' for the next path
+ *   segment in cpnode.  If the directory hash index is available, only the
+ *   nodes with a matching name hash are compared.  Otherwise all nodes in
+ *   the directory are traversed.
+ *
+ ****************************************************************************/
+
+static int cromfs_searchdir(FAR const struct cromfs_volume_s *fs,
+                            FAR const struct cromfs_node_s *node,
+                            FAR struct cromfs_comparenode_s *cpnode)
+{
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+  FAR const struct cromfs_hashent_s *ent;
+  uint32_t parent;
+  uint32_t hash;
+  uint16_t ndx;
+  int ret;
+
+  if (g_cromfs_dirhash.dh_buckets != NULL && node != NULL)
+    {
+      parent = cromfs_addr2offset(fs, node);
+      hash   = cromfs_namehash(parent, cpnode->segment, cpnode->seglen);
+
+      for (ndx = g_cromfs_dirhash.dh_buckets[hash & g_cromfs_dirhash.dh_mask];
+           ndx != CROMFS_HASH_NONE;
+           ndx = ent->he_next)
+        {
+          ent = &g_cromfs_dirhash.dh_ents[ndx];
+          if (ent->he_hash == hash && ent->he_parent == parent)
+            {
+              ret = cromfs_comparenode(fs, (FAR const struct cromfs_node_s *)
+                                       cromfs_offset2addr(fs, ent->he_node),
+                                       cpnode);
+              if (ret != 0)
+                {
+                  return ret;
+                }
+            }
+        }
+
+      return 0;
+    }
+#endif
+
+  return cromfs_foreach_node(fs, node, cromfs_comparenode, cpnode);
+}
+
 /****************************************************************************
  * Name: cromfs_findnode
  ****************************************************************************/
@@ -463,7 +835,7 @@ static int cromfs_findnode(FAR const struct cromfs_volume_s *fs,
   cpnode.segment = relpath;
   cpnode.seglen  = (uint16_t)cromfs_seglen(relpath);
 
-  ret = cromfs_foreach_node(fs, root, cromfs_comparenode, &cpnode);
+  ret = cromfs_searchdir(fs, root, &cpnode);
   if (ret > 0)
     {
       return OK;
@@ -478,6 +850,187 @@ static int cromfs_findnode(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_namehash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a name segment of length len, seeded with
+ *   the offset of the directory that contains it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+static uint32_t cromfs_namehash(uint32_t seed, FAR const char *name, int len)
+{
+  uint32_t hash = 2166136261u ^ seed;
+
+  while (len-- > 0)
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: cromfs_hashdir
+ *
+ * Description:
+ *   Add every node in the directory beginning at diroffset to the directory
+ *   hash index under construction.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+static int cromfs_hashdir(FAR const struct cromfs_volume_s *fs,
+                          uint32_t diroffset, uint16_t *pnents)
+{
+  FAR const struct cromfs_node_s *node;
+  FAR struct cromfs_hashent_s *ent;
+  FAR const char *name;
+
+  node = (FAR const struct cromfs_node_s *)cromfs_offset2addr(fs, diroffset);
+  while (node != NULL)
+    {
+      /* There cannot be more entries than nodes in the image */
+
+      if (*pnents >= fs->cv_nnodes)
+        {
+          return -EIO;
+        }
+
+      name           = (FAR const char *)cromfs_offset2addr(fs, node->cn_name);
+      ent            = &g_cromfs_dirhash.dh_ents[(*pnents)++];
+      ent->he_parent = diroffset;
+      ent->he_node   = cromfs_addr2offset(fs, node);
+      ent->he_hash   = cromfs_namehash(diroffset, name, strlen(name));
+
+      node = (FAR const struct cromfs_node_s *)
+             cromfs_offset2addr(fs, node->cn_peer);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: cromfs_buildhash
+ *
+ * Description:
+ *   Walk the directory tree of the CROMFS image and build the directory
+ *   hash index used by cromfs_findnode().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+static int cromfs_buildhash(FAR const struct cromfs_volume_s *fs)
+{
+  FAR struct cromfs_hashent_s *ents;
+  FAR const struct cromfs_node_s *node;
+  FAR uint16_t *buckets;
+  uint32_t nbuckets;
+  uint32_t bucket;
+  uint16_t nents = 0;
+  uint16_t ndx;
+  int ret;
+
+  ents = (FAR struct cromfs_hashent_s *)
+    kmm_malloc(fs->cv_nnodes * sizeof(struct cromfs_hashent_s));
+  if (ents == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  g_cromfs_dirhash.dh_ents = ents;
+
+  /* Index the root directory, then each sub-directory as it is found.  The
+   * entry array doubles as the queue of directories still to be indexed.
+   * Hard links (including "." and "..") are not followed.
+   */
+
+  ret = cromfs_hashdir(fs, fs->cv_root, &nents);
+  for (ndx = 0; ret >= 0 && ndx < nents; ndx++)
+    {
+      node = (FAR const struct cromfs_node_s *)
+             cromfs_offset2addr(fs, ents[ndx].he_node);
+      if (S_ISDIR(node->cn_mode) && !S_ISLNK(node->cn_mode) &&
+          node->u.cn_child != 0)
+        {
+          ret = cromfs_hashdir(fs, node->u.cn_child, &nents);
+        }
+    }
+
+  if (ret < 0)
+    {
+      goto errout_with_ents;
+    }
+
+  /* Size the bucket array to the next power of two above the number of
+   * entries and link each entry into its hash chain.
+   */
+
+  nbuckets = CROMFS_HASH_MINBUCKETS;
+  while (nbuckets < nents)
+    {
+      nbuckets <<= 1;
+    }
+
+  buckets = (FAR uint16_t *)kmm_malloc(nbuckets * sizeof(uint16_t));
+  if (buckets == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_ents;
+    }
+
+  memset(buckets, 0xff, nbuckets * sizeof(uint16_t));
+  for (ndx = 0; ndx < nents; ndx++)
+    {
+      bucket            = ents[ndx].he_hash & (nbuckets - 1);
+      ents[ndx].he_next = buckets[bucket];
+      buckets[bucket]   = ndx;
+    }
+
+  g_cromfs_dirhash.dh_buckets = buckets;
+  g_cromfs_dirhash.dh_mask    = (uint16_t)(nbuckets - 1);
+
+  finfo("Indexed %u nodes in %lu buckets\n",
+        nents, (unsigned long)nbuckets);
+  return OK;
+
+errout_with_ents:
+  kmm_free(ents);
+  g_cromfs_dirhash.dh_ents = NULL;
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: cromfs_freehash
+ *
+ * Description:
+ *   Release the directory hash index
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+static void cromfs_freehash(void)
+{
+  if (g_cromfs_dirhash.dh_buckets != NULL)
+    {
+      kmm_free(g_cromfs_dirhash.dh_buckets);
+      g_cromfs_dirhash.dh_buckets = NULL;
+    }
+
+  if (g_cromfs_dirhash.dh_ents != NULL)
+    {
+      kmm_free(g_cromfs_dirhash.dh_ents);
+      g_cromfs_dirhash.dh_ents = NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: cromfs_open
  ****************************************************************************/
@@ -546,13 +1099,13 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
+  /* Create the file buffers to support partial sector accesses */
 
-  ff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
-  if (!ff->ff_buffer)
+  ret = cromfs_allocbuffer(fs, ff);
+  if (ret < 0)
     {
       kmm_free(ff);
-      return -ENOMEM;
+      return ret;
     }
 
   /* Save the node in the open file instance */
@@ -688,6 +1241,8 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
             }
           else
             {
+              /* LZF_TYPE1_HDR and CROMFS_LZ4_HDR share the same layout */
+
               FAR struct lzf_type1_header_s * hdr1 =
                 (FAR struct lzf_type1_header_s *)currhdr;
 
@@ -728,82 +1283,68 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          /* If the source of the data is at the beginning of the compressed
-           * data buffer and if the uncompressed data would not overrun the
-           * buffer, then we can decompress directly into the user buffer.
-           */
+          FAR struct cromfs_cache_s *blk;
+          uint32_t voloffs;
+          int ret;
+
+          copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
+          DEBUGASSERT(ulen > copyoffs);
+          copysize = ulen - copyoffs;
 
-          if (filep->f_pos <= blkoffs && ulen <= remaining)
+          if (copysize > remaining)  /* Clip to the size really needed */
             {
-              uint32_t voloffs;
+              copysize = remaining;
+            }
 
-              copyoffs = 0;
-              copysize = ulen;
+          DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
 
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
-               */
+          /* Get the address and offset in the CROMFS image to obtain the
+           * data.  Check if we already have this offset in the cache.
+           */
 
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
+          src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+          voloffs = cromfs_addr2offset(fs, src);
+          blk     = cromfs_cacheblock(ff, voloffs, false);
 
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
+          if (blk == NULL && copyoffs == 0 && copysize == ulen)
+            {
+              /* The whole block is needed and is not cached.  We can
+               * decompress directly into the user buffer.
+               */
 
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+              ret = cromfs_decompress(currhdr->lzf_type, src, clen, dest,
+                                      ulen);
+              if (ret < 0)
+                {
+                  return ret;
                 }
-
-              finfo("voloffs=%lu blkoffs=%lu ulen=%u ff_offset=%u copysize=%u\n",
-                    (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
-                    ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
             }
           else
             {
-              uint32_t voloffs;
-
-              /* No, we will need to decompress into the our intermediate
-               * decompression buffer.
+              /* Otherwise decompress into the least recently used cache
+               * buffer (if not cached) and copy to the user buffer.
                */
 
-              copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
-              DEBUGASSERT(ulen > copyoffs);
-              copysize = ulen - copyoffs;
-
-              if (copysize > remaining)  /* Clip to the size really needed */
-                {
-                  copysize = remaining;
-                }
-
-              DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
-
-              src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
+              if (blk == NULL)
                 {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, ff->ff_buffer,
-                                             fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  blk = cromfs_cacheblock(ff, voloffs, true);
+                  ret = cromfs_decompress(currhdr->lzf_type, src, clen,
+                                          blk->cb_buffer, ulen);
+                  if (ret < 0)
+                    {
+                      return ret;
+                    }
+
+                  blk->cb_offset = voloffs;
                 }
 
-              finfo("voloffs=%lu blkoffs=%lu ulen=%u clen=%u ff_offset=%u "
-                    "copyoffs=%u copysize=%u\n",
-                    (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
-                    clen, ff->ff_offset, copyoffs, copysize);
-              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
-
-              /* Then copy to user buffer */
-
-              memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
+              memcpy(dest, &blk->cb_buffer[copyoffs], copysize);
             }
+
+          finfo("voloffs=%lu blkoffs=%lu ulen=%u clen=%u "
+                "copyoffs=%u copysize=%u\n",
+                (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
+                clen, copyoffs, copysize);
         }
 
       /* Adjust pointers counts and offset */
@@ -845,6 +1386,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   FAR struct cromfs_volume_s *fs;
   FAR struct cromfs_file_s *oldff;
   FAR struct cromfs_file_s *newff;
+  int ret;
 
   finfo("Dup %p->%p\n", oldp, newp);
   DEBUGASSERT(oldp->f_priv != NULL && oldp->f_inode != NULL &&
@@ -870,13 +1412,13 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
+  /* Create the file buffers to support partial sector accesses */
 
-  newff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
-  if (newff->ff_buffer == NULL)
+  ret = cromfs_allocbuffer(fs, newff);
+  if (ret < 0)
     {
       kmm_free(newff);
-      return -ENOMEM;
+      return ret;
     }
 
   /* Save the node in the open file instance */
@@ -1113,6 +1655,31 @@ static int cromfs_bind(FAR struct inode *blkdriver, const void *data,
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
   DEBUGASSERT(g_cromfs_image.cv_magic == CROMFS_MAGIC);
 
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+  /* Hash entries are indexed by node and CROMFS_HASH_NONE ends a chain, so
+   * that index must not be a valid one.  gencromfs refuses such images.
+   */
+
+  if (g_cromfs_image.cv_nnodes >= CROMFS_HASH_NONE)
+    {
+      ferr("ERROR: Too many nodes: %u\n", g_cromfs_image.cv_nnodes);
+      return -EFBIG;
+    }
+
+  /* Build the directory hash index on the first mount.  This is only an
+   * optimization:  If it fails, directories are searched linearly.
+   */
+
+  if (g_cromfs_dirhash.dh_nrefs++ == 0)
+    {
+      int ret = cromfs_buildhash(&g_cromfs_image);
+      if (ret < 0)
+        {
+          fwarn("WARNING: cromfs_buildhash failed: %d\n", ret);
+        }
+    }
+#endif
+
   /* Return the new file system handle */
 
   *handle = (FAR void *)&g_cromfs_image;
@@ -1132,6 +1699,15 @@ static int cromfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 {
   finfo("handle: %p blkdriver: %p flags: %02x\n",
         handle, blkdriver, flags);
+
+#ifdef CONFIG_FS_CROMFS_DIRHASH
+  /* Release the directory hash index on the last unmount */
+
+  if (g_cromfs_dirhash.dh_nrefs > 0 && --g_cromfs_dirhash.dh_nrefs == 0)
+    {
+      cromfs_freehash();
+    }
+#endif
   return OK;
 }
 
@@ -45,6 +45,8 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
@@ -65,6 +67,11 @@
  * removed.  In that case umount() holds the inode semaphore, but the block
  * driver may callback to unregister_blockdriver() after the un-mount,
  * requiring the semaphore again.
+ *
+ * If CONFIG_FS_INODE_RWLOCK is selected, look-ups may instead get shared
+ * access.  A reader holds the semaphore only long enough to count itself
+ * in 'nreaders'; the holder of the semaphore must then wait for 'nreaders'
+ * to drain to zero before it may modify the inode tree.
  */
 
 struct inode_sem_s
@@ -72,6 +79,11 @@ struct inode_sem_s
   sem_t   sem;     /* The semaphore */
   pid_t   holder;  /* The current holder of the semaphore */
   int16_t count;   /* Number of counts held */
+#ifdef CONFIG_FS_INODE_RWLOCK
+  int16_t nreaders; /* Number of readers with shared access */
+  bool    wrwait;  /* True: The holder waits for readers to drain */
+  sem_t   rdsem;   /* Posted when the last reader leaves */
+#endif
 };
 
 /****************************************************************************
@@ -103,6 +115,17 @@ void inode_initialize(void)
   g_inode_sem.holder = NO_HOLDER;
   g_inode_sem.count  = 0;
 
+#ifdef CONFIG_FS_INODE_RWLOCK
+  /* The reader semaphore is used for signaling, not for mutual exclusion,
+   * and should not have priority inheritance enabled.
+   */
+
+  g_inode_sem.nreaders = 0;
+  g_inode_sem.wrwait   = false;
+  (void)nxsem_init(&g_inode_sem.rdsem, 0, 0);
+  (void)nxsem_setprotocol(&g_inode_sem.rdsem, SEM_PRIO_NONE);
+#endif
+
   /* Initialize files array (if it is used) */
 
 #ifdef CONFIG_HAVE_WEAKFUNCTIONS
@@ -140,6 +163,9 @@ void inode_semtake(void)
 
   else
     {
+#ifdef CONFIG_FS_INODE_RWLOCK
+      irqstate_t flags;
+#endif
       int ret;
 
       do
@@ -154,6 +180,21 @@ void inode_semtake(void)
         }
       while (ret == -EINTR);
 
+#ifdef CONFIG_FS_INODE_RWLOCK
+      /* No new readers can enter while we hold the semaphore.  Wait for
+       * the readers already in the tree to leave.
+       */
+
+      flags = enter_critical_section();
+      while (g_inode_sem.nreaders > 0)
+        {
+          g_inode_sem.wrwait = true;
+          (void)nxsem_wait(&g_inode_sem.rdsem);
+        }
+
+      leave_critical_section(flags);
+#endif
+
       /* No we hold the semaphore */
 
       g_inode_sem.holder = me;
@@ -191,3 +232,82 @@ void inode_semgive(void)
       nxsem_post(&g_inode_sem.sem);
     }
 }
+
+/****************************************************************************
+ * Name: inode_rdtake
+ *
+ * Description:
+ *   Get shared, read-only access to the in-memory inode tree.  Other
+ *   readers may access the tree concurrently, but no modification of the
+ *   tree is possible until inode_rdgive() is called.  The caller must not
+ *   call inode_semtake() while it has shared access.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_RWLOCK
+void inode_rdtake(void)
+{
+  irqstate_t flags;
+  int ret;
+
+  /* If we already have exclusive access, then just nest it */
+
+  if (getpid() == g_inode_sem.holder)
+    {
+      inode_semtake();
+      return;
+    }
+
+  /* Otherwise, wait for any exclusive holder to finish and count
+   * ourself as a reader.
+   */
+
+  do
+    {
+      ret = nxsem_wait(&g_inode_sem.sem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+
+  flags = enter_critical_section();
+  g_inode_sem.nreaders++;
+  DEBUGASSERT(g_inode_sem.nreaders > 0);
+  leave_critical_section(flags);
+
+  nxsem_post(&g_inode_sem.sem);
+}
+#endif
+
+/****************************************************************************
+ * Name: inode_rdgive
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_RWLOCK
+void inode_rdgive(void)
+{
+  irqstate_t flags;
+
+  if (getpid() == g_inode_sem.holder)
+    {
+      inode_semgive();
+      return;
+    }
+
+  /* Wake up the exclusive holder if it waits for the last reader */
+
+  flags = enter_critical_section();
+  DEBUGASSERT(g_inode_sem.nreaders > 0);
+
+  if (--g_inode_sem.nreaders == 0 && g_inode_sem.wrwait)
+    {
+      g_inode_sem.wrwait = false;
+      nxsem_post(&g_inode_sem.rdsem);
+    }
+
+  leave_critical_section(flags);
+}
+#endif
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <errno.h>
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 #include "inode/inode.h"
 
@@ -60,8 +61,18 @@ void inode_addref(FAR struct inode *inode)
 {
   if (inode)
     {
+#ifdef CONFIG_FS_INODE_RWLOCK
+      irqstate_t flags;
+
+      inode_rdtake();
+      flags = enter_critical_section();
+      inode->i_crefs++;
+      leave_critical_section(flags);
+      inode_rdgive();
+#else
       inode_semtake();
       inode->i_crefs++;
       inode_semgive();
+#endif
     }
 }
@@ -42,6 +42,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
@@ -64,13 +65,16 @@
 
 int inode_find(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODE_RWLOCK
+  irqstate_t flags;
+#endif
   int ret;
 
   /* Find the node matching the path.  If found, increment the count of
    * references on the node.
    */
 
-  inode_semtake();
+  inode_rdtake();
   ret = inode_search(desc);
   if (ret >= 0)
     {
@@ -79,11 +83,19 @@ int inode_find(FAR struct inode_search_s *desc)
       FAR struct inode *node = desc->node;
       DEBUGASSERT(node != NULL);
 
-      /* Increment the reference count on the inode */
+      /* Increment the reference count on the inode.  Other look-ups may be
+       * doing the same concurrently.
+       */
 
+#ifdef CONFIG_FS_INODE_RWLOCK
+      flags = enter_critical_section();
       node->i_crefs++;
+      leave_critical_section(flags);
+#else
+      node->i_crefs++;
+#endif
     }
 
-  inode_semgive();
+  inode_rdgive();
   return ret;
 }
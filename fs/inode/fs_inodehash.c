@@ -0,0 +1,262 @@
+/****************************************************************************
+ * fs/inode/fs_inodehash.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_HASH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_INODE_HASHSIZE
+#  define CONFIG_FS_INODE_HASHSIZE 64
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All inodes in the pseudo-file system, hashed by parent inode and name */
+
+static FAR struct inode *g_inode_hash[CONFIG_FS_INODE_HASHSIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hashndx
+ *
+ * Description:
+ *   Return the hash table index for the path segment 'name' (terminated
+ *   with either '/' or NUL) below 'parent'.  This is an FNV-1a hash seeded
+ *   with the address of the parent inode.
+ *
+ ****************************************************************************/
+
+static unsigned int inode_hashndx(FAR struct inode *parent,
+                                  FAR const char *name)
+{
+  uint32_t hash = 2166136261u ^ (uint32_t)((uintptr_t)parent >> 2);
+
+  while (*name != '\0' && *name != '/')
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash % CONFIG_FS_INODE_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: inode_hashmatch
+ *
+ * Description:
+ *   Return true if the path segment 'name' is the same as the inode name.
+ *
+ ****************************************************************************/
+
+static bool inode_hashmatch(FAR const char *name, FAR const char *nname)
+{
+  while (*nname != '\0')
+    {
+      if (*name++ != *nname++)
+        {
+          return false;
+        }
+    }
+
+  return *name == '\0' || *name == '/';
+}
+
+/****************************************************************************
+ * Name: inode_hashremove
+ *
+ * Description:
+ *   Remove one inode from the hash index
+ *
+ ****************************************************************************/
+
+static void inode_hashremove(FAR struct inode *node)
+{
+  FAR struct inode *prev;
+  FAR struct inode *curr;
+  unsigned int ndx;
+
+  ndx = inode_hashndx(node->i_parent, node->i_name);
+  for (prev = NULL, curr = g_inode_hash[ndx];
+       curr != NULL && curr != node;
+       prev = curr, curr = curr->i_hnext);
+
+  if (curr != NULL)
+    {
+      if (prev != NULL)
+        {
+          prev->i_hnext = node->i_hnext;
+        }
+      else
+        {
+          g_inode_hash[ndx] = node->i_hnext;
+        }
+    }
+
+  node->i_hnext = NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hashfind
+ *
+ * Description:
+ *   Use the hash index to find the child of 'parent' (NULL for the root
+ *   level) whose name matches the first segment of 'name'.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore (shared or exclusive)
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_hashfind(FAR struct inode *parent,
+                                 FAR const char *name)
+{
+  FAR struct inode *node;
+
+  for (node = g_inode_hash[inode_hashndx(parent, name)];
+       node != NULL;
+       node = node->i_hnext)
+    {
+      if (node->i_parent == parent && inode_hashmatch(name, node->i_name))
+        {
+          return node;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: inode_hashinsert
+ *
+ * Description:
+ *   Add a newly inserted inode to the hash index.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore exclusively
+ *
+ ****************************************************************************/
+
+void inode_hashinsert(FAR struct inode *node, FAR struct inode *parent)
+{
+  unsigned int ndx;
+
+  DEBUGASSERT(node != NULL);
+
+  node->i_parent    = parent;
+  ndx               = inode_hashndx(parent, node->i_name);
+  node->i_hnext     = g_inode_hash[ndx];
+  g_inode_hash[ndx] = node;
+}
+
+/****************************************************************************
+ * Name: inode_unhash
+ *
+ * Description:
+ *   Remove an unlinked inode and all of the inodes below it from the hash
+ *   index.
+ *
+ *   The inodes below must be removed too:  Their hash keys refer to the
+ *   address of their parent which will be re-used when the unlinked inode
+ *   is freed.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore exclusively
+ *
+ ****************************************************************************/
+
+void inode_unhash(FAR struct inode *node)
+{
+  FAR struct inode *child;
+
+  DEBUGASSERT(node != NULL);
+
+  for (child = node->i_child; child != NULL; child = child->i_peer)
+    {
+      inode_unhash(child);
+    }
+
+  inode_hashremove(node);
+}
+
+/****************************************************************************
+ * Name: inode_rehash
+ *
+ * Description:
+ *   Add all of the inodes below 'parent' to the hash index.  This is used
+ *   when a subtree is moved to a new parent inode.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore exclusively
+ *
+ ****************************************************************************/
+
+void inode_rehash(FAR struct inode *parent)
+{
+  FAR struct inode *child;
+
+  DEBUGASSERT(parent != NULL);
+
+  for (child = parent->i_child; child != NULL; child = child->i_peer)
+    {
+      inode_hashinsert(child, parent);
+      inode_rehash(child);
+    }
+}
+
+#endif /* CONFIG_FS_INODE_HASH */
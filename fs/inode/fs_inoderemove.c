@@ -91,6 +91,27 @@ FAR struct inode *inode_unlink(FAR const char *path)
       node = desc.node;
       DEBUGASSERT(node != NULL);
 
+#ifdef CONFIG_FS_INODE_HASH
+      /* A node found through the hash index is returned without its left
+       * peer.  Find that now.
+       */
+
+      if (desc.peer == NULL)
+        {
+          FAR struct inode *peer = desc.parent != NULL ?
+                                   desc.parent->i_child : g_root_inode;
+
+          for (; peer != NULL && peer != node && peer->i_peer != node;
+               peer = peer->i_peer);
+
+          desc.peer = peer != node ? peer : NULL;
+        }
+
+      /* Remove the node and everything below it from the hash index */
+
+      inode_unhash(node);
+#endif
+
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
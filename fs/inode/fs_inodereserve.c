@@ -135,6 +135,10 @@ static void inode_insert(FAR struct inode *node,
       node->i_peer = g_root_inode;
       g_root_inode = node;
     }
+
+#ifdef CONFIG_FS_INODE_HASH
+  inode_hashinsert(node, parent);
+#endif
 }
 
 /****************************************************************************
@@ -280,7 +280,26 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
   while (node != NULL)
     {
-      int result = _inode_compare(name, node);
+      int result;
+
+#ifdef CONFIG_FS_INODE_HASH
+      /* At the first peer of each level, try the hash index before
+       * searching the sorted list of peers.  If the name is not in the
+       * index, then the search of the list below will fail but will also
+       * find the insertion point (left) needed by inode_reserve().
+       */
+
+      if (left == NULL)
+        {
+          FAR struct inode *found = inode_hashfind(above, name);
+          if (found != NULL)
+            {
+              node = found;
+            }
+        }
+#endif
+
+      result = _inode_compare(name, node);
 
       /* Case 1:  The name is less than the name of the node.
        * Since the names are ordered, these means that there
@@ -106,7 +106,10 @@
  *  node     - INPUT:  (not used)
  *             OUTPUT: On success, holds the pointer to the inode found.
  *  peer     - INPUT:  (not used)
- *             OUTPUT: The inode to the "left" of the inode found.
+ *             OUTPUT: The inode to the "left" of the inode found.  This is
+ *                     valid only if the search fails.  If the inode was
+ *                     found through the hash index (CONFIG_FS_INODE_HASH),
+ *                     peer will be NULL.
  *  parent   - INPUT:  (not used)
  *             OUTPUT: The inode to the "above" of the inode found.
  *  relpath  - INPUT:  (not used)
@@ -200,6 +203,37 @@ void inode_semtake(void);
 
 void inode_semgive(void);
 
+/****************************************************************************
+ * Name: inode_rdtake
+ *
+ * Description:
+ *   Get shared, read-only access to the in-memory inode tree.  Other
+ *   readers may access the tree concurrently, but no modification of the
+ *   tree is possible until inode_rdgive() is called.  The caller must not
+ *   call inode_semtake() while it has shared access.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_RWLOCK
+void inode_rdtake(void);
+#else
+#  define inode_rdtake() inode_semtake()
+#endif
+
+/****************************************************************************
+ * Name: inode_rdgive
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_RWLOCK
+void inode_rdgive(void);
+#else
+#  define inode_rdgive() inode_semgive()
+#endif
+
 /****************************************************************************
  * Name: inode_search
  *
@@ -264,6 +298,70 @@ int inode_find(FAR struct inode_search_s *desc);
 struct stat;  /* Forward reference */
 int inode_stat(FAR struct inode *inode, FAR struct stat *buf);
 
+/****************************************************************************
+ * Name: inode_hashfind
+ *
+ * Description:
+ *   Use the hash index to find the child of 'parent' (NULL for the root
+ *   level) whose name matches the first segment of 'name'.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore (shared or exclusive)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+FAR struct inode *inode_hashfind(FAR struct inode *parent,
+                                 FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: inode_hashinsert
+ *
+ * Description:
+ *   Add a newly inserted inode to the hash index.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore exclusively
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+void inode_hashinsert(FAR struct inode *node, FAR struct inode *parent);
+#endif
+
+/****************************************************************************
+ * Name: inode_unhash
+ *
+ * Description:
+ *   Remove an unlinked inode and all of the inodes below it from the hash
+ *   index.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore exclusively
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+void inode_unhash(FAR struct inode *node);
+#endif
+
+/****************************************************************************
+ * Name: inode_rehash
+ *
+ * Description:
+ *   Add all of the inodes below 'parent' to the hash index.  This is used
+ *   when a subtree is moved to a new parent inode.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore exclusively
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_HASH
+void inode_rehash(FAR struct inode *parent);
+#endif
+
 /****************************************************************************
  * Name: inode_free
  *
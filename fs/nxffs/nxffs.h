@@ -50,9 +50,14 @@
 #include <stdbool.h>
 #include <semaphore.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/fs/nxffs.h>
 
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+#  include <nuttx/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -133,7 +138,9 @@
  *    open flag is not supported.
  * 6. The re-packing process occurs only during a write when the free FLASH
  *    memory at the end of the FLASH is exhausted.  Thus, occasionally, file
- *    writing may take a long time.
+ *    writing may take a long time.  With CONFIG_NXFFS_PACK_BACKGROUND, most
+ *    of that work is done ahead of time, in slices, on the low priority
+ *    work queue.
  * 7. Another limitation is that there can be only a single NXFFS volume
  *    mounted at any time.  This has to do with the fact that we bind to
  *    an MTD driver (instead of a block driver) and bypass all of the normal
@@ -185,6 +192,20 @@
 
 #define NXFFS_NERASED             128
 
+/* Incremental packing */
+
+#ifndef CONFIG_NXFFS_PACK_SLICE
+#  define CONFIG_NXFFS_PACK_SLICE 1
+#endif
+
+#ifndef CONFIG_NXFFS_PACK_WATERMARK
+#  define CONFIG_NXFFS_PACK_WATERMARK 25
+#endif
+
+#ifndef CONFIG_NXFFS_PACK_DELAY
+#  define CONFIG_NXFFS_PACK_DELAY 50
+#endif
+
 /* Quasi-standard definitions */
 
 #ifndef MIN
@@ -302,6 +323,17 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+  struct work_s             packwork;  /* Supports background packing */
+#endif
+  bool                      dirty;     /* Packing may recover some space */
+  uint32_t                  npacks;    /* Number of completed packing passes */
+  uint32_t                  nslices;   /* Number of incremental packing slices */
+  off_t                     compacted; /* Bytes of stale data packed out */
+  off_t                     reclaimed; /* Bytes returned to the free region */
+  clock_t                   maxslice;  /* Longest packing slice (ticks) */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -1082,6 +1114,55 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name);
 
 int nxffs_pack(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_packslice
+ *
+ * Description:
+ *   Perform one bounded slice of an incremental pack, leaving the volume in
+ *   a consistent state so that the volume semaphore may be released
+ *   between slices.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   Zero is returned if the packing pass is complete; -EAGAIN is returned
+ *   if more slices are needed.  Otherwise, a negated errno value is
+ *   returned to indicate the nature of the failure.
+ *
+ * Defined in nxffs_pack.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+int nxffs_packslice(FAR struct nxffs_volume_s *volume);
+#endif
+
+/****************************************************************************
+ * Name: nxffs_packnotify
+ *
+ * Description:
+ *   Called with the volume semaphore held after FLASH has been consumed or
+ *   an inode deleted.  If the free FLASH has dropped below the configured
+ *   watermark and there may be space to recover, schedule incremental
+ *   packing on the low priority work queue.
+ *
+ * Input Parameters:
+ *   volume - The volume that was modified.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_pack.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+void nxffs_packnotify(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_packnotify(v)
+#endif
+
 /****************************************************************************
  * Standard mountpoint operation methods
  *
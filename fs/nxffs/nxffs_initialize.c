@@ -186,6 +186,9 @@ int nxffs_initialize(FAR struct mtd_dev_s *mtd)
 
   volume->mtd    = mtd;
   volume->cblock = (off_t)-1;
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  volume->dirty  = true;
+#endif
   nxsem_init(&volume->exclsem, 0, 1);
   nxsem_init(&volume->wrsem, 0, 1);
 
@@ -565,6 +568,17 @@ int nxffs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return -ENOSYS;
     }
 
-  return g_volume.ofiles ? -EBUSY : OK;
+  if (g_volume.ofiles)
+    {
+      return -EBUSY;
+    }
+
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+  /* Stop any background packing */
+
+  work_cancel(LPWORK, &g_volume.packwork);
+#endif
+
+  return OK;
 #endif
 }
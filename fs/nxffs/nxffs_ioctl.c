@@ -116,9 +116,26 @@ int nxffs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     {
       finfo("Optimize command\n");
 
-      /* Pack the volume */
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+      /* A non-zero argument requests a single, bounded slice of packing.
+       * -EAGAIN is returned if more slices are needed.
+       */
 
-      ret = nxffs_pack(volume);
+      if (arg != 0)
+        {
+          ret = nxffs_packslice(volume);
+          if (ret == OK)
+            {
+              volume->dirty = false;
+            }
+        }
+      else
+#endif
+        {
+          /* Pack the volume */
+
+          ret = nxffs_pack(volume);
+        }
     }
   else
     {
@@ -1169,6 +1169,13 @@ int nxffs_close(FAR struct file *filep)
           ret = nxffs_wrclose(volume, (FAR struct nxffs_wrfile_s *)ofile);
         }
 
+      /* The file data of a writer now occupies FLASH, and background
+       * packing may have been deferred while this file was open.  Check if
+       * it is time to start packing the volume in the background.
+       */
+
+      nxffs_packnotify(volume);
+
       /* Release all resouces held by the open file */
 
       nxffs_freeofile(volume, ofile);
@@ -48,6 +48,8 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
 
 #include "nxffs.h"
 
@@ -55,6 +57,14 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* When an incremental pack stops on an inode boundary, the stale region
+ * between the end of the packed data and the end of the source data is
+ * filled with this value.  It is neither the erased state (which would
+ * terminate inode searches) nor the start of any NXFFS magic sequence.
+ */
+
+#define NXFFS_FILLSTATE (CONFIG_NXFFS_ERASEDSTATE ^ 0xff)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -87,6 +97,13 @@ struct nxffs_pack_s
   off_t                ioblock;    /* I/O block number */
   off_t                block0;     /* First I/O block number in the erase block */
   uint16_t             iooffset;   /* I/O block offset */
+
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  /* These support stopping an incremental pack at an inode boundary */
+
+  off_t                srcend;     /* End of the last source inode packed */
+  bool                 stop;       /* Stop after the current inode */
+#endif
 };
 
 /****************************************************************************
@@ -952,6 +969,31 @@ static inline int nxffs_packblock(FAR struct nxffs_volume_s *volume,
           nxffs_wrdathdr(volume, pack);
           nxffs_wrinodehdr(volume, pack);
 
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+          /* If this slice of an incremental pack has used up its budget,
+           * then stop here on the inode boundary.  Everything in FLASH
+           * before srcend has now been copied to the destination.
+           */
+
+          if (pack->stop)
+            {
+              if (pack->src.blkoffset > 0)
+                {
+                  pack->srcend = pack->src.blkoffset + SIZEOF_NXFFS_DATA_HDR +
+                                 pack->src.blklen;
+                }
+              else
+                {
+                  pack->srcend = pack->src.entry.hoffset +
+                                 SIZEOF_NXFFS_INODE_HDR;
+                }
+
+              nxffs_freeentry(&pack->src.entry);
+              memset(&pack->src, 0, sizeof(struct nxffs_packstream_s));
+              return -EAGAIN;
+            }
+#endif
+
           /* Find the next valid source inode */
 
           offset = pack->src.blkoffset + pack->src.blklen;
@@ -1245,18 +1287,129 @@ static inline int nxffs_packwriter(FAR struct nxffs_volume_s *volume,
 }
 
 /****************************************************************************
- * Public Functions
+ * Name: nxffs_packerased
+ *
+ * Description:
+ *   Check if the data areas of every good block in the erase block that
+ *   was just read into the pack buffer are already in the erased state.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed
+ *   pack   - The volume packing state structure.
+ *
+ * Returned Value:
+ *   True if the erase block is clean and need not be re-written.
+ *
  ****************************************************************************/
 
+#ifndef CONFIG_NXFFS_NAND
+static bool nxffs_packerased(FAR struct nxffs_volume_s *volume,
+                             FAR struct nxffs_pack_s *pack)
+{
+  FAR struct nxffs_block_s *blkhdr;
+  FAR uint8_t *blkptr;
+  size_t datlen;
+  int i;
+
+  datlen = volume->geo.blocksize - SIZEOF_NXFFS_BLOCK_HDR;
+  for (i = 0, blkptr = volume->pack;
+       i < volume->blkper;
+       i++, blkptr += volume->geo.blocksize)
+    {
+      /* Bad blocks are not modified by packing */
+
+      blkhdr = (FAR struct nxffs_block_s *)blkptr;
+      if (memcmp(blkhdr->magic, g_blockmagic, NXFFS_MAGICSIZE) == 0 &&
+          blkhdr->state == BLOCK_STATE_GOOD &&
+          nxffs_erased(&blkptr[SIZEOF_NXFFS_BLOCK_HDR], datlen) < datlen)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
- * Name: nxffs_pack
+ * Name: nxffs_packfill
  *
  * Description:
- *   Pack and re-write the filesystem in order to free up memory at the end
- *   of FLASH.
+ *   An incremental pack has stopped on an inode boundary in the current
+ *   erase block.  Fill the stale region of the pack buffer between the end
+ *   of the packed data and the end of the source data so that there are no
+ *   erased gaps or duplicate inode headers left behind.  Anything in the
+ *   pack buffer beyond the end of the source data is still valid and must
+ *   be written back unmodified.
  *
  * Input Parameters:
- *   volume - The volume to be packed.
+ *   volume - The volume to be packed
+ *   pack   - The volume packing state structure.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+static void nxffs_packfill(FAR struct nxffs_volume_s *volume,
+                           FAR struct nxffs_pack_s *pack)
+{
+  FAR struct nxffs_block_s *blkhdr;
+  FAR uint8_t *blkptr;
+  off_t blkstart;
+  off_t block;
+  off_t endoffset;
+  off_t offset;
+
+  for (block = pack->ioblock;
+       block < pack->block0 + volume->blkper;
+       block++)
+    {
+      blkptr   = &volume->pack[(block - pack->block0) * volume->geo.blocksize];
+      blkstart = block * volume->geo.blocksize;
+      offset   = (block == pack->ioblock) ? pack->iooffset :
+                                            SIZEOF_NXFFS_BLOCK_HDR;
+
+      /* Stop when we reach the end of the source data */
+
+      if (blkstart + offset >= pack->srcend)
+        {
+          break;
+        }
+
+      /* Skip over any bad blocks (the current block is always good) */
+
+      blkhdr = (FAR struct nxffs_block_s *)blkptr;
+      if (block != pack->ioblock &&
+          (memcmp(blkhdr->magic, g_blockmagic, NXFFS_MAGICSIZE) != 0 ||
+           blkhdr->state != BLOCK_STATE_GOOD))
+        {
+          continue;
+        }
+
+      /* Fill up to the end of the source data or the end of the block */
+
+      endoffset = MIN(pack->srcend - blkstart, volume->geo.blocksize);
+      memset(&blkptr[offset], NXFFS_FILLSTATE, endoffset - offset);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxffs_packstale
+ *
+ * Description:
+ *   An incremental pack has stopped on an inode boundary.  Any source inode
+ *   headers that lie in erase blocks beyond the one just written are now
+ *   duplicates of inodes that were moved.  Mark them as deleted.  This only
+ *   burns bits from the erased to the non-erased state.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed
+ *   pack   - The volume packing state structure.
+ *   offset - FLASH offset to the first byte after the erase block that was
+ *     just written.
  *
  * Returned Value:
  *   Zero on success; Otherwise, a negated errno value is returned to
@@ -1264,13 +1417,93 @@ static inline int nxffs_packwriter(FAR struct nxffs_volume_s *volume,
  *
  ****************************************************************************/
 
-int nxffs_pack(FAR struct nxffs_volume_s *volume)
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+static int nxffs_packstale(FAR struct nxffs_volume_s *volume,
+                           FAR struct nxffs_pack_s *pack, off_t offset)
+{
+  FAR struct nxffs_inode_s *inode;
+  struct nxffs_entry_s entry;
+  int ret;
+
+  while (offset < pack->srcend)
+    {
+      /* Find the next valid inode header at or after this offset */
+
+      ret = nxffs_nextentry(volume, offset, &entry);
+      if (ret < 0)
+        {
+          return ret == -ENOENT ? OK : ret;
+        }
+
+      nxffs_freeentry(&entry);
+      if (entry.hoffset >= pack->srcend)
+        {
+          break;
+        }
+
+      /* Change the inode state to deleted in the cached block and write
+       * it back to FLASH.
+       */
+
+      nxffs_ioseek(volume, entry.hoffset);
+      ret = nxffs_rdcache(volume, volume->ioblock);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to read block %d into cache: %d\n",
+               volume->ioblock, ret);
+          return ret;
+        }
+
+      inode = (FAR struct nxffs_inode_s *)&volume->cache[volume->iooffset];
+      inode->state = INODE_STATE_DELETED;
+
+      ret = nxffs_wrcache(volume);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to write block %d: %d\n",
+               volume->ioblock, ret);
+          return ret;
+        }
+
+      offset = entry.hoffset + SIZEOF_NXFFS_INODE_HDR;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxffs_dopack
+ *
+ * Description:
+ *   Pack and re-write the filesystem in order to free up memory at the end
+ *   of FLASH.
+ *
+ * Input Parameters:
+ *   volume   - The volume to be packed.
+ *   neblocks - If non-zero, the packing stops on the first inode boundary
+ *     after this number of erase blocks have been re-written.  Zero means
+ *     that the entire volume is packed.
+ *
+ * Returned Value:
+ *   Zero on success; -EAGAIN if an incremental pack stopped before
+ *   completion.  Otherwise, a negated errno value is returned to indicate
+ *   the nature of the failure.
+ *
+ ****************************************************************************/
+
+static int nxffs_dopack(FAR struct nxffs_volume_s *volume, off_t neblocks)
 {
   struct nxffs_pack_s pack;
   FAR struct nxffs_wrfile_s *wrfile;
   off_t iooffset;
   off_t eblock;
   off_t block;
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  off_t froffset;
+  off_t ndone;
+  bool stopped;
+#endif
   bool packed;
   int i;
   int ret = OK;
@@ -1280,6 +1513,18 @@ int nxffs_pack(FAR struct nxffs_volume_s *volume)
   wrfile = NULL;
   packed = false;
 
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  /* The free FLASH offset is moved as data is packed.  If this slice stops
+   * before the packing is complete, it must be restored.
+   */
+
+  froffset = volume->froffset;
+  ndone    = 0;
+  stopped  = false;
+#else
+  UNUSED(neblocks);
+#endif
+
   iooffset = nxffs_mediacheck(volume, &pack);
   if (iooffset == 0)
     {
@@ -1398,6 +1643,15 @@ start_pack:
   pack.iooffset    = nxffs_getoffset(volume, iooffset, pack.ioblock);
   volume->froffset = iooffset;
 
+  /* If the first valid inode is moved, it will be moved toward the
+   * beginning of FLASH.
+   */
+
+  if (iooffset < volume->inoffset)
+    {
+      volume->inoffset = iooffset;
+    }
+
   /* Then pack all erase blocks starting with the erase block that contains
    * the ioblock and through the final erase block on the FLASH.
    */
@@ -1410,6 +1664,20 @@ start_pack:
 
       pack.block0 = eblock * volume->blkper;
 
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+      /* If this is the last erase block in the budget for this slice, then
+       * stop on the next inode boundary.  Once all of the inodes have been
+       * packed, the remaining erase blocks must be cleaned in this slice;
+       * otherwise there would be an erased gap ahead of the free FLASH
+       * region.
+       */
+
+      if (neblocks > 0 && !packed && ++ndone >= neblocks)
+        {
+          pack.stop = true;
+        }
+#endif
+
 #ifndef CONFIG_NXFFS_NAND
       /* Read the erase block into the pack buffer.  We need to do this even
        * if we are overwriting the entire block so that we skip over
@@ -1453,6 +1721,20 @@ start_pack:
         }
 #endif
 
+#ifndef CONFIG_NXFFS_NAND
+      /* If all of the inodes have been packed and the data areas of this
+       * erase block are already erased, then there is nothing to be done
+       * here.  Skipping the block avoids needless erase cycles on clean
+       * FLASH beyond the old end of the volume data.
+       */
+
+      if (packed && wrfile == NULL && nxffs_packerased(volume, &pack))
+        {
+          pack.iooffset = SIZEOF_NXFFS_BLOCK_HDR;
+          continue;
+        }
+#endif
+
       /* Now pack each I/O block */
 
       for (i = 0, block = pack.block0, pack.iobuffer = volume->pack;
@@ -1511,6 +1793,18 @@ start_pack:
 
                               wrfile = nxffs_setupwriter(volume, &pack);
                             }
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+                          /* -EAGAIN means that the budget for this slice is
+                           * used up and that packing stopped on an inode
+                           * boundary.
+                           */
+
+                          else if (ret == -EAGAIN)
+                            {
+                              stopped = true;
+                              break;
+                            }
+#endif
                           else
                             {
                               /* Otherwise, something really bad happened */
@@ -1574,6 +1868,19 @@ start_pack:
             }
         }
 
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+      /* If packing stopped in this erase block, then cover the stale region
+       * up to the end of the source data.  The rest of the erase block still
+       * holds valid, unpacked data.
+       */
+
+      if (stopped)
+        {
+          volume->compacted += pack.srcend - nxffs_packtell(volume, &pack);
+          nxffs_packfill(volume, &pack);
+        }
+#endif
+
       /* We now have an in-memory image of how we want this erase block to
        * appear. Now it is safe to erase the block.
        */
@@ -1595,10 +1902,227 @@ start_pack:
                eblock, pack.block0, -ret);
           goto errout_with_pack;
         }
+
+      /* The volume cache may hold a stale copy of one of the blocks that
+       * were just re-written.
+       */
+
+      volume->cblock = (off_t)-1;
+
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+      if (stopped)
+        {
+          /* Invalidate the duplicate inode headers in later erase blocks and
+           * restore the free FLASH offset.  The volume is left consistent
+           * and the next slice will resume from the gap.
+           */
+
+          ret = nxffs_packstale(volume, &pack,
+                                (pack.block0 + volume->blkper) *
+                                volume->geo.blocksize);
+          volume->froffset = froffset;
+          if (ret == OK)
+            {
+              ret = -EAGAIN;
+            }
+
+          goto errout_with_pack;
+        }
+#endif
     }
 
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  /* The packing pass has completed */
+
+  if (froffset > volume->froffset)
+    {
+      volume->reclaimed += froffset - volume->froffset;
+    }
+
+  volume->npacks++;
+#endif
+
 errout_with_pack:
   nxffs_freeentry(&pack.src.entry);
   nxffs_freeentry(&pack.dest.entry);
   return ret;
 }
+
+/****************************************************************************
+ * Name: nxffs_packworker
+ *
+ * Description:
+ *   Perform one slice of an incremental pack on the low priority work
+ *   queue, then re-schedule if more slices are needed.
+ *
+ * Input Parameters:
+ *   arg - The volume to be packed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+static void nxffs_packworker(FAR void *arg)
+{
+  FAR struct nxffs_volume_s *volume = (FAR struct nxffs_volume_s *)arg;
+  int ret;
+
+  ret = nxsem_wait(&volume->exclsem);
+  if (ret < 0)
+    {
+      ferr("ERROR: nxsem_wait failed: %d\n", ret);
+      return;
+    }
+
+  /* Don't move the data of a file while it is open.  Packing relocates and
+   * erases blocks, which would invalidate the FLASH offsets cached in an
+   * open reader or writer.  Closing the last file will re-schedule the
+   * packing.
+   */
+
+  if (volume->ofiles != NULL)
+    {
+      ret = OK;
+    }
+  else
+    {
+      ret = nxffs_packslice(volume);
+      if (ret == OK)
+        {
+          volume->dirty = false;
+        }
+      else if (ret == -EAGAIN)
+        {
+          /* Give the foreground some time before the next slice */
+
+          work_queue(LPWORK, &volume->packwork, nxffs_packworker, volume,
+                     MSEC2TICK(CONFIG_NXFFS_PACK_DELAY));
+        }
+      else
+        {
+          ferr("ERROR: Background packing failed: %d\n", ret);
+        }
+    }
+
+  nxsem_post(&volume->exclsem);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_pack
+ *
+ * Description:
+ *   Pack and re-write the filesystem in order to free up memory at the end
+ *   of FLASH.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   Zero on success; Otherwise, a negated errno value is returned to
+ *   indicate the nature of the failure.
+ *
+ ****************************************************************************/
+
+int nxffs_pack(FAR struct nxffs_volume_s *volume)
+{
+  return nxffs_dopack(volume, 0);
+}
+
+/****************************************************************************
+ * Name: nxffs_packslice
+ *
+ * Description:
+ *   Perform one bounded slice of an incremental pack.  At most
+ *   CONFIG_NXFFS_PACK_SLICE erase blocks are re-written before packing
+ *   stops on the next inode boundary (an inode larger than the slice will
+ *   extend it).  The volume is left in a consistent state between slices so
+ *   that the volume semaphore can be released and other file system
+ *   operations can proceed.
+ *
+ *   The space recovered only becomes available at the end of FLASH when the
+ *   final slice completes the pass and cleans the tail of the volume.
+ *
+ * Input Parameters:
+ *   volume - The volume to be packed.
+ *
+ * Returned Value:
+ *   Zero is returned if the packing pass is complete; -EAGAIN is returned
+ *   if more slices are needed.  Otherwise, a negated errno value is
+ *   returned to indicate the nature of the failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+int nxffs_packslice(FAR struct nxffs_volume_s *volume)
+{
+  clock_t start;
+  clock_t elapsed;
+  int ret;
+
+  start = clock_systimer();
+  ret   = nxffs_dopack(volume, CONFIG_NXFFS_PACK_SLICE);
+
+  elapsed = clock_systimer() - start;
+  if (elapsed > volume->maxslice)
+    {
+      volume->maxslice = elapsed;
+    }
+
+  volume->nslices++;
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxffs_packnotify
+ *
+ * Description:
+ *   Called with the volume semaphore held after FLASH has been consumed or
+ *   an inode deleted.  If the free FLASH has dropped below the configured
+ *   watermark and there may be space to recover, schedule incremental
+ *   packing on the low priority work queue.
+ *
+ * Input Parameters:
+ *   volume - The volume that was modified.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+void nxffs_packnotify(FAR struct nxffs_volume_s *volume)
+{
+  off_t total;
+  off_t avail;
+
+  /* Is there anything to recover and is packing not already scheduled? */
+
+  if (!volume->dirty || !work_available(&volume->packwork))
+    {
+      return;
+    }
+
+  /* Has the free FLASH at the end of the volume dropped below the
+   * watermark?
+   */
+
+  total = volume->nblocks * volume->geo.blocksize;
+  avail = total - volume->froffset;
+
+  if (avail < (total / 100) * CONFIG_NXFFS_PACK_WATERMARK)
+    {
+      finfo("Free %ld of %ld bytes, scheduling packing\n",
+            (long)avail, (long)total);
+
+      work_queue(LPWORK, &volume->packwork, nxffs_packworker, volume, 0);
+    }
+}
+#endif
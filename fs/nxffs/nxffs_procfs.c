@@ -0,0 +1,398 @@
+/****************************************************************************
+ * fs/nxffs/nxffs_procfs.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "nxffs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NXFFS) && defined(CONFIG_NXFFS_PREALLOCATED)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of the buffer that holds the formatted volume status.
+ * The status is generated once when the file is opened so that it remains
+ * stable if the user reads it in small pieces.
+ */
+
+#define NXFFS_PROCFS_BUFSIZE 512
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct nxffs_procfs_file_s
+{
+  struct procfs_file_s base;         /* Base open file structure */
+  unsigned int buflen;               /* Number of valid characters in buffer[] */
+  char buffer[NXFFS_PROCFS_BUFSIZE]; /* Formatted volume status */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     nxffs_procfs_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     nxffs_procfs_close(FAR struct file *filep);
+static ssize_t nxffs_procfs_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     nxffs_procfs_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     nxffs_procfs_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_procfs.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations nxffs_procfsoperations =
+{
+  nxffs_procfs_open,   /* open */
+  nxffs_procfs_close,  /* close */
+  nxffs_procfs_read,   /* read */
+  NULL,                /* write */
+
+  nxffs_procfs_dup,    /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  nxffs_procfs_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_procfs_status
+ *
+ * Description:
+ *   Format the block statistics and packing status of the volume.
+ *
+ ****************************************************************************/
+
+static int nxffs_procfs_status(FAR struct nxffs_volume_s *volume,
+                               FAR struct nxffs_procfs_file_s *attr)
+{
+  struct nxffs_blkstats_s stats;
+  FAR char *ptr = attr->buffer;
+  size_t remaining = NXFFS_PROCFS_BUFSIZE;
+  size_t len;
+  off_t total;
+  int ret;
+
+  /* Get exclusive access to the volume.  Collecting the block statistics
+   * uses the volume pack buffer.
+   */
+
+  ret = nxsem_wait(&volume->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxffs_blockstats(volume, &stats);
+  if (ret < 0)
+    {
+      goto errout_with_semaphore;
+    }
+
+  total = volume->nblocks * volume->geo.blocksize;
+
+  len = snprintf(ptr, remaining,
+                 "Erase blocks:  %6lu x %lu\n"
+                 "Blocks:        %6ld x %lu\n"
+                 "  Good:        %6ld\n"
+                 "  Bad:         %6ld\n"
+                 "  Unformatted: %6ld\n"
+                 "  Corrupt:     %6ld\n"
+                 "  Unreadable:  %6ld\n"
+                 "Free:          %6ld of %ld bytes\n",
+                 (unsigned long)volume->geo.neraseblocks,
+                 (unsigned long)volume->geo.erasesize,
+                 (long)stats.nblocks, (unsigned long)volume->geo.blocksize,
+                 (long)stats.ngood, (long)stats.nbad, (long)stats.nunformat,
+                 (long)stats.ncorrupt, (long)stats.nbadread,
+                 (long)(total - volume->froffset), (long)total);
+
+  ptr       += len;
+  remaining -= len;
+
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  len = snprintf(ptr, remaining,
+                 "Packing:       %s\n"
+                 "  Passes:      %6lu\n"
+                 "  Slices:      %6lu\n"
+                 "  Compacted:   %6ld bytes\n"
+                 "  Reclaimed:   %6ld bytes\n"
+                 "  Max slice:   %6lu msec\n",
+#ifdef CONFIG_NXFFS_PACK_BACKGROUND
+                 !work_available(&volume->packwork) ? "scheduled" :
+#endif
+                 volume->dirty ? "pending" : "idle",
+                 (unsigned long)volume->npacks,
+                 (unsigned long)volume->nslices,
+                 (long)volume->compacted, (long)volume->reclaimed,
+                 (unsigned long)TICK2MSEC(volume->maxslice));
+
+  ptr       += len;
+  remaining -= len;
+#endif
+
+  attr->buflen = NXFFS_PROCFS_BUFSIZE - remaining;
+  ret = OK;
+
+errout_with_semaphore:
+  nxsem_post(&volume->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxffs_procfs_open
+ ****************************************************************************/
+
+static int nxffs_procfs_open(FAR struct file *filep, FAR const char *relpath,
+                             int oflags, mode_t mode)
+{
+  FAR struct nxffs_procfs_file_s *attr;
+  int ret;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "fs/nxffs" is the only acceptable value for the relpath and there must
+   * be an initialized NXFFS volume.
+   */
+
+  if (strcmp(relpath, "fs/nxffs") != 0 || g_volume.mtd == NULL)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct nxffs_procfs_file_s *)
+    kmm_zalloc(sizeof(struct nxffs_procfs_file_s));
+
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of the volume status */
+
+  ret = nxffs_procfs_status(&g_volume, attr);
+  if (ret < 0)
+    {
+      kmm_free(attr);
+      return ret;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxffs_procfs_close
+ ****************************************************************************/
+
+static int nxffs_procfs_close(FAR struct file *filep)
+{
+  FAR struct nxffs_procfs_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct nxffs_procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxffs_procfs_read
+ ****************************************************************************/
+
+static ssize_t nxffs_procfs_read(FAR struct file *filep, FAR char *buffer,
+                                 size_t buflen)
+{
+  FAR struct nxffs_procfs_file_s *attr;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct nxffs_procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Transfer the volume status to user receive buffer */
+
+  offset = filep->f_pos;
+  ret    = procfs_memcpy(attr->buffer, attr->buflen, buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxffs_procfs_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int nxffs_procfs_dup(FAR const struct file *oldp,
+                            FAR struct file *newp)
+{
+  FAR struct nxffs_procfs_file_s *oldattr;
+  FAR struct nxffs_procfs_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct nxffs_procfs_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct nxffs_procfs_file_s *)
+    kmm_malloc(sizeof(struct nxffs_procfs_file_s));
+
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct nxffs_procfs_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxffs_procfs_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int nxffs_procfs_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/nxffs" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "fs/nxffs") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "fs/nxffs" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && ... */
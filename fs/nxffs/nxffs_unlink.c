@@ -131,6 +131,15 @@ int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name)
            volume->ioblock, ret);
     }
 
+#ifdef CONFIG_NXFFS_PACK_INCREMENTAL
+  /* The FLASH used by the deleted inode can be recovered by packing */
+
+  else
+    {
+      volume->dirty = true;
+    }
+#endif
+
 errout_with_entry:
   nxffs_freeentry(&entry);
 errout:
@@ -167,6 +176,10 @@ int nxffs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   /* Then remove the NXFFS inode */
 
   ret = nxffs_rminode(volume, relpath);
+  if (ret == OK)
+    {
+      nxffs_packnotify(volume);
+    }
 
   nxsem_post(&volume->exclsem);
 
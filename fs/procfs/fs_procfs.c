@@ -80,6 +80,7 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations latency_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
@@ -96,6 +97,7 @@ extern const struct procfs_operations net_procfs_routeoperations;
 extern const struct procfs_operations part_procfsoperations;
 extern const struct procfs_operations mount_procfsoperations;
 extern const struct procfs_operations smartfs_procfsoperations;
+extern const struct procfs_operations nxffs_procfsoperations;
 
 /* And even worse, this one is specific to the STM32.  The solution to
  * this nasty couple would be to replace this hard-coded, ROM-able
@@ -130,6 +132,12 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #if defined(CONFIG_SCHED_CRITMONITOR)
   { "critmon",       &critmon_operations,         PROCFS_FILE_TYPE   },
 #endif
+#if defined(CONFIG_SCHED_CRITMONITOR_HISTOGRAM)
+  { "crithist",      &critmon_operations,         PROCFS_FILE_TYPE   },
+#endif
+#if defined(CONFIG_SCHED_LATENCY)
+  { "latency",       &latency_operations,         PROCFS_FILE_TYPE   },
+#endif
 
 #ifdef CONFIG_SCHED_IRQMONITOR
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
@@ -159,6 +167,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/smartfs**",  &smartfs_procfsoperations,   PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_FS_NXFFS) && defined(CONFIG_NXFFS_PREALLOCATED) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NXFFS)
+  { "fs/nxffs",      &nxffs_procfsoperations,     PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_NET) && !defined(CONFIG_FS_PROCFS_EXCLUDE_NET)
   { "net",           &net_procfsoperations,       PROCFS_DIR_TYPE    },
 #if defined(CONFIG_NET_ROUTE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_ROUTE)
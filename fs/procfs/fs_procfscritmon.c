@@ -55,6 +55,8 @@
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -72,10 +74,30 @@
 
 #define CRITMON_LINELEN 64
 
+#ifdef CONFIG_SMP_NCPUS
+#  define CRITMON_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define CRITMON_NCPUS 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* A consistent copy of the histograms taken when "crithist" is opened */
+
+struct critmon_snapshot_s
+{
+  struct critmon_hist_s  premp_hist[CRITMON_NCPUS];
+  struct critmon_hist_s  crit_hist[CRITMON_NCPUS];
+  struct critmon_worst_s premp_worst[CRITMON_NCPUS]
+                                    [CONFIG_SCHED_CRITMONITOR_NWORST];
+  struct critmon_worst_s crit_worst[CRITMON_NCPUS]
+                                   [CONFIG_SCHED_CRITMONITOR_NWORST];
+};
+#endif
+
 /* This structure describes one open "file" */
 
 struct critmon_file_s
@@ -83,6 +105,10 @@ struct critmon_file_s
   struct procfs_file_s  base;   /* Base open file structure */
   unsigned int linesize;        /* Number of valid characters in line[] */
   char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  bool hist;                    /* True: "crithist", false: "critmon" */
+  struct critmon_snapshot_s snap; /* Histogram snapshot for "crithist" */
+#endif
 };
 
 /****************************************************************************
@@ -96,6 +122,10 @@ static int     critmon_open(FAR struct file *filep, FAR const char *relpath,
 static int     critmon_close(FAR struct file *filep);
 static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t critmon_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+#endif
 static int     critmon_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     critmon_stat(FAR const char *relpath, FAR struct stat *buf);
@@ -114,7 +144,11 @@ const struct procfs_operations critmon_operations =
   critmon_open,       /* open */
   critmon_close,      /* close */
   critmon_read,       /* read */
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  critmon_write,      /* write */
+#else
   NULL,               /* write */
+#endif
 
   critmon_dup,        /* dup */
 
@@ -138,24 +172,31 @@ static int critmon_open(FAR struct file *filep, FAR const char *relpath,
                       int oflags, mode_t mode)
 {
   FAR struct critmon_file_s *attr;
+  bool hist = false;
 
   finfo("Open '%s'\n", relpath);
 
-  /* PROCFS is read-only.  Any attempt to open with any kind of write
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  /* "crithist" may also be written to reset the histograms */
+
+  hist = (strcmp(relpath, "crithist") == 0);
+#endif
+
+  /* "critmon" is read-only.  Any attempt to open it with any kind of write
    * access is not permitted.
-   *
-   * REVISIT:  Write-able proc files could be quite useful.
    */
 
-  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+  if (!hist && ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0))
     {
       ferr("ERROR: Only O_RDONLY supported\n");
       return -EACCES;
     }
 
-  /* "critmon" is the only acceptable value for the relpath */
+  /* "critmon" and "crithist" are the only acceptable values for the
+   * relpath.
+   */
 
-  if (strcmp(relpath, "critmon") != 0)
+  if (!hist && strcmp(relpath, "critmon") != 0)
     {
       ferr("ERROR: relpath is '%s'\n", relpath);
       return -ENOENT;
@@ -170,6 +211,25 @@ static int critmon_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  /* Take a snapshot of the histograms so that all of the reads see
+   * consistent data.
+   */
+
+  attr->hist = hist;
+  if (hist)
+    {
+      irqstate_t flags = enter_critical_section();
+
+      memcpy(attr->snap.premp_hist, g_premp_hist, sizeof(g_premp_hist));
+      memcpy(attr->snap.crit_hist, g_crit_hist, sizeof(g_crit_hist));
+      memcpy(attr->snap.premp_worst, g_premp_worst, sizeof(g_premp_worst));
+      memcpy(attr->snap.crit_worst, g_crit_worst, sizeof(g_crit_worst));
+
+      leave_critical_section(flags);
+    }
+#endif
+
   /* Save the attributes as the open-specific state in filep->f_priv */
 
   filep->f_priv = (FAR void *)attr;
@@ -272,6 +332,149 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: critmon_read_worst
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t critmon_read_worst(FAR struct critmon_file_s *attr,
+                                  FAR char *buffer, size_t buflen,
+                                  FAR off_t *offset, int cpu,
+                                  FAR const char *name,
+                                  FAR const struct critmon_worst_s *worst)
+{
+  struct timespec maxtime;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+
+  totalsize = 0;
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_NWORST && buflen > 0; i++)
+    {
+      /* Skip unused entries */
+
+      if (worst[i].elapsed == 0)
+        {
+          continue;
+        }
+
+      up_critmon_convert(worst[i].elapsed, &maxtime);
+
+      linesize = snprintf(attr->line, CRITMON_LINELEN,
+                          "%d,%s,%p,%d,%lu.%09lu\n",
+                          cpu, name, worst[i].caller, (int)worst[i].pid,
+                          (unsigned long)maxtime.tv_sec,
+                          (unsigned long)maxtime.tv_nsec);
+      copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                               offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: critmon_read_hist
+ *
+ * Description:
+ *   Generate the "crithist" output from the snapshot.  For each CPU there
+ *   is one line per bucket with the lower bound of the bucket, the
+ *   pre-emption disabled count and the critical section count, followed
+ *   by one line per recorded worst caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t critmon_read_hist(FAR struct critmon_file_s *attr,
+                                 FAR char *buffer, size_t buflen,
+                                 off_t offset)
+{
+  FAR struct critmon_snapshot_s *snap = &attr->snap;
+  FAR struct critmon_hist_s *premp;
+  FAR struct critmon_hist_s *crit;
+  struct timespec lower;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int bucket;
+  int cpu;
+
+  totalsize = 0;
+
+  for (cpu = 0; cpu < CRITMON_NCPUS; cpu++)
+    {
+      premp = &snap->premp_hist[cpu];
+      crit  = &snap->crit_hist[cpu];
+
+      for (bucket = 0;
+           bucket < CONFIG_SCHED_CRITMONITOR_NBUCKETS &&
+           bucket + CONFIG_SCHED_CRITMONITOR_BUCKETSHIFT < 32;
+           bucket++)
+        {
+          /* Convert the lower bound of the bucket */
+
+          if (bucket > 0)
+            {
+              up_critmon_convert((uint32_t)1 <<
+                                 (bucket +
+                                  CONFIG_SCHED_CRITMONITOR_BUCKETSHIFT),
+                                 &lower);
+            }
+          else
+            {
+              lower.tv_sec  = 0;
+              lower.tv_nsec = 0;
+            }
+
+          linesize = snprintf(attr->line, CRITMON_LINELEN,
+                              "%d,%lu.%09lu,%lu,%lu\n", cpu,
+                              (unsigned long)lower.tv_sec,
+                              (unsigned long)lower.tv_nsec,
+                              (unsigned long)premp->count[bucket],
+                              (unsigned long)crit->count[bucket]);
+          copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                                   &offset);
+
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          if (buflen == 0)
+            {
+              return totalsize;
+            }
+        }
+
+      /* Generate output for the worst callers */
+
+      copysize   = critmon_read_worst(attr, buffer, buflen, &offset, cpu,
+                                      "premp", snap->premp_worst[cpu]);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      copysize   = critmon_read_worst(attr, buffer, buflen, &offset, cpu,
+                                      "csection", snap->crit_worst[cpu]);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      if (buflen == 0)
+        {
+          break;
+        }
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_read
  ****************************************************************************/
@@ -293,6 +496,19 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   attr = (FAR struct critmon_file_s *)filep->f_priv;
   DEBUGASSERT(attr);
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  if (attr->hist)
+    {
+      ret = critmon_read_hist(attr, buffer, buflen, filep->f_pos);
+      if (ret > 0)
+        {
+          filep->f_pos += ret;
+        }
+
+      return ret;
+    }
+#endif
+
   ret    = 0;
   offset = filep->f_pos;
 
@@ -327,6 +543,47 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   return ret;
 }
 
+/****************************************************************************
+ * Name: critmon_write
+ *
+ * Description:
+ *   Writing "reset" to "crithist" clears the histograms and the worst
+ *   callers of all CPUs and threads.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t critmon_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  FAR struct critmon_file_s *attr;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct critmon_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  if (!attr->hist)
+    {
+      return -EACCES;
+    }
+
+  /* Accept "reset" with an optional trailing newline */
+
+  if (buflen < 5 || strncmp(buffer, "reset", 5) != 0 ||
+      (buflen > 5 && (buflen != 6 || buffer[5] != '\n')))
+    {
+      ferr("ERROR: Unrecognized command\n");
+      return -EINVAL;
+    }
+
+  sched_critmon_reset();
+  return buflen;
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_dup
  *
@@ -375,7 +632,19 @@ static int critmon_dup(FAR const struct file *oldp, FAR struct file *newp)
 
 static int critmon_stat(const char *relpath, struct stat *buf)
 {
-  /* "critmon" is the only acceptable value for the relpath */
+  memset(buf, 0, sizeof(struct stat));
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  /* "crithist" is the name for a read/write file */
+
+  if (strcmp(relpath, "crithist") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+      return OK;
+    }
+#endif
+
+  /* "critmon" is the only other acceptable value for the relpath */
 
   if (strcmp(relpath, "critmon") != 0)
     {
@@ -385,7 +654,6 @@ static int critmon_stat(const char *relpath, struct stat *buf)
 
   /* "critmon" is the name for a read-only file */
 
-  memset(buf, 0, sizeof(struct stat));
   buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
   return OK;
 }
@@ -0,0 +1,456 @@
+/****************************************************************************
+ * fs/procfs/fs_procfslatency.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched_latency.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_LATENCY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define LATENCY_LINELEN 64
+
+/* The longest command accepted by latency_write() */
+
+#define LATENCY_CMDLEN  32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct latency_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  uint32_t period;              /* Benchmark period when opened */
+  struct latency_stat_s stats[LATENCY_NSTAGES]; /* Snapshot taken at open */
+  char line[LATENCY_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     latency_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     latency_close(FAR struct file *filep);
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t latency_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     latency_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     latency_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Names of the stages, see enum latency_stage_e */
+
+static FAR const char *g_latency_names[LATENCY_NSTAGES] =
+{
+  "irq-wakeup",
+  "wakeup-switch",
+  "switch-run",
+  "irq-run",
+  "cyclic"
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations latency_operations =
+{
+  latency_open,       /* open */
+  latency_close,      /* close */
+  latency_read,       /* read */
+  latency_write,      /* write */
+
+  latency_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  latency_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_open
+ ****************************************************************************/
+
+static int latency_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct latency_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* "latency" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "latency") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct latency_file_s *)
+    kmm_zalloc(sizeof(struct latency_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot so that all of the reads see consistent data */
+
+  attr->period = sched_latency_period();
+  sched_latency_snapshot(attr->stats);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_close
+ ****************************************************************************/
+
+static int latency_close(FAR struct file *filep)
+{
+  FAR struct latency_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_read
+ *
+ * Description:
+ *   The output is one "period" line with the benchmark period in usec
+ *   (zero if not running), one "stat" line per stage with the sample
+ *   count and the minimum, average and maximum duration in nsec, and one
+ *   "hist" line per non-empty histogram bucket with the lower bound of the
+ *   bucket in nsec and the count.
+ *
+ ****************************************************************************/
+
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct latency_file_s *attr;
+  FAR struct latency_stat_s *stat;
+  unsigned long avg;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int bucket;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  totalsize = 0;
+
+  /* Generate output for the benchmark period */
+
+  linesize = snprintf(attr->line, LATENCY_LINELEN, "period,%lu\n",
+                      (unsigned long)attr->period);
+  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  buflen    -= copysize;
+
+  /* Generate output for the statistics of each stage */
+
+  for (i = 0; i < LATENCY_NSTAGES && buflen > 0; i++)
+    {
+      stat = &attr->stats[i];
+      avg  = stat->count > 0 ? (unsigned long)(stat->sum / stat->count) : 0;
+
+      linesize = snprintf(attr->line, LATENCY_LINELEN,
+                          "stat,%s,%lu,%lu,%lu,%lu\n", g_latency_names[i],
+                          (unsigned long)stat->count,
+                          (unsigned long)stat->min, avg,
+                          (unsigned long)stat->max);
+      copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                               &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  /* Generate output for the non-empty histogram buckets */
+
+  for (i = 0; i < LATENCY_NSTAGES && buflen > 0; i++)
+    {
+      stat = &attr->stats[i];
+
+      for (bucket = 0;
+           bucket < CONFIG_SCHED_LATENCY_NBUCKETS && buflen > 0;
+           bucket++)
+        {
+          if (stat->hist[bucket] == 0)
+            {
+              continue;
+            }
+
+          linesize = snprintf(attr->line, LATENCY_LINELEN,
+                              "hist,%s,%lu,%lu\n", g_latency_names[i],
+                              bucket > 0 ? 1ul << bucket : 0ul,
+                              (unsigned long)stat->hist[bucket]);
+          copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                                   &offset);
+
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+        }
+    }
+
+  if (totalsize > 0)
+    {
+      filep->f_pos += totalsize;
+    }
+
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: latency_write
+ *
+ * Description:
+ *   Accepts the commands "start <period in usec> [<priority>]", "stop" and
+ *   "reset".
+ *
+ ****************************************************************************/
+
+static ssize_t latency_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  char cmd[LATENCY_CMDLEN];
+  FAR char *endptr;
+  unsigned long period;
+  long priority;
+  int ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  if (buflen >= LATENCY_CMDLEN)
+    {
+      return -EINVAL;
+    }
+
+  memcpy(cmd, buffer, buflen);
+  cmd[buflen] = '\0';
+
+  if (strncmp(cmd, "start", 5) == 0)
+    {
+      /* Range check both values before they are narrowed to the types of
+       * sched_latency_start().
+       */
+
+      period = strtoul(&cmd[5], &endptr, 10);
+      if (endptr == &cmd[5] || period == 0 || period >= USEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      priority = strtol(endptr, &endptr, 10);
+      if (priority == 0)
+        {
+          priority = CONFIG_SCHED_LATENCY_PRIORITY;
+        }
+      else if (priority < SCHED_PRIORITY_MIN ||
+               priority > SCHED_PRIORITY_MAX)
+        {
+          return -EINVAL;
+        }
+
+      ret = sched_latency_start(period, (int)priority);
+    }
+  else if (strncmp(cmd, "stop", 4) == 0)
+    {
+      ret = sched_latency_stop();
+    }
+  else if (strncmp(cmd, "reset", 5) == 0)
+    {
+      sched_latency_reset();
+      ret = OK;
+    }
+  else
+    {
+      ferr("ERROR: Unrecognized command '%s'\n", cmd);
+      ret = -EINVAL;
+    }
+
+  return ret < 0 ? ret : (ssize_t)buflen;
+}
+
+/****************************************************************************
+ * Name: latency_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int latency_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct latency_file_s *oldattr;
+  FAR struct latency_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct latency_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct latency_file_s *)
+    kmm_malloc(sizeof(struct latency_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct latency_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int latency_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "latency" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "latency") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "latency" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_LATENCY */
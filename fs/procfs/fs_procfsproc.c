@@ -93,7 +93,11 @@
  * to handle the longest line generated by this logic.
  */
 
-#define STATUS_LINELEN 32
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+#  define STATUS_LINELEN 48
+#else
+#  define STATUS_LINELEN 32
+#endif
 
 /****************************************************************************
  * Private Type Definitions
@@ -113,6 +117,9 @@ enum proc_node_e
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
+#endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  PROC_CRITHIST,                      /* Critical section histograms */
 #endif
   PROC_STACK,                         /* Task stack info */
   PROC_GROUP,                         /* Group directory */
@@ -199,6 +206,11 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t proc_crithist(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
@@ -294,6 +306,13 @@ static const struct proc_node_s g_critmon =
 };
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static const struct proc_node_s g_crithist =
+{
+  "crithist",     "crithist", (uint8_t)PROC_CRITHIST,   DTYPE_FILE        /* Critical Section Histograms */
+};
+#endif
+
 static const struct proc_node_s g_stack =
 {
   "stack",        "stack",   (uint8_t)PROC_STACK,        DTYPE_FILE        /* Task stack info */
@@ -333,6 +352,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
+#endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  &g_crithist,     /* Critical section histograms */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -356,6 +378,9 @@ static const struct proc_node_s * const g_level0info[] =
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
+#endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  &g_crithist,     /* Critical section histograms */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -848,6 +873,79 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_crithist
+ *
+ * Description:
+ *   One line per histogram bucket with the lower bound of the bucket, the
+ *   pre-emption disabled count and the critical section count, followed by
+ *   the callers of the longest intervals.  Unlike "critmon", reading does
+ *   not reset the data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t proc_crithist(FAR struct proc_file_s *procfile,
+                             FAR struct tcb_s *tcb, FAR char *buffer,
+                             size_t buflen, off_t offset)
+{
+  struct timespec lower;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int bucket;
+
+  totalsize = 0;
+
+  for (bucket = 0;
+       bucket < CONFIG_SCHED_CRITMONITOR_NBUCKETS &&
+       bucket + CONFIG_SCHED_CRITMONITOR_BUCKETSHIFT < 32;
+       bucket++)
+    {
+      /* Convert the lower bound of the bucket */
+
+      if (bucket > 0)
+        {
+          up_critmon_convert((uint32_t)1 <<
+                             (bucket + CONFIG_SCHED_CRITMONITOR_BUCKETSHIFT),
+                             &lower);
+        }
+      else
+        {
+          lower.tv_sec  = 0;
+          lower.tv_nsec = 0;
+        }
+
+      linesize = snprintf(procfile->line, STATUS_LINELEN,
+                          "%lu.%09lu,%lu,%lu\n",
+                          (unsigned long)lower.tv_sec,
+                          (unsigned long)lower.tv_nsec,
+                          (unsigned long)tcb->premp_hist.count[bucket],
+                          (unsigned long)tcb->crit_hist.count[bucket]);
+      copysize = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                               &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      if (buflen == 0)
+        {
+          return totalsize;
+        }
+    }
+
+  /* Generate output for the callers of the longest intervals */
+
+  linesize = snprintf(procfile->line, STATUS_LINELEN, "caller,%p,%p\n",
+                      tcb->premp_caller, tcb->crit_caller);
+  copysize = procfs_memcpy(procfile->line, linesize, buffer, buflen, &offset);
+
+  totalsize += copysize;
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -1426,6 +1524,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
     case PROC_CRITMON: /* Critical section monitor */
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
+#endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+    case PROC_CRITHIST: /* Critical section histograms */
+      ret = proc_crithist(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
 #endif
     case PROC_STACK: /* Task stack info */
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
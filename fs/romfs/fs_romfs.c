@@ -1019,6 +1019,18 @@ static int romfs_bind(FAR struct inode *blkdriver, FAR const void *data,
       goto errout_with_buffer;
     }
 
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  /* Build the directory hash index.  This is only an optimization:  If it
+   * fails, directories are searched linearly.
+   */
+
+  ret = romfs_buildindex(rm);
+  if (ret < 0)
+    {
+      fwarn("WARNING: romfs_buildindex failed: %d\n", ret);
+    }
+#endif
+
   /* Mounted! */
 
   *handle = (FAR void *)rm;
@@ -1104,6 +1116,10 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
       /* Release the mountpoint private data */
 
+#if defined(CONFIG_FS_ROMFS_DIRHASH) || CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+      romfs_freeindex(rm);
+#endif
+
       if (!rm->rm_xipbase && rm->rm_buffer)
         {
           kmm_free(rm->rm_buffer);
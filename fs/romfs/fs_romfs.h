@@ -125,6 +125,15 @@
 
 #define ROMF_MAX_LINKS 64
 
+/* Directory hash index and path cache */
+
+#ifndef CONFIG_FS_ROMFS_PATHCACHE_SIZE
+#  define CONFIG_FS_ROMFS_PATHCACHE_SIZE 0
+#endif
+
+#define ROMFS_HASH_NONE    0xffffffff /* Marks the end of a hash chain */
+#define ROMFS_HASH_MINBUCKETS 16      /* Minimum number of hash buckets */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -134,6 +143,52 @@
  * mounted with a fat32 filesystem.
  */
 
+/* This structure describes one entry in the directory hash index.  Entries
+ * are keyed by the offset of the first entry in the containing directory
+ * and the entry name.
+ */
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+struct romfs_hashent_s
+{
+  uint32_t he_parent;               /* Offset to the first entry of the directory */
+  uint32_t he_offset;               /* Offset to the file header of the entry */
+  uint32_t he_hash;                 /* Hash of he_parent and the entry name */
+  uint32_t he_next;                 /* Index of the next entry in the hash chain */
+};
+#endif
+
+/* This structure is used internally for describing the result of
+ * walking a path
+ */
+
+struct romfs_dirinfo_s
+{
+  /* These values describe the directory containing the terminal
+   * path component (of the terminal component itself if it is
+   * a directory.
+   */
+
+  struct fs_romfsdir_s rd_dir;    /* Describes directory. */
+
+  /* Values from the ROMFS file entry */
+
+  uint32_t rd_next;               /* Offset of the next file header+flags */
+  uint32_t rd_size;               /* Size (if file) */
+};
+
+/* This structure describes one entry in the per-mount path cache */
+
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+struct romfs_pathent_s
+{
+  FAR char *pe_path;                /* Cached relative path (NULL if unused) */
+  uint32_t  pe_hash;                /* Hash of the relative path */
+  uint32_t  pe_stamp;               /* Time of last use for LRU replacement */
+  struct romfs_dirinfo_s pe_dirinfo; /* Result of the path lookup */
+};
+#endif
+
 struct romfs_file_s;
 struct romfs_mountpt_s
 {
@@ -149,6 +204,15 @@ struct romfs_mountpt_s
   uint32_t rm_cachesector;          /* Current sector in the rm_buffer */
   uint8_t *rm_xipbase;              /* Base address of directly accessible media */
   uint8_t *rm_buffer;               /* Device sector buffer, allocated if rm_xipbase==0 */
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  FAR struct romfs_hashent_s *rm_hashents; /* Directory hash index entries */
+  FAR uint32_t *rm_hashbuckets;     /* Heads of the hash chains */
+  uint32_t rm_hashmask;             /* Number of hash buckets - 1 */
+#endif
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+  uint32_t rm_pathstamp;            /* Incremented on each path cache hit or insertion */
+  struct romfs_pathent_s rm_pathcache[CONFIG_FS_ROMFS_PATHCACHE_SIZE];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -166,25 +230,6 @@ struct romfs_file_s
   uint8_t rf_type;                  /* File type (for fstat()) */
 };
 
-/* This structure is used internally for describing the result of
- * walking a path
- */
-
-struct romfs_dirinfo_s
-{
-  /* These values describe the directory containing the terminal
-   * path component (of the terminal component itself if it is
-   * a directory.
-   */
-
-  struct fs_romfsdir_s rd_dir;    /* Describes directory. */
-
-  /* Values from the ROMFS file entry */
-
-  uint32_t rd_next;               /* Offset of the next file header+flags */
-  uint32_t rd_size;               /* Size (if file) */
-};
-
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -223,6 +268,12 @@ int  romfs_parsefilename(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR char *pname);
 int  romfs_datastart(FAR struct romfs_mountpt_s *rm, uint32_t offset,
        FAR uint32_t *start);
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+int  romfs_buildindex(FAR struct romfs_mountpt_s *rm);
+#endif
+#if defined(CONFIG_FS_ROMFS_DIRHASH) || CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+void romfs_freeindex(FAR struct romfs_mountpt_s *rm);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -256,6 +256,257 @@ static int romfs_followhardlinks(struct romfs_mountpt_s *rm, uint32_t offset,
   return -ELOOP;
 }
 
+/****************************************************************************
+ * Name: romfs_namehash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a name segment of length len, seeded with
+ *   the offset of the directory that contains it.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_FS_ROMFS_DIRHASH) || CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+static uint32_t romfs_namehash(uint32_t seed, FAR const char *name, int len)
+{
+  uint32_t hash = 2166136261u ^ seed;
+
+  while (len-- > 0)
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_searchindex
+ *
+ * Description:
+ *   This is the hashed alternative to romfs_searchdir().  Look up entryname
+ *   in the directory beginning at dirinfo->fr_firstoffset using the
+ *   directory hash index.  Only the entries whose hash matches are read
+ *   from the media.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+static int romfs_searchindex(struct romfs_mountpt_s *rm,
+                             const char *entryname, int entrylen,
+                             struct romfs_dirinfo_s *dirinfo)
+{
+  FAR struct romfs_hashent_s *ent;
+  uint32_t parent;
+  uint32_t hash;
+  uint32_t ndx;
+  int      ret;
+
+  parent = dirinfo->rd_dir.fr_firstoffset;
+  hash   = romfs_namehash(parent, entryname, entrylen);
+
+  for (ndx = rm->rm_hashbuckets[hash & rm->rm_hashmask];
+       ndx != ROMFS_HASH_NONE;
+       ndx = ent->he_next)
+    {
+      ent = &rm->rm_hashents[ndx];
+      if (ent->he_hash == hash && ent->he_parent == parent)
+        {
+          ret = romfs_checkentry(rm, ent->he_offset, entryname, entrylen,
+                                 dirinfo);
+          if (ret != -ENOENT)
+            {
+              return ret;
+            }
+        }
+    }
+
+  /* The index is complete so there is nothing in this directory with that
+   * name.
+   */
+
+  return -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_indexdir
+ *
+ * Description:
+ *   Add every entry in the directory beginning at diroffset to the
+ *   directory hash index under construction.  While the index is being
+ *   built, he_next holds the offset of the first entry of sub-directories
+ *   that still need to be indexed (zero otherwise).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+static int romfs_indexdir(struct romfs_mountpt_s *rm, uint32_t diroffset,
+                          FAR struct romfs_hashent_s **pents,
+                          FAR uint32_t *pnents, FAR uint32_t *pmaxents)
+{
+  FAR struct romfs_hashent_s *ents = *pents;
+  FAR struct romfs_hashent_s *ent;
+  char     name[NAME_MAX + 1];
+  uint32_t offset;
+  uint32_t next;
+  uint32_t info;
+  int16_t  ndx;
+  int      ret;
+
+  offset = diroffset;
+  do
+    {
+      ndx = romfs_devcacheread(rm, offset);
+      if (ndx < 0)
+        {
+          return ndx;
+        }
+
+      next = romfs_devread32(rm, ndx + ROMFS_FHDR_NEXT);
+      info = romfs_devread32(rm, ndx + ROMFS_FHDR_INFO);
+
+      ret = romfs_parsefilename(rm, offset, name);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Grow the entry array as needed.  Each file header takes at least
+       * 32 bytes so anything beyond that is a corrupted (circular) image.
+       */
+
+      if (*pnents >= *pmaxents)
+        {
+          uint32_t maxents = *pmaxents ? *pmaxents << 1 : ROMFS_HASH_MINBUCKETS;
+
+          if (maxents > rm->rm_volsize / 32)
+            {
+              return -EIO;
+            }
+
+          ents = (FAR struct romfs_hashent_s *)
+            kmm_realloc(ents, maxents * sizeof(struct romfs_hashent_s));
+          if (ents == NULL)
+            {
+              return -ENOMEM;
+            }
+
+          *pents    = ents;
+          *pmaxents = maxents;
+        }
+
+      ent            = &ents[(*pnents)++];
+      ent->he_parent = diroffset;
+      ent->he_offset = offset;
+      ent->he_hash   = romfs_namehash(diroffset, name, strlen(name));
+      ent->he_next   = 0;
+
+      /* Only descend into real sub-directories.  Hard links are not
+       * followed and the "." and ".." entries refer back up the tree.
+       */
+
+      if (IS_DIRECTORY(next) && info != 0 && info != diroffset &&
+          strcmp(name, ".") != 0 && strcmp(name, "..") != 0)
+        {
+          ent->he_next = info;
+        }
+
+      offset = next & RFNEXT_OFFSETMASK;
+    }
+  while (offset != 0);
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_pathlookup
+ *
+ * Description:
+ *   Look up a relative path in the per-mount path cache.  Returns OK and
+ *   the saved directory entry information on a hit.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+static int romfs_pathlookup(struct romfs_mountpt_s *rm, const char *path,
+                            struct romfs_dirinfo_s *dirinfo)
+{
+  FAR struct romfs_pathent_s *pe;
+  uint32_t hash;
+  int i;
+
+  hash = romfs_namehash(0, path, strlen(path));
+  for (i = 0; i < CONFIG_FS_ROMFS_PATHCACHE_SIZE; i++)
+    {
+      pe = &rm->rm_pathcache[i];
+      if (pe->pe_path != NULL && pe->pe_hash == hash &&
+          strcmp(pe->pe_path, path) == 0)
+        {
+          pe->pe_stamp = ++rm->rm_pathstamp;
+          memcpy(dirinfo, &pe->pe_dirinfo, sizeof(struct romfs_dirinfo_s));
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_pathinsert
+ *
+ * Description:
+ *   Save the result of a successful path lookup in the per-mount path
+ *   cache, replacing the least recently used entry if the cache is full.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+static void romfs_pathinsert(struct romfs_mountpt_s *rm, const char *path,
+                             const struct romfs_dirinfo_s *dirinfo)
+{
+  FAR struct romfs_pathent_s *pe;
+  FAR struct romfs_pathent_s *victim;
+  size_t len;
+  int i;
+
+  victim = &rm->rm_pathcache[0];
+  for (i = 0; i < CONFIG_FS_ROMFS_PATHCACHE_SIZE; i++)
+    {
+      pe = &rm->rm_pathcache[i];
+      if (pe->pe_path == NULL)
+        {
+          victim = pe;
+          break;
+        }
+
+      if ((int32_t)(pe->pe_stamp - victim->pe_stamp) < 0)
+        {
+          victim = pe;
+        }
+    }
+
+  if (victim->pe_path != NULL)
+    {
+      kmm_free(victim->pe_path);
+    }
+
+  len             = strlen(path);
+  victim->pe_path = (FAR char *)kmm_malloc(len + 1);
+  if (victim->pe_path == NULL)
+    {
+      return;
+    }
+
+  memcpy(victim->pe_path, path, len + 1);
+  victim->pe_hash  = romfs_namehash(0, path, len);
+  victim->pe_stamp = ++rm->rm_pathstamp;
+  memcpy(&victim->pe_dirinfo, dirinfo, sizeof(struct romfs_dirinfo_s));
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_searchdir
  *
@@ -274,6 +525,15 @@ static inline int romfs_searchdir(struct romfs_mountpt_s *rm,
   int16_t  ndx;
   int      ret;
 
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  /* Use the directory hash index if one was built when mounted */
+
+  if (rm->rm_hashbuckets != NULL)
+    {
+      return romfs_searchindex(rm, entryname, entrylen, dirinfo);
+    }
+#endif
+
   /* Then loop through the current directory until the directory
    * with the matching name is found.  Or until all of the entries
    * the directory have been examined.
@@ -742,6 +1002,15 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
       return OK;
     }
 
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+  /* Check if this path was resolved recently */
+
+  if (romfs_pathlookup(rm, path, dirinfo) == OK)
+    {
+      return OK;
+    }
+#endif
+
   /* Then loop for each directory/file component in the full path */
 
   entryname    = path;
@@ -788,6 +1057,9 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
         {
            /* Yes.. return success */
 
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+           romfs_pathinsert(rm, path, dirinfo);
+#endif
            return OK;
         }
 
@@ -988,3 +1260,130 @@ int romfs_datastart(struct romfs_mountpt_s *rm, uint32_t offset,
 
   return -EINVAL; /* Won't get here */
 }
+
+/****************************************************************************
+ * Name: romfs_buildindex
+ *
+ * Description:
+ *   Walk the whole directory tree of the mounted volume and build the
+ *   directory hash index used by romfs_finddirentry().  On failure, no
+ *   index is retained and directories are searched linearly.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+int romfs_buildindex(struct romfs_mountpt_s *rm)
+{
+  FAR struct romfs_hashent_s *ents = NULL;
+  FAR uint32_t *buckets;
+  uint32_t nents    = 0;
+  uint32_t maxents  = 0;
+  uint32_t nbuckets;
+  uint32_t bucket;
+  uint32_t child;
+  uint32_t ndx;
+  int ret;
+
+  /* Index the root directory, then each sub-directory as it is found.  The
+   * entry array doubles as the queue of directories still to be indexed.
+   */
+
+  ret = romfs_indexdir(rm, rm->rm_rootoffset, &ents, &nents, &maxents);
+  for (ndx = 0; ret >= 0 && ndx < nents; ndx++)
+    {
+      child = ents[ndx].he_next;
+      if (child != 0)
+        {
+          ret = romfs_indexdir(rm, child, &ents, &nents, &maxents);
+        }
+    }
+
+  if (ret < 0)
+    {
+      goto errout_with_ents;
+    }
+
+  /* Size the bucket array to the next power of two above the number of
+   * entries and link each entry into its hash chain.
+   */
+
+  nbuckets = ROMFS_HASH_MINBUCKETS;
+  while (nbuckets < nents)
+    {
+      nbuckets <<= 1;
+    }
+
+  buckets = (FAR uint32_t *)kmm_malloc(nbuckets * sizeof(uint32_t));
+  if (buckets == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_ents;
+    }
+
+  memset(buckets, 0xff, nbuckets * sizeof(uint32_t));
+  for (ndx = 0; ndx < nents; ndx++)
+    {
+      bucket            = ents[ndx].he_hash & (nbuckets - 1);
+      ents[ndx].he_next = buckets[bucket];
+      buckets[bucket]   = ndx;
+    }
+
+  rm->rm_hashents    = ents;
+  rm->rm_hashbuckets = buckets;
+  rm->rm_hashmask    = nbuckets - 1;
+
+  finfo("Indexed %lu entries in %lu buckets\n",
+        (unsigned long)nents, (unsigned long)nbuckets);
+  return OK;
+
+errout_with_ents:
+  if (ents != NULL)
+    {
+      kmm_free(ents);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: romfs_freeindex
+ *
+ * Description:
+ *   Release the directory hash index and the path cache
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_FS_ROMFS_DIRHASH) || CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+void romfs_freeindex(struct romfs_mountpt_s *rm)
+{
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+  int i;
+#endif
+
+#ifdef CONFIG_FS_ROMFS_DIRHASH
+  if (rm->rm_hashents != NULL)
+    {
+      kmm_free(rm->rm_hashents);
+      rm->rm_hashents = NULL;
+    }
+
+  if (rm->rm_hashbuckets != NULL)
+    {
+      kmm_free(rm->rm_hashbuckets);
+      rm->rm_hashbuckets = NULL;
+    }
+#endif
+
+#if CONFIG_FS_ROMFS_PATHCACHE_SIZE > 0
+  for (i = 0; i < CONFIG_FS_ROMFS_PATHCACHE_SIZE; i++)
+    {
+      if (rm->rm_pathcache[i].pe_path != NULL)
+        {
+          kmm_free(rm->rm_pathcache[i].pe_path);
+          rm->rm_pathcache[i].pe_path = NULL;
+        }
+    }
+#endif
+}
+#endif
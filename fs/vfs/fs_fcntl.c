@@ -48,6 +48,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 
 #include "inode/inode.h"
@@ -205,6 +206,31 @@ int file_vfcntl(FAR struct file *filep, int cmd, va_list ap)
         ret = -ENOSYS; /* Not implemented */
         break;
 
+      case F_SETPIPE_SZ:
+        /* Change the size of the buffer of the pipe or FIFO referred to by
+         * fd to arg bytes.  The size actually set is returned.  This is a
+         * Linux extension;  the request is forwarded to the pipe driver.
+         */
+
+        {
+          unsigned long size = (unsigned long)va_arg(ap, int);
+
+          ret = file_ioctl(filep, PIPEIOC_SETSIZE, size);
+          if (ret >= 0)
+            {
+              ret = file_ioctl(filep, PIPEIOC_GETSIZE, 0);
+            }
+        }
+        break;
+
+      case F_GETPIPE_SZ:
+        /* Return the size of the buffer of the pipe or FIFO referred to by
+         * fd.
+         */
+
+        ret = file_ioctl(filep, PIPEIOC_GETSIZE, 0);
+        break;
+
       default:
         break;
     }
@@ -280,6 +280,15 @@ next_subdir:
   /* Remove all of the children from the unlinked inode */
 
   oldinode->i_child = NULL;
+
+#ifdef CONFIG_FS_INODE_HASH
+  /* inode_remove() dropped the moved children from the hash index.  Add
+   * them back under their new parent.
+   */
+
+  inode_rehash(newinode);
+#endif
+
   ret = OK;
 
 errout_with_sem:
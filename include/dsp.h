@@ -245,6 +245,125 @@ struct dq_frame_s
 
 typedef struct dq_frame_s dq_frame_t;
 
+/* Struct-of-arrays frames used by the batch functions.  Each member points
+ * to an array with one element per sample (or per motor), so the batch
+ * loops walk memory sequentially and can be vectorized by the compiler.
+ * Input and output may refer to the same arrays.
+ */
+
+struct abc_frame_soa_s
+{
+  FAR float *a;                /* A components */
+  FAR float *b;                /* B components */
+  FAR float *c;                /* C components */
+};
+
+typedef struct abc_frame_soa_s abc_frame_soa_t;
+
+struct ab_frame_soa_s
+{
+  FAR float *a;                /* Alpha components */
+  FAR float *b;                /* Beta components */
+};
+
+typedef struct ab_frame_soa_s ab_frame_soa_t;
+
+struct dq_frame_soa_s
+{
+  FAR float *d;                /* Direct components */
+  FAR float *q;                /* Quadrature components */
+};
+
+typedef struct dq_frame_soa_s dq_frame_soa_t;
+
+struct phase_angle_soa_s
+{
+  FAR float *angle;            /* Angles in radians */
+  FAR float *sin;              /* Sine of the angles */
+  FAR float *cos;              /* Cosine of the angles */
+};
+
+typedef struct phase_angle_soa_s phase_angle_soa_t;
+
+#ifdef CONFIG_LIBDSP_FIXED
+/* Fixed-point fractions in range <-1.0, 1.0) */
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+/* Fixed-point struct-of-arrays frames.  Angles are binary angles where
+ * the full integer range corresponds to one electrical revolution (2PI).
+ */
+
+struct abc_frame_q15_soa_s
+{
+  FAR q15_t *a;                /* A components */
+  FAR q15_t *b;                /* B components */
+  FAR q15_t *c;                /* C components */
+};
+
+typedef struct abc_frame_q15_soa_s abc_frame_q15_soa_t;
+
+struct ab_frame_q15_soa_s
+{
+  FAR q15_t *a;                /* Alpha components */
+  FAR q15_t *b;                /* Beta components */
+};
+
+typedef struct ab_frame_q15_soa_s ab_frame_q15_soa_t;
+
+struct dq_frame_q15_soa_s
+{
+  FAR q15_t *d;                /* Direct components */
+  FAR q15_t *q;                /* Quadrature components */
+};
+
+typedef struct dq_frame_q15_soa_s dq_frame_q15_soa_t;
+
+struct phase_angle_q15_soa_s
+{
+  FAR uint16_t *angle;         /* Binary angles (65536 = 2PI) */
+  FAR q15_t    *sin;           /* Sine of the angles */
+  FAR q15_t    *cos;           /* Cosine of the angles */
+};
+
+typedef struct phase_angle_q15_soa_s phase_angle_q15_soa_t;
+
+struct abc_frame_q31_soa_s
+{
+  FAR q31_t *a;                /* A components */
+  FAR q31_t *b;                /* B components */
+  FAR q31_t *c;                /* C components */
+};
+
+typedef struct abc_frame_q31_soa_s abc_frame_q31_soa_t;
+
+struct ab_frame_q31_soa_s
+{
+  FAR q31_t *a;                /* Alpha components */
+  FAR q31_t *b;                /* Beta components */
+};
+
+typedef struct ab_frame_q31_soa_s ab_frame_q31_soa_t;
+
+struct dq_frame_q31_soa_s
+{
+  FAR q31_t *d;                /* Direct components */
+  FAR q31_t *q;                /* Quadrature components */
+};
+
+typedef struct dq_frame_q31_soa_s dq_frame_q31_soa_t;
+
+struct phase_angle_q31_soa_s
+{
+  FAR uint32_t *angle;         /* Binary angles (2^32 = 2PI) */
+  FAR q31_t    *sin;           /* Sine of the angles */
+  FAR q31_t    *cos;           /* Cosine of the angles */
+};
+
+typedef struct phase_angle_q31_soa_s phase_angle_q31_soa_t;
+#endif /* CONFIG_LIBDSP_FIXED */
+
 /* Space Vector Modulation data for 3-phase system */
 
 struct svm3_state_s
@@ -391,6 +510,9 @@ float fast_sin(float angle);
 float fast_sin2(float angle);
 float fast_cos(float angle);
 float fast_cos2(float angle);
+void fast_sincos(float angle, FAR float *s, FAR float *c);
+void fast_sincos_batch(FAR const float *angle, FAR float *s, FAR float *c,
+                       size_t n);
 float fast_atan2(float y, float x);
 
 void f_saturate(FAR float *val, float min, float max);
@@ -423,11 +545,55 @@ void park_transform(FAR phase_angle_t *angle, FAR ab_frame_t *ab,
 void inv_park_transform(FAR phase_angle_t *angle, FAR dq_frame_t *dq,
                         FAR ab_frame_t *ab);
 
+void clarke_transform_batch(FAR abc_frame_soa_t *abc,
+                            FAR ab_frame_soa_t *ab, size_t n);
+void inv_clarke_transform_batch(FAR ab_frame_soa_t *ab,
+                                FAR abc_frame_soa_t *abc, size_t n);
+void park_transform_batch(FAR phase_angle_soa_t *angle,
+                          FAR ab_frame_soa_t *ab,
+                          FAR dq_frame_soa_t *dq, size_t n);
+void inv_park_transform_batch(FAR phase_angle_soa_t *angle,
+                              FAR dq_frame_soa_t *dq,
+                              FAR ab_frame_soa_t *ab, size_t n);
+
+#ifdef CONFIG_LIBDSP_FIXED
+void clarke_transform_q15_batch(FAR abc_frame_q15_soa_t *abc,
+                                FAR ab_frame_q15_soa_t *ab, size_t n);
+void inv_clarke_transform_q15_batch(FAR ab_frame_q15_soa_t *ab,
+                                    FAR abc_frame_q15_soa_t *abc,
+                                    size_t n);
+void park_transform_q15_batch(FAR phase_angle_q15_soa_t *angle,
+                              FAR ab_frame_q15_soa_t *ab,
+                              FAR dq_frame_q15_soa_t *dq, size_t n);
+void inv_park_transform_q15_batch(FAR phase_angle_q15_soa_t *angle,
+                                  FAR dq_frame_q15_soa_t *dq,
+                                  FAR ab_frame_q15_soa_t *ab, size_t n);
+
+void clarke_transform_q31_batch(FAR abc_frame_q31_soa_t *abc,
+                                FAR ab_frame_q31_soa_t *ab, size_t n);
+void inv_clarke_transform_q31_batch(FAR ab_frame_q31_soa_t *ab,
+                                    FAR abc_frame_q31_soa_t *abc,
+                                    size_t n);
+void park_transform_q31_batch(FAR phase_angle_q31_soa_t *angle,
+                              FAR ab_frame_q31_soa_t *ab,
+                              FAR dq_frame_q31_soa_t *dq, size_t n);
+void inv_park_transform_q31_batch(FAR phase_angle_q31_soa_t *angle,
+                                  FAR dq_frame_q31_soa_t *dq,
+                                  FAR ab_frame_q31_soa_t *ab, size_t n);
+#endif
+
 /* Phase angle related functions */
 
 void angle_norm(FAR float *angle, float per, float bottom, float top);
 void angle_norm_2pi(FAR float *angle, float bottom, float top);
 void phase_angle_update(FAR struct phase_angle_s *angle, float val);
+void phase_angle_update_batch(FAR phase_angle_soa_t *angle,
+                              FAR const float *val, size_t n);
+
+#ifdef CONFIG_LIBDSP_FIXED
+void sincos_q15_batch(FAR phase_angle_q15_soa_t *angle, size_t n);
+void sincos_q31_batch(FAR phase_angle_q31_soa_t *angle, size_t n);
+#endif
 
 /* 3-phase system space vector modulation*/
 
@@ -446,6 +612,9 @@ void foc_init(FAR struct foc_data_s *data,
 void foc_process(FAR struct foc_data_s *foc,
                  FAR abc_frame_t *i_abc,
                  FAR phase_angle_t *angle);
+void foc_process_batch(FAR struct foc_data_s *foc,
+                       FAR abc_frame_soa_t *i_abc,
+                       FAR phase_angle_soa_t *angle, size_t n);
 
 /* BLDC/PMSM motor observers */
 
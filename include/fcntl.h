@@ -109,6 +109,8 @@
 #define F_SETLKW    12 /* Like F_SETLK, but wait for lock to become available */
 #define F_SETOWN    13 /* Set pid that will receive SIGIO and SIGURG signals for fd */
 #define F_SETSIG    14 /* Set the signal to be sent */
+#define F_SETPIPE_SZ 15 /* Set the size of the pipe/FIFO buffer (linux) */
+#define F_GETPIPE_SZ 16 /* Get the size of the pipe/FIFO buffer (linux) */
 
 /* For posix fcntl() and lockf() */
 
@@ -41,6 +41,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -69,4 +70,80 @@
 #define TCP_KEEPCNT   (__SO_PROTOCOL + 3) /* Number of keepalives before death
                                            * Argument: max retry count */
 
+/* TCP protocol socket options needed to support congestion control: */
+
+#define TCP_INFO      (__SO_PROTOCOL + 4) /* Get connection information
+                                           * Argument: struct tcp_info */
+#define TCP_CONGESTION (__SO_PROTOCOL + 5) /* Congestion control algorithm
+                                           * Argument: char[TCP_CA_NAME_MAX] */
+
+/* Maximum length of a congestion control algorithm name */
+
+#define TCP_CA_NAME_MAX 16
+
+/* Congestion control states (tcpi_ca_state) */
+
+#define TCP_CA_OPEN     0 /* Normal operation */
+#define TCP_CA_DISORDER 1 /* Duplicate ACKs seen */
+#define TCP_CA_CWR      2 /* Window reduced */
+#define TCP_CA_RECOVERY 3 /* Fast recovery */
+#define TCP_CA_LOSS     4 /* Recovering from a retransmission timeout */
+
+/* Options negotiated on the connection (tcpi_options) */
+
+#define TCPI_OPT_TIMESTAMPS (1 << 0)
+#define TCPI_OPT_SACK       (1 << 1)
+#define TCPI_OPT_WSCALE     (1 << 2)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Returned by getsockopt(TCP_INFO).  The layout follows Linux.  Times are
+ * in microseconds, windows and thresholds in segments.  Fields that are
+ * not maintained are reported as zero.
+ */
+
+struct tcp_info
+{
+  uint8_t  tcpi_state;          /* TCP state */
+  uint8_t  tcpi_ca_state;       /* Congestion control state (TCP_CA_*) */
+  uint8_t  tcpi_retransmits;    /* Retransmissions of the current segment */
+  uint8_t  tcpi_probes;         /* Unanswered keep-alive probes */
+  uint8_t  tcpi_backoff;        /* RTO backoff */
+  uint8_t  tcpi_options;        /* Negotiated options (TCPI_OPT_*) */
+  uint8_t  tcpi_snd_wscale : 4; /* Shift applied to the peer's window */
+  uint8_t  tcpi_rcv_wscale : 4; /* Shift applied to our window */
+
+  uint32_t tcpi_rto;            /* Retransmission time-out */
+  uint32_t tcpi_ato;            /* Delayed ACK time-out */
+  uint32_t tcpi_snd_mss;        /* Send maximum segment size */
+  uint32_t tcpi_rcv_mss;        /* Receive maximum segment size */
+
+  uint32_t tcpi_unacked;        /* Segments sent but not ACKed */
+  uint32_t tcpi_sacked;         /* Segments selectively ACKed */
+  uint32_t tcpi_lost;           /* Segments considered lost */
+  uint32_t tcpi_retrans;        /* Segments being retransmitted */
+  uint32_t tcpi_fackets;
+
+  uint32_t tcpi_last_data_sent;
+  uint32_t tcpi_last_ack_sent;
+  uint32_t tcpi_last_data_recv;
+  uint32_t tcpi_last_ack_recv;
+
+  uint32_t tcpi_pmtu;
+  uint32_t tcpi_rcv_ssthresh;
+  uint32_t tcpi_rtt;            /* Smoothed round trip time */
+  uint32_t tcpi_rttvar;         /* Round trip time variation */
+  uint32_t tcpi_snd_ssthresh;   /* Slow start threshold */
+  uint32_t tcpi_snd_cwnd;       /* Congestion window */
+  uint32_t tcpi_advmss;         /* Advertised maximum segment size */
+  uint32_t tcpi_reordering;
+
+  uint32_t tcpi_rcv_rtt;
+  uint32_t tcpi_rcv_space;
+
+  uint32_t tcpi_total_retrans;  /* Total retransmitted segments */
+};
+
 #endif /* __INCLUDE_NETINET_TCP_H */
@@ -239,6 +239,24 @@ typedef int64_t sclock_t;
 typedef int32_t sclock_t;
 #endif
 
+/* This structure describes the shared clock time page.  The kernel updates
+ * it on each timer tick and whenever the time-of-day is changed.  Readers
+ * use the sequence count to detect concurrent updates:  The count is odd
+ * while an update is in progress and changes each time the page is
+ * written.  A count of zero means that the page has never been written.
+ */
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+struct clock_timepage_s
+{
+  volatile uint32_t seq;         /* Update sequence count */
+  volatile time_t   mono_sec;    /* Elapsed time since power up (seconds) */
+  volatile long     mono_nsec;   /* Elapsed time since power up (nsec) */
+  volatile time_t   base_sec;    /* Time-of-day base time (seconds) */
+  volatile long     base_nsec;   /* Time-of-day base time (nsec) */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -266,6 +284,14 @@ EXTERN volatile clock_t g_system_timer;
 #endif
 #endif
 
+/* The shared clock time page.  This always resides in user memory so that
+ * it can be read without a system call.
+ */
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+EXTERN struct clock_timepage_s g_timepage;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -387,6 +413,47 @@ clock_t clock_systimer(void);
 
 int clock_systimespec(FAR struct timespec *ts);
 
+/****************************************************************************
+ * Name: clock_timepage_read
+ *
+ * Description:
+ *   Read CLOCK_REALTIME or CLOCK_MONOTONIC from the shared clock time page
+ *   without a system call and without entering a critical section.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   OK on success; -EAGAIN if the time page cannot provide the clock (the
+ *   page has not yet been written or the clock is not supported).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+int clock_timepage_read(clockid_t clock_id, FAR struct timespec *tp);
+#endif
+
+/****************************************************************************
+ * Name: clock_timepage_gettime
+ *
+ * Description:
+ *   A drop-in replacement for clock_gettime() that uses the shared clock
+ *   time page when possible and falls back to clock_gettime() otherwise.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   Same as clock_gettime().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+int clock_timepage_gettime(clockid_t clock_id, FAR struct timespec *tp);
+#endif
+
 /****************************************************************************
  * Name:  clock_cpuload
  *
@@ -398,6 +398,10 @@ struct inode
 {
   FAR struct inode *i_peer;     /* Link to same level inode */
   FAR struct inode *i_child;    /* Link to lower level inode */
+#ifdef CONFIG_FS_INODE_HASH
+  FAR struct inode *i_parent;   /* Link to upper level inode */
+  FAR struct inode *i_hnext;    /* Link to next inode in hash chain */
+#endif
   int16_t           i_crefs;    /* References to inode */
   uint16_t          i_flags;    /* Flags for inode */
   union inode_ops_u u;          /* Inode operations */
@@ -375,6 +375,20 @@
                                              *       (default)
                                              *     1=fre when empty
                                              * OUT: None */
+#define PIPEIOC_SETSIZE   _PIPEIOC(0x0002)  /* Set ring buffer size
+                                             * IN: unsigned long integer
+                                             *     size in bytes
+                                             * OUT: None */
+#define PIPEIOC_GETSIZE   _PIPEIOC(0x0003)  /* Get ring buffer size
+                                             * IN: None
+                                             * OUT: None (size is the
+                                             *      return value) */
+#define PIPEIOC_SPSC      _PIPEIOC(0x0004)  /* Set single-producer/
+                                             * single-consumer mode
+                                             * IN: unsigned long integer
+                                             *     0=disabled (default)
+                                             *     1=enabled
+                                             * OUT: None */
 
 /* RTC driver ioctl definitions *********************************************/
 /* (see nuttx/include/rtc.h */
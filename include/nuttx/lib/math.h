@@ -230,9 +230,14 @@ long double expl  (long double x);
 #define expm1l(x) (expl(x) - 1.0)
 #endif
 
+float       __cosf(float x, float y);
+float       __sinf(float x, float y, int iy);
+int         __rem_pio2f(float x, FAR float *y);
 #ifdef CONFIG_HAVE_DOUBLE
 double      __cos(double x, double y);
 double      __sin(double x, double y, int iy);
+int         __rem_pio2(double x, FAR double *y);
+double      __exp(double x, double xtail);
 double      gamma(double x);
 double      lgamma(double x);
 #endif
@@ -303,6 +308,11 @@ double      cos   (double x);
 long double cosl  (long double x);
 #endif
 
+void        sincosf(float x, FAR float *s, FAR float *c);
+#ifdef CONFIG_HAVE_DOUBLE
+void        sincos(double x, FAR double *s, FAR double *c);
+#endif
+
 float       tanf  (float x);
 #ifdef CONFIG_HAVE_DOUBLE
 double      tan   (double x);
@@ -92,6 +92,12 @@
 #  define _MQ_GETERRVAL(r)            (-errno)
 #endif
 
+/* Number of 32-bit words in the bitmap of non-empty priority buckets */
+
+#ifdef CONFIG_MQ_PRIOBUCKETS
+#  define MQ_NPRIOWORDS ((CONFIG_MQ_NPRIOBUCKETS + 31) >> 5)
+#endif
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
@@ -103,7 +109,16 @@ struct mq_des; /* forward reference */
 struct mqueue_inode_s
 {
   FAR struct inode *inode;    /* Containing inode */
+#ifdef CONFIG_MQ_PRIOBUCKETS
+  sq_queue_t msgbucket[CONFIG_MQ_NPRIOBUCKETS]; /* Per-priority FIFOs */
+  uint32_t prioset[MQ_NPRIOWORDS]; /* Bitmap of non-empty buckets */
+#else
   sq_queue_t msglist;         /* Prioritized message list */
+#endif
+#ifdef CONFIG_MQ_MSGSLAB
+  FAR void *msgslab;          /* Pre-allocated messages for this queue */
+  sq_queue_t slabfree;        /* Free messages in msgslab */
+#endif
   int16_t maxmsgs;            /* Maximum number of messages in the queue */
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
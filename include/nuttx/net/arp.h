@@ -74,6 +74,10 @@
 #define ARPHRD_IEEE80211    801  /* IEEE 802.11 */
 #define ARPHRD_IEEE802154   804  /* IEEE 802.15.4 */
 
+/* Values of the at_flags field of struct arp_entry_s */
+
+#define ARP_FLAG_NEGATIVE   (1 << 0) /* Address resolution failed */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -85,6 +89,8 @@ struct arp_entry_s
   in_addr_t         at_ipaddr;   /* IP address */
   struct ether_addr at_ethaddr;  /* Hardware address */
   clock_t           at_time;     /* Time of last usage */
+  uint32_t          at_hits;     /* Number of successful look-ups */
+  uint8_t           at_flags;    /* See ARP_FLAG_* definitions */
 };
 
 /****************************************************************************
@@ -126,7 +126,7 @@ enum net_lltype_e
 
 /* This defines a bitmap big enough for one bit for each socket option */
 
-typedef uint16_t sockopt_t;
+typedef uint32_t sockopt_t;
 
 /* This defines the storage size of a timeout value.  This effects only
  * range of supported timeout values.  With an LSB in seciseconds, the
@@ -963,6 +963,76 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' datagrams from a socket with a
+ *   single call.  The network is locked once for the whole batch so that
+ *   datagrams already queued in the read-ahead buffers are drained without
+ *   releasing and re-acquiring the lock for each datagram.  This is an
+ *   internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message headers.  Each must have exactly one
+ *             I/O vector.
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Receive flags.  MSG_WAITFORONE causes MSG_DONTWAIT to be
+ *             used after the first datagram has been received.
+ *   timeout - Optional limit on the time spent in the call.  As with
+ *             Linux, it is checked only after each datagram is received.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received; msg_len of each
+ *   received message holds its length.  If an error occurs after at least
+ *   one message was received, the number of messages received is returned.
+ *   Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' datagrams on a socket with a
+ *   single call and a single acquisition of the network lock.  This is an
+ *   internal OS interface.  It is functionally equivalent to sendmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message headers.  Each must have exactly one
+ *             I/O vector.
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent; msg_len of each sent
+ *   message holds the number of bytes sent.  If an error occurs after at
+ *   least one message was sent, the number of messages sent is returned.
+ *   Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
@@ -134,6 +134,7 @@
 #  define NETDEV_TXDONE(dev)      _NETDEV_STATISTIC(dev,tx_done)
 #  define NETDEV_TXERRORS(dev)    _NETDEV_ERROR(dev,tx_errors)
 #  define NETDEV_TXTIMEOUTS(dev)  _NETDEV_ERROR(dev,tx_timeouts)
+#  define NETDEV_TXPOLLS(dev)     _NETDEV_STATISTIC(dev,tx_polls)
 
 #  define NETDEV_ERRORS(dev)      _NETDEV_STATISTIC(dev,errors)
 
@@ -151,6 +152,7 @@
 #  define NETDEV_TXDONE(dev)
 #  define NETDEV_TXERRORS(dev)
 #  define NETDEV_TXTIMEOUTS(dev)
+#  define NETDEV_TXPOLLS(dev)
 
 #  define NETDEV_ERRORS(dev)
 #endif
@@ -189,6 +191,7 @@ struct netdev_statistics_s
   uint32_t tx_done;        /* Number of packets completed */
   uint32_t tx_errors;      /* Number of receive errors (incl timeouts) */
   uint32_t tx_timeouts;    /* Number of Tx timeout errors */
+  uint32_t tx_polls;       /* Number of connections polled for Tx */
 
   /* Other status */
 
@@ -390,6 +393,15 @@ struct net_driver_s
   int (*d_ifup)(FAR struct net_driver_s *dev);
   int (*d_ifdown)(FAR struct net_driver_s *dev);
   int (*d_txavail)(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+  /* Optional.  Transmit the packet in d_buf/d_len now.  Used by the IP
+   * forwarding fast path, which points d_buf into the receiving device's
+   * buffer for the duration of the call:  The driver must send or copy the
+   * packet before returning.  Returns -EBUSY if there is no TX capacity.
+   */
+
+  int (*d_transmit)(FAR struct net_driver_s *dev);
+#endif
 #ifdef CONFIG_NET_MCASTGROUP
   int (*d_addmac)(FAR struct net_driver_s *dev, FAR const uint8_t *mac);
   int (*d_rmmac)(FAR struct net_driver_s *dev, FAR const uint8_t *mac);
@@ -547,6 +559,46 @@ int sixlowpan_input(FAR struct radio_driver_s *ieee,
 int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback);
 int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback);
 
+/****************************************************************************
+ * Batched packet transfers
+ *
+ * The network processes one packet at a time in d_buf.  Drivers with
+ * descriptor rings may instead exchange packets with the network in
+ * batches of IOB chains.  This allows several packets to be in flight in
+ * the hardware, and locks the network only once per batch.
+ *
+ * netdev_txbatch() polls the network for up to 'budget' outgoing packets
+ * and adds each, with its link layer header complete, to 'txq'.
+ *
+ * netdev_rxbatch() removes up to 'budget' received packets from 'rxq' and
+ * passes each in d_buf to the driver's 'input' function.  That function
+ * does what the driver would otherwise do for a single received packet.
+ * Unprocessed packets remain in 'rxq'.
+ *
+ * Both return the number of packets transferred.  CONFIG_NETDEV_BATCH_BUDGET
+ * is the suggested budget.
+ *
+ * Example:
+ *   while (netdev_rxbatch(dev, &priv->rxq, CONFIG_NETDEV_BATCH_BUDGET,
+ *                         driver_input) > 0);
+ *
+ *   if (netdev_txbatch(dev, &priv->txq, ntxfree) > 0)
+ *     {
+ *       driver_transmit_queue(priv);
+ *     }
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_BATCH
+struct iob_queue_s;      /* Forward reference See iob.h */
+
+int netdev_txbatch(FAR struct net_driver_s *dev,
+                   FAR struct iob_queue_s *txq, int budget);
+int netdev_rxbatch(FAR struct net_driver_s *dev,
+                   FAR struct iob_queue_s *rxq, int budget,
+                   devif_poll_callback_t input);
+#endif
+
 /****************************************************************************
  * Name: neighbor_out
  *
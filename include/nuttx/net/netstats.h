@@ -80,6 +80,23 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_IPFORWARD
+/* IP forwarding statistics */
+
+struct ipfwd_stats_s
+{
+  net_stats_t fastpath;   /* Number of packets handed directly to the
+                             forwarding device */
+  net_stats_t queued;     /* Number of packets queued for the next poll
+                             of the forwarding device */
+  net_stats_t sent;       /* Number of queued packets that were sent */
+  net_stats_t drop;       /* Number of packets dropped while forwarding */
+  net_stats_t latmax;     /* Maximum queuing latency (clock ticks) */
+  uint32_t    lattotal;   /* Total queuing latency of all sent packets
+                             (clock ticks) */
+};
+#endif
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -117,6 +134,10 @@ struct net_stats_s
 #ifdef CONFIG_NET_UDP
   struct udp_stats_s  udp;      /* UDP statistics */
 #endif
+
+#ifdef CONFIG_NET_IPFORWARD
+  struct ipfwd_stats_s ipfwd;   /* IP forwarding statistics */
+#endif
 };
 
 /****************************************************************************
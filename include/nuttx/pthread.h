@@ -43,6 +43,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <pthread.h>
 #include <sched.h>
 
@@ -58,6 +59,27 @@
 #  define PTHREAD_DEFAULT_POLICY SCHED_RR
 #endif
 
+/* PTHREAD_MUTEX_ISFAST() is true if the mutex may be locked and unlocked
+ * via the atomic fast path without calling into the OS.  Robust mutexes
+ * and, when both are supported, mutexes whose ownership must be tracked
+ * by the OS always use the OS interfaces.
+ */
+
+#ifdef CONFIG_SEM_FASTPATH
+#  if defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
+#    define PTHREAD_MUTEX_ISFAST(m) (true)
+#  elif defined(CONFIG_PTHREAD_MUTEX_BOTH) && defined(CONFIG_PTHREAD_MUTEX_TYPES)
+#    define PTHREAD_MUTEX_ISFAST(m) \
+       (((m)->flags & _PTHREAD_MFLAGS_ROBUST) == 0 && \
+        (m)->type == PTHREAD_MUTEX_NORMAL)
+#  elif defined(CONFIG_PTHREAD_MUTEX_BOTH)
+#    define PTHREAD_MUTEX_ISFAST(m) \
+       (((m)->flags & _PTHREAD_MFLAGS_ROBUST) == 0)
+#  else
+#    define PTHREAD_MUTEX_ISFAST(m) (false)
+#  endif
+#endif
+
 /* A lot of hassle to use the old-fashioned struct initializers.  But this
  * gives us backward compatibility with some very old compilers.
  */
@@ -132,6 +154,23 @@ EXTERN const pthread_attr_t g_default_pthread_attr;
  * Public Function Prototypes
  ****************************************************************************/
 
+#ifdef CONFIG_SEM_FASTPATH
+/****************************************************************************
+ * Name: pthread_mutex_trylock_slow and pthread_mutex_unlock_slow
+ *
+ * Description:
+ *   These are the OS implementations of pthread_mutex_trylock() and
+ *   pthread_mutex_unlock().  When CONFIG_SEM_FASTPATH is selected, the C
+ *   library provides pthread_mutex_trylock() and pthread_mutex_unlock()
+ *   which operate on the mutex lock word directly and call these only
+ *   when the mutex is contended or must be managed by the OS.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trylock_slow(FAR pthread_mutex_t *mutex);
+int pthread_mutex_unlock_slow(FAR pthread_mutex_t *mutex);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
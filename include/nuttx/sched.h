@@ -382,6 +382,28 @@ struct dspace_s
 };
 #endif
 
+/* struct critmon_hist_s *********************************************************/
+/* Log2 bucketed histogram of the durations with pre-emption disabled or within a
+ * critical section.  See CONFIG_SCHED_CRITMONITOR_NBUCKETS for the meaning of
+ * the buckets.
+ */
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+struct critmon_hist_s
+{
+  uint32_t count[CONFIG_SCHED_CRITMONITOR_NBUCKETS];
+};
+
+/* One of the worst offenders recorded per CPU */
+
+struct critmon_worst_s
+{
+  FAR void *caller;                 /* Caller that started the section          */
+  uint32_t  elapsed;                /* Longest duration started by the caller   */
+  pid_t     pid;                    /* Thread that was running the section      */
+};
+#endif
+
 /* struct task_group_s ***********************************************************/
 /* All threads created by pthread_create belong in the same task group (along with
  * the thread of the original task).  struct task_group_s is a shared structure
@@ -662,6 +684,11 @@ struct tcb_s
 
 #ifndef CONFIG_DISABLE_MQUEUE
   FAR struct mqueue_inode_s *msgwaitq;   /* Waiting for this message queue      */
+#ifdef CONFIG_MQ_HANDOFF
+  FAR char  *msgrcvbuf;                  /* Hand-off: Receiver's buffer         */
+  size_t     msgrcvlen;                  /* Hand-off: Length of message         */
+  uint8_t    msgrcvprio;                 /* Hand-off: Priority of message       */
+#endif
 #endif
 
   /* POSIX Thread Specific Data *************************************************/
@@ -677,6 +704,22 @@ struct tcb_s
   uint32_t premp_max;                    /* Max time preemption disabled        */
   uint32_t crit_start;                   /* Time critical section entered       */
   uint32_t crit_max;                     /* Max time in critical section        */
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  FAR void *premp_from;                  /* Caller that disabled preemption     */
+  FAR void *premp_caller;                /* Caller of the max preemption time   */
+  FAR void *crit_from;                   /* Caller that entered crit. section   */
+  FAR void *crit_caller;                 /* Caller of the max crit. section     */
+  struct critmon_hist_s premp_hist;      /* Histogram of preemption disabled    */
+  struct critmon_hist_s crit_hist;       /* Histogram of critical sections      */
+#endif
+#endif
+
+  /* Wakeup latency tracer support **********************************************/
+
+#ifdef CONFIG_SCHED_LATENCY
+  uint32_t lat_irq;                      /* Interrupt entry time of the wakeup  */
+  uint32_t lat_wakeup;                   /* Time made ready-to-run              */
+  uint32_t lat_switch;                   /* Time switched in after the wakeup   */
 #endif
 
   /* Library related fields *****************************************************/
@@ -792,6 +835,26 @@ EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_premp_max[1];
 EXTERN uint32_t g_crit_max[1];
 #endif
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Histograms and the worst offenders for each CPU.  Updated within a critical
+ * section.
+ */
+
+#ifdef CONFIG_SMP_NCPUS
+EXTERN struct critmon_hist_s g_premp_hist[CONFIG_SMP_NCPUS];
+EXTERN struct critmon_hist_s g_crit_hist[CONFIG_SMP_NCPUS];
+EXTERN struct critmon_worst_s
+  g_premp_worst[CONFIG_SMP_NCPUS][CONFIG_SCHED_CRITMONITOR_NWORST];
+EXTERN struct critmon_worst_s
+  g_crit_worst[CONFIG_SMP_NCPUS][CONFIG_SCHED_CRITMONITOR_NWORST];
+#else
+EXTERN struct critmon_hist_s g_premp_hist[1];
+EXTERN struct critmon_hist_s g_crit_hist[1];
+EXTERN struct critmon_worst_s g_premp_worst[1][CONFIG_SCHED_CRITMONITOR_NWORST];
+EXTERN struct critmon_worst_s g_crit_worst[1][CONFIG_SCHED_CRITMONITOR_NWORST];
+#endif
+#endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
 /********************************************************************************
@@ -816,6 +879,14 @@ void sched_foreach(sched_foreach_t handler, FAR void *arg);
 
 FAR struct tcb_s *sched_gettcb(pid_t pid);
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Clear the critical section histograms and the worst offenders of all CPUs
+ * and of all threads.
+ */
+
+void sched_critmon_reset(void);
+#endif
+
 /* File system helpers **********************************************************/
 /* These functions all extract lists from the group structure assocated with the
  * currently executing task.
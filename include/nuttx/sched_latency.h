@@ -0,0 +1,206 @@
+/****************************************************************************
+ * include/nuttx/sched_latency.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SCHED_LATENCY_H
+#define __INCLUDE_NUTTX_SCHED_LATENCY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/sched.h>
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The stages of the path from an interrupt to the woken thread.  The
+ * durations of each stage are accumulated separately.
+ */
+
+enum latency_stage_e
+{
+  LATENCY_IRQ_WAKEUP = 0,  /* Interrupt entry -> thread made ready-to-run */
+  LATENCY_WAKEUP_SWITCH,   /* Ready-to-run -> context switched in */
+  LATENCY_SWITCH_RUN,      /* Context switch -> return from the wait */
+  LATENCY_IRQ_RUN,         /* Interrupt entry -> return from the wait */
+  LATENCY_CYCLIC,          /* Periodic benchmark thread wakeup latency */
+  LATENCY_NSTAGES
+};
+
+/* Statistics of one stage.  All durations are in nanoseconds.  Bucket 0 of
+ * the histogram counts durations below 2 ns, bucket n the durations in
+ * range [2^n, 2^(n+1)) ns; the last bucket also counts all longer
+ * durations.
+ */
+
+struct latency_stat_s
+{
+  uint32_t min;                /* Shortest duration */
+  uint32_t max;                /* Longest duration */
+#ifdef CONFIG_HAVE_LONG_LONG
+  uint64_t sum;                /* Sum of all durations */
+#else
+  uint32_t sum;                /* Sum of all durations */
+#endif
+  uint32_t count;              /* Number of samples */
+  uint32_t hist[CONFIG_SCHED_LATENCY_NBUCKETS];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: sched_latency_irq, sched_latency_wakeup, sched_latency_switch and
+ *       sched_latency_run
+ *
+ * Description:
+ *   Instrumentation hooks along the wakeup path:
+ *
+ *   sched_latency_irq    - Interrupt entry, called from irq_dispatch()
+ *   sched_latency_wakeup - A blocked thread is made ready-to-run
+ *   sched_latency_switch - The thread is about to be switched in
+ *   sched_latency_run    - The thread returns from its wait
+ *
+ * Assumptions:
+ *   Called within a critical section or from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void sched_latency_irq(void);
+void sched_latency_wakeup(FAR struct tcb_s *tcb);
+void sched_latency_switch(FAR struct tcb_s *tcb);
+void sched_latency_run(FAR struct tcb_s *tcb);
+
+/****************************************************************************
+ * Name: sched_latency_snapshot
+ *
+ * Description:
+ *   Copy the statistics of all stages.
+ *
+ * Input Parameters:
+ *   stats - An array of LATENCY_NSTAGES statistics to receive the copy
+ *
+ ****************************************************************************/
+
+void sched_latency_snapshot(FAR struct latency_stat_s *stats);
+
+/****************************************************************************
+ * Name: sched_latency_reset
+ *
+ * Description:
+ *   Clear the statistics of all stages.
+ *
+ ****************************************************************************/
+
+void sched_latency_reset(void);
+
+/****************************************************************************
+ * Name: sched_latency_start
+ *
+ * Description:
+ *   Start the periodic benchmark thread.  Like cyclictest, the thread
+ *   sleeps until an absolute time, one period after the previous one, and
+ *   records how late it actually woke up in the LATENCY_CYCLIC stage.
+ *
+ * Input Parameters:
+ *   period   - The period in microseconds
+ *   priority - The priority of the benchmark thread
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -EBUSY is
+ *   returned if the benchmark is already running and -ENOSYS if
+ *   CONFIG_SCHED_TICKLESS is not selected.
+ *
+ ****************************************************************************/
+
+int sched_latency_start(uint32_t period, int priority);
+
+/****************************************************************************
+ * Name: sched_latency_stop
+ *
+ * Description:
+ *   Request the periodic benchmark thread to stop.  The thread exits after
+ *   its next wakeup.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ESRCH if the benchmark is not running.
+ *
+ ****************************************************************************/
+
+int sched_latency_stop(void);
+
+/****************************************************************************
+ * Name: sched_latency_period
+ *
+ * Description:
+ *   Return the period of the benchmark thread in microseconds, or zero if
+ *   the benchmark is not running.
+ *
+ ****************************************************************************/
+
+uint32_t sched_latency_period(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#else /* CONFIG_SCHED_LATENCY */
+
+#  define sched_latency_irq()
+#  define sched_latency_wakeup(t)
+#  define sched_latency_switch(t)
+#  define sched_latency_run(t)
+
+#endif /* CONFIG_SCHED_LATENCY */
+#endif /* __INCLUDE_NUTTX_SCHED_LATENCY_H */
@@ -66,6 +66,14 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+/* Values for struct note_stream_s */
+
+#define NOTE_STREAM_MAGIC     "NXNT"   /* Stream header magic (4 bytes) */
+#define NOTE_STREAM_VERSION   1        /* Stream header version */
+
+#define NOTE_STREAM_SMP       (1 << 0) /* Notes include nc_cpu */
+#define NOTE_STREAM_BIGENDIAN (1 << 1) /* Pointers in notes are big-endian */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -234,6 +242,23 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+/* The /dev/note driver begins the stream of notes with this header.  It
+ * describes the encoding of the notes that follow so that a host tool
+ * (such as tools/note2json.c) can decode them.  All multi-byte fields are
+ * little-endian.
+ */
+
+struct note_stream_s
+{
+  uint8_t nsh_magic[4];         /* NOTE_STREAM_MAGIC */
+  uint8_t nsh_version;          /* NOTE_STREAM_VERSION */
+  uint8_t nsh_flags;            /* See NOTE_STREAM_* definitions */
+  uint8_t nsh_ncpus;            /* Number of CPUs */
+  uint8_t nsh_ptrsize;          /* Size of a pointer in bytes */
+  uint8_t nsh_tickfs[8];        /* Duration of one timestamp count in
+                                 * femtoseconds */
+};
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
@@ -42,6 +42,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <errno.h>
 #include <semaphore.h>
 
@@ -100,6 +101,27 @@
 #  define _SEM_ERRVAL(r)        (-errno)
 #endif
 
+#ifdef CONFIG_SEM_FASTPATH
+/* Atomic compare-and-exchange used by the semaphore and mutex fast paths.
+ * 'e' points to the expected value.  It is updated with the current value
+ * if the exchange fails.
+ */
+
+#  define SEM_CMPXCHG(p,e,d) \
+     __atomic_compare_exchange_n((p), (e), (d), false, __ATOMIC_ACQ_REL, \
+                                 __ATOMIC_ACQUIRE)
+
+/* A count can only be taken or given on the fast path if the OS need not
+ * record the holder of the count for priority inheritance.
+ */
+
+#  ifdef CONFIG_PRIORITY_INHERITANCE
+#    define SEM_FASTPATH(s)     (((s)->flags & PRIOINHERIT_FLAGS_DISABLE) != 0)
+#  else
+#    define SEM_FASTPATH(s)     true
+#  endif
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -554,6 +576,23 @@ static inline int nxsem_wait_uninterruptible(FAR sem_t *sem)
   return ret;
 }
 
+/****************************************************************************
+ * Name: sem_wait_slow, sem_trywait_slow, and sem_post_slow
+ *
+ * Description:
+ *   With CONFIG_SEM_FASTPATH, sem_wait(), sem_trywait() and sem_post() are
+ *   provided by the C library.  They complete uncontended operations with
+ *   an atomic compare-and-exchange and call these OS interfaces otherwise.
+ *   They have the full semantics of the corresponding POSIX interfaces.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_FASTPATH
+int sem_wait_slow(FAR sem_t *sem);
+int sem_trywait_slow(FAR sem_t *sem);
+int sem_post_slow(FAR sem_t *sem);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -93,6 +93,9 @@
 struct tls_info_s
 {
   uintptr_t tl_elem[CONFIG_TLS_NELEM]; /* TLS elements */
+#ifdef CONFIG_SEM_FASTPATH
+  pid_t tl_pid;                         /* Cached ID of this thread */
+#endif
 };
 
 /****************************************************************************
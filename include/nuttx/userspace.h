@@ -48,6 +48,7 @@
 #include <pthread.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 
 #ifdef CONFIG_BUILD_PROTECTED
 
@@ -133,6 +134,14 @@ struct userspace_s
 #ifdef CONFIG_LIB_USRWORK
   CODE int (*work_usrstart)(void);
 #endif
+
+  /* Shared clock time page.  Lives in user memory and is written only by
+   * the kernel.
+   */
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+  FAR struct clock_timepage_s *us_timepage;
+#endif
 };
 
 /****************************************************************************
@@ -198,6 +198,15 @@
 #define _PTHREAD_MFLAGS_INCONSISTENT  (1 << 1) /* Mutex is in an inconsistent state */
 #define _PTHREAD_MFLAGS_NRECOVERABLE  (1 << 2) /* Inconsistent mutex has been unlocked */
 
+/* Values for struct pthread_mutex_s owner (CONFIG_SEM_FASTPATH).  These are
+ * non-standard and intended only for internal use within the OS and the C
+ * library.  Zero means that the mutex is free.
+ */
+
+#define _PTHREAD_MOWNER_PIDMASK       0x0000ffff /* PID of a fast path holder */
+#define _PTHREAD_MOWNER_LOCKED        (1u << 30) /* Held via the fast path */
+#define _PTHREAD_MOWNER_KERNEL        (1u << 31) /* Managed by the OS semaphore */
+
 /* Definitions to map some non-standard, BSD thread management interfaces to
  * the non-standard Linux-like prctl() interface.  Since these are simple
  * mappings to prctl, they will return 0 on success and -1 on failure with the
@@ -323,6 +332,9 @@ struct pthread_mutex_s
   uint8_t type;     /* Type of the mutex.  See PTHREAD_MUTEX_* definitions */
   int16_t nlocks;   /* The number of recursive locks held */
 #endif
+#ifdef CONFIG_SEM_FASTPATH
+  volatile uint32_t owner; /* Fast path lock word.  See _PTHREAD_MOWNER_* */
+#endif
 };
 
 #ifndef __PTHREAD_MUTEX_T_DEFINED
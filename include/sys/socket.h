@@ -124,6 +124,8 @@
 #define MSG_ERRQUEUE   0x2000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
+#define MSG_WAITFORONE 0x10000 /* recvmmsg(): Block only for the first
+                                * message.  */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -197,6 +199,12 @@
 #define SO_TYPE         15 /* Reports the socket type (get only).
                             * return: int
                             */
+#define SO_REUSEPORT    16 /* Allow multiple sockets to bind to the same
+                            * address and port (get/set).  Currently
+                            * supported only for UDP.
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* Protocol-level socket operations. */
 
@@ -211,7 +219,7 @@
 
 /* Protocol-level socket options may begin with this value */
 
-#define __SO_PROTOCOL  16
+#define __SO_PROTOCOL  17
 
 /* Values for the 'how' argument of shutdown() */
 
@@ -303,6 +311,16 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* Used with recvmmsg() and sendmmsg() to transfer several messages in one
+ * call.
+ */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* Message header */
+  unsigned int msg_len;         /* Number of bytes transferred */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -378,6 +396,12 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+struct timespec;
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -86,10 +86,22 @@
 /* Semaphores */
 
 #define SYS_sem_destroy                (CONFIG_SYS_RESERVED + 15)
-#define SYS_sem_post                   (CONFIG_SYS_RESERVED + 16)
 #define SYS_sem_timedwait              (CONFIG_SYS_RESERVED + 17)
-#define SYS_sem_trywait                (CONFIG_SYS_RESERVED + 18)
-#define SYS_sem_wait                   (CONFIG_SYS_RESERVED + 19)
+
+/* With CONFIG_SEM_FASTPATH, sem_post(), sem_trywait(), and sem_wait() are
+ * provided by the C library and the system calls are only used when the
+ * semaphore is contended.
+ */
+
+#ifdef CONFIG_SEM_FASTPATH
+#  define SYS_sem_post_slow            (CONFIG_SYS_RESERVED + 16)
+#  define SYS_sem_trywait_slow         (CONFIG_SYS_RESERVED + 18)
+#  define SYS_sem_wait_slow            (CONFIG_SYS_RESERVED + 19)
+#else
+#  define SYS_sem_post                 (CONFIG_SYS_RESERVED + 16)
+#  define SYS_sem_trywait              (CONFIG_SYS_RESERVED + 18)
+#  define SYS_sem_wait                 (CONFIG_SYS_RESERVED + 19)
+#endif
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 #  define SYS_sem_setprotocol          (CONFIG_SYS_RESERVED + 20)
@@ -433,8 +445,13 @@
 #  define SYS_pthread_mutex_destroy    (__SYS_pthread + 12)
 #  define SYS_pthread_mutex_init       (__SYS_pthread + 13)
 #  define SYS_pthread_mutex_timedlock  (__SYS_pthread + 14)
+#ifdef CONFIG_SEM_FASTPATH
+#  define SYS_pthread_mutex_trylock_slow (__SYS_pthread + 15)
+#  define SYS_pthread_mutex_unlock_slow (__SYS_pthread + 16)
+#else
 #  define SYS_pthread_mutex_trylock    (__SYS_pthread + 15)
 #  define SYS_pthread_mutex_unlock     (__SYS_pthread + 16)
+#endif
 
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
 #  define SYS_pthread_mutex_consistent (__SYS_pthread + 17)
@@ -529,10 +546,12 @@
 #  define SYS_listen                   (__SYS_network + 6)
 #  define SYS_recv                     (__SYS_network + 7)
 #  define SYS_recvfrom                 (__SYS_network + 8)
-#  define SYS_send                     (__SYS_network + 9)
-#  define SYS_sendto                   (__SYS_network + 10)
-#  define SYS_setsockopt               (__SYS_network + 11)
-#  define SYS_socket                   (__SYS_network + 12)
+#  define SYS_recvmmsg                 (__SYS_network + 9)
+#  define SYS_send                     (__SYS_network + 10)
+#  define SYS_sendmmsg                 (__SYS_network + 11)
+#  define SYS_sendto                   (__SYS_network + 12)
+#  define SYS_setsockopt               (__SYS_network + 13)
+#  define SYS_socket                   (__SYS_network + 14)
 #else
 #  define SYS_socket                    __SYS_network
 #endif
@@ -0,0 +1,267 @@
+/****************************************************************************
+ * include/threadpool.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_THREADPOOL_H
+#define __INCLUDE_THREADPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+
+#ifdef CONFIG_LIB_THREADPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values of struct tpool_work_s state */
+
+#define TPOOL_WORK_IDLE     0  /* Not submitted (or initialized) */
+#define TPOOL_WORK_QUEUED   1  /* Waiting for a worker */
+#define TPOOL_WORK_RUNNING  2  /* Being executed by a worker */
+#define TPOOL_WORK_DONE     3  /* Complete, the result is available */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct tpool_s;       /* Opaque thread pool (forward reference) */
+struct tpool_work_s;  /* Forward reference */
+
+/* The function that performs the work.  Its return value becomes the
+ * result of the work.
+ */
+
+typedef CODE FAR void *(*tpool_func_t)(FAR void *arg);
+
+/* An optional completion function.  It is called by the worker thread
+ * after the work has completed, so it must not block.
+ */
+
+typedef CODE void (*tpool_notify_t)(FAR struct tpool_work_s *work);
+
+/* This structure describes one item of work and its outcome (a "future").
+ * It is allocated by the caller and must remain valid until tpool_wait()
+ * has returned.  The fields are private to the thread pool; use
+ * tpool_work_init() to set them up.
+ */
+
+struct tpool_work_s
+{
+  tpool_func_t func;          /* Work function */
+  FAR void *arg;              /* Argument passed to the work function */
+  tpool_notify_t notify;      /* Completion function (may be NULL) */
+  FAR void *result;           /* Value returned by the work function */
+  FAR struct tpool_s *pool;   /* The pool the work was submitted to */
+  volatile uint8_t state;     /* See TPOOL_WORK_* definitions */
+  sem_t done;                 /* Posted when the work completes */
+};
+
+/* Thread pool creation attributes */
+
+struct tpool_attr_s
+{
+  uint8_t nworkers;           /* Number of worker threads */
+  uint8_t priority;           /* Priority of the worker threads */
+  size_t stacksize;           /* Stack size of each worker thread */
+#ifdef CONFIG_SMP
+  cpu_set_t affinity;         /* CPUs to distribute the workers over */
+#endif
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: tpool_attr_init
+ *
+ * Description:
+ *   Initialize thread pool attributes to the configured defaults.  In SMP
+ *   configurations, the default affinity is zero:  The workers are not
+ *   pinned.
+ *
+ * Input Parameters:
+ *   attr - The attributes to be initialized
+ *
+ * Returned Value:
+ *   Zero (OK) on success; an errno value on failure.
+ *
+ ****************************************************************************/
+
+int tpool_attr_init(FAR struct tpool_attr_s *attr);
+
+/****************************************************************************
+ * Name: tpool_create
+ *
+ * Description:
+ *   Create a thread pool and start its worker threads.  If a CPU affinity
+ *   set is given, the workers are pinned round-robin to one CPU of that
+ *   set each.
+ *
+ * Input Parameters:
+ *   pool - The location to return the new thread pool
+ *   attr - Creation attributes.  NULL selects the defaults.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; an errno value on failure.
+ *
+ ****************************************************************************/
+
+int tpool_create(FAR struct tpool_s **pool,
+                 FAR const struct tpool_attr_s *attr);
+
+/****************************************************************************
+ * Name: tpool_destroy
+ *
+ * Description:
+ *   Stop the worker threads after all submitted work has completed and
+ *   free the thread pool.  No work may be submitted once this has been
+ *   called.
+ *
+ * Input Parameters:
+ *   pool - The thread pool to be destroyed
+ *
+ * Returned Value:
+ *   Zero (OK) on success; an errno value on failure.
+ *
+ ****************************************************************************/
+
+int tpool_destroy(FAR struct tpool_s *pool);
+
+/****************************************************************************
+ * Name: tpool_work_init
+ *
+ * Description:
+ *   Prepare a work structure for submission.
+ *
+ * Input Parameters:
+ *   work   - The work structure to be initialized
+ *   func   - The function that performs the work
+ *   arg    - The argument passed to func
+ *   notify - An optional completion function (may be NULL)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void tpool_work_init(FAR struct tpool_work_s *work, tpool_func_t func,
+                     FAR void *arg, tpool_notify_t notify);
+
+/****************************************************************************
+ * Name: tpool_submit
+ *
+ * Description:
+ *   Queue work for execution by the thread pool.  Work submitted by one of
+ *   the pool's own workers is placed on that worker's deque, where other
+ *   workers may steal it.  Other work is placed on the shared queue.
+ *
+ *   Every successful submission must be matched by exactly one call to
+ *   tpool_wait() before the work structure is re-used or freed.
+ *
+ * Input Parameters:
+ *   pool - The thread pool
+ *   work - The initialized work structure
+ *
+ * Returned Value:
+ *   Zero (OK) on success; an errno value on failure:
+ *
+ *   EBUSY  - The work is already queued or running
+ *   EAGAIN - The queues of the thread pool are full
+ *
+ ****************************************************************************/
+
+int tpool_submit(FAR struct tpool_s *pool, FAR struct tpool_work_s *work);
+
+/****************************************************************************
+ * Name: tpool_wait
+ *
+ * Description:
+ *   Wait for submitted work to complete and return its result.  When
+ *   called from one of the pool's worker threads, the caller executes
+ *   other queued work while it waits so that nested parallel work cannot
+ *   deadlock the pool.
+ *
+ * Input Parameters:
+ *   work   - The submitted work
+ *   result - The location to return the result of the work (may be NULL)
+ *
+ * Returned Value:
+ *   Zero (OK) on success; an errno value on failure.
+ *
+ ****************************************************************************/
+
+int tpool_wait(FAR struct tpool_work_s *work, FAR void **result);
+
+/****************************************************************************
+ * Name: tpool_done
+ *
+ * Description:
+ *   Check without blocking whether submitted work has completed.
+ *   tpool_wait() must still be called before the work is re-used.
+ *
+ * Input Parameters:
+ *   work - The submitted work
+ *
+ * Returned Value:
+ *   true if the work has completed.
+ *
+ ****************************************************************************/
+
+bool tpool_done(FAR struct tpool_work_s *work);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_LIB_THREADPOOL */
+#endif /* __INCLUDE_THREADPOOL_H */
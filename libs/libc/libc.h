@@ -222,6 +222,12 @@ double lib_expi(size_t n);
 float lib_sqrtapprox(float x);
 #endif
 
+/* Defined in pthread_mutex_getpid.c */
+
+#ifdef CONFIG_SEM_FASTPATH
+pid_t lib_mutex_getpid(void);
+#endif
+
 /* Defined in lib_parsehostfile.c */
 
 #ifdef CONFIG_NETDB_HOSTFILE
@@ -0,0 +1,240 @@
+/****************************************************************************
+ * libs/libc/math/__exp.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+#ifdef CONFIG_HAVE_DOUBLE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define EXP_TABLE_BITS 6
+#define EXP_TABLE_SIZE (1 << EXP_TABLE_BITS)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const double g_o_threshold =  7.09782712893383973096e+02; /* 0x40862e42fefa39ef */
+static const double g_u_threshold = -7.45133219101941108420e+02; /* 0xc0874910d52d3051 */
+
+/* Cody-Waite reduction constants:  ln2/64 is split so that k * g_ln2n_hi
+ * is exact for any k in the non-overflowing range.
+ */
+
+static const double g_invln2n = 9.23324826168936567683e+01; /* 0x40571547652b82fe */
+static const double g_ln2n_hi = 1.08304246962234174134e-02; /* 0x3f862e42fefa0000 */
+static const double g_ln2n_lo = 2.57280462232766910762e-14; /* 0x3d1cf79abc9e3b3a */
+
+/* 2^(j/64) as the sum of two doubles */
+
+static const double g_exp2_tbl[EXP_TABLE_SIZE][2] =
+{
+  { 1.0000000000000000e+00,  0.0000000000000000e+00 },
+  { 1.0108892860517005e+00, -1.5234778603368577e-17 },
+  { 1.0218971486541166e+00,  5.1092250289734439e-17 },
+  { 1.0330248790212284e+00,  7.6008388740270885e-18 },
+  { 1.0442737824274138e+00,  8.5518897055379649e-17 },
+  { 1.0556451783605572e+00,  1.7593257387720920e-18 },
+  { 1.0671404006768237e+00, -7.8998539668415821e-17 },
+  { 1.0787607977571199e+00, -6.6566604360565926e-17 },
+  { 1.0905077326652577e+00, -3.0467820798124711e-17 },
+  { 1.1023825833078409e+00,  5.2660368715706944e-17 },
+  { 1.1143867425958924e+00,  1.0410278456845571e-16 },
+  { 1.1265216186082418e+00,  5.1658567587954567e-17 },
+  { 1.1387886347566916e+00,  8.9128126760254078e-17 },
+  { 1.1511892299529827e+00,  3.2507102188638272e-17 },
+  { 1.1637248587775775e+00,  3.8292048369240935e-17 },
+  { 1.1763969916502812e+00,  5.5542032542180790e-17 },
+  { 1.1892071150027210e+00,  3.9820152314656461e-17 },
+  { 1.2021567314527031e+00,  6.6449814992523012e-17 },
+  { 1.2152473599804690e+00, -7.7126306926814881e-17 },
+  { 1.2284805361068700e+00, -1.8987816313025300e-17 },
+  { 1.2418578120734840e+00,  4.6580275918369368e-17 },
+  { 1.2553807570246911e+00, -6.7113898212968784e-18 },
+  { 1.2690509571917332e+00,  2.6679321313421861e-18 },
+  { 1.2828700160787783e+00,  1.7135949182435610e-17 },
+  { 1.2968395546510096e+00,  2.5382502794888315e-17 },
+  { 1.3109612115247644e+00, -7.1815361355194539e-17 },
+  { 1.3252366431597413e+00, -2.8587312100388614e-17 },
+  { 1.3396675240533029e+00,  8.9272825948317320e-17 },
+  { 1.3542555469368927e+00,  7.7009483798029895e-17 },
+  { 1.3690024229745905e+00,  9.5937979191188488e-17 },
+  { 1.3839098819638320e+00, -6.7705116587947863e-17 },
+  { 1.3989796725383112e+00, -9.6142132090513231e-17 },
+  { 1.4142135623730951e+00, -9.6672933134529135e-17 },
+  { 1.4296133383919700e+00, -1.2031642489053655e-17 },
+  { 1.4451808069770467e+00, -3.0237581349939873e-17 },
+  { 1.4609177941806470e+00, -5.6003771860752158e-17 },
+  { 1.4768261459394993e+00, -3.4839945568927958e-17 },
+  { 1.4929077282912648e+00,  1.4192920154284036e-17 },
+  { 1.5091644275934228e+00, -1.0164553277542950e-16 },
+  { 1.5255981507445384e+00, -1.1024941712342561e-16 },
+  { 1.5422108254079407e+00,  7.9498348096976209e-17 },
+  { 1.5590044002378369e+00,  3.7812070533575275e-17 },
+  { 1.5759808451078865e+00, -1.0136916471278304e-17 },
+  { 1.5931421513422670e+00, -1.0094406542311964e-16 },
+  { 1.6104903319492543e+00,  2.4707192569797888e-17 },
+  { 1.6280274218573478e+00, -6.7129550847070841e-17 },
+  { 1.6457554781539649e+00, -1.0125679913674773e-16 },
+  { 1.6636765803267364e+00,  5.8909926967130997e-17 },
+  { 1.6817928305074290e+00,  8.1990100205814965e-17 },
+  { 1.7001063537185235e+00, -8.0237193703977002e-18 },
+  { 1.7186192981224779e+00, -1.8513804182631110e-17 },
+  { 1.7373338352737062e+00,  3.1643892992929569e-17 },
+  { 1.7562521603732995e+00,  2.9601406954488733e-17 },
+  { 1.7753764925265212e+00,  6.4297317965565720e-17 },
+  { 1.7947090750031072e+00,  1.8227458427912087e-17 },
+  { 1.8142521755003989e+00, -9.9695315389203488e-17 },
+  { 1.8340080864093424e+00,  3.2831072242456272e-17 },
+  { 1.8539791250833855e+00,  9.7618874907275935e-17 },
+  { 1.8741676341103000e+00, -6.1227634130041426e-17 },
+  { 1.8945759815869656e+00,  3.4034035352165297e-17 },
+  { 1.9152065613971474e+00, -1.0619946056195963e-16 },
+  { 1.9360617934922943e+00,  1.0332385960676326e-16 },
+  { 1.9571441241754002e+00,  8.9607677910366678e-17 },
+  { 1.9784560263879509e+00,  4.0388753109278167e-17 }
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __exp
+ *
+ * Description:
+ *   Kernel exponential function:  return exp(x + xtail), where xtail is
+ *   small compared to x.  The tail lets pow() pass y * log(x) with more
+ *   than double precision.
+ *
+ *   x = (64 * k + j) * ln2/64 + r with |r| <= ln2/128, so that
+ *   exp(x) = 2^k * 2^(j/64) * exp(r).  exp(r) - 1 is a degree 6 Taylor
+ *   polynomial, good to 2^-65 on that interval.
+ *
+ ****************************************************************************/
+
+double __exp(double x, double xtail)
+{
+  union
+  {
+    double f;
+    uint64_t i;
+  } u =
+  {
+    x
+  };
+
+  uint32_t hx = (uint32_t)(u.i >> 32) & 0x7fffffff;
+  double kd;
+  double r;
+  double r2;
+  double p;
+  double y;
+  int k;
+  int j;
+
+  if (hx >= 0x40862e42)
+    {
+      /* |x| >= 709.78 */
+
+      if (hx >= 0x7ff00000)
+        {
+          /* exp(NaN) = NaN, exp(+Inf) = +Inf, exp(-Inf) = 0 */
+
+          return (u.i >> 63) != 0 && (u.i << 12) == 0 ? 0.0 : x + x;
+        }
+
+      if (x > g_o_threshold)
+        {
+          return INFINITY;
+        }
+
+      if (x < g_u_threshold)
+        {
+          return 0.0;
+        }
+    }
+
+  if (hx < 0x3c900000)
+    {
+      /* |x| < 2^-54 */
+
+      return 1.0 + (x + xtail);
+    }
+
+  /* Round x * 64/ln2 to the nearest integer; kd * g_ln2n_hi is exact */
+
+  kd = x * g_invln2n + 0x1.8p52;
+  kd = kd - 0x1.8p52;
+  k  = (int)kd;
+  j  = k & (EXP_TABLE_SIZE - 1);
+  k  = (k - j) / EXP_TABLE_SIZE;
+
+  r  = (x - kd * g_ln2n_hi) - (kd * g_ln2n_lo - xtail);
+  r2 = r * r;
+  p  = r + r2 * (0.5 + r * (1.0 / 6.0 + r * (1.0 / 24.0 + r *
+       (1.0 / 120.0 + r * (1.0 / 720.0)))));
+
+  y  = g_exp2_tbl[j][0] + (g_exp2_tbl[j][1] + g_exp2_tbl[j][0] * p);
+
+  /* Scale by 2^k, in two steps near the ends of the exponent range */
+
+  if (k >= -1021)
+    {
+      if (k == 1024)
+        {
+          return y * 2.0 * 0x1p1023;
+        }
+
+      u.f  = y;
+      u.i += (uint64_t)k << 52;
+      return u.f;
+    }
+
+  u.f  = y;
+  u.i += (uint64_t)(k + 1000) << 52;
+  return u.f * 0x1p-1000;
+}
+#endif
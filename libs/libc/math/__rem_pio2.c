@@ -0,0 +1,353 @@
+/****************************************************************************
+ * libs/libc/math/__rem_pio2.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+#ifdef CONFIG_HAVE_DOUBLE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* High word of |x| below which (2^20 * pi/2) Cody-Waite reduction is used */
+
+#define MEDIUM_BOUND 0x413921fb
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* pi/2 split into three 33-bit parts and the remaining tails */
+
+static const double g_invpio2 = 6.36619772367581382433e-01; /* 0x3fe45f306dc9c883 */
+static const double g_pio2_1  = 1.57079632673412561417e+00; /* 0x3ff921fb54400000 */
+static const double g_pio2_1t = 6.07710050650619224932e-11; /* 0x3dd0b4611a626331 */
+static const double g_pio2_2  = 6.07710050630396597660e-11; /* 0x3dd0b4611a600000 */
+static const double g_pio2_2t = 2.02226624879595063154e-21; /* 0x3ba3198a2e037073 */
+static const double g_pio2_3  = 2.02226624871116645580e-21; /* 0x3ba3198a2e000000 */
+static const double g_pio2_3t = 8.47842766036889956997e-32; /* 0x397b839a252049c1 */
+
+/* pi/2 split into three 29-bit parts for the large reduction */
+
+static const double g_pio2_29[3] =
+{
+  1.57079632580280303955e+00,   /* 0x3ff921fb54000000 */
+  9.92093577428798667484e-10,   /* 0x3e110b4611000000 */
+  2.25174177063465778611e-18    /* 0x3c44c4c662000000 */
+};
+
+/* The bits of 2/pi, preceded by two zero words so that exponents just
+ * above MEDIUM_BOUND can be indexed too.
+ */
+
+static const uint32_t g_two_over_pi[] =
+{
+  0x00000000, 0x00000000,
+  0xa2f9836e, 0x4e441529, 0xfc2757d1, 0xf534ddc0,
+  0xdb629599, 0x3c439041, 0xfe5163ab, 0xdebbc561,
+  0xb7246e3a, 0x424dd2e0, 0x06492eea, 0x09d1921c,
+  0xfe1deb1c, 0xb129a73e, 0xe88235f5, 0x2ebb4484,
+  0xe99c7026, 0xb45f7e41, 0x3991d639, 0x835339f4,
+  0x9c845f8b, 0xbdf9283b, 0x1ff897ff, 0xde05980f,
+  0xef2f118b, 0x5a0a6d1f, 0x6d367ecf, 0x27cb09b7,
+  0x4f463f66, 0x9e5fea2d, 0x7527bac7, 0xebe5f17b,
+  0x3d0739f7, 0x8a5292ea, 0x6bfb5fb1, 0x1f8d5d08,
+  0x56033046, 0xfc7b6bab
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rem_pio2_large
+ *
+ * Description:
+ *   Payne-Hanek reduction for large |x|.  x = m * 2^(e-52) with a 53-bit
+ *   integer m.  A 192-bit window of 2/pi is selected so that bits of lower
+ *   weight only contribute multiples of 4 to x * 2/pi and the product is
+ *   formed modulo 2^192 in 32-bit limbs.  This leaves more than 120
+ *   significant bits after the worst case cancellation of a double.  The
+ *   top 72 bits of the remainder are then multiplied by pi/2 in 24x29 bit
+ *   pieces, which are exact.
+ *
+ ****************************************************************************/
+
+static int rem_pio2_large(uint64_t ix, FAR double *y)
+{
+  union
+  {
+    double f;
+    uint64_t i;
+  } scale;
+
+  uint32_t wl[6];
+  uint32_t z[6];
+  uint32_t m0;
+  uint32_t m1;
+  uint32_t n;
+  uint64_t t;
+  double f0;
+  double f1;
+  double f2;
+  double t0;
+  double s;
+  int neg;
+  int pos;
+  int sh;
+  int i;
+  int j;
+
+  /* The first bit of 2/pi that is needed, counting the leading zero
+   * words.
+   */
+
+  pos = (int)(ix >> 52) - 1076 - 1 + 64;
+  i   = pos >> 5;
+  sh  = pos & 31;
+
+  for (j = 0; j < 6; j++)
+    {
+      wl[5 - j] = g_two_over_pi[i + j];
+      if (sh != 0)
+        {
+          wl[5 - j] = (wl[5 - j] << sh) |
+                      (g_two_over_pi[i + j + 1] >> (32 - sh));
+        }
+    }
+
+  t  = (ix & 0x000fffffffffffffull) | 0x0010000000000000ull;
+  m0 = (uint32_t)t;
+  m1 = (uint32_t)(t >> 32);
+
+  /* z = m * w mod 2^192:  x * 2/pi mod 4 with 190 fraction bits */
+
+  t = 0;
+  for (j = 0; j < 6; j++)
+    {
+      t   += (uint64_t)m0 * wl[j];
+      z[j] = (uint32_t)t;
+      t  >>= 32;
+    }
+
+  t = 0;
+  for (j = 0; j < 5; j++)
+    {
+      t       += (uint64_t)m1 * wl[j] + z[j + 1];
+      z[j + 1] = (uint32_t)t;
+      t      >>= 32;
+    }
+
+  /* Round to the nearest quadrant, leaving a signed remainder */
+
+  n     = (z[5] + ((uint32_t)1 << 29)) >> 30;
+  z[5] -= n << 30;
+  neg   = z[5] >> 31;
+
+  if (neg)
+    {
+      t = 1;
+      for (j = 0; j < 6; j++)
+        {
+          t   += (uint32_t)~z[j];
+          z[j] = (uint32_t)t;
+          t  >>= 32;
+        }
+    }
+
+  /* Normalize so that the top bit of z[5] is set */
+
+  sh = 0;
+  while (z[5] == 0)
+    {
+      for (j = 5; j > 0; j--)
+        {
+          z[j] = z[j - 1];
+        }
+
+      z[0] = 0;
+      sh  += 32;
+    }
+
+  i = 0;
+  while ((z[5] << i) < 0x80000000u)
+    {
+      i++;
+    }
+
+  if (i != 0)
+    {
+      for (j = 5; j > 0; j--)
+        {
+          z[j] = (z[j] << i) | (z[j - 1] >> (32 - i));
+        }
+
+      z[0] <<= i;
+      sh    += i;
+    }
+
+  /* The top 72 bits in three 24-bit pieces; their unit is 2^-(70 + sh)
+   * quadrants.
+   */
+
+  scale.i = (uint64_t)(1023 - 70 - sh) << 52;
+
+  f0 = (double)(z[5] >> 8) * scale.f * 0x1p48;
+  f1 = (double)(((z[5] & 0xff) << 16) | (z[4] >> 16)) * scale.f * 0x1p24;
+  f2 = (double)(((z[4] & 0xffff) << 8) | (z[3] >> 24)) * scale.f;
+
+  t0 = f0 * g_pio2_29[0];
+  s  = f0 * g_pio2_29[1] + f1 * g_pio2_29[0];
+  s += (f0 * g_pio2_29[2] + f1 * g_pio2_29[1] + f2 * g_pio2_29[0]) +
+       (f1 * g_pio2_29[2] + f2 * g_pio2_29[1]);
+
+  y[0] = t0 + s;
+  y[1] = (t0 - y[0]) + s;
+
+  if (neg)
+    {
+      y[0] = -y[0];
+      y[1] = -y[1];
+    }
+
+  return (int)(n & 3);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __rem_pio2
+ *
+ * Description:
+ *   Return x mod pi/2 as y[0] + y[1] and the quadrant n, so that
+ *   x ~= n * pi/2 + y[0] + y[1]; only the two low bits of n are
+ *   significant.  Cody-Waite reduction in up to three rounds is used below
+ *   2^20 * pi/2 and Payne-Hanek reduction above.
+ *
+ ****************************************************************************/
+
+int __rem_pio2(double x, FAR double *y)
+{
+  union
+  {
+    double f;
+    uint64_t i;
+  } u =
+  {
+    x
+  };
+
+  uint64_t ix = u.i & 0x7fffffffffffffffull;
+  uint32_t hx = (uint32_t)(ix >> 32);
+  double fn;
+  double r;
+  double t;
+  double w;
+  int ex;
+  int n;
+
+  if (hx < MEDIUM_BOUND)
+    {
+      /* Round x * 2/pi to the nearest integer */
+
+      fn = x * g_invpio2 + 0x1.8p52;
+      fn = fn - 0x1.8p52;
+      n  = (int)fn;
+
+      /* The first round is good to 85 bits */
+
+      r    = x - fn * g_pio2_1;
+      w    = fn * g_pio2_1t;
+      y[0] = r - w;
+      u.f  = y[0];
+      ex   = (int)(hx >> 20);
+
+      if (ex - (int)((u.i >> 52) & 0x7ff) > 16)
+        {
+          /* Too much cancellation: second round, good to 118 bits */
+
+          t    = r;
+          w    = fn * g_pio2_2;
+          r    = t - w;
+          w    = fn * g_pio2_2t - ((t - r) - w);
+          y[0] = r - w;
+          u.f  = y[0];
+
+          if (ex - (int)((u.i >> 52) & 0x7ff) > 49)
+            {
+              /* Third round, good to 151 bits */
+
+              t    = r;
+              w    = fn * g_pio2_3;
+              r    = t - w;
+              w    = fn * g_pio2_3t - ((t - r) - w);
+              y[0] = r - w;
+            }
+        }
+
+      y[1] = (r - y[0]) - w;
+      return n;
+    }
+
+  if (hx >= 0x7ff00000)
+    {
+      /* Inf or NaN */
+
+      y[0] = x - x;
+      y[1] = y[0];
+      return 0;
+    }
+
+  n = rem_pio2_large(ix, y);
+  if (u.i >> 63)
+    {
+      y[0] = -y[0];
+      y[1] = -y[1];
+      return -n;
+    }
+
+  return n;
+}
+#endif
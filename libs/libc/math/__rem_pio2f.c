@@ -0,0 +1,263 @@
+/****************************************************************************
+ * libs/libc/math/__rem_pio2f.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* |x| below this bound (2^7 * pi/2) uses Cody-Waite reduction.  Above it
+ * the remainder can come close enough to zero that the rounding of
+ * n * pi/2 in float shows, so the integer reduction is used instead.
+ */
+
+#define MEDIUM_BOUND 0x43490fdb
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* pi/2 split into three 8-bit parts, so that n * g_pio2_n is exact, and
+ * the remaining tail.
+ */
+
+static const float g_invpio2 = 6.366197467e-01F; /* 0x3f22f983 */
+static const float g_pio2_1  = 1.570312500e+00F; /* 0x3fc90000 */
+static const float g_pio2_2  = 4.825592041e-04F; /* 0x39fd0000 */
+static const float g_pio2_3  = 1.266598701e-06F; /* 0x35aa0000 */
+static const float g_pio2_3t = 9.920936295e-10F; /* 0x30885a31 */
+
+/* pi/2 * 2^31 */
+
+#define PIO2_Q31 0xc90fdaa2u
+
+/* The bits of 2/pi, preceded by one zero word so that exponents below the
+ * large reduction bound can be indexed too.
+ */
+
+static const uint32_t g_two_over_pi[] =
+{
+  0x00000000, 0xa2f9836e, 0x4e441529, 0xfc2757d1,
+  0xf534ddc0, 0xdb629599, 0x3c439041, 0xfe5163ab
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rem_pio2f_large
+ *
+ * Description:
+ *   Payne-Hanek reduction for large |x|.  x = m * 2^(e-23) with a 24-bit
+ *   integer m.  Only the 96 bits of 2/pi that affect x * 2/pi mod 4 are
+ *   used, so the reduction is done with three 32x32->64 bit multiplies.
+ *   The remainder is multiplied by pi/2 in fixed point, too.
+ *
+ ****************************************************************************/
+
+static int rem_pio2f_large(uint32_t ix, FAR float *y)
+{
+  union
+  {
+    float f;
+    uint32_t i;
+  } scale;
+
+  uint32_t w0;
+  uint32_t w1;
+  uint32_t w2;
+  uint32_t m;
+  uint64_t res;
+  uint64_t a;
+  uint64_t n;
+  int64_t r;
+  float hi;
+  int pos;
+  int sh;
+  int i;
+
+  /* Bit position in g_two_over_pi of the first bit that contributes to
+   * x * 2/pi mod 4:  bits of lower weight make a multiple of 4.
+   */
+
+  pos = (int)(ix >> 23) - 127 + 7;
+  i   = pos >> 5;
+  sh  = pos & 31;
+
+  if (sh == 0)
+    {
+      w0 = g_two_over_pi[i];
+      w1 = g_two_over_pi[i + 1];
+      w2 = g_two_over_pi[i + 2];
+    }
+  else
+    {
+      w0 = (g_two_over_pi[i] << sh)     | (g_two_over_pi[i + 1] >> (32 - sh));
+      w1 = (g_two_over_pi[i + 1] << sh) | (g_two_over_pi[i + 2] >> (32 - sh));
+      w2 = (g_two_over_pi[i + 2] << sh) | (g_two_over_pi[i + 3] >> (32 - sh));
+    }
+
+  m = (ix & 0x007fffff) | 0x00800000;
+
+  /* res holds x * 2/pi mod 4 with 62 fraction bits */
+
+  res = ((uint64_t)(m * w0) << 32) + (uint64_t)m * w1 +
+        (((uint64_t)m * w2) >> 32);
+
+  /* Round to the nearest quadrant, leaving |r| <= 2^61 */
+
+  n    = (res + ((uint64_t)1 << 61)) >> 62;
+  r    = (int64_t)(res - (n << 62));
+  a    = r < 0 ? -(uint64_t)r : (uint64_t)r;
+
+  /* Normalize the remainder to 63 bits and multiply it by pi/2 */
+
+  sh = 0;
+  if (a != 0)
+    {
+      while (a < ((uint64_t)1 << 62))
+        {
+          a <<= 1;
+          sh++;
+        }
+    }
+
+  a = (a >> 32) * PIO2_Q31 + (((a & 0xffffffff) * PIO2_Q31) >> 32);
+
+  /* Scale by 2^-(61 + sh); the result cannot be subnormal */
+
+  scale.i = (uint32_t)(127 - 61 - sh) << 23;
+  hi      = (float)(int64_t)a;
+  y[0]    = hi * scale.f;
+  y[1]    = (float)((int64_t)a - (int64_t)hi) * scale.f;
+
+  if (r < 0)
+    {
+      y[0] = -y[0];
+      y[1] = -y[1];
+    }
+
+  return (int)n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __rem_pio2f
+ *
+ * Description:
+ *   Return x mod pi/2 as y[0] + y[1] and the quadrant n, so that
+ *   x ~= n * pi/2 + y[0] + y[1]; only the two low bits of n are
+ *   significant.  This is the float counterpart of __rem_pio2().
+ *   Cody-Waite reduction with a three-part pi/2 is used for moderate
+ *   arguments and Payne-Hanek reduction above 2^7 * pi/2.
+ *
+ ****************************************************************************/
+
+int __rem_pio2f(float x, FAR float *y)
+{
+  union
+  {
+    float f;
+    uint32_t i;
+  } u =
+  {
+    x
+  };
+
+  uint32_t ix = u.i & 0x7fffffff;
+  float fn;
+  float hi;
+  float lo;
+  float r;
+  float t;
+  float w;
+  int n;
+
+  if (ix < MEDIUM_BOUND)
+    {
+      /* Round x * 2/pi to the nearest integer */
+
+      fn = x * g_invpio2 + 0x1.8p23F;
+      fn = fn - 0x1.8p23F;
+      n  = (int)fn;
+
+      /* The first two steps are exact.  The third is done with an exact
+       * two-sum, so that cancellation leaves a correct tail.
+       */
+
+      r  = x - fn * g_pio2_1;
+      r  = r - fn * g_pio2_2;
+      w  = fn * g_pio2_3;
+      hi = r - w;
+      t  = hi - r;
+      lo = ((r - (hi - t)) - (w + t)) - fn * g_pio2_3t;
+
+      y[0] = hi + lo;
+      y[1] = (hi - y[0]) + lo;
+      return n;
+    }
+
+  if (ix >= 0x7f800000)
+    {
+      /* Inf or NaN */
+
+      y[0] = x - x;
+      y[1] = y[0];
+      return 0;
+    }
+
+  n = rem_pio2f_large(ix, y);
+  if (u.i >> 31)
+    {
+      y[0] = -y[0];
+      y[1] = -y[1];
+      return -n;
+    }
+
+  return n;
+}
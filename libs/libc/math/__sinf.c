@@ -0,0 +1,107 @@
+/****************************************************************************
+ * libs/libc/math/__sinf.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Minimax approximation of (sin(x) - x) / x^3 as a polynomial in x^2 on
+ * [-pi/4, pi/4].  Relative error of the result < 2^-27.
+ */
+
+static const float g_s1 = -1.666665524e-01F;
+static const float g_s2 =  8.332160302e-03F;
+static const float g_s3 = -1.951528247e-04F;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __sinf
+ *
+ * Description:
+ *   Kernel sine function on [-pi/4, pi/4], the float counterpart of
+ *   __sin().  y is the tail of x; if iy is zero, y is assumed to be zero.
+ *
+ ****************************************************************************/
+
+float __sinf(float x, float y, int iy)
+{
+  union
+  {
+    float f;
+    uint32_t i;
+  } u =
+  {
+    x
+  };
+
+  float z;
+  float v;
+  float r;
+
+  /* sin(x) rounds to x for |x| < 2^-12.  Return x itself so that the sign
+   * of zero is preserved.
+   */
+
+  if ((u.i & 0x7fffffff) < 0x39800000)
+    {
+      return x;
+    }
+
+  z = x * x;
+  v = z * x;
+  r = g_s2 + z * g_s3;
+
+  if (iy == 0)
+    {
+      return x + v * (g_s1 + z * r);
+    }
+  else
+    {
+      return x - ((z * (0.5F * y - v * r) - y) - v * g_s1);
+    }
+}
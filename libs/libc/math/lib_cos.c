@@ -32,15 +32,58 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdint.h>
 #include <math.h>
 
+#ifdef CONFIG_HAVE_DOUBLE
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
-#ifdef CONFIG_HAVE_DOUBLE
 double cos(double x)
 {
-  return sin(x + M_PI_2);
+  union
+  {
+    double f;
+    uint64_t i;
+  } u =
+  {
+    x
+  };
+
+  uint32_t ix = (uint32_t)(u.i >> 32) & 0x7fffffff;
+  double y[2];
+  int n;
+
+  /* No reduction is needed for |x| <= pi/4 */
+
+  if (ix <= 0x3fe921fb)
+    {
+      if (ix < 0x3e46a09e)
+        {
+          /* |x| < 2^-27 * sqrt(2):  cos(x) rounds to 1 */
+
+          return 1.0;
+        }
+
+      return __cos(x, 0.0);
+    }
+
+  n = __rem_pio2(x, y);
+  switch (n & 3)
+    {
+      case 0:
+        return __cos(y[0], y[1]);
+
+      case 1:
+        return -__sin(y[0], y[1], 1);
+
+      case 2:
+        return -__cos(y[0], y[1]);
+
+      default:
+        return __sin(y[0], y[1], 1);
+    }
 }
 #endif
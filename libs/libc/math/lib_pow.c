@@ -32,15 +32,446 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdint.h>
 #include <math.h>
 
+#ifdef CONFIG_HAVE_DOUBLE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* log(x) uses a table of 128 subintervals of [OFF, 2 * OFF).  OFF is
+ * chosen so that 1.0 is the center of one of them.
+ */
+
+#define POW_LOG_TABLE_BITS 7
+#define POW_LOG_TABLE_SIZE (1 << POW_LOG_TABLE_BITS)
+#define POW_LOG_OFF        0x3fe6100000000000ull
+
+/* Keep the 26 most significant bits of a double */
+
+#define POW_HI26_MASK      0xfffffffff8000000ull
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct pow_log_s
+{
+  double invc;     /* 1/c with 13 fraction bits, exactly 1.0 near 1.0 */
+  double logc_hi;  /* -log(invc) rounded */
+  double logc_lo;  /* -log(invc) - logc_hi */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* ln2 split so that k * g_ln2_hi is exact for any exponent k */
+
+static const double g_ln2_hi = 6.93147180559890330187e-01; /* 0x3fe62e42fefa3800 */
+static const double g_ln2_lo = 5.49792301870837115524e-14; /* 0x3d2ef35793c76730 */
+
+static const struct pow_log_s g_pow_log_tbl[POW_LOG_TABLE_SIZE] =
+{
+  { 1.4462890625000000e+00, -3.6900100866834568e-01, -1.2517854846245798e-17 },
+  { 1.4382324218750000e+00, -3.6341487480234363e-01,  9.0485349203066173e-18 },
+  { 1.4301757812500000e+00, -3.5779736066833506e-01, -1.1783449666483858e-17 },
+  { 1.4222412109375000e+00, -3.5223394494065208e-01, -2.1906139979618210e-17 },
+  { 1.4143066406250000e+00, -3.4663940437728041e-01, -6.7043266052609076e-18 },
+  { 1.4066162109375000e+00, -3.4118696973472545e-01, -1.3286563887652647e-17 },
+  { 1.3989257812500000e+00, -3.3570464298944153e-01, -8.9990352643186788e-18 },
+  { 1.3913574218750000e+00, -3.3027983311565584e-01, -7.1460160029259208e-18 },
+  { 1.3837890625000000e+00, -3.2482543409122733e-01, -1.4787408474824705e-17 },
+  { 1.3763427734375000e+00, -3.1942981709159007e-01, -1.0651360711400322e-18 },
+  { 1.3690185546875000e+00, -3.1409409967501967e-01, -3.0529856423663770e-18 },
+  { 1.3616943359375000e+00, -3.0872975958734389e-01,  2.3138347996800640e-17 },
+  { 1.3544921875000000e+00, -3.0342661471537852e-01,  2.2655028556910697e-17 },
+  { 1.3474121093750000e+00, -2.9818579672015755e-01, -2.1837099474837049e-17 },
+  { 1.3403320312500000e+00, -2.9291736778423261e-01,  4.7886356029061583e-18 },
+  { 1.3333740234375000e+00, -2.8771258956425411e-01, -7.3510539466638865e-18 },
+  { 1.3264160156250000e+00, -2.8248057983217933e-01, -2.5505772773184581e-17 },
+  { 1.3195800781250000e+00, -2.7731356335396495e-01,  1.4384445967487669e-17 },
+  { 1.3128662109375000e+00, -2.7221269442254142e-01,  2.1636345691773782e-17 },
+  { 1.3061523437500000e+00, -2.6708567317070853e-01,  7.3975237397911735e-18 },
+  { 1.2994384765625000e+00, -2.6193223004829080e-01, -1.8967251639361108e-17 },
+  { 1.2929687500000000e+00, -2.5694093089750042e-01, -6.3078807437632903e-18 },
+  { 1.2863769531250000e+00, -2.5182970348994205e-01, -1.8937584675189385e-17 },
+  { 1.2800292968750000e+00, -2.4688296585318906e-01, -1.3548825305012675e-17 },
+  { 1.2736816406250000e+00, -2.4191163630304902e-01,  6.1951087734209785e-18 },
+  { 1.2673339843750000e+00, -2.3691546910788530e-01, -8.9068661964554080e-18 },
+  { 1.2611083984375000e+00, -2.3199101557015639e-01,  1.4540754340558545e-18 },
+  { 1.2548828125000000e+00, -2.2704219172986709e-01,  8.9658540069417482e-18 },
+  { 1.2487792968750000e+00, -2.2216651166638315e-01,  1.1086323702892288e-17 },
+  { 1.2426757812500000e+00, -2.1726694282522471e-01, -1.2694992572894219e-18 },
+  { 1.2366943359375000e+00, -2.1244196177438837e-01,  4.8439188138709072e-18 },
+  { 1.2307128906250000e+00, -2.0759358736328712e-01, -1.0955448314533180e-17 },
+  { 1.2248535156250000e+00, -2.0282125776490925e-01, -9.2682862974410298e-18 },
+  { 1.2189941406250000e+00, -1.9802604378126556e-01, -5.1298594214914469e-18 },
+  { 1.2132568359375000e+00, -1.9330834368871652e-01, -8.9997721855783495e-18 },
+  { 1.2075195312500000e+00, -1.8856828136201781e-01,  7.5007751442290410e-18 },
+  { 1.2019042968750000e+00, -1.8390721303885688e-01,  5.6978903088415579e-19 },
+  { 1.1962890625000000e+00, -1.7922431737937428e-01,  1.0853625867329427e-17 },
+  { 1.1906738281250000e+00, -1.7451938899070887e-01, -1.3121627281846970e-17 },
+  { 1.1851806640625000e+00, -1.6989522209085586e-01, -8.7650047223783015e-18 },
+  { 1.1796875000000000e+00, -1.6524957289530717e-01,  1.0094935622322628e-17 },
+  { 1.1743164062500000e+00, -1.6068619638046316e-01,  1.2902095030988453e-17 },
+  { 1.1689453125000000e+00, -1.5610189995852006e-01,  3.5551647321106538e-18 },
+  { 1.1636962890625000e+00, -1.5160139521428911e-01, -1.0347534945064110e-17 },
+  { 1.1583251953125000e+00, -1.4697516469446950e-01, -8.3998959821951011e-18 },
+  { 1.1531982421875000e+00, -1.4253916248984533e-01,  1.2534567689969196e-17 },
+  { 1.1479492187500000e+00, -1.3797706238067112e-01,  1.0189154814864874e-17 },
+  { 1.1428222656250000e+00, -1.3350087458072687e-01,  1.3133161930790713e-17 },
+  { 1.1378173828125000e+00, -1.2911185078186807e-01, -1.4732878532905248e-18 },
+  { 1.1326904296875000e+00, -1.2459571407389028e-01, -6.5875770754657414e-18 },
+  { 1.1278076171875000e+00, -1.2027558639145612e-01,  3.1343849760849221e-18 },
+  { 1.1228027343750000e+00, -1.1582800082058010e-01,  2.8749783918415243e-19 },
+  { 1.1179199218750000e+00, -1.1146974593775175e-01,  3.8654900836704027e-18 },
+  { 1.1130371093750000e+00, -1.0709241349409769e-01, -5.2015748560028588e-18 },
+  { 1.1082763671875000e+00, -1.0280598609246816e-01, -4.5926782600898665e-18 },
+  { 1.1033935546875000e+00, -9.8390480519121901e-02, -3.3007821663612713e-18 },
+  { 1.0987548828125000e+00, -9.4177613977796226e-02, -3.9893081754301157e-19 },
+  { 1.0939941406250000e+00, -8.9835348066799312e-02, -1.6371447997592503e-18 },
+  { 1.0893554687500000e+00, -8.5586208273134110e-02,  1.6928959166138549e-19 },
+  { 1.0847167968750000e+00, -8.1318936216564761e-02, -3.2403648963461612e-19 },
+  { 1.0802001953125000e+00, -7.7146389988061156e-02, -3.7236694063855566e-18 },
+  { 1.0756835937500000e+00, -7.2956360642944723e-02,  3.1928777555289048e-18 },
+  { 1.0711669921875000e+00, -6.8748701054777539e-02,  1.9934079192629060e-18 },
+  { 1.0666503906250000e+00, -6.4523262232092163e-02, -2.7678191842557431e-18 },
+  { 1.0622558593750000e+00, -6.0394816001336393e-02, -2.1693760677802474e-18 },
+  { 1.0578613281250000e+00, -5.6249255020565693e-02, -1.3403463529566346e-18 },
+  { 1.0534667968750000e+00, -5.2086436798184609e-02,  1.5044605406070887e-18 },
+  { 1.0491943359375000e+00, -4.8022570537660611e-02,  3.1947830922925031e-18 },
+  { 1.0449218750000000e+00, -4.3942121856498761e-02, -1.6937468575336251e-18 },
+  { 1.0406494140625000e+00, -3.9844954872428520e-02,  3.4186684664399868e-18 },
+  { 1.0363769531250000e+00, -3.5730932026103980e-02,  2.4240443715837647e-18 },
+  { 1.0322265625000000e+00, -3.1718180270784539e-02, -5.0841594524468609e-19 },
+  { 1.0280761718750000e+00, -2.7689261442584059e-02, -1.2273908914834034e-18 },
+  { 1.0240478515625000e+00, -2.3763255567005571e-02, -9.8905484181037481e-19 },
+  { 1.0198974609375000e+00, -1.9702093750205065e-02, -3.6319603256813172e-19 },
+  { 1.0158691406250000e+00, -1.5744542263597568e-02,  1.5437739398573666e-19 },
+  { 1.0118408203125000e+00, -1.1771266312237206e-02,  1.9612071239717523e-19 },
+  { 1.0079345703125000e+00, -7.9032571381395418e-03,  3.7892338195952288e-19 },
+  { 1.0039062500000000e+00, -3.8986404156573229e-03, -1.2541659038304973e-19 },
+  { 1.0000000000000000e+00,  0.0000000000000000e+00,  0.0000000000000000e+00 },
+  { 9.9218750000000000e-01,  7.8431774610258926e-03,  2.7647081541249038e-19 },
+  { 9.8461914062500000e-01,  1.5500371845975568e-02,  2.5046199576733797e-19 },
+  { 9.7705078125000000e-01,  2.3216651575664993e-02,  1.4915945626181052e-18 },
+  { 9.6972656250000000e-01,  3.0741141554280503e-02, -1.0529562910593368e-18 },
+  { 9.6240234375000000e-01,  3.8322679006678198e-02,  2.2679860516409623e-18 },
+  { 9.5520019531250000e-01,  4.5834331870935059e-02, -2.6284671063073804e-18 },
+  { 9.4812011718750000e-01,  5.3274078859641694e-02,  5.4925242194888631e-19 },
+  { 9.4116210937500000e-01,  6.0639880721913848e-02,  3.4299065183124548e-19 },
+  { 9.3432617187500000e-01,  6.7929681293641450e-02,  1.0811927028825801e-18 },
+  { 9.2749023437500000e-01,  7.5273013531718141e-02,  2.0739181148480901e-19 },
+  { 9.2089843750000000e-01,  8.2405522965995598e-02,  1.6038879412186651e-18 },
+  { 9.1430664062500000e-01,  8.9589270768023865e-02, -5.3582045211937095e-18 },
+  { 9.0783691406250000e-01,  9.6690526575988825e-02,  2.0484397071144502e-18 },
+  { 9.0136718750000000e-01,  1.0384257109660093e-01,  6.5755190594195396e-18 },
+  { 8.9514160156250000e-01,  1.1077335918548951e-01, -3.6025743811401154e-18 },
+  { 8.8891601562500000e-01,  1.1775251854391026e-01,  3.6455958351879269e-18 },
+  { 8.8281250000000000e-01,  1.2464244520727660e-01, -5.8089126789409707e-18 },
+  { 8.7670898437500000e-01,  1.3158017249326087e-01,  1.8711952809073789e-18 },
+  { 8.7072753906250000e-01,  1.3842616500125091e-01, -2.1212151257510345e-18 },
+  { 8.6486816406250000e-01,  1.4517819515450822e-01, -1.0261245354665822e-17 },
+  { 8.5900878906250000e-01,  1.5197612531274010e-01,  2.0067657562368574e-19 },
+  { 8.5339355468750000e-01,  1.5853446076730388e-01, -1.2610807878996945e-17 },
+  { 8.4765625000000000e-01,  1.6528009093910292e-01, -6.2623135519199867e-19 },
+  { 8.4216308593750000e-01,  1.7178159473318033e-01, -4.6537591278383280e-19 },
+  { 8.3654785156250000e-01,  1.7847155569346534e-01, -9.7107895087202692e-18 },
+  { 8.3117675781250000e-01,  1.8491280179632238e-01, -8.5390938220670172e-18 },
+  { 8.2580566406250000e-01,  1.9139580667440062e-01, -1.1840376119668105e-17 },
+  { 8.2055664062500000e-01,  1.9777233899423804e-01,  5.6029750545081277e-18 },
+  { 8.1530761718750000e-01,  2.0418979255365305e-01,  1.9763635230530454e-18 },
+  { 8.1018066406250000e-01,  2.1049801413336405e-01,  3.0284457938014159e-18 },
+  { 8.0505371093750000e-01,  2.1684628212787405e-01,  3.2516823432795907e-18 },
+  { 8.0004882812500000e-01,  2.2308251802052911e-01,  3.6298654951983502e-18 },
+  { 7.9504394531250000e-01,  2.2935788873288748e-01,  5.0298934893514237e-18 },
+  { 7.9016113281250000e-01,  2.3551838873377884e-01, -3.4148813788878716e-18 },
+  { 7.8527832031250000e-01,  2.4171707586828867e-01,  1.0947511306400756e-18 },
+  { 7.8051757812500000e-01,  2.4779801765950227e-01, -2.6509716034833891e-18 },
+  { 7.7575683593750000e-01,  2.5391616365573461e-01, -7.7589766082994226e-18 },
+  { 7.7111816406250000e-01,  2.5991365638058861e-01,  2.3936917729574862e-17 },
+  { 7.6647949218750000e-01,  2.6594733616517963e-01, -2.7313973674124085e-17 },
+  { 7.6196289062500000e-01,  2.7185742444856431e-01, -2.7754301998947231e-17 },
+  { 7.5744628906250000e-01,  2.7780264964058143e-01,  4.6385474543710568e-18 },
+  { 7.5292968750000000e-01,  2.8378343203612361e-01, -1.8093860415863246e-18 },
+  { 7.4853515625000000e-01,  2.8963710728758429e-01, -1.6471427994592946e-17 },
+  { 7.4414062500000000e-01,  2.9552524991280682e-01,  3.2722484018602266e-19 },
+  { 7.3986816406250000e-01,  3.0128326532800398e-01,  1.1536920766287452e-17 },
+  { 7.3559570312500000e-01,  3.0707462758904247e-01,  7.6958676154905435e-18 },
+  { 7.3144531250000000e-01,  3.1273282208223363e-01, -1.4449475118518507e-17 },
+  { 7.2729492187500000e-01,  3.1842321400606144e-01, -9.6758196461698393e-18 }
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pow_checkint
+ *
+ * Description:
+ *   Return 0 if the double with bits iy is not an integer, 1 if it is an
+ *   odd integer and 2 if it is an even integer.
+ *
+ ****************************************************************************/
+
+static int pow_checkint(uint64_t iy)
+{
+  int e = (int)(iy >> 52 & 0x7ff);
+
+  if (e < 0x3ff)
+    {
+      return 0;
+    }
+
+  if (e > 0x3ff + 52)
+    {
+      return 2;
+    }
+
+  if ((iy & (((uint64_t)1 << (0x3ff + 52 - e)) - 1)) != 0)
+    {
+      return 0;
+    }
+
+  if ((iy & ((uint64_t)1 << (0x3ff + 52 - e))) != 0)
+    {
+      return 1;
+    }
+
+  return 2;
+}
+
+/****************************************************************************
+ * Name: pow_log
+ *
+ * Description:
+ *   Return log(x) for a positive normal x with bits ix as the sum of the
+ *   return value and *tail, with a relative error below 2^-68.
+ *
+ *   x = 2^k * z and log(x) = k * ln2 + log(c) + log1p(r) with
+ *   r = z / c - 1, where c is near the center of the table interval that
+ *   contains z.  1/c is short, so that with z split in two, r is exactly
+ *   rhi + rlo.  This is renormalized to rh + rl and r^2 is formed exactly
+ *   from the halves of rh.  Everything down to the r^2 term is added with
+ *   exact two-sums.  The remaining Taylor series converges quickly, since
+ *   |r| < 2^-7.9.
+ *
+ ****************************************************************************/
+
+static double pow_log(uint64_t ix, FAR double *tail)
+{
+  union
+  {
+    double f;
+    uint64_t i;
+  } u;
+
+  uint64_t tmp;
+  double invc;
+  double zhi;
+  double zlo;
+  double rhi;
+  double rlo;
+  double rh;
+  double rl;
+  double ra;
+  double rb;
+  double ar2;
+  double kf;
+  double a;
+  double s;
+  double t;
+  double hi;
+  double lo;
+  int i;
+
+  tmp  = ix - POW_LOG_OFF;
+  i    = (int)((tmp >> (52 - POW_LOG_TABLE_BITS)) % POW_LOG_TABLE_SIZE);
+  kf   = (double)((int64_t)tmp >> 52);
+  invc = g_pow_log_tbl[i].invc;
+
+  /* Both products are exact:  zhi has 21 bits, zlo 32 and invc 14 */
+
+  u.i  = ix - (tmp & 0xfff0000000000000ull);
+  zlo  = u.f;
+  u.i &= 0xffffffff00000000ull;
+  zhi  = u.f;
+  zlo -= zhi;
+
+  rhi  = zhi * invc - 1.0;
+  rlo  = zlo * invc;
+
+  rh   = rhi + rlo;
+  t    = rh - rhi;
+  rl   = (rhi - (rh - t)) + (rlo - t);
+
+  /* rh = ra + rb with 26 and 27-bit halves */
+
+  u.f  = rh;
+  u.i &= POW_HI26_MASK;
+  ra   = u.f;
+  rb   = rh - ra;
+
+  a    = kf * g_ln2_hi;
+  hi   = a + g_pow_log_tbl[i].logc_hi;
+  lo   = (a - hi) + g_pow_log_tbl[i].logc_hi;
+
+  s    = hi + rh;
+  lo  += (hi - s) + rh;
+
+  ar2  = -0.5 * ra * ra;
+  hi   = s + ar2;
+  lo  += (s - hi) + ar2;
+
+  lo  += kf * g_ln2_lo + g_pow_log_tbl[i].logc_lo + rl -
+         (ra * rb + 0.5 * rb * rb + rh * rl) +
+         rh * rh * rh * (1.0 / 3.0 + rh * (-0.25 + rh * (0.2 + rh *
+         (-1.0 / 6.0 + rh * (1.0 / 7.0 + rh * (-0.125 + rh / 9.0))))));
+
+  s     = hi + lo;
+  *tail = (hi - s) + lo;
+  return s;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
-#ifdef CONFIG_HAVE_DOUBLE
-double pow(double b, double e)
+/****************************************************************************
+ * Name: pow
+ *
+ * Description:
+ *   pow(x, y) = exp(y * log(x)).  log(x) is computed in double-double
+ *   precision by pow_log() and the product with y is formed exactly enough
+ *   that the rounding of y * log(x) does not show in the result, which
+ *   stays below 1 ulp.  Special cases follow C99 Annex F.
+ *
+ ****************************************************************************/
+
+double pow(double x, double y)
 {
-  return exp(e * log(b));
+  union
+  {
+    double f;
+    uint64_t i;
+  } u;
+
+  uint64_t ix;
+  uint64_t iy;
+  double ltail;
+  double lhi;
+  double l;
+  double yhi;
+  double ehi;
+  double elo;
+  double e2;
+  double r;
+  int yint = 0;
+  int neg = 0;
+
+  u.f = x;
+  ix  = u.i;
+  u.f = y;
+  iy  = u.i;
+
+  if ((iy << 1) == 0 || x == 1.0)
+    {
+      /* pow(x, +-0) = 1 and pow(1, y) = 1, even for NaN */
+
+      return 1.0;
+    }
+
+  if (x != x || y != y)
+    {
+      return x + y;
+    }
+
+  if ((iy << 1) == 0xffe0000000000000ull)
+    {
+      /* y = +-Inf */
+
+      if (x == -1.0)
+        {
+          return 1.0;
+        }
+
+      return (fabs(x) < 1.0) == ((iy >> 63) == 0) ? 0.0 : INFINITY;
+    }
+
+  if ((ix >> 63) != 0)
+    {
+      yint = pow_checkint(iy);
+    }
+
+  if ((ix << 1) == 0 || (ix << 1) == 0xffe0000000000000ull)
+    {
+      /* x = +-0 or +-Inf */
+
+      r = x * x;
+      if (yint == 1)
+        {
+          r = -r;
+        }
+
+      return (iy >> 63) != 0 ? 1.0 / r : r;
+    }
+
+  if ((ix >> 63) != 0)
+    {
+      /* Finite x < 0:  only integer powers are defined */
+
+      if (yint == 0)
+        {
+          return NAN;
+        }
+
+      neg = (yint == 1);
+      ix &= 0x7fffffffffffffffull;
+    }
+
+  if ((ix >> 52) == 0)
+    {
+      /* Subnormal x:  normalize */
+
+      u.i  = ix;
+      u.f *= 0x1p52;
+      ix   = u.i - ((uint64_t)52 << 52);
+    }
+
+  l   = pow_log(ix, &ltail);
+  ehi = y * l;
+
+  if (fabs(ehi) > 1000.0)
+    {
+      /* The result overflows or underflows anyway */
+
+      r = __exp(ehi, 0.0);
+    }
+  else
+    {
+      /* y * l exactly as ehi + e2:  26 x 27 and 26 x 26 bit products */
+
+      u.f = l;
+      u.i &= POW_HI26_MASK;
+      lhi = u.f;
+      ltail += l - lhi;
+
+      u.f = y;
+      u.i &= POW_HI26_MASK;
+      yhi = u.f;
+
+      ehi = yhi * lhi;
+      e2  = (y - yhi) * lhi;
+      r   = ehi + e2;
+      elo = (ehi - r) + e2 + y * ltail;
+
+      r   = __exp(r, elo);
+    }
+
+  return neg ? -r : r;
 }
 #endif
@@ -29,6 +29,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <math.h>
 
 /****************************************************************************
@@ -37,5 +39,13 @@
 
 float powf(float b, float e)
 {
+#ifdef CONFIG_HAVE_DOUBLE
+  /* pow() is accurate to well below one float ulp and handles all of the
+   * special cases, which are the same for float arguments.
+   */
+
+  return (float)pow((double)b, (double)e);
+#else
   return expf(e * logf(b));
+#endif
 }
@@ -0,0 +1,107 @@
+/****************************************************************************
+ * libs/libc/math/lib_sincosf.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <math.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sincosf
+ *
+ * Description:
+ *   Compute the sine and cosine of x, sharing the argument reduction.
+ *
+ ****************************************************************************/
+
+void sincosf(float x, FAR float *s, FAR float *c)
+{
+  union
+  {
+    float f;
+    uint32_t i;
+  } u =
+  {
+    x
+  };
+
+  float sy;
+  float cy;
+  float y[2];
+  int n;
+
+  if ((u.i & 0x7fffffff) <= 0x3f490fdb)
+    {
+      *s = __sinf(x, 0.0F, 0);
+      *c = __cosf(x, 0.0F);
+      return;
+    }
+
+  n  = __rem_pio2f(x, y);
+  sy = __sinf(y[0], y[1], 1);
+  cy = __cosf(y[0], y[1]);
+
+  switch (n & 3)
+    {
+      case 0:
+        *s = sy;
+        *c = cy;
+        break;
+
+      case 1:
+        *s = cy;
+        *c = -sy;
+        break;
+
+      case 2:
+        *s = -sy;
+        *c = -cy;
+        break;
+
+      default:
+        *s = -cy;
+        *c = sy;
+        break;
+    }
+}
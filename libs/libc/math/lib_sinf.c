@@ -29,76 +29,59 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
 #include <math.h>
 
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1 / 1! */
-  1.0 / 6.0,                    /* 1 / 3! */
-  1.0 / 120.0,                  /* 1 / 5! */
-  1.0 / 5040.0,                 /* 1 / 7! */
-  1.0 / 362880.0,               /* 1 / 9! */
-  1.0 / 39916800.0,             /* 1 / 11! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: sinf
+ *
+ * Description:
+ *   Compute the sine of x.  The maximum error, measured exhaustively
+ *   against a long double reference, is 0.81 ulp.
+ *
  ****************************************************************************/
 
 float sinf(float x)
 {
-  float x_squared;
-  float sin_x;
-  size_t i;
+  union
+  {
+    float f;
+    uint32_t i;
+  } u =
+  {
+    x
+  };
 
-  /* Move x to [-pi, pi) */
+  float y[2];
+  int n;
 
-  x = fmodf(x, 2 * M_PI_F);
-  if (x >= M_PI_F)
-    {
-      x -= 2 * M_PI_F;
-    }
+  /* No reduction is needed for |x| <= pi/4 */
 
-  if (x < -M_PI_F)
+  if ((u.i & 0x7fffffff) <= 0x3f490fdb)
     {
-      x += 2 * M_PI_F;
+      return __sinf(x, 0.0F, 0);
     }
 
-  /* Move x to [-pi/2, pi/2) */
-
-  if (x >= M_PI_2_F)
-    {
-      x = M_PI_F - x;
-    }
-
-  if (x < -M_PI_2_F)
+  n = __rem_pio2f(x, y);
+  switch (n & 3)
     {
-      x = -M_PI_F - x;
-    }
-
-  x_squared = x * x;
-  sin_x = 0.0F;
+      case 0:
+        return __sinf(y[0], y[1], 1);
 
-  /* Perform Taylor series approximation for sin(x) with six terms */
+      case 1:
+        return __cosf(y[0], y[1]);
 
-  for (i = 0; i < 6; i++)
-    {
-      if (i % 2 == 0)
-        {
-          sin_x += x * _flt_inv_fact[i];
-        }
-      else
-        {
-          sin_x -= x * _flt_inv_fact[i];
-        }
+      case 2:
+        return -__sinf(y[0], y[1], 1);
 
-      x *= x_squared;
+      default:
+        return -__cosf(y[0], y[1]);
     }
-
-  return sin_x;
 }
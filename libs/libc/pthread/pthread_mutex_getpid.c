@@ -0,0 +1,95 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_getpid.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <nuttx/tls.h>
+#include <arch/tls.h>
+
+#include "libc.h"
+
+#ifdef CONFIG_SEM_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_mutex_getpid
+ *
+ * Description:
+ *   Return the ID of the calling thread for use in the fast path lock word
+ *   of a pthread mutex.
+ *
+ *   getpid() is a system call in the PROTECTED and KERNEL builds.  With
+ *   CONFIG_TLS, the ID is obtained once per thread and then cached in the
+ *   TLS data at the base of the thread's stack, which is accessible from
+ *   user mode.  The TLS data is zeroed whenever a stack is created, so a
+ *   zero value means that the ID has not been cached yet.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The ID of the calling thread.
+ *
+ ****************************************************************************/
+
+pid_t lib_mutex_getpid(void)
+{
+#ifdef CONFIG_TLS
+  FAR struct tls_info_s *info = up_tls_info();
+
+  if (info->tl_pid == 0)
+    {
+      info->tl_pid = getpid();
+    }
+
+  return info->tl_pid;
+#else
+  /* getpid() is a simple function call in the FLAT build */
+
+  return getpid();
+#endif
+}
+
+#endif /* CONFIG_SEM_FASTPATH */
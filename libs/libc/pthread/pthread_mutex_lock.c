@@ -39,7 +39,14 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <pthread.h>
+#include <errno.h>
+
+#include <nuttx/semaphore.h>
+#include <nuttx/pthread.h>
+
+#include "libc.h"
 
 /****************************************************************************
  * Public Functions
@@ -79,6 +86,10 @@
  *   from the signal handler the thread resumes waiting for the mutex as if
  *   it was not interrupted.
  *
+ *   With CONFIG_SEM_FASTPATH, a free mutex is locked by setting its lock
+ *   word with an atomic compare-and-exchange.  The OS is entered only if
+ *   the mutex is already locked by another thread.
+ *
  * Input Parameters:
  *   mutex - A reference to the mutex to be locked.
  *
@@ -97,6 +108,53 @@
 
 int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 {
+#ifdef CONFIG_SEM_FASTPATH
+  uint32_t owner;
+  uint32_t mine;
+  pid_t mypid;
+
+  if (mutex != NULL && PTHREAD_MUTEX_ISFAST(mutex))
+    {
+      mypid = lib_mutex_getpid();
+      mine  = ((uint32_t)mypid & _PTHREAD_MOWNER_PIDMASK) |
+              _PTHREAD_MOWNER_LOCKED;
+      owner = 0;
+
+      /* Try to take the free mutex with the lock word */
+
+      if (SEM_CMPXCHG(&mutex->owner, &owner, mine))
+        {
+          mutex->pid    = mypid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          mutex->nlocks = 1;
+#endif
+          return OK;
+        }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      /* Check if the calling thread already holds the mutex via the lock
+       * word.  A NORMAL mutex is permitted to deadlock in the OS.
+       */
+
+      if (owner == mine && mutex->type != PTHREAD_MUTEX_NORMAL)
+        {
+          if (mutex->type != PTHREAD_MUTEX_RECURSIVE)
+            {
+              return EDEADLK;
+            }
+
+          if (mutex->nlocks >= INT16_MAX)
+            {
+              return EOVERFLOW;
+            }
+
+          mutex->nlocks++;
+          return OK;
+        }
+#endif
+    }
+#endif
+
   /* pthread_mutex_lock() is equivalent to pthread_mutex_timedlock() when
    * the absolute time delay is a NULL value.
    */
@@ -0,0 +1,134 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_trylock.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include <nuttx/semaphore.h>
+#include <nuttx/pthread.h>
+
+#include "libc.h"
+
+#ifdef CONFIG_SEM_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_trylock
+ *
+ * Description:
+ *   The function pthread_mutex_trylock() is identical to pthread_mutex_lock()
+ *   except that if the mutex object referenced by mutex is currently locked
+ *   (by any thread, including the current thread), the call returns
+ *   immediately with the errno EBUSY.
+ *
+ *   A free mutex is locked by setting its lock word with an atomic
+ *   compare-and-exchange.  The OS is entered only if the mutex is managed
+ *   by the OS.
+ *
+ * Input Parameters:
+ *   mutex - A reference to the mutex to be locked.
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.  Note that the errno EINTR
+ *   is never returned by pthread_mutex_trylock().
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+{
+  uint32_t owner;
+  uint32_t mine;
+  pid_t mypid;
+
+  if (mutex != NULL && PTHREAD_MUTEX_ISFAST(mutex))
+    {
+      mypid = lib_mutex_getpid();
+      mine  = ((uint32_t)mypid & _PTHREAD_MOWNER_PIDMASK) |
+              _PTHREAD_MOWNER_LOCKED;
+      owner = 0;
+
+      /* Try to take the free mutex with the lock word */
+
+      if (SEM_CMPXCHG(&mutex->owner, &owner, mine))
+        {
+          mutex->pid = mypid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          if (mutex->type == PTHREAD_MUTEX_RECURSIVE)
+            {
+              mutex->nlocks = 1;
+            }
+#endif
+          return OK;
+        }
+
+      /* If the mutex is held via the lock word, then there is no need to
+       * enter the OS.
+       */
+
+      if ((owner & _PTHREAD_MOWNER_KERNEL) == 0)
+        {
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          /* Check if recursive mutex was locked by the calling thread. */
+
+          if (owner == mine && mutex->type == PTHREAD_MUTEX_RECURSIVE)
+            {
+              if (mutex->nlocks >= INT16_MAX)
+                {
+                  return EOVERFLOW;
+                }
+
+              mutex->nlocks++;
+              return OK;
+            }
+#endif
+
+          return EBUSY;
+        }
+    }
+
+  return pthread_mutex_trylock_slow(mutex);
+}
+
+#endif /* CONFIG_SEM_FASTPATH */
@@ -0,0 +1,210 @@
+/****************************************************************************
+ * libs/libc/time/lib_timepage.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* In the PROTECTED build, this file is built into both the user- and the
+ * kernel-space C libraries.  The time page must reside in user memory; the
+ * kernel-space copy of the library simply defers to clock_gettime().
+ */
+
+#if defined(CONFIG_BUILD_PROTECTED) && defined(__KERNEL__)
+#  undef HAVE_TIMEPAGE
+#else
+#  define HAVE_TIMEPAGE 1
+#endif
+
+/* Give up on the lock-free read after this many collisions with the
+ * writer.  This can only happen if the reader is being preempted for a
+ * whole tick on each attempt.
+ */
+
+#define TIMEPAGE_RETRIES 4
+
+/* Memory barriers are only needed (and only provided by nuttx/spinlock.h)
+ * when other CPUs may access the time page concurrently.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef HAVE_TIMEPAGE
+struct clock_timepage_s g_timepage;
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_timepage_read
+ *
+ * Description:
+ *   Read CLOCK_REALTIME or CLOCK_MONOTONIC from the shared clock time page
+ *   without a system call and without entering a critical section.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   OK on success; -EAGAIN if the time page cannot provide the clock (the
+ *   page has not yet been written or the clock is not supported).
+ *
+ ****************************************************************************/
+
+int clock_timepage_read(clockid_t clock_id, FAR struct timespec *tp)
+{
+#ifdef HAVE_TIMEPAGE
+  FAR volatile struct clock_timepage_s *page = &g_timepage;
+  time_t sec;
+  long nsec;
+  uint32_t seq;
+  int retries;
+
+  if (clock_id != CLOCK_REALTIME
+#ifdef CONFIG_CLOCK_MONOTONIC
+      && clock_id != CLOCK_MONOTONIC
+#endif
+     )
+    {
+      return -EAGAIN;
+    }
+
+  for (retries = 0; retries < TIMEPAGE_RETRIES; retries++)
+    {
+      /* An odd sequence count means that an update is in progress;  zero
+       * means that the page has not been written yet.
+       */
+
+      seq = page->seq;
+      if (seq == 0)
+        {
+          return -EAGAIN;
+        }
+
+      if ((seq & 1) != 0)
+        {
+          continue;
+        }
+
+      SP_DMB();
+
+      sec  = page->mono_sec;
+      nsec = page->mono_nsec;
+
+      if (clock_id == CLOCK_REALTIME)
+        {
+          /* Add the base time as clock_gettime() does */
+
+          sec  += (uint32_t)page->base_sec;
+          nsec += (uint32_t)page->base_nsec;
+        }
+
+      SP_DMB();
+
+      /* The snapshot is consistent only if no update started meanwhile */
+
+      if (page->seq == seq)
+        {
+          /* Handle carry to seconds.  Both nanosecond fields are below
+           * one second, so at most one second can carry.
+           */
+
+          if (nsec >= NSEC_PER_SEC)
+            {
+              sec++;
+              nsec -= NSEC_PER_SEC;
+            }
+
+          tp->tv_sec  = sec;
+          tp->tv_nsec = nsec;
+          return OK;
+        }
+    }
+#endif
+
+  return -EAGAIN;
+}
+
+/****************************************************************************
+ * Name: clock_timepage_gettime
+ *
+ * Description:
+ *   A drop-in replacement for clock_gettime() that uses the shared clock
+ *   time page when possible and falls back to clock_gettime() otherwise.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   Same as clock_gettime().
+ *
+ ****************************************************************************/
+
+int clock_timepage_gettime(clockid_t clock_id, FAR struct timespec *tp)
+{
+  if (clock_timepage_read(clock_id, tp) == OK)
+    {
+      return OK;
+    }
+
+  return clock_gettime(clock_id, tp);
+}
+
+#endif /* CONFIG_CLOCK_TIMEPAGE */
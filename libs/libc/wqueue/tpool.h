@@ -0,0 +1,163 @@
+/****************************************************************************
+ * libs/libc/wqueue/tpool.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBC_WQUEUE_TPOOL_H
+#define __LIBC_WQUEUE_TPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <threadpool.h>
+
+#if defined(CONFIG_LIB_THREADPOOL) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TPOOL_DEQUESIZE  CONFIG_LIB_THREADPOOL_DEQUESIZE
+#define TPOOL_DEQUEMASK  (TPOOL_DEQUESIZE - 1)
+#define TPOOL_QUEUESIZE  CONFIG_LIB_THREADPOOL_QUEUESIZE
+#define TPOOL_QUEUEMASK  (TPOOL_QUEUESIZE - 1)
+
+#if (TPOOL_DEQUESIZE & TPOOL_DEQUEMASK) != 0
+#  error "CONFIG_LIB_THREADPOOL_DEQUESIZE must be a power of two"
+#endif
+
+#if (TPOOL_QUEUESIZE & TPOOL_QUEUEMASK) != 0
+#  error "CONFIG_LIB_THREADPOOL_QUEUESIZE must be a power of two"
+#endif
+
+/* Atomic accessors.  ARCH_HAVE_CMPXCHG guarantees that these are lock-free
+ * and usable from user mode.
+ */
+
+#define TPOOL_LOAD(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define TPOOL_STORE(p,v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define TPOOL_ADD(p,v)       __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define TPOOL_FENCE()        __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define TPOOL_CMPXCHG(p,e,d) \
+  __atomic_compare_exchange_n((p), (e), (d), false, __ATOMIC_SEQ_CST, \
+                              __ATOMIC_RELAXED)
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* A work-stealing deque (Chase-Lev).  Only the owning worker pushes and
+ * pops at the bottom; any thread may steal from the top.
+ */
+
+struct tpool_deque_s
+{
+  int32_t top;                /* Next entry to steal */
+  int32_t bottom;             /* Next free entry */
+  FAR struct tpool_work_s *slot[TPOOL_DEQUESIZE];
+};
+
+/* A bounded multi-producer, multi-consumer queue.  Each cell carries a
+ * sequence number that tells producers and consumers whose turn it is.
+ */
+
+struct tpool_cell_s
+{
+  uint32_t seq;               /* Cell sequence number */
+  FAR struct tpool_work_s *work;
+};
+
+struct tpool_queue_s
+{
+  uint32_t head;              /* Next position to dequeue */
+  uint32_t tail;              /* Next position to enqueue */
+  struct tpool_cell_s cell[TPOOL_QUEUESIZE];
+};
+
+/* One worker thread */
+
+struct tpool_worker_s
+{
+  FAR struct tpool_s *pool;   /* Containing pool */
+  pthread_t thread;           /* The worker thread */
+  uint8_t index;              /* Index in the pool's worker array */
+  struct tpool_deque_s deque; /* Work owned by this worker */
+};
+
+/* The thread pool */
+
+struct tpool_s
+{
+  struct tpool_queue_s queue; /* Work submitted from outside of the pool */
+  sem_t wake;                 /* Posted to wake an idle worker */
+  int nidle;                  /* Number of workers going idle */
+  bool stop;                  /* Set by tpool_destroy() */
+  uint8_t nworkers;           /* Number of worker threads */
+  struct tpool_worker_s worker[1]; /* Actually nworkers entries */
+};
+
+#define SIZEOF_TPOOL_S(n) \
+  (sizeof(struct tpool_s) + ((n) - 1) * sizeof(struct tpool_worker_s))
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* tpool_deque.c ***********************************************************/
+
+void tpool_deque_init(FAR struct tpool_deque_s *deque);
+int tpool_deque_push(FAR struct tpool_deque_s *deque,
+                     FAR struct tpool_work_s *work);
+FAR struct tpool_work_s *tpool_deque_pop(FAR struct tpool_deque_s *deque);
+FAR struct tpool_work_s *tpool_deque_steal(FAR struct tpool_deque_s *deque);
+
+void tpool_queue_init(FAR struct tpool_queue_s *queue);
+int tpool_queue_put(FAR struct tpool_queue_s *queue,
+                    FAR struct tpool_work_s *work);
+FAR struct tpool_work_s *tpool_queue_get(FAR struct tpool_queue_s *queue);
+
+/* tpool_submit.c **********************************************************/
+
+FAR struct tpool_worker_s *tpool_self(FAR struct tpool_s *pool);
+bool tpool_runone(FAR struct tpool_s *pool,
+                  FAR struct tpool_worker_s *self);
+
+#endif /* CONFIG_LIB_THREADPOOL && !__KERNEL__ */
+#endif /* __LIBC_WQUEUE_TPOOL_H */
@@ -0,0 +1,302 @@
+/****************************************************************************
+ * libs/libc/wqueue/tpool_create.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/semaphore.h>
+
+#include "wqueue/tpool.h"
+#include "libc.h"
+
+#if defined(CONFIG_LIB_THREADPOOL) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tpool_worker
+ *
+ * Description:
+ *   The body of each worker thread.  Run work until the pool is stopped and
+ *   no work is left.  A worker that finds nothing to do first announces
+ *   that it is going idle and then looks once more before sleeping, so
+ *   that a concurrent tpool_submit() either sees the idle worker and wakes
+ *   it or has its work found by that last look.
+ *
+ ****************************************************************************/
+
+static FAR void *tpool_worker(FAR void *arg)
+{
+  FAR struct tpool_worker_s *self = (FAR struct tpool_worker_s *)arg;
+  FAR struct tpool_s *pool = self->pool;
+
+  for (; ; )
+    {
+      if (tpool_runone(pool, self))
+        {
+          continue;
+        }
+
+      TPOOL_ADD(&pool->nidle, 1);
+
+      if (tpool_runone(pool, self))
+        {
+          TPOOL_ADD(&pool->nidle, -1);
+          continue;
+        }
+
+      if (TPOOL_LOAD(&pool->stop))
+        {
+          TPOOL_ADD(&pool->nidle, -1);
+          break;
+        }
+
+      while (sem_wait(&pool->wake) < 0)
+        {
+          DEBUGASSERT(errno == EINTR);
+        }
+
+      TPOOL_ADD(&pool->nidle, -1);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tpool_stop
+ *
+ * Description:
+ *   Stop and join the first 'nworkers' worker threads.
+ *
+ ****************************************************************************/
+
+static void tpool_stop(FAR struct tpool_s *pool, int nworkers)
+{
+  int i;
+
+  TPOOL_STORE(&pool->stop, true);
+  TPOOL_FENCE();
+
+  for (i = 0; i < nworkers; i++)
+    {
+      sem_post(&pool->wake);
+    }
+
+  for (i = 0; i < nworkers; i++)
+    {
+      (void)pthread_join(pool->worker[i].thread, NULL);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tpool_attr_init
+ *
+ * Description:
+ *   Initialize thread pool attributes to the configured defaults.
+ *
+ ****************************************************************************/
+
+int tpool_attr_init(FAR struct tpool_attr_s *attr)
+{
+  if (attr == NULL)
+    {
+      return EINVAL;
+    }
+
+  attr->nworkers  = CONFIG_LIB_THREADPOOL_NWORKERS;
+  attr->priority  = CONFIG_LIB_THREADPOOL_PRIORITY;
+  attr->stacksize = CONFIG_LIB_THREADPOOL_STACKSIZE;
+#ifdef CONFIG_SMP
+  CPU_ZERO(&attr->affinity);
+#endif
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tpool_create
+ *
+ * Description:
+ *   Create a thread pool and start its worker threads.
+ *
+ ****************************************************************************/
+
+int tpool_create(FAR struct tpool_s **pool,
+                 FAR const struct tpool_attr_s *attr)
+{
+  FAR struct tpool_s *newpool;
+  struct tpool_attr_s defattr;
+  struct sched_param param;
+  pthread_attr_t pattr;
+#ifdef CONFIG_SMP
+  cpu_set_t affinity;
+  cpu_set_t cpuset;
+  int cpu = 0;
+#endif
+  int ret;
+  int i;
+
+  if (pool == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (attr == NULL)
+    {
+      tpool_attr_init(&defattr);
+      attr = &defattr;
+    }
+
+  if (attr->nworkers < 1)
+    {
+      return EINVAL;
+    }
+
+#ifdef CONFIG_SMP
+  /* Ignore CPUs that do not exist, but refuse a set that names none that
+   * do.
+   */
+
+  affinity = attr->affinity & ((1 << CONFIG_SMP_NCPUS) - 1);
+  if (attr->affinity != 0 && affinity == 0)
+    {
+      return EINVAL;
+    }
+#endif
+
+  newpool = (FAR struct tpool_s *)lib_zalloc(SIZEOF_TPOOL_S(attr->nworkers));
+  if (newpool == NULL)
+    {
+      return ENOMEM;
+    }
+
+  tpool_queue_init(&newpool->queue);
+  sem_init(&newpool->wake, 0, 0);
+  sem_setprotocol(&newpool->wake, SEM_PRIO_NONE);
+
+  /* Set up the attributes shared by all workers */
+
+  pthread_attr_init(&pattr);
+  pthread_attr_setstacksize(&pattr, attr->stacksize);
+  param.sched_priority = attr->priority;
+  pthread_attr_setschedparam(&pattr, &param);
+  pthread_attr_setinheritsched(&pattr, PTHREAD_EXPLICIT_SCHED);
+
+  for (i = 0; i < attr->nworkers; i++)
+    {
+      FAR struct tpool_worker_s *worker = &newpool->worker[i];
+
+      worker->pool  = newpool;
+      worker->index = i;
+      tpool_deque_init(&worker->deque);
+
+#ifdef CONFIG_SMP
+      /* Pin each worker to the next CPU of the affinity set */
+
+      if (affinity != 0)
+        {
+          while (!CPU_ISSET(cpu, &affinity))
+            {
+              cpu = (cpu + 1) % CONFIG_SMP_NCPUS;
+            }
+
+          CPU_ZERO(&cpuset);
+          CPU_SET(cpu, &cpuset);
+          pthread_attr_setaffinity_np(&pattr, sizeof(cpu_set_t), &cpuset);
+          cpu = (cpu + 1) % CONFIG_SMP_NCPUS;
+        }
+#endif
+
+      /* The worker count is only raised once the thread exists, so the
+       * workers never look at a deque that is not set up yet.
+       */
+
+      ret = pthread_create(&worker->thread, &pattr, tpool_worker, worker);
+      if (ret != OK)
+        {
+          tpool_stop(newpool, i);
+          sem_destroy(&newpool->wake);
+          lib_free(newpool);
+          pthread_attr_destroy(&pattr);
+          return ret;
+        }
+
+      TPOOL_STORE(&newpool->nworkers, i + 1);
+    }
+
+  pthread_attr_destroy(&pattr);
+  *pool = newpool;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tpool_destroy
+ *
+ * Description:
+ *   Stop the worker threads after all submitted work has completed and
+ *   free the thread pool.
+ *
+ ****************************************************************************/
+
+int tpool_destroy(FAR struct tpool_s *pool)
+{
+  if (pool == NULL || tpool_self(pool) != NULL)
+    {
+      /* A worker cannot join itself */
+
+      return EINVAL;
+    }
+
+  tpool_stop(pool, pool->nworkers);
+  sem_destroy(&pool->wake);
+  lib_free(pool);
+  return OK;
+}
+
+#endif /* CONFIG_LIB_THREADPOOL && !__KERNEL__ */
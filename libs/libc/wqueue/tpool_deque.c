@@ -0,0 +1,323 @@
+/****************************************************************************
+ * libs/libc/wqueue/tpool_deque.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "wqueue/tpool.h"
+
+#if defined(CONFIG_LIB_THREADPOOL) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tpool_deque_init
+ *
+ * Description:
+ *   Initialize an empty work-stealing deque.
+ *
+ ****************************************************************************/
+
+void tpool_deque_init(FAR struct tpool_deque_s *deque)
+{
+  deque->top    = 0;
+  deque->bottom = 0;
+}
+
+/****************************************************************************
+ * Name: tpool_deque_push
+ *
+ * Description:
+ *   Push work at the bottom of the deque.  Only the owning worker may call
+ *   this.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSPC if the deque is full.
+ *
+ ****************************************************************************/
+
+int tpool_deque_push(FAR struct tpool_deque_s *deque,
+                     FAR struct tpool_work_s *work)
+{
+  int32_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+  int32_t top    = TPOOL_LOAD(&deque->top);
+
+  if (bottom - top >= TPOOL_DEQUESIZE)
+    {
+      return -ENOSPC;
+    }
+
+  /* Store the work before publishing the new bottom to thieves */
+
+  __atomic_store_n(&deque->slot[bottom & TPOOL_DEQUEMASK], work,
+                   __ATOMIC_RELAXED);
+  TPOOL_STORE(&deque->bottom, bottom + 1);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tpool_deque_pop
+ *
+ * Description:
+ *   Pop the most recently pushed work from the bottom of the deque.  Only
+ *   the owning worker may call this.
+ *
+ * Returned Value:
+ *   The work or NULL if the deque is empty (or the last entry was stolen).
+ *
+ ****************************************************************************/
+
+FAR struct tpool_work_s *tpool_deque_pop(FAR struct tpool_deque_s *deque)
+{
+  FAR struct tpool_work_s *work;
+  int32_t bottom;
+  int32_t top;
+
+  /* Reserve the bottom entry, then see whether a thief got there first */
+
+  bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+  __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+  TPOOL_FENCE();
+  top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+  if (top > bottom)
+    {
+      /* The deque was empty */
+
+      __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+      return NULL;
+    }
+
+  work = __atomic_load_n(&deque->slot[bottom & TPOOL_DEQUEMASK],
+                         __ATOMIC_RELAXED);
+
+  if (top == bottom)
+    {
+      /* This is the last entry.  Race the thieves for it. */
+
+      if (!TPOOL_CMPXCHG(&deque->top, &top, top + 1))
+        {
+          work = NULL;
+        }
+
+      __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+  return work;
+}
+
+/****************************************************************************
+ * Name: tpool_deque_steal
+ *
+ * Description:
+ *   Steal the oldest work from the top of the deque.  Any thread may call
+ *   this.
+ *
+ * Returned Value:
+ *   The work or NULL if the deque is empty or another thread won the race
+ *   for the top entry.
+ *
+ ****************************************************************************/
+
+FAR struct tpool_work_s *tpool_deque_steal(FAR struct tpool_deque_s *deque)
+{
+  FAR struct tpool_work_s *work;
+  int32_t bottom;
+  int32_t top;
+
+  top = TPOOL_LOAD(&deque->top);
+  TPOOL_FENCE();
+  bottom = TPOOL_LOAD(&deque->bottom);
+
+  if (top >= bottom)
+    {
+      return NULL;
+    }
+
+  work = __atomic_load_n(&deque->slot[top & TPOOL_DEQUEMASK],
+                         __ATOMIC_RELAXED);
+
+  if (!TPOOL_CMPXCHG(&deque->top, &top, top + 1))
+    {
+      return NULL;
+    }
+
+  return work;
+}
+
+/****************************************************************************
+ * Name: tpool_queue_init
+ *
+ * Description:
+ *   Initialize an empty multi-producer, multi-consumer queue.
+ *
+ ****************************************************************************/
+
+void tpool_queue_init(FAR struct tpool_queue_s *queue)
+{
+  uint32_t i;
+
+  for (i = 0; i < TPOOL_QUEUESIZE; i++)
+    {
+      queue->cell[i].seq  = i;
+      queue->cell[i].work = NULL;
+    }
+
+  queue->head = 0;
+  queue->tail = 0;
+}
+
+/****************************************************************************
+ * Name: tpool_queue_put
+ *
+ * Description:
+ *   Add work at the tail of the queue.  Any thread may call this.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSPC if the queue is full.
+ *
+ ****************************************************************************/
+
+int tpool_queue_put(FAR struct tpool_queue_s *queue,
+                    FAR struct tpool_work_s *work)
+{
+  FAR struct tpool_cell_s *cell;
+  uint32_t pos;
+  int32_t diff;
+
+  pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+  for (; ; )
+    {
+      cell = &queue->cell[pos & TPOOL_QUEUEMASK];
+      diff = (int32_t)(TPOOL_LOAD(&cell->seq) - pos);
+
+      if (diff == 0)
+        {
+          /* The cell is free.  Try to claim it. */
+
+          if (TPOOL_CMPXCHG(&queue->tail, &pos, pos + 1))
+            {
+              break;
+            }
+        }
+      else if (diff < 0)
+        {
+          /* The cell still holds work from one lap ago:  The queue is
+           * full.
+           */
+
+          return -ENOSPC;
+        }
+      else
+        {
+          /* Another producer claimed the cell */
+
+          pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+  /* Fill the cell, then hand it over to the consumers */
+
+  cell->work = work;
+  TPOOL_STORE(&cell->seq, pos + 1);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tpool_queue_get
+ *
+ * Description:
+ *   Remove work from the head of the queue.  Any thread may call this.
+ *
+ * Returned Value:
+ *   The work or NULL if the queue is empty.
+ *
+ ****************************************************************************/
+
+FAR struct tpool_work_s *tpool_queue_get(FAR struct tpool_queue_s *queue)
+{
+  FAR struct tpool_cell_s *cell;
+  FAR struct tpool_work_s *work;
+  uint32_t pos;
+  int32_t diff;
+
+  pos = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+  for (; ; )
+    {
+      cell = &queue->cell[pos & TPOOL_QUEUEMASK];
+      diff = (int32_t)(TPOOL_LOAD(&cell->seq) - (pos + 1));
+
+      if (diff == 0)
+        {
+          /* The cell is filled.  Try to claim it. */
+
+          if (TPOOL_CMPXCHG(&queue->head, &pos, pos + 1))
+            {
+              break;
+            }
+        }
+      else if (diff < 0)
+        {
+          /* The cell has not been filled:  The queue is empty */
+
+          return NULL;
+        }
+      else
+        {
+          /* Another consumer claimed the cell */
+
+          pos = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+        }
+    }
+
+  /* Take the work, then release the cell to the producers of the next
+   * lap.
+   */
+
+  work = cell->work;
+  TPOOL_STORE(&cell->seq, pos + TPOOL_QUEUESIZE);
+  return work;
+}
+
+#endif /* CONFIG_LIB_THREADPOOL && !__KERNEL__ */
@@ -0,0 +1,308 @@
+/****************************************************************************
+ * libs/libc/wqueue/tpool_submit.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/semaphore.h>
+
+#include "wqueue/tpool.h"
+
+#if defined(CONFIG_LIB_THREADPOOL) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tpool_execute
+ *
+ * Description:
+ *   Run one work item and signal its completion.  The semaphore is posted
+ *   last:  That is the worker's final access to the work structure.
+ *
+ ****************************************************************************/
+
+static void tpool_execute(FAR struct tpool_work_s *work)
+{
+  TPOOL_STORE(&work->state, TPOOL_WORK_RUNNING);
+  work->result = work->func(work->arg);
+  TPOOL_STORE(&work->state, TPOOL_WORK_DONE);
+
+  if (work->notify != NULL)
+    {
+      work->notify(work);
+    }
+
+  sem_post(&work->done);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tpool_self
+ *
+ * Description:
+ *   Return the worker structure of the calling thread if it is one of the
+ *   pool's workers; NULL otherwise.
+ *
+ ****************************************************************************/
+
+FAR struct tpool_worker_s *tpool_self(FAR struct tpool_s *pool)
+{
+  pthread_t self = pthread_self();
+  int i;
+
+  for (i = 0; i < pool->nworkers; i++)
+    {
+      if (pool->worker[i].thread == self)
+        {
+          return &pool->worker[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tpool_runone
+ *
+ * Description:
+ *   Find one item of work and execute it.  The worker's own deque is tried
+ *   first (newest work first), then the shared queue, and finally the
+ *   deques of the other workers (oldest work first).
+ *
+ * Input Parameters:
+ *   pool - The thread pool
+ *   self - The calling worker
+ *
+ * Returned Value:
+ *   true if work was executed; false if none was found.
+ *
+ ****************************************************************************/
+
+bool tpool_runone(FAR struct tpool_s *pool, FAR struct tpool_worker_s *self)
+{
+  FAR struct tpool_work_s *work;
+  int nworkers;
+  int victim;
+  int i;
+
+  work = tpool_deque_pop(&self->deque);
+  if (work == NULL)
+    {
+      work = tpool_queue_get(&pool->queue);
+    }
+
+  /* The number of workers still grows while the pool is being created */
+
+  nworkers = TPOOL_LOAD(&pool->nworkers);
+  for (i = 1; work == NULL && i < nworkers; i++)
+    {
+      victim = (self->index + i) % nworkers;
+      work   = tpool_deque_steal(&pool->worker[victim].deque);
+    }
+
+  if (work == NULL)
+    {
+      return false;
+    }
+
+  tpool_execute(work);
+  return true;
+}
+
+/****************************************************************************
+ * Name: tpool_work_init
+ *
+ * Description:
+ *   Prepare a work structure for submission.
+ *
+ ****************************************************************************/
+
+void tpool_work_init(FAR struct tpool_work_s *work, tpool_func_t func,
+                     FAR void *arg, tpool_notify_t notify)
+{
+  DEBUGASSERT(work != NULL && func != NULL);
+
+  work->func   = func;
+  work->arg    = arg;
+  work->notify = notify;
+  work->result = NULL;
+  work->pool   = NULL;
+  work->state  = TPOOL_WORK_IDLE;
+}
+
+/****************************************************************************
+ * Name: tpool_submit
+ *
+ * Description:
+ *   Queue work for execution by the thread pool.
+ *
+ ****************************************************************************/
+
+int tpool_submit(FAR struct tpool_s *pool, FAR struct tpool_work_s *work)
+{
+  FAR struct tpool_worker_s *self;
+  int ret = -ENOSPC;
+  uint8_t state;
+
+  DEBUGASSERT(pool != NULL && work != NULL && work->func != NULL);
+
+  /* The state may still be written by the worker finishing the work */
+
+  state = TPOOL_LOAD(&work->state);
+  if (state == TPOOL_WORK_QUEUED || state == TPOOL_WORK_RUNNING)
+    {
+      return EBUSY;
+    }
+
+  /* The completion semaphore is used for signaling, not for mutual
+   * exclusion.
+   */
+
+  sem_init(&work->done, 0, 0);
+  sem_setprotocol(&work->done, SEM_PRIO_NONE);
+
+  work->pool   = pool;
+  work->result = NULL;
+  work->state  = TPOOL_WORK_QUEUED;
+
+  /* Work created by a worker goes to its own deque, where it is cheapest
+   * to reach and where idle workers can steal it.
+   */
+
+  self = tpool_self(pool);
+  if (self != NULL)
+    {
+      ret = tpool_deque_push(&self->deque, work);
+    }
+
+  if (ret < 0)
+    {
+      ret = tpool_queue_put(&pool->queue, work);
+      if (ret < 0)
+        {
+          work->state = TPOOL_WORK_IDLE;
+          sem_destroy(&work->done);
+          return EAGAIN;
+        }
+    }
+
+  /* Wake an idle worker.  The fence pairs with the one in the worker
+   * between announcing that it is idle and looking for work once more.
+   */
+
+  TPOOL_FENCE();
+  if (TPOOL_LOAD(&pool->nidle) > 0)
+    {
+      sem_post(&pool->wake);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tpool_wait
+ *
+ * Description:
+ *   Wait for submitted work to complete and return its result.
+ *
+ ****************************************************************************/
+
+int tpool_wait(FAR struct tpool_work_s *work, FAR void **result)
+{
+  FAR struct tpool_worker_s *self;
+
+  DEBUGASSERT(work != NULL && work->pool != NULL);
+
+  /* A worker must not simply block:  The work it waits for may be sitting
+   * in its own deque.  Help with whatever work is available until the
+   * awaited work is done or there is nothing left to run (then the work
+   * is running on another worker).
+   */
+
+  self = tpool_self(work->pool);
+  if (self != NULL)
+    {
+      while (TPOOL_LOAD(&work->state) != TPOOL_WORK_DONE &&
+             tpool_runone(work->pool, self));
+    }
+
+  /* Wait for the completion to be posted.  This returns at once if the
+   * work has already completed.
+   */
+
+  while (sem_wait(&work->done) < 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  sem_destroy(&work->done);
+
+  if (result != NULL)
+    {
+      *result = work->result;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tpool_done
+ *
+ * Description:
+ *   Check without blocking whether submitted work has completed.
+ *
+ ****************************************************************************/
+
+bool tpool_done(FAR struct tpool_work_s *work)
+{
+  DEBUGASSERT(work != NULL);
+  return TPOOL_LOAD(&work->state) == TPOOL_WORK_DONE;
+}
+
+#endif /* CONFIG_LIB_THREADPOOL && !__KERNEL__ */
@@ -0,0 +1,566 @@
+/****************************************************************************
+ * libs/libdsp/lib_fixed.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Constants in Q15 and Q31 format */
+
+#define ONE_BY_SQRT3_Q15     (18919)
+#define SQRT3_BY_TWO_Q15     (28378)
+#define HALF_Q15             (16384)
+#define ONE_BY_SQRT3_Q31     (1239850262ll)
+#define SQRT3_BY_TWO_Q31     (1859775393ll)
+#define HALF_Q31             (1073741824ll)
+
+/* Rounding constants for the product shifts */
+
+#define ROUND_Q15            (1 << 14)
+#define ROUND_Q31            (1ll << 30)
+
+/* Sine table geometry, see g_sin_q15 */
+
+#define SIN_Q15_LUT_SIZE     256
+#define SIN_Q15_LUT_MASK     (SIN_Q15_LUT_SIZE - 1)
+#define SIN_Q15_LUT_COS      (SIN_Q15_LUT_SIZE / 4)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* sin(2*PI*i/SIN_Q15_LUT_SIZE) in Q15 format, one full period */
+
+static const q15_t g_sin_q15[SIN_Q15_LUT_SIZE] =
+{
+  0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+  6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+  27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+  32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285,
+  32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+  30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683,
+  27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+  23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868,
+  18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+  12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179,
+  6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+  0, -804, -1608, -2410, -3212, -4011, -4808, -5602,
+  -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+  -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+  -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+  -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+  -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+  -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+  -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+  -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+  -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+  -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+  -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+  -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+  -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+  -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179,
+  -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: q15_sat
+ ****************************************************************************/
+
+static inline q15_t q15_sat(int32_t x)
+{
+  if (x > INT16_MAX)
+    {
+      return INT16_MAX;
+    }
+  else if (x < INT16_MIN)
+    {
+      return INT16_MIN;
+    }
+
+  return (q15_t)x;
+}
+
+/****************************************************************************
+ * Name: q31_sat
+ ****************************************************************************/
+
+static inline q31_t q31_sat(int64_t x)
+{
+  if (x > INT32_MAX)
+    {
+      return INT32_MAX;
+    }
+  else if (x < INT32_MIN)
+    {
+      return INT32_MIN;
+    }
+
+  return (q31_t)x;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sincos_q15_batch
+ *
+ * Description:
+ *   Update sine and cosine for n binary angles (65536 = 2PI) in Q15
+ *   format.  The upper 8 bits of the angle select the table entry and the
+ *   lower 8 bits are used for linear interpolation.
+ *
+ * Input Parameters:
+ *   angle - (in/out) pointer to the phase angle data
+ *   n     - (in) number of angles
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sincos_q15_batch(FAR phase_angle_q15_soa_t *angle, size_t n)
+{
+  uint32_t is;
+  uint32_t ic;
+  int32_t  f;
+  int32_t  y0;
+  int32_t  y1;
+  size_t   i;
+
+  DEBUGASSERT(angle != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      is = angle->angle[i] >> 8;
+      ic = (is + SIN_Q15_LUT_COS) & SIN_Q15_LUT_MASK;
+      f  = angle->angle[i] & 0xff;
+
+      y0 = g_sin_q15[is];
+      y1 = g_sin_q15[(is + 1) & SIN_Q15_LUT_MASK];
+      angle->sin[i] = (q15_t)(y0 + (((y1 - y0) * f + 128) >> 8));
+
+      y0 = g_sin_q15[ic];
+      y1 = g_sin_q15[(ic + 1) & SIN_Q15_LUT_MASK];
+      angle->cos[i] = (q15_t)(y0 + (((y1 - y0) * f + 128) >> 8));
+    }
+}
+
+/****************************************************************************
+ * Name: sincos_q31_batch
+ *
+ * Description:
+ *   Update sine and cosine for n binary angles (2^32 = 2PI) in Q31
+ *   format.  The same table as for Q15 is used, with 16 bits of
+ *   interpolation fraction, so the accuracy is limited by the table
+ *   (about 1e-4), not by the output format.
+ *
+ * Input Parameters:
+ *   angle - (in/out) pointer to the phase angle data
+ *   n     - (in) number of angles
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sincos_q31_batch(FAR phase_angle_q31_soa_t *angle, size_t n)
+{
+  uint32_t is;
+  uint32_t ic;
+  int32_t  f;
+  int32_t  y0;
+  int32_t  y1;
+  size_t   i;
+
+  DEBUGASSERT(angle != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      is = angle->angle[i] >> 24;
+      ic = (is + SIN_Q15_LUT_COS) & SIN_Q15_LUT_MASK;
+      f  = (angle->angle[i] >> 8) & 0xffff;
+
+      y0 = g_sin_q15[is];
+      y1 = g_sin_q15[(is + 1) & SIN_Q15_LUT_MASK];
+      angle->sin[i] = y0 * 65536 + (y1 - y0) * f;
+
+      y0 = g_sin_q15[ic];
+      y1 = g_sin_q15[(ic + 1) & SIN_Q15_LUT_MASK];
+      angle->cos[i] = y0 * 65536 + (y1 - y0) * f;
+    }
+}
+
+/****************************************************************************
+ * Name: clarke_transform_q15_batch
+ *
+ * Description:
+ *   Clarke transform for n samples in Q15 format.  Results that do not fit
+ *   in Q15 are saturated.
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_q15_batch(FAR abc_frame_q15_soa_t *abc,
+                                FAR ab_frame_q15_soa_t *ab, size_t n)
+{
+  int32_t a;
+  int32_t b;
+  size_t  i;
+
+  DEBUGASSERT(abc != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      a = abc->a[i];
+      b = abc->b[i];
+
+      /* beta = (a + 2*b)/sqrt(3) */
+
+      ab->a[i] = (q15_t)a;
+      ab->b[i] = q15_sat(((a + 2*b) * ONE_BY_SQRT3_Q15 + ROUND_Q15) >> 15);
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_q15_batch
+ *
+ * Description:
+ *   Inverse Clarke transform for n samples in Q15 format.
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_q15_batch(FAR ab_frame_q15_soa_t *ab,
+                                    FAR abc_frame_q15_soa_t *abc,
+                                    size_t n)
+{
+  int32_t a;
+  int32_t b;
+  size_t  i;
+
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(abc != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      a = ab->a[i];
+      b = q15_sat((SQRT3_BY_TWO_Q15 * (int32_t)ab->b[i] - HALF_Q15 * a +
+                   ROUND_Q15) >> 15);
+
+      abc->a[i] = (q15_t)a;
+      abc->b[i] = (q15_t)b;
+      abc->c[i] = q15_sat(-a - b);
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_q15_batch
+ *
+ * Description:
+ *   Park transform for n samples in Q15 format.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_q15_batch(FAR phase_angle_q15_soa_t *angle,
+                              FAR ab_frame_q15_soa_t *ab,
+                              FAR dq_frame_q15_soa_t *dq, size_t n)
+{
+  int32_t s;
+  int32_t c;
+  int32_t a;
+  int32_t b;
+  size_t  i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(dq != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      s = angle->sin[i];
+      c = angle->cos[i];
+      a = ab->a[i];
+      b = ab->b[i];
+
+      /* sin^2 + cos^2 <= 1, so the sums can not overflow 32 bits */
+
+      dq->d[i] = q15_sat((c*a + s*b + ROUND_Q15) >> 15);
+      dq->q[i] = q15_sat((c*b - s*a + ROUND_Q15) >> 15);
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_q15_batch
+ *
+ * Description:
+ *   Inverse Park transform for n samples in Q15 format.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_q15_batch(FAR phase_angle_q15_soa_t *angle,
+                                  FAR dq_frame_q15_soa_t *dq,
+                                  FAR ab_frame_q15_soa_t *ab, size_t n)
+{
+  int32_t s;
+  int32_t c;
+  int32_t d;
+  int32_t q;
+  size_t  i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(dq != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      s = angle->sin[i];
+      c = angle->cos[i];
+      d = dq->d[i];
+      q = dq->q[i];
+
+      ab->a[i] = q15_sat((c*d - s*q + ROUND_Q15) >> 15);
+      ab->b[i] = q15_sat((c*q + s*d + ROUND_Q15) >> 15);
+    }
+}
+
+/****************************************************************************
+ * Name: clarke_transform_q31_batch
+ *
+ * Description:
+ *   Clarke transform for n samples in Q31 format.
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_q31_batch(FAR abc_frame_q31_soa_t *abc,
+                                FAR ab_frame_q31_soa_t *ab, size_t n)
+{
+  int64_t a;
+  int64_t b;
+  size_t  i;
+
+  DEBUGASSERT(abc != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      a = abc->a[i];
+      b = abc->b[i];
+
+      ab->a[i] = (q31_t)a;
+      ab->b[i] = q31_sat(((a + 2*b) * ONE_BY_SQRT3_Q31 + ROUND_Q31) >> 31);
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_q31_batch
+ *
+ * Description:
+ *   Inverse Clarke transform for n samples in Q31 format.
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_q31_batch(FAR ab_frame_q31_soa_t *ab,
+                                    FAR abc_frame_q31_soa_t *abc,
+                                    size_t n)
+{
+  int64_t a;
+  int64_t b;
+  size_t  i;
+
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(abc != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      a = ab->a[i];
+      b = q31_sat((SQRT3_BY_TWO_Q31 * ab->b[i] - HALF_Q31 * a +
+                   ROUND_Q31) >> 31);
+
+      abc->a[i] = (q31_t)a;
+      abc->b[i] = (q31_t)b;
+      abc->c[i] = q31_sat(-a - b);
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_q31_batch
+ *
+ * Description:
+ *   Park transform for n samples in Q31 format.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_q31_batch(FAR phase_angle_q31_soa_t *angle,
+                              FAR ab_frame_q31_soa_t *ab,
+                              FAR dq_frame_q31_soa_t *dq, size_t n)
+{
+  int64_t s;
+  int64_t c;
+  int64_t a;
+  int64_t b;
+  size_t  i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(dq != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      s = angle->sin[i];
+      c = angle->cos[i];
+      a = ab->a[i];
+      b = ab->b[i];
+
+      dq->d[i] = q31_sat((c*a + s*b + ROUND_Q31) >> 31);
+      dq->q[i] = q31_sat((c*b - s*a + ROUND_Q31) >> 31);
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_q31_batch
+ *
+ * Description:
+ *   Inverse Park transform for n samples in Q31 format.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_q31_batch(FAR phase_angle_q31_soa_t *angle,
+                                  FAR dq_frame_q31_soa_t *dq,
+                                  FAR ab_frame_q31_soa_t *ab, size_t n)
+{
+  int64_t s;
+  int64_t c;
+  int64_t d;
+  int64_t q;
+  size_t  i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(dq != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      s = angle->sin[i];
+      c = angle->cos[i];
+      d = dq->d[i];
+      q = dq->q[i];
+
+      ab->a[i] = q31_sat((c*d - s*q + ROUND_Q31) >> 31);
+      ab->b[i] = q31_sat((c*q + s*d + ROUND_Q31) >> 31);
+    }
+}
@@ -282,3 +282,67 @@ void foc_process(FAR struct foc_data_s *foc,
   foc->v_ab_mod.a = foc->v_ab.a * foc->vab_mod_scale;
   foc->v_ab_mod.b = foc->v_ab.b * foc->vab_mod_scale;
 }
+
+/****************************************************************************
+ * Name: foc_process_batch
+ *
+ * Description:
+ *   Process FOC for n motors in one call.  The phase currents and angles
+ *   of all motors are passed as struct-of-arrays, the per-motor controller
+ *   state is an array of n FOC data structures.
+ *
+ * Input Parameters:
+ *   foc   - (in/out) array of n FOC data structures
+ *   i_abc - (in) pointer to the ABC current frames
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   n     - (in) number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_process_batch(FAR struct foc_data_s *foc,
+                       FAR abc_frame_soa_t *i_abc,
+                       FAR phase_angle_soa_t *angle, size_t n)
+{
+  FAR struct foc_data_s *m;
+  float s;
+  float c;
+  size_t i;
+
+  DEBUGASSERT(foc != NULL);
+  DEBUGASSERT(i_abc != NULL);
+  DEBUGASSERT(angle != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      m = &foc[i];
+      s = angle->sin[i];
+      c = angle->cos[i];
+
+      /* Clarke and Park transforms (abc current -> dq current) */
+
+      m->i_abc.a = i_abc->a[i];
+      m->i_abc.b = i_abc->b[i];
+      m->i_abc.c = i_abc->c[i];
+
+      m->i_ab.a = m->i_abc.a;
+      m->i_ab.b = ONE_BY_SQRT3_F*m->i_abc.a + TWO_BY_SQRT3_F*m->i_abc.b;
+
+      m->i_dq.d = c*m->i_ab.a + s*m->i_ab.b;
+      m->i_dq.q = c*m->i_ab.b - s*m->i_ab.a;
+
+      /* Run FOC current control (current dq -> voltage dq) */
+
+      foc_current_control(m);
+
+      /* Inverse Park transform and alpha-beta voltage normalization */
+
+      m->v_ab.a = c*m->v_dq.d - s*m->v_dq.q;
+      m->v_ab.b = c*m->v_dq.q + s*m->v_dq.d;
+
+      m->v_ab_mod.a = m->v_ab.a * m->vab_mod_scale;
+      m->v_ab_mod.b = m->v_ab.b * m->vab_mod_scale;
+    }
+}
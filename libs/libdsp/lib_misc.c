@@ -471,6 +471,8 @@ void phase_angle_update(FAR struct phase_angle_s *angle, float val)
 #elif CONFIG_LIBDSP_PRECISION == 2
   angle->sin = sin(val);
   angle->cos = cos(val);
+#elif CONFIG_LIBDSP_PRECISION == 3
+  fast_sincos(val, &angle->sin, &angle->cos);
 #else
   angle->sin = fast_sin(val);
   angle->cos = fast_cos(val);
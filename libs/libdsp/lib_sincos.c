@@ -0,0 +1,249 @@
+/****************************************************************************
+ * libs/libdsp/lib_sincos.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The table covers one full period so that sine and cosine share it;
+ * cosine is read a quarter period (SINCOS_LUT_SIZE/4 entries) ahead.
+ * With linear interpolation between entries the maximum absolute error
+ * is about 7.5e-5.
+ */
+
+#define SINCOS_LUT_SIZE   256
+#define SINCOS_LUT_MASK   (SINCOS_LUT_SIZE - 1)
+#define SINCOS_LUT_COS    (SINCOS_LUT_SIZE / 4)
+#define SINCOS_LUT_SCALE  ((float)SINCOS_LUT_SIZE / (2.0f*M_PI_F))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* sin(2*PI*i/SINCOS_LUT_SIZE) */
+
+static const float g_sincos_lut[SINCOS_LUT_SIZE] =
+{
+  0.000000000f, 0.024541229f, 0.049067674f, 0.073564564f,
+  0.098017140f, 0.122410675f, 0.146730474f, 0.170961889f,
+  0.195090322f, 0.219101240f, 0.242980180f, 0.266712757f,
+  0.290284677f, 0.313681740f, 0.336889853f, 0.359895037f,
+  0.382683432f, 0.405241314f, 0.427555093f, 0.449611330f,
+  0.471396737f, 0.492898192f, 0.514102744f, 0.534997620f,
+  0.555570233f, 0.575808191f, 0.595699304f, 0.615231591f,
+  0.634393284f, 0.653172843f, 0.671558955f, 0.689540545f,
+  0.707106781f, 0.724247083f, 0.740951125f, 0.757208847f,
+  0.773010453f, 0.788346428f, 0.803207531f, 0.817584813f,
+  0.831469612f, 0.844853565f, 0.857728610f, 0.870086991f,
+  0.881921264f, 0.893224301f, 0.903989293f, 0.914209756f,
+  0.923879533f, 0.932992799f, 0.941544065f, 0.949528181f,
+  0.956940336f, 0.963776066f, 0.970031253f, 0.975702130f,
+  0.980785280f, 0.985277642f, 0.989176510f, 0.992479535f,
+  0.995184727f, 0.997290457f, 0.998795456f, 0.999698819f,
+  1.000000000f, 0.999698819f, 0.998795456f, 0.997290457f,
+  0.995184727f, 0.992479535f, 0.989176510f, 0.985277642f,
+  0.980785280f, 0.975702130f, 0.970031253f, 0.963776066f,
+  0.956940336f, 0.949528181f, 0.941544065f, 0.932992799f,
+  0.923879533f, 0.914209756f, 0.903989293f, 0.893224301f,
+  0.881921264f, 0.870086991f, 0.857728610f, 0.844853565f,
+  0.831469612f, 0.817584813f, 0.803207531f, 0.788346428f,
+  0.773010453f, 0.757208847f, 0.740951125f, 0.724247083f,
+  0.707106781f, 0.689540545f, 0.671558955f, 0.653172843f,
+  0.634393284f, 0.615231591f, 0.595699304f, 0.575808191f,
+  0.555570233f, 0.534997620f, 0.514102744f, 0.492898192f,
+  0.471396737f, 0.449611330f, 0.427555093f, 0.405241314f,
+  0.382683432f, 0.359895037f, 0.336889853f, 0.313681740f,
+  0.290284677f, 0.266712757f, 0.242980180f, 0.219101240f,
+  0.195090322f, 0.170961889f, 0.146730474f, 0.122410675f,
+  0.098017140f, 0.073564564f, 0.049067674f, 0.024541229f,
+  0.000000000f, -0.024541229f, -0.049067674f, -0.073564564f,
+  -0.098017140f, -0.122410675f, -0.146730474f, -0.170961889f,
+  -0.195090322f, -0.219101240f, -0.242980180f, -0.266712757f,
+  -0.290284677f, -0.313681740f, -0.336889853f, -0.359895037f,
+  -0.382683432f, -0.405241314f, -0.427555093f, -0.449611330f,
+  -0.471396737f, -0.492898192f, -0.514102744f, -0.534997620f,
+  -0.555570233f, -0.575808191f, -0.595699304f, -0.615231591f,
+  -0.634393284f, -0.653172843f, -0.671558955f, -0.689540545f,
+  -0.707106781f, -0.724247083f, -0.740951125f, -0.757208847f,
+  -0.773010453f, -0.788346428f, -0.803207531f, -0.817584813f,
+  -0.831469612f, -0.844853565f, -0.857728610f, -0.870086991f,
+  -0.881921264f, -0.893224301f, -0.903989293f, -0.914209756f,
+  -0.923879533f, -0.932992799f, -0.941544065f, -0.949528181f,
+  -0.956940336f, -0.963776066f, -0.970031253f, -0.975702130f,
+  -0.980785280f, -0.985277642f, -0.989176510f, -0.992479535f,
+  -0.995184727f, -0.997290457f, -0.998795456f, -0.999698819f,
+  -1.000000000f, -0.999698819f, -0.998795456f, -0.997290457f,
+  -0.995184727f, -0.992479535f, -0.989176510f, -0.985277642f,
+  -0.980785280f, -0.975702130f, -0.970031253f, -0.963776066f,
+  -0.956940336f, -0.949528181f, -0.941544065f, -0.932992799f,
+  -0.923879533f, -0.914209756f, -0.903989293f, -0.893224301f,
+  -0.881921264f, -0.870086991f, -0.857728610f, -0.844853565f,
+  -0.831469612f, -0.817584813f, -0.803207531f, -0.788346428f,
+  -0.773010453f, -0.757208847f, -0.740951125f, -0.724247083f,
+  -0.707106781f, -0.689540545f, -0.671558955f, -0.653172843f,
+  -0.634393284f, -0.615231591f, -0.595699304f, -0.575808191f,
+  -0.555570233f, -0.534997620f, -0.514102744f, -0.492898192f,
+  -0.471396737f, -0.449611330f, -0.427555093f, -0.405241314f,
+  -0.382683432f, -0.359895037f, -0.336889853f, -0.313681740f,
+  -0.290284677f, -0.266712757f, -0.242980180f, -0.219101240f,
+  -0.195090322f, -0.170961889f, -0.146730474f, -0.122410675f,
+  -0.098017140f, -0.073564564f, -0.049067674f, -0.024541229f,
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fast_sincos
+ *
+ * Description:
+ *   Table based sine and cosine with linear interpolation.  Both values
+ *   are obtained from a single table index calculation.
+ *
+ * Input Parameters:
+ *   angle - (in) angle in radians, no normalization is required
+ *   s     - (out) sine of the angle
+ *   c     - (out) cosine of the angle
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fast_sincos(float angle, FAR float *s, FAR float *c)
+{
+  float    x;
+  float    f;
+  int32_t  i;
+  uint32_t is;
+  uint32_t ic;
+
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(c != NULL);
+
+  /* Split the angle into the table index and the interpolation fraction */
+
+  x = angle * SINCOS_LUT_SCALE;
+  i = (int32_t)x;
+
+  if ((float)i > x)
+    {
+      i -= 1;
+    }
+
+  f  = x - (float)i;
+  is = (uint32_t)i & SINCOS_LUT_MASK;
+  ic = ((uint32_t)i + SINCOS_LUT_COS) & SINCOS_LUT_MASK;
+
+  *s = g_sincos_lut[is] +
+       f * (g_sincos_lut[(is + 1) & SINCOS_LUT_MASK] - g_sincos_lut[is]);
+  *c = g_sincos_lut[ic] +
+       f * (g_sincos_lut[(ic + 1) & SINCOS_LUT_MASK] - g_sincos_lut[ic]);
+}
+
+/****************************************************************************
+ * Name: fast_sincos_batch
+ *
+ * Description:
+ *   fast_sincos() for n angles.
+ *
+ * Input Parameters:
+ *   angle - (in) array of angles in radians
+ *   s     - (out) array of sine values
+ *   c     - (out) array of cosine values
+ *   n     - (in) number of angles
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fast_sincos_batch(FAR const float *angle, FAR float *s, FAR float *c,
+                       size_t n)
+{
+  size_t i;
+
+  DEBUGASSERT(angle != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      fast_sincos(angle[i], &s[i], &c[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: phase_angle_update_batch
+ *
+ * Description:
+ *   phase_angle_update() for n angles stored as struct-of-arrays.  The
+ *   sine and cosine are always taken from the interpolated table.
+ *
+ * Input Parameters:
+ *   angle - (out) pointer to the phase angle data
+ *   val   - (in) array of angle radian values
+ *   n     - (in) number of angles
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void phase_angle_update_batch(FAR phase_angle_soa_t *angle,
+                              FAR const float *val, size_t n)
+{
+  float  v;
+  size_t i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(val != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      /* Normalize angle to <0.0, 2PI> */
+
+      v = val[i];
+      angle_norm_2pi(&v, 0.0f, 2.0f*M_PI_F);
+
+      angle->angle[i] = v;
+      fast_sincos(v, &angle->sin[i], &angle->cos[i]);
+    }
+}
@@ -162,3 +162,198 @@ void inv_park_transform(FAR phase_angle_t *angle,
   ab->a = angle->cos * dq->d - angle->sin * dq->q;
   ab->b = angle->cos * dq->q + angle->sin * dq->d;
 }
+
+/****************************************************************************
+ * Name: clarke_transform_batch
+ *
+ * Description:
+ *   Clarke transform for n samples stored as struct-of-arrays.
+ *   The loop body has no dependencies between samples, so the compiler is
+ *   free to vectorize it.
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch(FAR abc_frame_soa_t *abc,
+                            FAR ab_frame_soa_t *ab, size_t n)
+{
+  FAR const float *a_in;
+  FAR const float *b_in;
+  FAR float *a_out;
+  FAR float *b_out;
+  size_t i;
+
+  DEBUGASSERT(abc != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  a_in = abc->a;
+  b_in = abc->b;
+  a_out = ab->a;
+  b_out = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      float a = a_in[i];
+      float b = b_in[i];
+
+      a_out[i] = a;
+      b_out[i] = ONE_BY_SQRT3_F*a + TWO_BY_SQRT3_F*b;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch
+ *
+ * Description:
+ *   Inverse Clarke transform for n samples stored as struct-of-arrays.
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch(FAR ab_frame_soa_t *ab,
+                                FAR abc_frame_soa_t *abc, size_t n)
+{
+  FAR const float *a_in;
+  FAR const float *b_in;
+  FAR float *a_out;
+  FAR float *b_out;
+  FAR float *c_out;
+  size_t i;
+
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(abc != NULL);
+
+  a_in = ab->a;
+  b_in = ab->b;
+  a_out = abc->a;
+  b_out = abc->b;
+  c_out = abc->c;
+
+  for (i = 0; i < n; i++)
+    {
+      float a = a_in[i];
+      float b = -0.5f*a + SQRT3_BY_TWO_F*b_in[i];
+
+      a_out[i] = a;
+      b_out[i] = b;
+      c_out[i] = -a - b;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch
+ *
+ * Description:
+ *   Park transform for n samples stored as struct-of-arrays.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch(FAR phase_angle_soa_t *angle,
+                          FAR ab_frame_soa_t *ab,
+                          FAR dq_frame_soa_t *dq, size_t n)
+{
+  FAR const float *s_in;
+  FAR const float *c_in;
+  FAR const float *a_in;
+  FAR const float *b_in;
+  FAR float *d_out;
+  FAR float *q_out;
+  size_t i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(dq != NULL);
+
+  s_in = angle->sin;
+  c_in = angle->cos;
+  a_in = ab->a;
+  b_in = ab->b;
+  d_out = dq->d;
+  q_out = dq->q;
+
+  for (i = 0; i < n; i++)
+    {
+      float s = s_in[i];
+      float c = c_in[i];
+      float a = a_in[i];
+      float b = b_in[i];
+
+      d_out[i] = c*a + s*b;
+      q_out[i] = c*b - s*a;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch
+ *
+ * Description:
+ *   Inverse Park transform for n samples stored as struct-of-arrays.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angle data (sin/cos must be valid)
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch(FAR phase_angle_soa_t *angle,
+                              FAR dq_frame_soa_t *dq,
+                              FAR ab_frame_soa_t *ab, size_t n)
+{
+  FAR const float *s_in;
+  FAR const float *c_in;
+  FAR const float *d_in;
+  FAR const float *q_in;
+  FAR float *a_out;
+  FAR float *b_out;
+  size_t i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(dq != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  s_in = angle->sin;
+  c_in = angle->cos;
+  d_in = dq->d;
+  q_in = dq->q;
+  a_out = ab->a;
+  b_out = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      float s = s_in[i];
+      float c = c_in[i];
+      float d = d_in[i];
+      float q = q_in[i];
+
+      a_out[i] = c*d - s*q;
+      b_out[i] = c*q + s*d;
+    }
+}
@@ -53,6 +53,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <semaphore.h>
 #include <errno.h>
 
@@ -78,6 +79,14 @@
 #  define CONFIG_ARP_SEND_DELAYMSEC 20
 #endif
 
+#ifndef CONFIG_NET_ARP_HASHSIZE
+#  define CONFIG_NET_ARP_HASHSIZE 8
+#endif
+
+#ifndef CONFIG_NET_ARP_NEGAGE
+#  define CONFIG_NET_ARP_NEGAGE 0
+#endif
+
 /* ARP Definitions **********************************************************/
 
 #define ARP_REQUEST    1
@@ -128,6 +137,12 @@ struct arp_iphdr_s
   uint16_t eh_ipoption[2];   /* (optional) */
 };
 
+/* Callback type used by arp_foreach() */
+
+struct arp_entry_s;  /* Forward reference */
+typedef int (*arp_entry_callback_t)(FAR struct arp_entry_s *entry,
+                                    FAR void *arg);
+
 #ifdef CONFIG_NET_ARP_SEND
 /* This structure holds the state of the send operation until it can be
  * operated upon from the network driver poll.
@@ -382,6 +397,16 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr);
 
 void arp_delete(in_addr_t ipaddr);
 
+/****************************************************************************
+ * Name: arp_initialize
+ *
+ * Description:
+ *   Initialize the ARP table.
+ *
+ ****************************************************************************/
+
+void arp_initialize(void);
+
 /****************************************************************************
  * Name: arp_update
  *
@@ -426,6 +451,73 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
 
+/****************************************************************************
+ * Name: arp_negative_add
+ *
+ * Description:
+ *   Record that address resolution for this IP address has failed.  Until
+ *   the negative entry expires, arp_is_negative() will report the address
+ *   as unreachable.  A valid mapping is never replaced by a negative entry.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_NEGAGE > 0
+void arp_negative_add(in_addr_t ipaddr);
+#else
+#  define arp_negative_add(i)
+#endif
+
+/****************************************************************************
+ * Name: arp_is_negative
+ *
+ * Description:
+ *   Check if there is an unexpired negative entry for this IP address.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *
+ * Returned Value:
+ *   True if address resolution recently failed for this IP address.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_NEGAGE > 0
+bool arp_is_negative(in_addr_t ipaddr);
+#else
+#  define arp_is_negative(i) (false)
+#endif
+
+/****************************************************************************
+ * Name: arp_foreach
+ *
+ * Description:
+ *   Enumerate each in-use entry in the ARP table.
+ *
+ * Input Parameters:
+ *   callback - Will be called for each entry.  Enumeration stops if the
+ *              callback returns a non-zero value.
+ *   arg      - An arbitrary argument passed to the callback.
+ *
+ * Returned Value:
+ *   The non-zero value returned by the callback that terminated the
+ *   enumeration; zero if all entries were visited.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+int arp_foreach(arp_entry_callback_t callback, FAR void *arg);
+
 /****************************************************************************
  * Name: arp_dump
  *
@@ -450,6 +542,7 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 
 /* If ARP is disabled, stub out all ARP interfaces */
 
+#  define arp_initialize()
 #  define arp_format(d,i);
 #  define arp_send(i) (0)
 #  define arp_poll(d,c) (0)
@@ -461,6 +554,8 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_delete(i)
 #  define arp_update(i,m);
 #  define arp_hdr_update(i,m);
+#  define arp_negative_add(i)
+#  define arp_is_negative(i) (false)
 #  define arp_dump(arp)
 
 #endif /* CONFIG_NET_ARP */
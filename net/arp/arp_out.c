@@ -254,6 +254,17 @@ void arp_out(FAR struct net_driver_s *dev)
   ret = arp_find(ipaddr, &ethaddr);
   if (ret < 0)
     {
+      /* Don't flood the network with requests for an address that did
+       * not respond recently.  Just drop the packet.
+       */
+
+      if (arp_is_negative(ipaddr))
+        {
+          ninfo("Negative ARP entry for IP %08lx\n", (unsigned long)ipaddr);
+          dev->d_len = 0;
+          return;
+        }
+
       ninfo("ARP request for IP %08lx\n", (unsigned long)ipaddr);
 
       /* The destination address was not in our ARP table, so we overwrite
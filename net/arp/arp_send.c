@@ -296,6 +296,17 @@ int arp_send(in_addr_t ipaddr)
    */
 
   net_lock();
+
+  /* Fail immediately if address resolution recently failed for this
+   * address.
+   */
+
+  if (arp_is_negative(ipaddr))
+    {
+      ret = -EHOSTUNREACH;
+      goto errout_with_lock;
+    }
+
   state.snd_cb = arp_callback_alloc(dev);
   if (!state.snd_cb)
     {
@@ -406,6 +417,13 @@ int arp_send(in_addr_t ipaddr)
       nerr("ERROR: arp_wait failed: %d\n", ret);
     }
 
+  /* Remember the failure so that the next attempt does not stall again */
+
+  if (ret == -ETIMEDOUT)
+    {
+      arp_negative_add(ipaddr);
+    }
+
   nxsem_destroy(&state.snd_sem);
   arp_callback_free(dev, state.snd_cb);
 errout_with_lock:
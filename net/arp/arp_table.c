@@ -48,7 +48,11 @@
 
 #include <sys/ioctl.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
 #include <debug.h>
 
 #include <netinet/in.h>
@@ -72,6 +76,18 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+#if CONFIG_NET_ARP_NEGAGE > 0
+#  define ARP_NEGAGE_TICK DSEC2TICK(CONFIG_NET_ARP_NEGAGE)
+#endif
+
+/* Hash an IPv4 address (network order) into the ARP hash table.  All four
+ * octets are folded so that hosts on the same sub-net spread evenly.
+ */
+
+#define ARP_HASH(a) \
+  ((uint32_t)((a) ^ ((a) >> 8) ^ ((a) >> 16) ^ ((a) >> 24)) % \
+   CONFIG_NET_ARP_HASHSIZE)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,13 +98,35 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One ARP table entry with its hash chain and LRU list linkage.  The
+ * public arp_entry_s is what is returned to callers of arp_lookup().
+ */
+
+struct arp_table_entry_s
+{
+  dq_entry_t                    ae_node;   /* LRU list link.  Must be first */
+  FAR struct arp_table_entry_s *ae_hnext;  /* Next entry in the hash chain */
+  struct arp_entry_s            ae_entry;  /* The ARP table entry */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 /* The table of known address mappings */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct arp_table_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+
+/* Hash table of in-use entries, indexed by ARP_HASH() of the IP address */
+
+static FAR struct arp_table_entry_s *g_arphash[CONFIG_NET_ARP_HASHSIZE];
+
+/* All table entries ordered from least recently used (head) to most
+ * recently used (tail).  Unused entries are kept at the head so that they
+ * are always selected for re-use before any valid mapping is evicted.
+ */
+
+static dq_queue_t g_arplru;
 
 /****************************************************************************
  * Private Functions
@@ -141,38 +179,141 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_table_find
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Find the in-use ARP table entry for this IP address, regardless of its
+ *   age or whether it is a negative entry.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static FAR struct arp_table_entry_s *arp_table_find(in_addr_t ipaddr)
 {
-  if (e1->at_ipaddr == 0)
+  FAR struct arp_table_entry_s *tabptr;
+
+  if (ipaddr == 0)
     {
-      return e1;
+      return NULL;
     }
-  else if (e2->at_ipaddr == 0)
+
+  for (tabptr = g_arphash[ARP_HASH(ipaddr)];
+       tabptr != NULL;
+       tabptr = tabptr->ae_hnext)
     {
-      return e2;
+      if (net_ipv4addr_cmp(ipaddr, tabptr->ae_entry.at_ipaddr))
+        {
+          return tabptr;
+        }
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_table_remove
+ *
+ * Description:
+ *   Remove an in-use entry from its hash chain and return it to the head
+ *   of the LRU list so that it is the first to be re-used.
+ *
+ ****************************************************************************/
+
+static void arp_table_remove(FAR struct arp_table_entry_s *tabptr)
+{
+  FAR struct arp_table_entry_s **pprev;
+
+  pprev = &g_arphash[ARP_HASH(tabptr->ae_entry.at_ipaddr)];
+  while (*pprev != NULL)
     {
-      return e1;
+      if (*pprev == tabptr)
+        {
+          *pprev = tabptr->ae_hnext;
+          break;
+        }
+
+      pprev = &(*pprev)->ae_hnext;
     }
-  else
+
+  memset(&tabptr->ae_entry, 0, sizeof(struct arp_entry_s));
+  tabptr->ae_hnext = NULL;
+
+  dq_rem(&tabptr->ae_node, &g_arplru);
+  dq_addfirst(&tabptr->ae_node, &g_arplru);
+}
+
+/****************************************************************************
+ * Name: arp_table_touch
+ *
+ * Description:
+ *   Make the entry the most recently used one.
+ *
+ ****************************************************************************/
+
+static inline void arp_table_touch(FAR struct arp_table_entry_s *tabptr)
+{
+  dq_rem(&tabptr->ae_node, &g_arplru);
+  dq_addlast(&tabptr->ae_node, &g_arplru);
+}
+
+/****************************************************************************
+ * Name: arp_table_alloc
+ *
+ * Description:
+ *   Allocate an entry for this IP address, evicting the least recently
+ *   used entry if the table is full.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_entry_s *arp_table_alloc(in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *tabptr;
+  int ndx;
+
+  tabptr = (FAR struct arp_table_entry_s *)dq_peek(&g_arplru);
+  DEBUGASSERT(tabptr != NULL);
+
+  if (tabptr->ae_entry.at_ipaddr != 0)
     {
-      return e2;
+      arp_table_remove(tabptr);
     }
+
+  ndx                        = ARP_HASH(ipaddr);
+  tabptr->ae_entry.at_ipaddr = ipaddr;
+  tabptr->ae_hnext           = g_arphash[ndx];
+  g_arphash[ndx]             = tabptr;
+
+  arp_table_touch(tabptr);
+  return tabptr;
 }
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: arp_initialize
+ *
+ * Description:
+ *   Initialize the ARP table.  All entries are initially unused and placed
+ *   on the LRU list.
+ *
+ * Assumptions:
+ *   Called early in the initialization sequence so that no special
+ *   protection is required.
+ *
+ ****************************************************************************/
+
+void arp_initialize(void)
+{
+  int i;
+
+  dq_init(&g_arplru);
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; i++)
+    {
+      dq_addlast(&g_arptable[i].ae_node, &g_arplru);
+    }
+}
+
 /****************************************************************************
  * Name: arp_update
  *
@@ -195,43 +336,34 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_table_entry_s *tabptr;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
-   */
-
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  if (ipaddr == 0)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
+      return -EINVAL;
+    }
 
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
+  /* Find the existing entry for this IP address.  If none is found, the
+   * IP -> MAC address mapping is inserted in the least recently used
+   * entry of the ARP table.
+   */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+  tabptr = arp_table_find(ipaddr);
+  if (tabptr == NULL)
+    {
+      tabptr = arp_table_alloc(ipaddr);
+    }
+  else
+    {
+      arp_table_touch(tabptr);
     }
 
-  /* Now, tabptr is the ARP table entry which we will fill with the new
-   * information.
-   */
+  /* A valid mapping replaces any negative entry for the address */
 
-  tabptr->at_ipaddr = ipaddr;
-  memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_time = clock_systimer();
+  memcpy(tabptr->ae_entry.at_ethaddr.ether_addr_octet, ethaddr,
+         ETHER_ADDR_LEN);
+  tabptr->ae_entry.at_time   = clock_systimer();
+  tabptr->ae_entry.at_flags &= ~ARP_FLAG_NEGATIVE;
   return OK;
 }
 
@@ -281,19 +413,18 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
 
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  FAR struct arp_table_entry_s *tabptr;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_table_find(ipaddr);
+  if (tabptr != NULL &&
+      (tabptr->ae_entry.at_flags & ARP_FLAG_NEGATIVE) == 0 &&
+      clock_systimer() - tabptr->ae_entry.at_time <= ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systimer() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      tabptr->ae_entry.at_hits++;
+      arp_table_touch(tabptr);
+      return &tabptr->ae_entry;
     }
 
   /* Not found */
@@ -380,17 +511,142 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
 void arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_table_entry_s *tabptr;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
+  tabptr = arp_table_find(ipaddr);
   if (tabptr != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Unlink it and make it the next entry to be re-used */
+
+      arp_table_remove(tabptr);
+    }
+}
+
+/****************************************************************************
+ * Name: arp_negative_add
+ *
+ * Description:
+ *   Record that address resolution for this IP address has failed.  Until
+ *   the negative entry expires, arp_is_negative() will report the address
+ *   as unreachable so that callers can fail fast instead of repeating the
+ *   full ARP request/retry cycle.  A valid mapping is never replaced by a
+ *   negative entry.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_NEGAGE > 0
+void arp_negative_add(in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *tabptr;
+
+  if (ipaddr == 0)
+    {
+      return;
+    }
+
+  tabptr = arp_table_find(ipaddr);
+  if (tabptr == NULL)
+    {
+      tabptr = arp_table_alloc(ipaddr);
+    }
+  else if ((tabptr->ae_entry.at_flags & ARP_FLAG_NEGATIVE) == 0 &&
+           clock_systimer() - tabptr->ae_entry.at_time <= ARP_MAXAGE_TICK)
+    {
+      return;
+    }
+
+  memset(&tabptr->ae_entry.at_ethaddr, 0, sizeof(struct ether_addr));
+  tabptr->ae_entry.at_time   = clock_systimer();
+  tabptr->ae_entry.at_flags |= ARP_FLAG_NEGATIVE;
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_is_negative
+ *
+ * Description:
+ *   Check if there is an unexpired negative entry for this IP address.
+ *   Expired negative entries are released as a side effect.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *
+ * Returned Value:
+ *   True if address resolution recently failed for this IP address.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_NEGAGE > 0
+bool arp_is_negative(in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *tabptr;
+
+  tabptr = arp_table_find(ipaddr);
+  if (tabptr == NULL ||
+      (tabptr->ae_entry.at_flags & ARP_FLAG_NEGATIVE) == 0)
+    {
+      return false;
+    }
+
+  if (clock_systimer() - tabptr->ae_entry.at_time <= ARP_NEGAGE_TICK)
+    {
+      tabptr->ae_entry.at_hits++;
+      return true;
+    }
+
+  /* The negative entry has expired.  Free it for re-use. */
+
+  arp_table_remove(tabptr);
+  return false;
+}
+#endif
 
-      tabptr->at_ipaddr = 0;
+/****************************************************************************
+ * Name: arp_foreach
+ *
+ * Description:
+ *   Enumerate each in-use entry in the ARP table.  This is used by procfs
+ *   to show the content of the ARP cache.
+ *
+ * Input Parameters:
+ *   callback - Will be called for each entry.  Enumeration stops if the
+ *              callback returns a non-zero value.
+ *   arg      - An arbitrary argument passed to the callback.
+ *
+ * Returned Value:
+ *   The non-zero value returned by the callback that terminated the
+ *   enumeration; zero if all entries were visited.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+int arp_foreach(arp_entry_callback_t callback, FAR void *arg)
+{
+  int ret = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE && ret == 0; i++)
+    {
+      if (g_arptable[i].ae_entry.at_ipaddr != 0)
+        {
+          ret = callback(&g_arptable[i].ae_entry, arg);
+        }
     }
+
+  return ret;
 }
 
 #endif /* CONFIG_NET_ARP */
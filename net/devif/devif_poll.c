@@ -389,6 +389,7 @@ static inline int devif_poll_icmpv6(FAR struct net_driver_s *dev,
  *
  * Description:
  *   Poll the device event to see if any task is waiting to forward a packet.
+ *   Up to CONFIG_NET_IPFORWARD_BATCH queued packets are sent in one poll.
  *
  ****************************************************************************/
 
@@ -396,18 +397,38 @@ static inline int devif_poll_icmpv6(FAR struct net_driver_s *dev,
 static inline int devif_poll_forward(FAR struct net_driver_s *dev,
                                      devif_poll_callback_t callback)
 {
-  /* Perform the forwarding poll */
+  int navail;
+  int bstop;
+  int i;
 
-  ipfwd_poll(dev);
+  for (i = 0; i < CONFIG_NET_IPFORWARD_BATCH; i++)
+    {
+      /* Perform the forwarding poll */
 
-  /* NOTE: that 6LoWPAN packet conversions are handled differently for
-   * forwarded packets.  That is because we don't know what the packet
-   * type is at this point; not within peeking into the device's d_buf.
-   */
+      navail = ipfwd_navail();
+      ipfwd_poll(dev);
 
-  /* Call back into the driver */
+      /* NOTE: that 6LoWPAN packet conversions are handled differently for
+       * forwarded packets.  That is because we don't know what the packet
+       * type is at this point; not within peeking into the device's d_buf.
+       */
 
-  return callback(dev);
+      /* Call back into the driver */
+
+      bstop = callback(dev);
+
+      /* Stop if the driver can take no more or if no forwarding structure
+       * was released:  Either nothing is pending or the pending packet is
+       * still waiting for an ARP or Neighbor response.
+       */
+
+      if (bstop || ipfwd_navail() <= navail)
+        {
+          break;
+        }
+    }
+
+  return bstop;
 }
 #endif /* CONFIG_NET_ICMPv6_SOCKET || CONFIG_NET_ICMPv6_NEIGHBOR*/
 
@@ -471,11 +492,38 @@ static inline int devif_poll_mld(FAR struct net_driver_s *dev,
 }
 #endif /* CONFIG_NET_MLD */
 
+/****************************************************************************
+ * Name: devif_pollwanted
+ *
+ * Description:
+ *   Return true if any callback in the connection's callback list is still
+ *   waiting for a poll event.  UDP_POLL has the same value as TCP_POLL.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TXPENDING) && \
+    (defined(NET_UDP_HAVE_STACK) || defined(NET_TCP_HAVE_STACK))
+static bool devif_pollwanted(FAR struct devif_callback_s *list)
+{
+  for (; list != NULL; list = list->nxtconn)
+    {
+      if ((list->flags & TCP_POLL) != 0)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Name: devif_poll_udp_connections
  *
  * Description:
- *   Poll all UDP connections for available packets to send.
+ *   Poll all UDP connections for available packets to send.  If
+ *   CONFIG_NET_TXPENDING is selected and 'full' is false, then only the
+ *   UDP connections with pending output are polled.
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
@@ -485,17 +533,59 @@ static inline int devif_poll_mld(FAR struct net_driver_s *dev,
 
 #ifdef NET_UDP_HAVE_STACK
 static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
-                                      devif_poll_callback_t callback)
+                                      devif_poll_callback_t callback,
+                                      bool full)
 {
   FAR struct udp_conn_s *conn = NULL;
   int bstop = 0;
 
+#ifdef CONFIG_NET_TXPENDING
+  if (!full)
+    {
+      FAR struct udp_conn_s *next;
+
+      /* Traverse only the UDP connections with pending output */
+
+      for (conn = udp_nextpending(NULL); !bstop && conn != NULL; conn = next)
+        {
+          /* The poll may remove the connection from the pending list */
+
+          next = udp_nextpending(conn);
+
+          /* Perform the UDP TX poll */
+
+          NETDEV_TXPOLLS(dev);
+          udp_poll(dev, conn);
+
+          /* Drop the connection from the pending list when nothing is
+           * waiting for another poll.
+           */
+
+          if (!devif_pollwanted(conn->list))
+            {
+              udp_txdone(conn);
+            }
+
+          /* Perform any necessary conversions on outgoing packets */
+
+          devif_packet_conversion(dev, DEVIF_UDP);
+
+          /* Call back into the driver */
+
+          bstop = callback(dev);
+        }
+
+      return bstop;
+    }
+#endif
+
   /* Traverse all of the allocated UDP connections and perform the poll action */
 
   while (!bstop && (conn = udp_nextconn(conn)))
     {
       /* Perform the UDP TX poll */
 
+      NETDEV_TXPOLLS(dev);
       udp_poll(dev, conn);
 
       /* Perform any necessary conversions on outgoing packets */
@@ -515,7 +605,9 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
  * Name: devif_poll_tcp_connections
  *
  * Description:
- *   Poll all UDP connections for available packets to send.
+ *   Poll all TCP connections for available packets to send.  If
+ *   CONFIG_NET_TXPENDING is selected and 'full' is false, then only the
+ *   TCP connections with pending output are polled.
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
@@ -525,17 +617,59 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 
 #ifdef NET_TCP_HAVE_STACK
 static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
-                                             devif_poll_callback_t callback)
+                                             devif_poll_callback_t callback,
+                                             bool full)
 {
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
 
+#ifdef CONFIG_NET_TXPENDING
+  if (!full)
+    {
+      FAR struct tcp_conn_s *next;
+
+      /* Traverse only the TCP connections with pending output */
+
+      for (conn = tcp_nextpending(NULL); !bstop && conn != NULL; conn = next)
+        {
+          /* The poll may remove the connection from the pending list */
+
+          next = tcp_nextpending(conn);
+
+          /* Perform the TCP TX poll */
+
+          NETDEV_TXPOLLS(dev);
+          tcp_poll(dev, conn);
+
+          /* Drop the connection from the pending list when nothing is
+           * waiting for another poll.
+           */
+
+          if (!devif_pollwanted(conn->list))
+            {
+              tcp_txdone(conn);
+            }
+
+          /* Perform any necessary conversions on outgoing packets */
+
+          devif_packet_conversion(dev, DEVIF_TCP);
+
+          /* Call back into the driver */
+
+          bstop = callback(dev);
+        }
+
+      return bstop;
+    }
+#endif
+
   /* Traverse all of the active TCP connections and perform the poll action */
 
   while (!bstop && (conn = tcp_nextconn(conn)))
     {
       /* Perform the TCP TX poll */
 
+      NETDEV_TXPOLLS(dev);
       tcp_poll(dev, conn);
 
       /* Perform any necessary conversions on outgoing packets */
@@ -550,7 +684,7 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
   return bstop;
 }
 #else
-# define devif_poll_tcp_connections(dev, callback) (0)
+# define devif_poll_tcp_connections(dev, callback, full) (0)
 #endif
 
 /****************************************************************************
@@ -598,27 +732,13 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: devif_poll
+ * Name: devif_poll_internal
  *
  * Description:
- *   This function will traverse each active network connection structure and
- *   will perform network polling operations. devif_poll() may be called
- *   asynchronously with the network driver can accept another outgoing
- *   packet.
- *
- *   This function will call the provided callback function for every active
- *   connection. Polling will continue until all connections have been polled
- *   or until the user-supplied function returns a non-zero value (which it
- *   should do only if it cannot accept further write data).
- *
- *   When the callback function is called, there may be an outbound packet
- *   waiting for service in the device packet buffer, and if so the d_len field
- *   is set to a value larger than zero. The device driver should then send
- *   out the packet.
+ *   Common logic of devif_poll() and devif_timer().  If 'full' is true,
+ *   then every TCP and UDP connection is polled; otherwise only the
+ *   connections with pending output are polled (when CONFIG_NET_TXPENDING
+ *   is selected).
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
@@ -626,7 +746,8 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
+static int devif_poll_internal(FAR struct net_driver_s *dev,
+                               devif_poll_callback_t callback, bool full)
 {
   int bstop = false;
 
@@ -691,7 +812,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
        * action.
        */
 
-      bstop = devif_poll_tcp_connections(dev, callback);
+      bstop = devif_poll_tcp_connections(dev, callback, full);
     }
 
   if (!bstop)
@@ -702,7 +823,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
        * the poll action
        */
 
-      bstop = devif_poll_udp_connections(dev, callback);
+      bstop = devif_poll_udp_connections(dev, callback, full);
     }
 
   if (!bstop)
@@ -741,6 +862,40 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   return bstop;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_poll
+ *
+ * Description:
+ *   This function will traverse each active network connection structure and
+ *   will perform network polling operations. devif_poll() may be called
+ *   asynchronously with the network driver can accept another outgoing
+ *   packet.
+ *
+ *   This function will call the provided callback function for every active
+ *   connection. Polling will continue until all connections have been polled
+ *   or until the user-supplied function returns a non-zero value (which it
+ *   should do only if it cannot accept further write data).
+ *
+ *   When the callback function is called, there may be an outbound packet
+ *   waiting for service in the device packet buffer, and if so the d_len field
+ *   is set to a value larger than zero. The device driver should then send
+ *   out the packet.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
+{
+  return devif_poll_internal(dev, callback, false);
+}
+
 /****************************************************************************
  * Name: devif_timer
  *
@@ -816,12 +971,13 @@ int devif_timer(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
     }
 
   /* If possible, continue with a normal poll checking for pending
-   * network driver actions.
+   * network driver actions.  The periodic poll visits every connection,
+   * not just those with pending output.
    */
 
   if (!bstop)
     {
-      bstop = devif_poll(dev, callback);
+      bstop = devif_poll_internal(dev, callback, true);
     }
 
   return bstop;
@@ -266,6 +266,17 @@ int icmpv6_neighbor(const net_ipv6addr_t ipaddr)
    */
 
   net_lock();
+
+  /* Fail immediately if Neighbor Solicitation recently failed for this
+   * address.
+   */
+
+  if (neighbor_is_negative(lookup))
+    {
+      ret = -EHOSTUNREACH;
+      goto errout_with_lock;
+    }
+
   state.snd_cb = devif_callback_alloc((dev), &(dev)->d_conncb);
   if (!state.snd_cb)
     {
@@ -365,6 +376,13 @@ int icmpv6_neighbor(const net_ipv6addr_t ipaddr)
       state.snd_retries++;
     }
 
+  /* Remember the failure so that the next attempt does not stall again */
+
+  if (ret == -ETIMEDOUT)
+    {
+      neighbor_negative_add(lookup);
+    }
+
   nxsem_destroy(&state.snd_sem);
   devif_dev_callback_free(dev, state.snd_cb);
 
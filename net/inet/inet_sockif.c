@@ -445,6 +445,21 @@ static int inet_bind(FAR struct socket *psock,
       case SOCK_DGRAM:
         {
 #ifdef NET_UDP_HAVE_STACK
+#ifdef CONFIG_NET_UDP_REUSEPORT
+          FAR struct udp_conn_s *conn = psock->s_conn;
+
+          /* SO_REUSEPORT must be selected before the socket is bound */
+
+          if (_SO_GETOPT(psock->s_options, SO_REUSEPORT))
+            {
+              conn->flags |= _UDP_FLAG_REUSEPORT;
+            }
+          else
+            {
+              conn->flags &= ~_UDP_FLAG_REUSEPORT;
+            }
+#endif
+
           /* Bind a UDP/IP datagram socket */
 
           ret = udp_bind(psock->s_conn, addr);
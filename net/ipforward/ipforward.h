@@ -44,6 +44,8 @@
 
 #include <stdint.h>
 
+#include <nuttx/clock.h>
+
 #undef HAVE_FWDALLOC
 #ifdef CONFIG_NET_IPFORWARD
 
@@ -57,6 +59,10 @@
 #  define CONFIG_NET_IPFORWARD_NSTRUCT 4
 #endif
 
+#ifndef CONFIG_NET_IPFORWARD_BATCH
+#  define CONFIG_NET_IPFORWARD_BATCH 4
+#endif
+
 /* Allocate a new IP forwarding data callback */
 
 #define ipfwd_callback_alloc(dev)   devif_callback_alloc(dev, &(dev)->d_conncb)
@@ -78,6 +84,9 @@ struct forward_s
   FAR struct net_driver_s     *f_dev;     /* Forwarding device */
   FAR struct iob_s            *f_iob;     /* IOB chain containing the packet */
   FAR struct devif_callback_s *f_cb;      /* Reference to callback instance */
+#ifdef CONFIG_NET_STATISTICS
+  clock_t                      f_time;    /* Time that the packet was queued */
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
   uint8_t                      f_domain;  /* Domain: PF_INET or PF_INET6 */
 #endif
@@ -132,6 +141,20 @@ FAR struct forward_s *ipfwd_alloc(void);
 
 void ipfwd_free(FAR struct forward_s *fwd);
 
+/****************************************************************************
+ * Name: ipfwd_navail
+ *
+ * Description:
+ *   Return the number of forwarding structures that are available in the
+ *   free list.
+ *
+ * Assumptions:
+ *   Caller holds the network lock.
+ *
+ ****************************************************************************/
+
+int ipfwd_navail(void);
+
 /****************************************************************************
  * Name: ipv4_forward_broadcast
  *
@@ -273,6 +296,62 @@ void ipfwd_dropstats(FAR struct forward_s *fwd);
 #  define ipfwd_dropstats(fwd)
 #endif
 
+/****************************************************************************
+ * Name: ipfwd_sentstats
+ *
+ * Description:
+ *   Update statistics for a queued packet that has been sent, including
+ *   the time that the packet spent waiting for the forwarding device.
+ *
+ * Input Parameters:
+ *   fwd - The forwarding state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_STATISTICS
+void ipfwd_sentstats(FAR struct forward_s *fwd);
+#else
+#  define ipfwd_sentstats(fwd)
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_fastpath
+ *
+ * Description:
+ *   Try to send a forwarded packet immediately, directly from the buffer of
+ *   the device that received it.  The forwarding device's d_buf is pointed
+ *   into the receiving device's buffer so that the IP header follows the
+ *   forwarding device's link layer header, the link layer header is
+ *   completed, and the packet is handed to the forwarding device's
+ *   d_transmit() method.  No copy is made.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received
+ *   fwddev - The device on which the packet must be forwarded
+ *   iphdr  - A pointer to the IP header within dev->d_buf.  The TTL must
+ *            already have been decremented.
+ *   domain - PF_INET or PF_INET6
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the packet was sent.  A negated errno value is
+ *   returned if the fast path could not be used;  the packet is unmodified
+ *   (apart from the space in front of the IP header) and the caller should
+ *   queue it instead.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+int ipfwd_fastpath(FAR struct net_driver_s *dev,
+                   FAR struct net_driver_s *fwddev, FAR uint8_t *iphdr,
+                   uint8_t domain);
+#endif
+
 /****************************************************************************
  * Name: ipv4_forward
  *
@@ -87,6 +87,10 @@ static struct forward_s g_fwdpool[CONFIG_NET_IPFORWARD_NSTRUCT];
 
 static FAR struct forward_s *g_fwdfree;
 
+/* The number of forwarding structures in the free list */
+
+static int g_fwdnfree;
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -123,6 +127,8 @@ void ipfwd_initialize(void)
       fwd->f_flink = g_fwdfree;
       g_fwdfree    = fwd;
     }
+
+  g_fwdnfree = CONFIG_NET_IPFORWARD_NSTRUCT;
 }
 
 /****************************************************************************
@@ -146,6 +152,7 @@ FAR struct forward_s *ipfwd_alloc(void)
   if (fwd != NULL)
     {
       g_fwdfree = fwd->f_flink;
+      g_fwdnfree--;
       memset (fwd, 0, sizeof(struct forward_s));
     }
 
@@ -168,6 +175,24 @@ void ipfwd_free(FAR struct forward_s *fwd)
 {
   fwd->f_flink = g_fwdfree;
   g_fwdfree    = fwd;
+  g_fwdnfree++;
+}
+
+/****************************************************************************
+ * Name: ipfwd_navail
+ *
+ * Description:
+ *   Return the number of forwarding structures that are available in the
+ *   free list.
+ *
+ * Assumptions:
+ *   Caller holds the network lock.
+ *
+ ****************************************************************************/
+
+int ipfwd_navail(void)
+{
+  return g_fwdnfree;
 }
 
 #endif /* CONFIG_NET_IPFORWARD */
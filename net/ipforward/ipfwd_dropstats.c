@@ -128,6 +128,7 @@ void ipv6_dropstats(FAR struct ipv6_hdr_s *ipv6)
     }
 
   g_netstats.ipv6.drop++;
+  g_netstats.ipfwd.drop++;
 }
 #endif
 
@@ -158,6 +159,7 @@ void ipv4_dropstats(FAR struct ipv4_hdr_s *ipv4)
     }
 
   g_netstats.ipv4.drop++;
+  g_netstats.ipfwd.drop++;
 }
 #endif
 
@@ -195,4 +197,40 @@ void ipfwd_dropstats(FAR struct forward_s *fwd)
 #endif
 }
 
+/****************************************************************************
+ * Name: ipfwd_sentstats
+ *
+ * Description:
+ *   Update statistics for a queued packet that has been sent, including
+ *   the time that the packet spent waiting for the forwarding device.
+ *
+ * Input Parameters:
+ *   fwd - The forwarding state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ipfwd_sentstats(FAR struct forward_s *fwd)
+{
+  clock_t elapsed = clock_systimer() - fwd->f_time;
+
+  /* Restart the latency total when the count of sent packets wraps so
+   * that the average remains meaningful.
+   */
+
+  if (++g_netstats.ipfwd.sent == 0)
+    {
+      g_netstats.ipfwd.lattotal = 0;
+    }
+
+  g_netstats.ipfwd.lattotal += elapsed;
+
+  if (elapsed > g_netstats.ipfwd.latmax)
+    {
+      g_netstats.ipfwd.latmax = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    }
+}
+
 #endif /* CONFIG_NET_IPFORWARD && CONFIG_NET_STATISTICS */
@@ -0,0 +1,298 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_fastpath.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netstats.h>
+
+#include "netdev/netdev.h"
+#include "route/route.h"
+#include "arp/arp.h"
+#include "neighbor/neighbor.h"
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_llresolved
+ *
+ * Description:
+ *   Return true if the link layer address of the next hop is known so that
+ *   arp_out() or neighbor_out() will complete the Ethernet header rather
+ *   than replace the packet with an ARP request or a Neighbor Solicitation.
+ *   The next hop is selected just as arp_out() and neighbor_out() select
+ *   it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ETHERNET
+static bool ipfwd_llresolved(FAR struct net_driver_s *fwddev,
+                             FAR uint8_t *iphdr, uint8_t domain)
+{
+  if (fwddev->d_lltype != NET_LL_ETHERNET)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if (domain == PF_INET)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)iphdr;
+      in_addr_t destipaddr;
+      in_addr_t ipaddr;
+
+      destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+      if (!net_ipv4addr_maskcmp(destipaddr, fwddev->d_ipaddr,
+                                fwddev->d_netmask))
+        {
+#ifdef CONFIG_NET_ROUTE
+          netdev_ipv4_router(fwddev, destipaddr, &ipaddr);
+#else
+          net_ipv4addr_copy(ipaddr, fwddev->d_draddr);
+#endif
+        }
+      else
+        {
+          net_ipv4addr_copy(ipaddr, destipaddr);
+        }
+
+      return arp_find(ipaddr, NULL) >= 0;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET6)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)iphdr;
+      net_ipv6addr_t ipaddr;
+
+      if (!net_ipv6addr_maskcmp(ipv6->destipaddr, fwddev->d_ipv6addr,
+                                fwddev->d_ipv6netmask))
+        {
+#ifdef CONFIG_NET_ROUTE
+          netdev_ipv6_router(fwddev, ipv6->destipaddr, ipaddr);
+#else
+          net_ipv6addr_copy(ipaddr, fwddev->d_ipv6draddr);
+#endif
+        }
+      else
+        {
+          net_ipv6addr_copy(ipaddr, ipv6->destipaddr);
+        }
+
+      return neighbor_lookup(ipaddr, NULL) >= 0;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  return false;
+}
+#else
+#  define ipfwd_llresolved(d,i,f) (true)
+#endif /* CONFIG_NET_ETHERNET */
+
+/****************************************************************************
+ * Name: ipfwd_llout
+ *
+ * Description:
+ *   Complete the link layer header of the packet in fwddev->d_buf.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ETHERNET
+static void ipfwd_llout(FAR struct net_driver_s *fwddev, uint8_t domain)
+{
+  if (fwddev->d_lltype == NET_LL_ETHERNET)
+    {
+#ifdef CONFIG_NET_IPv4
+      if (domain == PF_INET)
+        {
+          arp_out(fwddev);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (domain == PF_INET6)
+        {
+          neighbor_out(fwddev);
+        }
+#endif
+    }
+}
+#else
+#  define ipfwd_llout(d,f)
+#endif /* CONFIG_NET_ETHERNET */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_fastpath
+ *
+ * Description:
+ *   Try to send a forwarded packet immediately, directly from the buffer of
+ *   the device that received it.  The forwarding device's d_buf is pointed
+ *   into the receiving device's buffer so that the IP header follows the
+ *   forwarding device's link layer header, the link layer header is
+ *   completed, and the packet is handed to the forwarding device's
+ *   d_transmit() method.  No copy is made.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received
+ *   fwddev - The device on which the packet must be forwarded
+ *   iphdr  - A pointer to the IP header within dev->d_buf.  The TTL must
+ *            already have been decremented.
+ *   domain - PF_INET or PF_INET6
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the packet was sent.  A negated errno value is
+ *   returned if the fast path could not be used;  the packet is unmodified
+ *   (apart from the space in front of the IP header) and the caller should
+ *   queue it instead.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int ipfwd_fastpath(FAR struct net_driver_s *dev,
+                   FAR struct net_driver_s *fwddev, FAR uint8_t *iphdr,
+                   uint8_t domain)
+{
+  FAR uint8_t *d_buf;
+  uint16_t d_len;
+  uint8_t d_flags;
+  int llhdrlen;
+  int ret;
+
+  if (fwddev->d_transmit == NULL)
+    {
+      return -ENOSYS;
+    }
+
+#ifdef CONFIG_NET_6LOWPAN
+  /* Packets forwarded to a 6LoWPAN radio must be converted into frames */
+
+  if (fwddev->d_lltype == NET_LL_IEEE802154 ||
+      fwddev->d_lltype == NET_LL_PKTRADIO)
+    {
+      return -ENOSYS;
+    }
+#endif
+
+  /* There must be room in front of the IP header for the forwarding
+   * device's link layer header and the packet must fit within the
+   * forwarding device's MTU.
+   */
+
+  llhdrlen = NET_LL_HDRLEN(fwddev);
+  if (iphdr - dev->d_buf < llhdrlen ||
+      llhdrlen + dev->d_len > NETDEV_PKTSIZE(fwddev))
+    {
+      return -ENOSPC;
+    }
+
+  /* The packet would be replaced by an ARP request or a Neighbor
+   * Solicitation if the next hop is unknown.  Let the queued path deal with
+   * that case.
+   */
+
+  if (!ipfwd_llresolved(fwddev, iphdr, domain))
+    {
+      return -EAGAIN;
+    }
+
+  /* Borrow the receiving device's buffer */
+
+  d_buf           = fwddev->d_buf;
+  d_len           = fwddev->d_len;
+  d_flags         = fwddev->d_flags;
+
+  fwddev->d_buf   = iphdr - llhdrlen;
+  fwddev->d_len   = dev->d_len;
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  if (domain == PF_INET)
+    {
+      IFF_SET_IPv4(fwddev->d_flags);
+    }
+  else
+    {
+      IFF_SET_IPv6(fwddev->d_flags);
+    }
+#endif
+
+  /* Complete the link layer header and send the packet */
+
+  ipfwd_llout(fwddev, domain);
+  ret = fwddev->d_transmit(fwddev);
+
+  fwddev->d_buf   = d_buf;
+  fwddev->d_len   = d_len;
+  fwddev->d_flags = d_flags;
+
+  if (ret < 0)
+    {
+      ninfo("d_transmit failed: %d\n", ret);
+      return ret;
+    }
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.ipfwd.fastpath++;
+#endif
+
+  dev->d_len = 0;
+  return OK;
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FASTPATH */
@@ -276,6 +276,8 @@ static uint16_t ipfwd_eventhandler(FAR struct net_driver_s *dev, FAR void *conn,
             {
               return flags;
             }
+
+          ipfwd_sentstats(fwd);
         }
 
       /* Free the allocated callback structure */
@@ -341,6 +343,13 @@ int ipfwd_forward(FAR struct forward_s *fwd)
       fwd->f_cb->priv    = (FAR void *)fwd;
       fwd->f_cb->event   = ipfwd_eventhandler;
 
+#ifdef CONFIG_NET_STATISTICS
+      /* Remember when the packet was queued */
+
+      fwd->f_time        = clock_systimer();
+      g_netstats.ipfwd.queued++;
+#endif
+
       /* Notify the device driver of the availability of TX data */
 
       netdev_txnotify_dev(fwd->f_dev);
@@ -243,8 +243,8 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
   /* Initialize the easy stuff in the forwarding structure */
 
   fwd->f_dev    = fwddev;  /* Forwarding device */
-#ifdef CONFIG_NET_IPv5
-  fwd->f_domain = PF_INET; /* IPv64 address domain */
+#ifdef CONFIG_NET_IPv6
+  fwd->f_domain = PF_INET; /* IPv4 address domain */
 #endif
 
 #ifdef CONFIG_DEBUG_NET_WARN
@@ -336,6 +336,68 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: ipv4_fastpath
+ *
+ * Description:
+ *   Try to forward a unicast IPv4 packet directly from the receiving
+ *   device's buffer, without copying it into an IOB chain.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received and which contains
+ *            the IPv4 packet.
+ *   fwddev - The device on which the packet must be forwarded.
+ *   ipv4   - A pointer to the IPv4 header in within the IPv4 packet
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the packet was sent.  Otherwise, a negated
+ *   errno value is returned, the IPv4 header is unmodified, and the packet
+ *   should be queued by ipv4_dev_forward().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+static int ipv4_fastpath(FAR struct net_driver_s *dev,
+                         FAR struct net_driver_s *fwddev,
+                         FAR struct ipv4_hdr_s *ipv4)
+{
+  uint16_t ipchksum;
+  uint8_t ttl;
+  int ret;
+
+  if (fwddev->d_transmit == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  /* Decrement the TTL in place.  If the packet cannot be sent now, the TTL
+   * and checksum are restored so that ipv4_dev_forward() sees the packet
+   * as it was received.
+   */
+
+  ipchksum = ipv4->ipchksum;
+  ttl      = ipv4->ttl;
+
+  ret = ipv4_decr_ttl(ipv4);
+  if (ret > 0)
+    {
+      ret = ipfwd_fastpath(dev, fwddev, (FAR uint8_t *)ipv4, PF_INET);
+      if (ret >= 0)
+        {
+          return OK;
+        }
+    }
+  else
+    {
+      ret = -EMULTIHOP;
+    }
+
+  ipv4->ipchksum = ipchksum;
+  ipv4->ttl      = ttl;
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: ipv4_forward_callback
  *
@@ -449,6 +511,15 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
 
   if (fwddev != dev)
     {
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+      /* Try to send the packet now, without copying it. */
+
+      if (ipv4_fastpath(dev, fwddev, ipv4) >= 0)
+        {
+          return OK;
+        }
+#endif
+
       /* Send the packet asynchrously on the forwarding device. */
 
       ret = ipv4_dev_forward(dev, fwddev, ipv4);
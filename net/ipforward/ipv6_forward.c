@@ -478,6 +478,65 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: ipv6_fastpath
+ *
+ * Description:
+ *   Try to forward a unicast IPv6 packet directly from the receiving
+ *   device's buffer, without copying it into an IOB chain.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received and which contains
+ *            the IPv6 packet.
+ *   fwddev - The device on which the packet must be forwarded.
+ *   ipv6   - A pointer to the IPv6 header in within the IPv6 packet
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if the packet was sent.  Otherwise, a negated
+ *   errno value is returned, the IPv6 header is unmodified, and the packet
+ *   should be queued by ipv6_dev_forward().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+static int ipv6_fastpath(FAR struct net_driver_s *dev,
+                         FAR struct net_driver_s *fwddev,
+                         FAR struct ipv6_hdr_s *ipv6)
+{
+  uint8_t ttl;
+  int ret;
+
+  if (fwddev->d_transmit == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  /* Decrement the hop limit in place.  If the packet cannot be sent now,
+   * the hop limit is restored so that ipv6_dev_forward() sees the packet
+   * as it was received.
+   */
+
+  ttl = ipv6->ttl;
+
+  ret = ipv6_decr_ttl(ipv6);
+  if (ret > 0)
+    {
+      ret = ipfwd_fastpath(dev, fwddev, (FAR uint8_t *)ipv6, PF_INET6);
+      if (ret >= 0)
+        {
+          return OK;
+        }
+    }
+  else
+    {
+      ret = -EMULTIHOP;
+    }
+
+  ipv6->ttl = ttl;
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: ipv6_forward_callback
  *
@@ -586,6 +645,15 @@ int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
 
   if (fwddev != dev)
     {
+#ifdef CONFIG_NET_IPFORWARD_FASTPATH
+      /* Try to send the packet now, without copying it. */
+
+      if (ipv6_fastpath(dev, fwddev, ipv6) >= 0)
+        {
+          return OK;
+        }
+#endif
+
       /* Send the packet asynchrously on the forwarding device. */
 
       ret = ipv6_dev_forward(dev, fwddev, ipv6);
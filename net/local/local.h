@@ -64,6 +64,17 @@
 #ifndef CONFIG_DISABLE_POLL
 #  define HAVE_LOCAL_POLL 1
 #  define LOCAL_ACCEPT_NPOLLWAITERS 2
+#  define LOCAL_RING_NPOLLWAITERS 2
+#endif
+
+#ifdef CONFIG_NET_LOCAL_RING
+#  ifndef CONFIG_NET_LOCAL_RING_SIZE
+#    define CONFIG_NET_LOCAL_RING_SIZE 2048
+#  endif
+
+#  if (CONFIG_NET_LOCAL_RING_SIZE & (CONFIG_NET_LOCAL_RING_SIZE - 1)) != 0
+#    error CONFIG_NET_LOCAL_RING_SIZE must be a power of two
+#  endif
 #endif
 
 /* Packet format in FIFO:
@@ -163,6 +174,27 @@ struct local_conn_s
   struct pollfd *lc_accept_fds[LOCAL_ACCEPT_NPOLLWAITERS];
 #endif
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Ring buffer transport between connected peers.  Each peer owns the
+   * ring that receives data from the other peer.  The head and tail are
+   * free-running byte counts.  All fields are protected by the network
+   * lock.
+   */
+
+  FAR struct local_conn_s *lc_peer; /* Connected peer (NULL if none) */
+  FAR uint8_t *lc_rxbuf;       /* Receive ring (CONFIG_NET_LOCAL_RING_SIZE) */
+  uint32_t lc_rxhead;          /* Count of bytes written by the peer */
+  uint32_t lc_rxtail;          /* Count of bytes read */
+  sem_t lc_rxsem;              /* Wait for data in lc_rxbuf */
+  sem_t lc_txsem;              /* Wait for space in the peer's lc_rxbuf */
+  uint8_t lc_rxwaiters;        /* Number of threads waiting on lc_rxsem */
+  uint8_t lc_txwaiters;        /* Number of threads waiting on lc_txsem */
+
+#ifdef HAVE_LOCAL_POLL
+  struct pollfd *lc_ring_fds[LOCAL_RING_NPOLLWAITERS];
+#endif
+#endif
+
   /* Union of fields unique to SOCK_STREAM client, server, and connected
    * peers.
    */
@@ -651,6 +683,129 @@ int local_open_sender(FAR struct local_conn_s *conn, FAR const char *path,
                       bool nonblock);
 #endif
 
+/****************************************************************************
+ * Name: local_ring_alloc
+ *
+ * Description:
+ *   Allocate the receive ring buffer of a SOCK_STREAM connection.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the ring could not be allocated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_alloc(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_free
+ *
+ * Description:
+ *   Free the receive ring buffer of a SOCK_STREAM connection (if any).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_free(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Pair two SOCK_STREAM connections that have both allocated their
+ *   receive rings.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_connect(FAR struct local_conn_s *conn1,
+                        FAR struct local_conn_s *conn2);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_disconnect
+ *
+ * Description:
+ *   Break the pairing of a connection that is being released.  Threads
+ *   waiting on the peer are awakened and see end-of-file or EPIPE.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_disconnect(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Copy data directly into the receive ring of the connected peer.
+ *
+ * Input Parameters:
+ *   conn     - The sending connection
+ *   buf      - Data to send
+ *   len      - Length of data to send
+ *   nonblock - True: Do not wait for space in the peer's ring
+ *
+ * Returned Value:
+ *   The number of bytes sent on success (which may be less than 'len' only
+ *   if 'nonblock' is true or the wait was interrupted).  A negated errno
+ *   value on failure:  -EPIPE if the peer has closed the connection or
+ *   -EAGAIN if 'nonblock' is true and there is no space.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const uint8_t *buf, size_t len, bool nonblock);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Copy data out of the connection's receive ring.
+ *
+ * Input Parameters:
+ *   conn     - The receiving connection
+ *   buf      - Buffer to receive data
+ *   len      - Length of the buffer
+ *   nonblock - True: Do not wait for data
+ *
+ * Returned Value:
+ *   The number of bytes received, zero if the peer has closed the
+ *   connection and all data has been read, or a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR uint8_t *buf,
+                        size_t len, bool nonblock);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_pollsetup
+ *
+ * Description:
+ *   Setup or teardown poll() monitoring of a connection that uses the ring
+ *   buffer transport.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(HAVE_LOCAL_POLL)
+int local_ring_pollsetup(FAR struct local_conn_s *conn,
+                         FAR struct pollfd *fds, bool setup);
+#endif
+
 /****************************************************************************
  * Name: local_accept_pollnotify
  ****************************************************************************/
@@ -184,6 +184,18 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               conn->lc_path[UNIX_PATH_MAX - 1] = '\0';
               conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_RING
+              /* Allocate the ring that will receive data from the client.
+               * No FIFOs are opened.
+               */
+
+              ret = local_ring_alloc(conn);
+              if (ret < 0)
+                {
+                   nerr("ERROR: Failed to allocate ring for %s: %d\n",
+                        conn->lc_path, ret);
+                }
+#else
               /* Open the server-side write-only FIFO.  This should not
                * block.
                */
@@ -195,8 +207,10 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                    nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
                         conn->lc_path, ret);
                 }
+#endif
             }
 
+#ifndef CONFIG_NET_LOCAL_RING
           /* Do we have a connection?  Is the write-side FIFO opened? */
 
           if (ret == OK)
@@ -216,12 +230,15 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                         conn->lc_path, ret);
                 }
             }
+#endif
 
           /* Do we have a connection?  Are the FIFOs opened? */
 
           if (ret == OK)
             {
+#ifndef CONFIG_NET_LOCAL_RING
               DEBUGASSERT(conn->lc_infile.f_inode != NULL);
+#endif
 
               /* Return the address family */
 
@@ -233,6 +250,12 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
           if (ret == OK)
             {
+#ifdef CONFIG_NET_LOCAL_RING
+              /* Pair the new connection with the client */
+
+              local_ring_connect(conn, client);
+#endif
+
               /* Setup the client socket structure */
 
               newsock->s_domain = psock->s_domain;
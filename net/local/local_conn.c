@@ -105,6 +105,15 @@ FAR struct local_conn_s *local_alloc(void)
 #ifdef HAVE_LOCAL_POLL
       memset(conn->lc_accept_fds, 0, sizeof(conn->lc_accept_fds));
 #endif
+
+#ifdef CONFIG_NET_LOCAL_RING
+      /* These semaphores are also used for signaling */
+
+      nxsem_init(&conn->lc_rxsem, 0, 0);
+      nxsem_setprotocol(&conn->lc_rxsem, SEM_PRIO_NONE);
+      nxsem_init(&conn->lc_txsem, 0, 0);
+      nxsem_setprotocol(&conn->lc_txsem, SEM_PRIO_NONE);
+#endif
 #endif
     }
 
@@ -141,9 +150,17 @@ void local_free(FAR struct local_conn_s *conn)
     }
 
 #ifdef CONFIG_NET_LOCAL_STREAM
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Free the receive ring.  No FIFOs were created for the connection. */
+
+  local_ring_free(conn);
+  nxsem_destroy(&conn->lc_rxsem);
+  nxsem_destroy(&conn->lc_txsem);
+#else
   /* Destroy all FIFOs associted with the connection */
 
   local_release_fifos(conn);
+#endif
   nxsem_destroy(&conn->lc_waitsem);
 #endif
 
@@ -156,6 +156,22 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   server->u.server.lc_pending++;
   DEBUGASSERT(server->u.server.lc_pending != 0);
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Allocate the ring that will receive data from the server.  No FIFOs
+   * are needed:  local_accept() pairs the two connections directly.
+   */
+
+  ret = local_ring_alloc(client);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to allocate ring for %s: %d\n",
+           client->lc_path, ret);
+
+      server->u.server.lc_pending--;
+      net_unlock();
+      return ret;
+    }
+#else
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(client);
@@ -183,6 +199,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
     }
 
   DEBUGASSERT(client->lc_outfile.f_inode != NULL);
+#endif
 
   /* Set the busy "result" before giving the semaphore. */
 
@@ -218,6 +235,11 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
       goto errout_with_outfd;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Yes.. local_accept() has already paired us with the server */
+
+  DEBUGASSERT(client->lc_peer != NULL);
+#else
   /* Yes.. open the read-only FIFO */
 
   ret = local_open_client_rx(client, nonblock);
@@ -229,15 +251,23 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
     }
 
   DEBUGASSERT(client->lc_infile.f_inode != NULL);
+#endif
+
   client->lc_state = LOCAL_STATE_CONNECTED;
   return OK;
 
 errout_with_outfd:
+#ifdef CONFIG_NET_LOCAL_RING
+  net_lock();
+  local_ring_free(client);
+  net_unlock();
+#else
   (void)file_close(&client->lc_outfile);
   client->lc_outfile.f_inode = NULL;
 
 errout_with_fifos:
   (void)local_release_fifos(client);
+#endif
   client->lc_state = LOCAL_STATE_BOUND;
   return ret;
 }
@@ -200,6 +200,13 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       goto pollerr;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_state == LOCAL_STATE_CONNECTED)
+    {
+      return local_ring_pollsetup(conn, fds, true);
+    }
+#endif
+
   switch (fds->events & (POLLIN | POLLOUT))
     {
       case (POLLIN | POLLOUT):
@@ -340,6 +347,13 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
       return OK;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_state == LOCAL_STATE_CONNECTED)
+    {
+      return local_ring_pollsetup(conn, fds, false);
+    }
+#endif
+
   switch (fds->events & (POLLIN | POLLOUT))
     {
       case (POLLIN | POLLOUT):
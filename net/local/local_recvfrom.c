@@ -159,6 +159,17 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return -ENOTCONN;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Copy the data directly out of the receive ring */
+
+  ret = local_ring_recv(conn, buf, len, _SS_ISNONBLOCK(psock->s_flags));
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  readlen = ret;
+#else
   /* The incoming FIFO should be open */
 
   DEBUGASSERT(conn->lc_infile.f_inode != NULL);
@@ -199,6 +210,7 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 
   DEBUGASSERT(readlen <= conn->u.peer.lc_remaining);
   conn->u.peer.lc_remaining -= readlen;
+#endif
 
   /* Return the address family */
 
@@ -89,7 +89,13 @@ int local_release(FAR struct local_conn_s *conn)
     {
       DEBUGASSERT(conn->lc_proto == SOCK_STREAM);
 
-      /* Just free the connection structure */
+#ifdef CONFIG_NET_LOCAL_RING
+      /* Detach from the peer so that it sees the loss of connection */
+
+      local_ring_disconnect(conn);
+#endif
+
+      /* Then just free the connection structure */
     }
 
   /* Is the socket is listening socket (SOCK_STREAM server) */
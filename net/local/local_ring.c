@@ -0,0 +1,545 @@
+/****************************************************************************
+ * net/local/local_ring.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_LOCAL_RING)
+
+#include <sys/types.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+
+#include "local/local.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCAL_RING_MASK  (CONFIG_NET_LOCAL_RING_SIZE - 1)
+
+/* A writer waiting for space is not awakened until at least this much of
+ * the ring is free.  This batches wakeups so that the writer and reader do
+ * not ping-pong on every small read.
+ */
+
+#define LOCAL_RING_LOWAT (CONFIG_NET_LOCAL_RING_SIZE / 2)
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_used
+ *
+ * Description:
+ *   Return the number of unread bytes in the receive ring of 'conn'.
+ *
+ ****************************************************************************/
+
+static inline uint32_t local_ring_used(FAR struct local_conn_s *conn)
+{
+  return conn->lc_rxhead - conn->lc_rxtail;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollnotify
+ *
+ * Description:
+ *   Report events to all threads polling on 'conn'.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+static void local_ring_pollnotify(FAR struct local_conn_s *conn,
+                                  pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < LOCAL_RING_NPOLLWAITERS; i++)
+    {
+      FAR struct pollfd *fds = conn->lc_ring_fds[i];
+      if (fds)
+        {
+          /* POLLHUP is always reported, whether requested or not */
+
+          fds->revents |= ((fds->events | POLLHUP) & eventset);
+          if (fds->revents != 0)
+            {
+              ninfo("Report events: %02x\n", fds->revents);
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+#else
+#  define local_ring_pollnotify(conn, eventset)
+#endif
+
+/****************************************************************************
+ * Name: local_ring_wakeup
+ *
+ * Description:
+ *   Wake up all threads waiting on 'sem'.  Waking only one is not enough:
+ *   It may consume less than what is available and there may be no later
+ *   event to wake the others.  The waiters re-check their condition on
+ *   each wakeup so a stale count on the semaphore is harmless.
+ *
+ ****************************************************************************/
+
+static void local_ring_wakeup(FAR sem_t *sem, uint8_t nwaiters)
+{
+  while (nwaiters-- > 0)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_copyin
+ *
+ * Description:
+ *   Copy 'len' bytes into the receive ring of 'conn'.  The caller has
+ *   verified that there is space.
+ *
+ ****************************************************************************/
+
+static void local_ring_copyin(FAR struct local_conn_s *conn,
+                              FAR const uint8_t *buf, size_t len)
+{
+  uint32_t offset = conn->lc_rxhead & LOCAL_RING_MASK;
+  size_t ncopy    = MIN(len, CONFIG_NET_LOCAL_RING_SIZE - offset);
+
+  memcpy(&conn->lc_rxbuf[offset], buf, ncopy);
+  if (ncopy < len)
+    {
+      memcpy(conn->lc_rxbuf, &buf[ncopy], len - ncopy);
+    }
+
+  conn->lc_rxhead += len;
+}
+
+/****************************************************************************
+ * Name: local_ring_copyout
+ *
+ * Description:
+ *   Copy 'len' bytes out of the receive ring of 'conn'.  The caller has
+ *   verified that the data is available.
+ *
+ ****************************************************************************/
+
+static void local_ring_copyout(FAR struct local_conn_s *conn,
+                               FAR uint8_t *buf, size_t len)
+{
+  uint32_t offset = conn->lc_rxtail & LOCAL_RING_MASK;
+  size_t ncopy    = MIN(len, CONFIG_NET_LOCAL_RING_SIZE - offset);
+
+  memcpy(buf, &conn->lc_rxbuf[offset], ncopy);
+  if (ncopy < len)
+    {
+      memcpy(&buf[ncopy], conn->lc_rxbuf, len - ncopy);
+    }
+
+  conn->lc_rxtail += len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_alloc
+ *
+ * Description:
+ *   Allocate the receive ring buffer of a SOCK_STREAM connection.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the ring could not be allocated.
+ *
+ ****************************************************************************/
+
+int local_ring_alloc(FAR struct local_conn_s *conn)
+{
+  DEBUGASSERT(conn->lc_rxbuf == NULL && conn->lc_peer == NULL);
+
+  conn->lc_rxbuf = (FAR uint8_t *)kmm_malloc(CONFIG_NET_LOCAL_RING_SIZE);
+  if (conn->lc_rxbuf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  conn->lc_rxhead = 0;
+  conn->lc_rxtail = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_free
+ *
+ * Description:
+ *   Free the receive ring buffer of a SOCK_STREAM connection (if any).
+ *
+ ****************************************************************************/
+
+void local_ring_free(FAR struct local_conn_s *conn)
+{
+  DEBUGASSERT(conn->lc_peer == NULL);
+
+  if (conn->lc_rxbuf != NULL)
+    {
+      kmm_free(conn->lc_rxbuf);
+      conn->lc_rxbuf = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Pair two SOCK_STREAM connections that have both allocated their
+ *   receive rings.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_ring_connect(FAR struct local_conn_s *conn1,
+                        FAR struct local_conn_s *conn2)
+{
+  DEBUGASSERT(conn1->lc_rxbuf != NULL && conn2->lc_rxbuf != NULL);
+
+  conn1->lc_peer = conn2;
+  conn2->lc_peer = conn1;
+}
+
+/****************************************************************************
+ * Name: local_ring_disconnect
+ *
+ * Description:
+ *   Break the pairing of a connection that is being released.  Threads
+ *   waiting on the peer are awakened and see end-of-file or EPIPE.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_ring_disconnect(FAR struct local_conn_s *conn)
+{
+  FAR struct local_conn_s *peer = conn->lc_peer;
+
+  if (peer != NULL)
+    {
+      DEBUGASSERT(peer->lc_peer == conn);
+
+      conn->lc_peer = NULL;
+      peer->lc_peer = NULL;
+
+      /* Wake up everything waiting on the peer */
+
+      local_ring_wakeup(&peer->lc_rxsem, peer->lc_rxwaiters);
+      local_ring_wakeup(&peer->lc_txsem, peer->lc_txwaiters);
+      local_ring_pollnotify(peer, POLLIN | POLLOUT | POLLHUP);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Copy data directly into the receive ring of the connected peer.
+ *
+ * Input Parameters:
+ *   conn     - The sending connection
+ *   buf      - Data to send
+ *   len      - Length of data to send
+ *   nonblock - True: Do not wait for space in the peer's ring
+ *
+ * Returned Value:
+ *   The number of bytes sent on success (which may be less than 'len' only
+ *   if 'nonblock' is true or the wait was interrupted).  A negated errno
+ *   value on failure:  -EPIPE if the peer has closed the connection or
+ *   -EAGAIN if 'nonblock' is true and there is no space.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const uint8_t *buf, size_t len, bool nonblock)
+{
+  FAR struct local_conn_s *peer;
+  size_t nsent = 0;
+  size_t nnotified = 0;
+  uint32_t space;
+  int ret = OK;
+
+  net_lock();
+  while (nsent < len)
+    {
+      peer = conn->lc_peer;
+      if (peer == NULL)
+        {
+          ret = -EPIPE;
+          break;
+        }
+
+      space = CONFIG_NET_LOCAL_RING_SIZE - local_ring_used(peer);
+      if (space == 0)
+        {
+          if (nonblock)
+            {
+              ret = -EAGAIN;
+              break;
+            }
+
+          /* Let the reader drain what has been written so far, then wait
+           * for it to free up space.
+           */
+
+          if (nsent > nnotified)
+            {
+              local_ring_wakeup(&peer->lc_rxsem, peer->lc_rxwaiters);
+              local_ring_pollnotify(peer, POLLIN);
+              nnotified = nsent;
+            }
+
+          conn->lc_txwaiters++;
+          ret = net_lockedwait(&conn->lc_txsem);
+          conn->lc_txwaiters--;
+
+          if (ret < 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      space = MIN(space, len - nsent);
+      local_ring_copyin(peer, &buf[nsent], space);
+      nsent += space;
+    }
+
+  /* Notify the reader once for the whole send */
+
+  peer = conn->lc_peer;
+  if (peer != NULL && nsent > nnotified)
+    {
+      local_ring_wakeup(&peer->lc_rxsem, peer->lc_rxwaiters);
+      local_ring_pollnotify(peer, POLLIN);
+    }
+
+  net_unlock();
+  return nsent > 0 ? (ssize_t)nsent : ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Copy data out of the connection's receive ring.
+ *
+ * Input Parameters:
+ *   conn     - The receiving connection
+ *   buf      - Buffer to receive data
+ *   len      - Length of the buffer
+ *   nonblock - True: Do not wait for data
+ *
+ * Returned Value:
+ *   The number of bytes received, zero if the peer has closed the
+ *   connection and all data has been read, or a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR uint8_t *buf,
+                        size_t len, bool nonblock)
+{
+  FAR struct local_conn_s *peer;
+  uint32_t used;
+  uint32_t before;
+  int ret;
+
+  DEBUGASSERT(conn->lc_rxbuf != NULL);
+
+  net_lock();
+  while ((used = local_ring_used(conn)) == 0)
+    {
+      /* End-of-file if the peer has gone away */
+
+      if (conn->lc_peer == NULL)
+        {
+          net_unlock();
+          return 0;
+        }
+
+      if (nonblock)
+        {
+          net_unlock();
+          return -EAGAIN;
+        }
+
+      conn->lc_rxwaiters++;
+      ret = net_lockedwait(&conn->lc_rxsem);
+      conn->lc_rxwaiters--;
+
+      if (ret < 0)
+        {
+          net_unlock();
+          return ret;
+        }
+    }
+
+  before = CONFIG_NET_LOCAL_RING_SIZE - used;
+  len    = MIN(len, used);
+  local_ring_copyout(conn, buf, len);
+
+  /* Wake up the writers only when the free space crosses the low water
+   * mark.  A blocked writer always sees the crossing because it waits
+   * only when the ring is full.
+   */
+
+  peer = conn->lc_peer;
+  if (peer != NULL && before < LOCAL_RING_LOWAT &&
+      before + len >= LOCAL_RING_LOWAT)
+    {
+      local_ring_wakeup(&peer->lc_txsem, peer->lc_txwaiters);
+      local_ring_pollnotify(peer, POLLOUT);
+    }
+
+  net_unlock();
+  return len;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollsetup
+ *
+ * Description:
+ *   Setup or teardown poll() monitoring of a connection that uses the ring
+ *   buffer transport.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+int local_ring_pollsetup(FAR struct local_conn_s *conn,
+                         FAR struct pollfd *fds, bool setup)
+{
+  pollevent_t eventset;
+  int ret = OK;
+  int i;
+
+  net_lock();
+  if (setup)
+    {
+      /* This is a request to set up the poll.  Find an available slot for
+       * the poll structure reference
+       */
+
+      for (i = 0; i < LOCAL_RING_NPOLLWAITERS; i++)
+        {
+          if (!conn->lc_ring_fds[i])
+            {
+              conn->lc_ring_fds[i] = fds;
+              fds->priv = &conn->lc_ring_fds[i];
+              break;
+            }
+        }
+
+      if (i >= LOCAL_RING_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret = -EBUSY;
+          goto errout;
+        }
+
+      /* Report any events that are already pending */
+
+      eventset = 0;
+      if (local_ring_used(conn) > 0)
+        {
+          eventset |= POLLIN;
+        }
+
+      if (conn->lc_peer == NULL)
+        {
+          eventset |= (POLLIN | POLLHUP);
+        }
+      else if (local_ring_used(conn->lc_peer) < CONFIG_NET_LOCAL_RING_SIZE)
+        {
+          eventset |= POLLOUT;
+        }
+
+      if (eventset)
+        {
+          local_ring_pollnotify(conn, eventset);
+        }
+    }
+  else
+    {
+      /* This is a request to tear down the poll. */
+
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      if (!slot)
+        {
+          ret = -EIO;
+          goto errout;
+        }
+
+      /* Remove all memory of the poll setup */
+
+      *slot = NULL;
+      fds->priv = NULL;
+    }
+
+errout:
+  net_unlock();
+  return ret;
+}
+#endif /* HAVE_LOCAL_POLL */
+
+#endif /* CONFIG_NET && CONFIG_NET_LOCAL_RING */
@@ -46,6 +46,7 @@
 
 #include <nuttx/net/net.h>
 
+#include "socket/socket.h"
 #include "local/local.h"
 
 #ifdef CONFIG_NET_LOCAL_STREAM
@@ -77,11 +78,27 @@ ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
                          size_t len, int flags)
 {
   FAR struct local_conn_s *peer;
+#ifndef CONFIG_NET_LOCAL_RING
   int ret;
+#endif
 
   DEBUGASSERT(psock && psock->s_conn && buf);
   peer = (FAR struct local_conn_s *)psock->s_conn;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Verify that this is a connected peer socket */
+
+  if (peer->lc_state != LOCAL_STATE_CONNECTED)
+    {
+      nerr("ERROR: not connected\n");
+      return -ENOTCONN;
+    }
+
+  /* Copy the data directly into the receive ring of the other peer */
+
+  return local_ring_send(peer, (FAR const uint8_t *)buf, len,
+                         _SS_ISNONBLOCK(psock->s_flags));
+#else
   /* Verify that this is a connected peer socket and that it has opened the
    * outgoing FIFO for write-only access.
    */
@@ -100,6 +117,7 @@ ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
   /* If the send was successful, then the full packet will have been sent */
 
   return ret < 0 ? ret : len;
+#endif
 }
 
 #endif /* CONFIG_NET_LOCAL_STREAM */
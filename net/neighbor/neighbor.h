@@ -46,6 +46,8 @@
  ****************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
 
 #include <net/ethernet.h>
 
@@ -64,6 +66,27 @@
 #  define CONFIG_NET_IPv6_NCONF_ENTRIES 8
 #endif
 
+#ifndef CONFIG_NET_IPv6_NCONF_HASHSIZE
+#  define CONFIG_NET_IPv6_NCONF_HASHSIZE 8
+#endif
+
+#ifndef CONFIG_NET_IPv6_NCONF_NEGAGE
+#  define CONFIG_NET_IPv6_NCONF_NEGAGE 0
+#endif
+
+/* Values of the ne_flags field of struct neighbor_entry */
+
+#define NEIGHBOR_FLAG_INUSE     (1 << 0) /* Entry holds an address mapping */
+#define NEIGHBOR_FLAG_NEGATIVE  (1 << 1) /* Address resolution failed */
+
+/* Hash an IPv6 address into the Neighbor hash table.  Only the interface
+ * identifier (the low 64 bits) varies between neighbors on a link.
+ */
+
+#define NEIGHBOR_HASH(a) \
+  ((uint16_t)((a)[4] ^ (a)[5] ^ (a)[6] ^ (a)[7]) % \
+   CONFIG_NET_IPv6_NCONF_HASHSIZE)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -92,11 +115,20 @@ struct neighbor_addr_s
 
 struct neighbor_entry
 {
+  dq_entry_t             ne_node;    /* LRU list link.  Must be first */
+  FAR struct neighbor_entry *ne_hnext; /* Next entry in the hash chain */
   net_ipv6addr_t         ne_ipaddr;  /* IPv6 address of the Neighbor */
   struct neighbor_addr_s ne_addr;    /* Link layer address of the Neighbor */
   clock_t                ne_time;    /* For aging, units of tick */
+  uint32_t               ne_hits;    /* Number of successful look-ups */
+  uint8_t                ne_flags;   /* See NEIGHBOR_FLAG_* definitions */
 };
 
+/* Callback type used by neighbor_foreach() */
+
+typedef int (*neighbor_callback_t)(FAR struct neighbor_entry *neighbor,
+                                   FAR void *arg);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -107,12 +139,36 @@ struct neighbor_entry
 
 extern struct neighbor_entry g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* Hash table of in-use entries, indexed by NEIGHBOR_HASH() of the IPv6
+ * address.
+ */
+
+extern FAR struct neighbor_entry *
+  g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+
+/* All Neighbor Table entries ordered from least recently used (head) to
+ * most recently used (tail).  Unused entries are kept at the head.
+ */
+
+extern dq_queue_t g_neighbor_lru;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
 struct net_driver_s; /* Forward reference */
 
+/****************************************************************************
+ * Name: neighbor_initialize
+ *
+ * Description:
+ *   Initialize the Neighbor Table.  All entries are initially unused and
+ *   placed on the LRU list.
+ *
+ ****************************************************************************/
+
+void neighbor_initialize(void);
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -125,12 +181,59 @@ struct net_driver_s; /* Forward reference */
  *
  * Returned Value:
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
- *   returned if there is no matching entry in the Neighbor Table.
+ *   returned if there is no matching entry in the Neighbor Table.  The
+ *   entry may be a negative entry (see NEIGHBOR_FLAG_NEGATIVE).
  *
  ****************************************************************************/
 
 FAR struct neighbor_entry *neighbor_findentry(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_allocentry
+ *
+ * Description:
+ *   Allocate a Neighbor Table entry for the IPv6 address, evicting the
+ *   least recently used entry if the table is full.  This interface is
+ *   internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address of the new entry.
+ *
+ * Returned Value:
+ *   The new Neighbor Table entry, linked into the hash table and marked as
+ *   most recently used.  Never NULL.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_entry *neighbor_allocentry(const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_freeentry
+ *
+ * Description:
+ *   Unlink an entry from the hash table and make it the next entry to be
+ *   re-used.  This interface is internal to the neighbor implementation.
+ *
+ ****************************************************************************/
+
+void neighbor_freeentry(FAR struct neighbor_entry *neighbor);
+
+/****************************************************************************
+ * Name: neighbor_touch
+ *
+ * Description:
+ *   Make the entry the most recently used one.
+ *
+ ****************************************************************************/
+
+#define neighbor_touch(n) \
+  do \
+    { \
+      dq_rem(&(n)->ne_node, &g_neighbor_lru); \
+      dq_addlast(&(n)->ne_node, &g_neighbor_lru); \
+    } \
+  while (0)
+
 /****************************************************************************
  * Name: neighbor_add
  *
@@ -190,6 +293,72 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
 
 void neighbor_update(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_negative_add
+ *
+ * Description:
+ *   Record that Neighbor Solicitation for this IPv6 address has failed.
+ *   Until the negative entry expires, neighbor_is_negative() will report
+ *   the address as unreachable.  A valid mapping is never replaced by a
+ *   negative entry.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address that could not be resolved
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_IPv6_NCONF_NEGAGE > 0
+void neighbor_negative_add(const net_ipv6addr_t ipaddr);
+#else
+#  define neighbor_negative_add(i)
+#endif
+
+/****************************************************************************
+ * Name: neighbor_is_negative
+ *
+ * Description:
+ *   Check if there is an unexpired negative entry for this IPv6 address.
+ *   Expired negative entries are released as a side effect.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to check
+ *
+ * Returned Value:
+ *   True if Neighbor Solicitation recently failed for this IPv6 address.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_IPv6_NCONF_NEGAGE > 0
+bool neighbor_is_negative(const net_ipv6addr_t ipaddr);
+#else
+#  define neighbor_is_negative(i) (false)
+#endif
+
+/****************************************************************************
+ * Name: neighbor_foreach
+ *
+ * Description:
+ *   Enumerate each in-use entry in the Neighbor Table.
+ *
+ * Input Parameters:
+ *   callback - Will be called for each entry.  Enumeration stops if the
+ *              callback returns a non-zero value.
+ *   arg      - An arbitrary argument passed to the callback.
+ *
+ * Returned Value:
+ *   The non-zero value returned by the callback that terminated the
+ *   enumeration; zero if all entries were visited.
+ *
+ * Assumptions:
+ *   The network is locked to assure exclusive access to the Neighbor Table.
+ *
+ ****************************************************************************/
+
+int neighbor_foreach(neighbor_callback_t callback, FAR void *arg);
+
 /****************************************************************************
  * Name: neighbor_ethernet_out
  *
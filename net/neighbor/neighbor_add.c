@@ -80,49 +80,35 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
-  uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
+  FAR struct neighbor_entry *neighbor;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the first unused entry or the oldest used entry. */
-
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  /* Find the existing entry for this address or replace the least
+   * recently used entry.
+   */
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  neighbor = neighbor_findentry(ipaddr);
+  if (neighbor == NULL)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
-        {
-          oldest_ndx = i;
-          break;
-        }
-
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
-        {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
-        }
+      neighbor = neighbor_allocentry(ipaddr);
+    }
+  else
+    {
+      neighbor_touch(neighbor);
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  /* A valid mapping replaces any negative entry for the address */
 
-  g_neighbors[oldest_ndx].ne_time = clock_systimer();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  neighbor->ne_time   = clock_systimer();
+  neighbor->ne_flags &= ~NEIGHBOR_FLAG_NEGATIVE;
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  neighbor->ne_addr.na_lltype = dev->d_lltype;
+  neighbor->ne_addr.na_llsize = netdev_lladdrsize(dev);
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  memcpy(&neighbor->ne_addr.u, addr, neighbor->ne_addr.na_llsize);
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", neighbor);
 }
@@ -177,6 +177,17 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
 
       if (neighbor_lookup(ipaddr, &laddr) < 0)
         {
+          /* Don't flood the network with solicitations for an address
+           * that did not respond recently.  Just drop the packet.
+           */
+
+          if (neighbor_is_negative(ipaddr))
+            {
+              ninfo("Negative Neighbor entry\n");
+              dev->d_len = 0;
+              return;
+            }
+
            ninfo("IPv6 Neighbor solicitation for IPv6\n");
 
           /* The destination address was not in our Neighbor Table, so we
@@ -64,36 +64,19 @@
  *
  * Returned Value:
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
- *   returned if there is no matching entry in the Neighbor Table.
+ *   returned if there is no matching entry in the Neighbor Table.  The
+ *   entry may be a negative entry (see NEIGHBOR_FLAG_NEGATIVE).
  *
  ****************************************************************************/
 
 FAR struct neighbor_entry *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  #ifdef CONFIG_NET_6LOWPAN
-  #else
-    int i;
+  FAR struct neighbor_entry *neighbor;
 
-    for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
-      {
-        FAR struct neighbor_entry *neighbor = &g_neighbors[i];
-
-        if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
-          {
-            neighbor_dumpentry("Entry found", neighbor);
-            return neighbor;
-          }
-      }
-
-    neighbor_dumpipaddr("Not found", ipaddr);
-    return NULL
-  #endif
-  /*int i;
-
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (neighbor = g_neighbor_hash[NEIGHBOR_HASH(ipaddr)];
+       neighbor != NULL;
+       neighbor = neighbor->ne_hnext)
     {
-      FAR struct neighbor_entry *neighbor = &g_neighbors[i];
-
       if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
           neighbor_dumpentry("Entry found", neighbor);
@@ -102,5 +85,5 @@ FAR struct neighbor_entry *neighbor_findentry(const net_ipv6addr_t ipaddr)
     }
 
   neighbor_dumpipaddr("Not found", ipaddr);
-  return NULL;*/
+  return NULL;
 }
@@ -56,3 +56,15 @@
 
 struct neighbor_entry g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* Hash table of in-use entries, indexed by NEIGHBOR_HASH() of the IPv6
+ * address.
+ */
+
+FAR struct neighbor_entry *g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+
+/* All Neighbor Table entries ordered from least recently used (head) to
+ * most recently used (tail).  Unused entries are kept at the head.
+ */
+
+dq_queue_t g_neighbor_lru;
+
@@ -136,7 +136,8 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
   /* Check if the IPv6 address is already in the neighbor table. */
 
   neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  if (neighbor != NULL &&
+      (neighbor->ne_flags & NEIGHBOR_FLAG_NEGATIVE) == 0)
     {
       /* Yes.. return the link layer address if the caller has provided a
        * non-NULL address in 'laddr'.
@@ -147,6 +148,9 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
           memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
         }
 
+      neighbor->ne_hits++;
+      neighbor_touch(neighbor);
+
       /* Return success in any case meaning that a valid link layer
        * address mapping is available for the IPv6 address.
        */
@@ -0,0 +1,137 @@
+/****************************************************************************
+ * net/neighbor/neighbor_negative.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/clock.h>
+
+#include "neighbor/neighbor.h"
+
+#if CONFIG_NET_IPv6_NCONF_NEGAGE > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NEIGHBOR_NEGAGE_TICK DSEC2TICK(CONFIG_NET_IPv6_NCONF_NEGAGE)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_negative_add
+ *
+ * Description:
+ *   Record that Neighbor Solicitation for this IPv6 address has failed.
+ *   Until the negative entry expires, neighbor_is_negative() will report
+ *   the address as unreachable.  A valid mapping is never replaced by a
+ *   negative entry.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address that could not be resolved
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void neighbor_negative_add(const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_entry *neighbor;
+
+  neighbor = neighbor_findentry(ipaddr);
+  if (neighbor == NULL)
+    {
+      neighbor = neighbor_allocentry(ipaddr);
+    }
+  else if ((neighbor->ne_flags & NEIGHBOR_FLAG_NEGATIVE) == 0)
+    {
+      return;
+    }
+
+  memset(&neighbor->ne_addr, 0, sizeof(struct neighbor_addr_s));
+  neighbor->ne_time   = clock_systimer();
+  neighbor->ne_flags |= NEIGHBOR_FLAG_NEGATIVE;
+
+  neighbor_dumpentry("Negative entry", neighbor);
+}
+
+/****************************************************************************
+ * Name: neighbor_is_negative
+ *
+ * Description:
+ *   Check if there is an unexpired negative entry for this IPv6 address.
+ *   Expired negative entries are released as a side effect.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to check
+ *
+ * Returned Value:
+ *   True if Neighbor Solicitation recently failed for this IPv6 address.
+ *
+ ****************************************************************************/
+
+bool neighbor_is_negative(const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_entry *neighbor;
+
+  neighbor = neighbor_findentry(ipaddr);
+  if (neighbor == NULL ||
+      (neighbor->ne_flags & NEIGHBOR_FLAG_NEGATIVE) == 0)
+    {
+      return false;
+    }
+
+  if (clock_systimer() - neighbor->ne_time <= NEIGHBOR_NEGAGE_TICK)
+    {
+      neighbor->ne_hits++;
+      return true;
+    }
+
+  /* The negative entry has expired.  Free it for re-use. */
+
+  neighbor_freeentry(neighbor);
+  return false;
+}
+
+#endif /* CONFIG_NET_IPv6_NCONF_NEGAGE > 0 */
@@ -0,0 +1,190 @@
+/****************************************************************************
+ * net/neighbor/neighbor_table.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "neighbor/neighbor.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_initialize
+ *
+ * Description:
+ *   Initialize the Neighbor Table.  All entries are initially unused and
+ *   placed on the LRU list.
+ *
+ * Assumptions:
+ *   Called early in the initialization sequence so that no special
+ *   protection is required.
+ *
+ ****************************************************************************/
+
+void neighbor_initialize(void)
+{
+  int i;
+
+  dq_init(&g_neighbor_lru);
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; i++)
+    {
+      dq_addlast(&g_neighbors[i].ne_node, &g_neighbor_lru);
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_allocentry
+ *
+ * Description:
+ *   Allocate a Neighbor Table entry for the IPv6 address, evicting the
+ *   least recently used entry if the table is full.  This interface is
+ *   internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address of the new entry.
+ *
+ * Returned Value:
+ *   The new Neighbor Table entry, linked into the hash table and marked as
+ *   most recently used.  Never NULL.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_entry *neighbor_allocentry(const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_entry *neighbor;
+  int ndx;
+
+  /* The head of the LRU list is either unused or the least recently used
+   * entry.
+   */
+
+  neighbor = (FAR struct neighbor_entry *)dq_peek(&g_neighbor_lru);
+  DEBUGASSERT(neighbor != NULL);
+
+  if ((neighbor->ne_flags & NEIGHBOR_FLAG_INUSE) != 0)
+    {
+      neighbor_dumpentry("Evicted entry", neighbor);
+      neighbor_freeentry(neighbor);
+    }
+
+  ndx                  = NEIGHBOR_HASH(ipaddr);
+  neighbor->ne_hnext   = g_neighbor_hash[ndx];
+  neighbor->ne_flags   = NEIGHBOR_FLAG_INUSE;
+  g_neighbor_hash[ndx] = neighbor;
+
+  net_ipv6addr_copy(neighbor->ne_ipaddr, ipaddr);
+  neighbor_touch(neighbor);
+  return neighbor;
+}
+
+/****************************************************************************
+ * Name: neighbor_freeentry
+ *
+ * Description:
+ *   Unlink an entry from the hash table and make it the next entry to be
+ *   re-used.  This interface is internal to the neighbor implementation.
+ *
+ ****************************************************************************/
+
+void neighbor_freeentry(FAR struct neighbor_entry *neighbor)
+{
+  FAR struct neighbor_entry **pprev;
+
+  pprev = &g_neighbor_hash[NEIGHBOR_HASH(neighbor->ne_ipaddr)];
+  while (*pprev != NULL)
+    {
+      if (*pprev == neighbor)
+        {
+          *pprev = neighbor->ne_hnext;
+          break;
+        }
+
+      pprev = &(*pprev)->ne_hnext;
+    }
+
+  neighbor->ne_hnext = NULL;
+  neighbor->ne_flags = 0;
+  neighbor->ne_hits  = 0;
+  memset(neighbor->ne_ipaddr, 0, sizeof(net_ipv6addr_t));
+  memset(&neighbor->ne_addr, 0, sizeof(struct neighbor_addr_s));
+
+  dq_rem(&neighbor->ne_node, &g_neighbor_lru);
+  dq_addfirst(&neighbor->ne_node, &g_neighbor_lru);
+}
+
+/****************************************************************************
+ * Name: neighbor_foreach
+ *
+ * Description:
+ *   Enumerate each in-use entry in the Neighbor Table.
+ *
+ * Input Parameters:
+ *   callback - Will be called for each entry.  Enumeration stops if the
+ *              callback returns a non-zero value.
+ *   arg      - An arbitrary argument passed to the callback.
+ *
+ * Returned Value:
+ *   The non-zero value returned by the callback that terminated the
+ *   enumeration; zero if all entries were visited.
+ *
+ * Assumptions:
+ *   The network is locked to assure exclusive access to the Neighbor Table.
+ *
+ ****************************************************************************/
+
+int neighbor_foreach(neighbor_callback_t callback, FAR void *arg)
+{
+  int ret = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES && ret == 0; i++)
+    {
+      if ((g_neighbors[i].ne_flags & NEIGHBOR_FLAG_INUSE) != 0)
+        {
+          ret = callback(&g_neighbors[i], arg);
+        }
+    }
+
+  return ret;
+}
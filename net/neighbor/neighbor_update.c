@@ -70,8 +70,10 @@ void neighbor_update(const net_ipv6addr_t ipaddr)
   struct neighbor_entry *neighbor;
 
   neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  if (neighbor != NULL &&
+      (neighbor->ne_flags & NEIGHBOR_FLAG_NEGATIVE) == 0)
     {
       neighbor->ne_time = clock_systimer();
+      neighbor_touch(neighbor);
     }
 }
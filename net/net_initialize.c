@@ -46,6 +46,7 @@
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
+#include "arp/arp.h"
 #include "devif/devif.h"
 #include "netdev/netdev.h"
 #include "ipforward/ipforward.h"
@@ -53,6 +54,7 @@
 #include "icmp/icmp.h"
 #include "icmpv6/icmpv6.h"
 #include "mld/mld.h"
+#include "neighbor/neighbor.h"
 #include "tcp/tcp.h"
 #include "udp/udp.h"
 #include "pkt/pkt.h"
@@ -98,7 +100,17 @@ void net_initialize(void)
 
   net_lockinitialize();
 
+#ifdef CONFIG_NET_ARP
+  /* Initialize the ARP table */
+
+  arp_initialize();
+#endif
+
 #ifdef CONFIG_NET_IPv6
+  /* Initialize the IPv6 Neighbor Table */
+
+  neighbor_initialize();
+
 #ifdef CONFIG_NET_MLD
   /* Initialize ICMPv6 Multicast Listener Discovery (MLD) logic */
 
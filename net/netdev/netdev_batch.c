@@ -0,0 +1,314 @@
+/****************************************************************************
+ * net/netdev/netdev_batch.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/arp.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_IOB_BATCH
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* State of the TX batch in progress.  There can be only one because the
+ * network is locked throughout netdev_txbatch().
+ */
+
+struct netdev_txbatch_s
+{
+  FAR struct iob_queue_s *txq; /* Queue that receives the outgoing packets */
+  int budget;                  /* Maximum number of packets to queue */
+  int npackets;                /* Number of packets queued so far */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct netdev_txbatch_s g_txbatch;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_room
+ *
+ * Description:
+ *   Return true if there are enough free IOBs to queue one more packet of
+ *   the maximum size for the device.
+ *
+ ****************************************************************************/
+
+static bool netdev_iob_room(FAR struct net_driver_s *dev)
+{
+  int niobs = (dev->d_pktsize + CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE;
+
+  return iob_navail(false) >= niobs && iob_qentry_navail() > 0;
+}
+
+/****************************************************************************
+ * Name: netdev_txbatch_callback
+ *
+ * Description:
+ *   The devif_poll() callback used by netdev_txbatch().  Complete the link
+ *   layer header of each outgoing packet and copy it into an IOB chain on
+ *   the TX queue.
+ *
+ ****************************************************************************/
+
+static int netdev_txbatch_callback(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_txbatch_s *batch = &g_txbatch;
+  FAR struct iob_s *iob;
+  int ret;
+
+  if (dev->d_len > 0)
+    {
+#ifdef CONFIG_NET_ETHERNET
+      /* Look up the destination MAC address and add it to the Ethernet
+       * header.
+       */
+
+      if (dev->d_lltype == NET_LL_ETHERNET)
+        {
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+          if (IFF_IS_IPv4(dev->d_flags))
+#endif
+            {
+              arp_out(dev);
+            }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+          else
+#endif
+            {
+              neighbor_out(dev);
+            }
+#endif /* CONFIG_NET_IPv6 */
+        }
+#endif /* CONFIG_NET_ETHERNET */
+
+      /* Packets to our own address are looped back immediately (except on
+       * the loopback device, which is the consumer of its own TX queue).
+       */
+
+      if (dev->d_lltype == NET_LL_LOOPBACK || !devif_loopback(dev))
+        {
+          /* Copy the packet into a new IOB chain and queue it */
+
+          iob = iob_tryalloc(false);
+          if (iob == NULL)
+            {
+              NETDEV_TXERRORS(dev);
+              return 1;
+            }
+
+          ret = iob_trycopyin(iob, dev->d_buf, dev->d_len, 0, false);
+          if (ret >= 0)
+            {
+              ret = iob_tryadd_queue(iob, batch->txq);
+            }
+
+          if (ret < 0)
+            {
+              nerr("ERROR: Failed to queue packet: %d\n", ret);
+              iob_free_chain(iob);
+              NETDEV_TXERRORS(dev);
+              return 1;
+            }
+
+          batch->npackets++;
+        }
+
+      dev->d_len = 0;
+    }
+
+  /* Stop the poll when the budget is exhausted or if another packet might
+   * not fit in the remaining IOBs.
+   */
+
+  return (batch->npackets >= batch->budget || !netdev_iob_room(dev)) ?
+         1 : 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_txbatch
+ *
+ * Description:
+ *   Poll the network for up to 'budget' outgoing packets and queue each in
+ *   its own IOB chain on 'txq'.  The link layer header of each packet is
+ *   complete:  For Ethernet devices, arp_out() or neighbor_out() has been
+ *   called and packets sent to the device's own address have been looped
+ *   back.  The driver may then hand the whole batch to the hardware (for
+ *   example, one packet per DMA descriptor) without further involvement of
+ *   the network.
+ *
+ *   The network is locked only once for the whole batch.
+ *
+ * Input Parameters:
+ *   dev    - The network device to poll
+ *   txq    - The queue that receives the outgoing packets
+ *   budget - The maximum number of packets to queue
+ *
+ * Returned Value:
+ *   The number of packets queued (zero if there is nothing to send or
+ *   there are not enough free IOBs).
+ *
+ ****************************************************************************/
+
+int netdev_txbatch(FAR struct net_driver_s *dev,
+                   FAR struct iob_queue_s *txq, int budget)
+{
+  int npackets = 0;
+
+  DEBUGASSERT(dev != NULL && dev->d_buf != NULL && txq != NULL);
+
+  net_lock();
+  if (budget > 0 && netdev_iob_room(dev))
+    {
+      g_txbatch.txq      = txq;
+      g_txbatch.budget   = budget;
+      g_txbatch.npackets = 0;
+
+      (void)devif_poll(dev, netdev_txbatch_callback);
+
+      npackets           = g_txbatch.npackets;
+      g_txbatch.txq      = NULL;
+    }
+
+  net_unlock();
+  return npackets;
+}
+
+/****************************************************************************
+ * Name: netdev_rxbatch
+ *
+ * Description:
+ *   Deliver up to 'budget' received packets from 'rxq' to the network.
+ *   Each IOB chain is copied into d_buf and passed to the 'input'
+ *   function.  That function is provided by the driver and is the same
+ *   logic that the driver would otherwise execute for each received
+ *   packet:  It dispatches the packet by type (ipv4_input(), arp_arpin(),
+ *   ...) and sends any response left in d_buf.
+ *
+ *   The network is locked only once for the whole batch so that a driver
+ *   may collect packets from its receive descriptors without the network
+ *   lock, then deliver them together.  Packets beyond the budget are left
+ *   in 'rxq' for the next call, so that one busy interface cannot starve
+ *   the others.
+ *
+ * Input Parameters:
+ *   dev    - The network device that received the packets
+ *   rxq    - The queue of received packets
+ *   budget - The maximum number of packets to deliver
+ *   input  - Driver function that processes one packet in d_buf
+ *
+ * Returned Value:
+ *   The number of packets removed from 'rxq'.
+ *
+ ****************************************************************************/
+
+int netdev_rxbatch(FAR struct net_driver_s *dev,
+                   FAR struct iob_queue_s *rxq, int budget,
+                   devif_poll_callback_t input)
+{
+  FAR struct iob_s *iob;
+  int npackets;
+  int ret;
+
+  DEBUGASSERT(dev != NULL && dev->d_buf != NULL && rxq != NULL &&
+              input != NULL);
+
+  net_lock();
+  for (npackets = 0; npackets < budget; npackets++)
+    {
+      iob = iob_remove_queue(rxq);
+      if (iob == NULL)
+        {
+          break;
+        }
+
+      if (iob->io_pktlen > dev->d_pktsize)
+        {
+          nwarn("WARNING: Dropped oversized packet: %u\n", iob->io_pktlen);
+          NETDEV_RXDROPPED(dev);
+          iob_free_chain(iob);
+          continue;
+        }
+
+      ret = iob_copyout(dev->d_buf, iob, iob->io_pktlen, 0);
+      iob_free_chain(iob);
+
+      if (ret < 0)
+        {
+          NETDEV_RXERRORS(dev);
+          continue;
+        }
+
+      dev->d_len = (uint16_t)ret;
+      (void)input(dev);
+    }
+
+  net_unlock();
+  return npackets;
+}
+
+#endif /* CONFIG_NETDEV_IOB_BATCH */
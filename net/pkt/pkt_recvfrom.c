@@ -410,6 +410,17 @@ ssize_t pkt_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     }
 #endif
 
+  /* Packet sockets do not buffer received frames; a frame can only be
+   * received by waiting for it.  So there is nothing to return to a
+   * caller that does not want to wait.
+   */
+
+  if ((flags & MSG_DONTWAIT) != 0)
+    {
+      ret = -EAGAIN;
+      goto errout_with_state;
+    }
+
   /* Set the socket state to receiving */
 
   psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_RECV);
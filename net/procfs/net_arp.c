@@ -0,0 +1,195 @@
+/****************************************************************************
+ * net/procfs/net_arp.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   IPADDR          HWADDR            AGE   HITS       FLAGS
+ *   xxx.xxx.xxx.xxx xx:xx:xx:xx:xx:xx nnnnn nnnnnnnnnn N
+ *
+ * AGE is the time in seconds since the entry was last updated.  FLAGS is
+ * 'N' for a negative entry (address resolution failed) and '-' otherwise.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <arpa/inet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/arp.h>
+
+#include "arp/arp.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_ARP)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The structure is used when traversing the ARP table */
+
+struct arp_info_s
+{
+  FAR char *line;                    /* Intermediate line buffer pointer */
+  FAR char *buffer;                  /* User buffer */
+  size_t    linelen;                 /* Size of the intermediate buffer */
+  size_t    buflen;                  /* Size of the user buffer */
+  size_t    remaining;               /* Bytes remaining in user buffer */
+  size_t    totalsize;               /* Accumulated size of the copy */
+  off_t     offset;                  /* Skip offset */
+  clock_t   now;                     /* Time of the traversal */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arp_sprintf
+ ****************************************************************************/
+
+static void arp_sprintf(FAR struct arp_info_s *info,
+                        FAR const char *fmt, ...)
+{
+  size_t linesize;
+  size_t copysize;
+  va_list ap;
+
+  /* Print the format and data to a line buffer */
+
+  va_start(ap, fmt);
+  linesize = vsnprintf(info->line, info->linelen, fmt, ap);
+  va_end(ap);
+
+  /* Copy the line buffer to the user buffer */
+
+  copysize = procfs_memcpy(info->line, linesize,
+                           info->buffer, info->remaining,
+                           &info->offset);
+
+  /* Update counts and pointers */
+
+  info->totalsize += copysize;
+  info->buffer    += copysize;
+  info->remaining -= copysize;
+}
+
+/****************************************************************************
+ * Name: arp_entry
+ ****************************************************************************/
+
+static int arp_entry(FAR struct arp_entry_s *entry, FAR void *arg)
+{
+  FAR struct arp_info_s *info = (FAR struct arp_info_s *)arg;
+  FAR const uint8_t *mac = entry->at_ethaddr.ether_addr_octet;
+  char ipaddr[INET_ADDRSTRLEN];
+
+  (void)inet_ntop(AF_INET, &entry->at_ipaddr, ipaddr, INET_ADDRSTRLEN);
+
+  arp_sprintf(info, "%-16s%02x:%02x:%02x:%02x:%02x:%02x %5lu %10lu %c\n",
+              ipaddr, mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+              (unsigned long)((info->now - entry->at_time) / CLK_TCK),
+              (unsigned long)entry->at_hits,
+              (entry->at_flags & ARP_FLAG_NEGATIVE) != 0 ? 'N' : '-');
+
+  return (info->totalsize >= info->buflen) ? 1 : 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_arptable
+ *
+ * Description:
+ *   Read and format the ARP table.
+ *
+ * Input Parameters:
+ *   priv   - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the ARP table will be
+ *            returned.
+ *   buflen - The size in bytes of the user provided buffer.
+ *   offset - The file offset of the read.
+ *
+ * Returned Value:
+ *   The number of bytes returned on success; a negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_arptable(FAR struct netprocfs_file_s *priv,
+                                FAR char *buffer, size_t buflen,
+                                off_t offset)
+{
+  struct arp_info_s info;
+
+  memset(&info, 0, sizeof(struct arp_info_s));
+  info.line      = priv->line;
+  info.linelen   = NET_LINELEN;
+  info.buffer    = buffer;
+  info.buflen    = buflen;
+  info.remaining = buflen;
+  info.offset    = offset;
+
+  arp_sprintf(&info, "%-16s%-18s%-6s%-11s%s\n",
+              "IPADDR", "HWADDR", "AGE", "HITS", "FLAGS");
+
+  /* The ARP table is only stable while the network is locked */
+
+  net_lock();
+  info.now = clock_systimer();
+  (void)arp_foreach(arp_entry, &info);
+  net_unlock();
+
+  return info.totalsize;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_ARP */
@@ -0,0 +1,238 @@
+/****************************************************************************
+ * net/procfs/net_neighbor.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   IPADDR                    LLADDR                   AGE   HITS       FLAGS
+ *   xxxx:xxxx::xxxx:xxxx      xx:xx:xx:xx:xx:xx        nnnnn nnnnnnnnnn N
+ *
+ * AGE is the time in seconds since the entry was last updated.  FLAGS is
+ * 'N' for a negative entry (Neighbor Solicitation failed) and '-'
+ * otherwise.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <arpa/inet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "neighbor/neighbor.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_IPv6)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* IPv6 addresses do not fit in the shared NET_LINELEN line buffer.  This
+ * determines the size of a larger intermediate buffer on the stack.
+ */
+
+#define NEIGHBOR_LINELEN 112
+
+/* Longest link layer address string: 8 bytes as xx:xx:...:xx plus the
+ * NUL terminator.
+ */
+
+#define NEIGHBOR_LLSTRLEN (3 * 8)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The structure is used when traversing the Neighbor Table */
+
+struct neighbor_info_s
+{
+  FAR char *line;                    /* Intermediate line buffer pointer */
+  FAR char *buffer;                  /* User buffer */
+  size_t    linelen;                 /* Size of the intermediate buffer */
+  size_t    buflen;                  /* Size of the user buffer */
+  size_t    remaining;               /* Bytes remaining in user buffer */
+  size_t    totalsize;               /* Accumulated size of the copy */
+  off_t     offset;                  /* Skip offset */
+  clock_t   now;                     /* Time of the traversal */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_sprintf
+ ****************************************************************************/
+
+static void neighbor_sprintf(FAR struct neighbor_info_s *info,
+                             FAR const char *fmt, ...)
+{
+  size_t linesize;
+  size_t copysize;
+  va_list ap;
+
+  /* Print the format and data to a line buffer */
+
+  va_start(ap, fmt);
+  linesize = vsnprintf(info->line, info->linelen, fmt, ap);
+  va_end(ap);
+
+  /* Copy the line buffer to the user buffer */
+
+  copysize = procfs_memcpy(info->line, linesize,
+                           info->buffer, info->remaining,
+                           &info->offset);
+
+  /* Update counts and pointers */
+
+  info->totalsize += copysize;
+  info->buffer    += copysize;
+  info->remaining -= copysize;
+}
+
+/****************************************************************************
+ * Name: neighbor_entry
+ ****************************************************************************/
+
+static int neighbor_entry(FAR struct neighbor_entry *neighbor, FAR void *arg)
+{
+  FAR struct neighbor_info_s *info = (FAR struct neighbor_info_s *)arg;
+  FAR const uint8_t *lladdr = (FAR const uint8_t *)&neighbor->ne_addr.u;
+  char ipaddr[INET6_ADDRSTRLEN];
+  char llstr[NEIGHBOR_LLSTRLEN];
+  FAR char *ptr;
+  int llsize;
+  int i;
+
+  (void)inet_ntop(AF_INET6, neighbor->ne_ipaddr, ipaddr, INET6_ADDRSTRLEN);
+
+  /* Format the link layer address.  Negative entries have none. */
+
+  llsize = neighbor->ne_addr.na_llsize;
+  if (llsize > NEIGHBOR_LLSTRLEN / 3)
+    {
+      llsize = NEIGHBOR_LLSTRLEN / 3;
+    }
+
+  if (llsize == 0)
+    {
+      strcpy(llstr, "-");
+    }
+  else
+    {
+      ptr = llstr;
+      for (i = 0; i < llsize; i++)
+        {
+          ptr += sprintf(ptr, i > 0 ? ":%02x" : "%02x", lladdr[i]);
+        }
+    }
+
+  neighbor_sprintf(info, "%-26s%-25s%5lu %10lu %c\n",
+                   ipaddr, llstr,
+                   (unsigned long)((info->now - neighbor->ne_time) / CLK_TCK),
+                   (unsigned long)neighbor->ne_hits,
+                   (neighbor->ne_flags & NEIGHBOR_FLAG_NEGATIVE) != 0 ?
+                   'N' : '-');
+
+  return (info->totalsize >= info->buflen) ? 1 : 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_neighbors
+ *
+ * Description:
+ *   Read and format the IPv6 Neighbor Table.
+ *
+ * Input Parameters:
+ *   priv   - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the Neighbor Table will
+ *            be returned.
+ *   buflen - The size in bytes of the user provided buffer.
+ *   offset - The file offset of the read.
+ *
+ * Returned Value:
+ *   The number of bytes returned on success; a negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_neighbors(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen,
+                                 off_t offset)
+{
+  struct neighbor_info_s info;
+  char line[NEIGHBOR_LINELEN];
+
+  memset(&info, 0, sizeof(struct neighbor_info_s));
+  info.line      = line;
+  info.linelen   = NEIGHBOR_LINELEN;
+  info.buffer    = buffer;
+  info.buflen    = buflen;
+  info.remaining = buflen;
+  info.offset    = offset;
+
+  neighbor_sprintf(&info, "%-26s%-25s%-6s%-11s%s\n",
+                   "IPADDR", "LLADDR", "AGE", "HITS", "FLAGS");
+
+  /* The Neighbor Table is only stable while the network is locked */
+
+  net_lock();
+  info.now = clock_systimer();
+  (void)neighbor_foreach(neighbor_entry, &info);
+  net_unlock();
+
+  return info.totalsize;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_IPv6 */
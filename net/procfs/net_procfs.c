@@ -75,12 +75,26 @@
 #  define STAT_INDEX     0
 #  ifdef CONFIG_NET_MLD
 #    define MLD_INDEX    1
-#    define _ROUTE_INDEX 2
+#    define _ARP_INDEX   2
 #  else
-#    define _ROUTE_INDEX 1
+#    define _ARP_INDEX   1
 #  endif
 #else
-#  define _ROUTE_INDEX   0
+#  define _ARP_INDEX     0
+#endif
+
+#ifdef CONFIG_NET_ARP
+#  define ARP_INDEX      _ARP_INDEX
+#  define _NBR_INDEX     (_ARP_INDEX + 1)
+#else
+#  define _NBR_INDEX     _ARP_INDEX
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#  define NEIGHBOR_INDEX _NBR_INDEX
+#  define _ROUTE_INDEX   (_NBR_INDEX + 1)
+#else
+#  define _ROUTE_INDEX   _NBR_INDEX
 #endif
 
 #ifdef CONFIG_NET_ROUTE
@@ -193,6 +207,32 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
 #endif
 #endif
 
+#ifdef CONFIG_NET_ARP
+  /* "net/arp" is an acceptable value for the relpath only if ARP is
+   * enabled.
+   */
+
+  if (strcmp(relpath, "net/arp") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_ARP;
+      dev   = NULL;
+    }
+  else
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  /* "net/neighbor" is an acceptable value for the relpath only if IPv6 is
+   * enabled.
+   */
+
+  if (strcmp(relpath, "net/neighbor") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_NEIGHBOR;
+      dev   = NULL;
+    }
+  else
+#endif
+
 #ifdef CONFIG_NET_ROUTE
   /* "net/route" is an acceptable value for the relpath only if routing
    * table support is initialized.
@@ -320,6 +360,24 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
 #endif
 #endif
 
+#ifdef CONFIG_NET_ARP
+      case NETPROCFS_SUBDIR_ARP:
+        /* Show the ARP table */
+
+        nreturned = netprocfs_read_arptable(priv, buffer, buflen,
+                                            filep->f_pos);
+        break;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      case NETPROCFS_SUBDIR_NEIGHBOR:
+        /* Show the IPv6 Neighbor Table */
+
+        nreturned = netprocfs_read_neighbors(priv, buffer, buflen,
+                                             filep->f_pos);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -440,6 +498,12 @@ static int netprocfs_opendir(FAR const char *relpath,
       level1->base.nentries++;
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+      level1->base.nentries++;
+#endif
+#ifdef CONFIG_NET_IPv6
+      level1->base.nentries++;
+#endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
 #endif
@@ -546,6 +610,26 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
       else
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+      if (index == ARP_INDEX)
+        {
+          /* Copy the ARP table directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "arp", NAME_MAX + 1);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_IPv6
+      if (index == NEIGHBOR_INDEX)
+        {
+          /* Copy the Neighbor Table directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "neighbor", NAME_MAX + 1);
+        }
+      else
+#endif
 #ifdef CONFIG_NET_ROUTE
       if (index == ROUTE_INDEX)
         {
@@ -677,6 +761,24 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
   else
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+  /* Check for the ARP table "net/arp" */
+
+  if (strcmp(relpath, "net/arp") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  /* Check for the IPv6 Neighbor Table "net/neighbor" */
+
+  if (strcmp(relpath, "net/neighbor") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
 #ifdef CONFIG_NET_ROUTE
   /* Check for network statistics "net/stat" */
 
@@ -80,6 +80,10 @@ static int     netprocfs_sent(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int     netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NET_TCP */
+#ifdef CONFIG_NET_IPFORWARD
+static int     netprocfs_ipforward_1(FAR struct netprocfs_file_s *netfile);
+static int     netprocfs_ipforward_2(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_IPFORWARD */
 
 /****************************************************************************
  * Private Data
@@ -114,6 +118,11 @@ static const linegen_t g_stat_linegen[] =
 #ifdef CONFIG_NET_TCP
   , netprocfs_retransmissions
 #endif /* CONFIG_NET_TCP */
+
+#ifdef CONFIG_NET_IPFORWARD
+  , netprocfs_ipforward_1
+  , netprocfs_ipforward_2
+#endif /* CONFIG_NET_IPFORWARD */
 };
 
 #define NSTAT_LINES (sizeof(g_stat_linegen) / sizeof(linegen_t))
@@ -436,6 +445,41 @@ static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_ipforward_1
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_IPFORWARD)
+static int netprocfs_ipforward_1(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "  Forward    Fast: %04x  Queued: %04x  Sent: %04x"
+                  "  Drop: %04x\n",
+                  g_netstats.ipfwd.fastpath, g_netstats.ipfwd.queued,
+                  g_netstats.ipfwd.sent, g_netstats.ipfwd.drop);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_IPFORWARD */
+
+/****************************************************************************
+ * Name: netprocfs_ipforward_2
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_IPFORWARD)
+static int netprocfs_ipforward_2(FAR struct netprocfs_file_s *netfile)
+{
+  uint32_t avg = 0;
+
+  if (g_netstats.ipfwd.sent > 0)
+    {
+      avg = g_netstats.ipfwd.lattotal / g_netstats.ipfwd.sent;
+    }
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "             Latency (ticks) Avg: %lu  Max: %u\n",
+                  (unsigned long)avg, g_netstats.ipfwd.latmax);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_IPFORWARD */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
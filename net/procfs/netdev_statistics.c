@@ -496,8 +496,9 @@ static int netprocfs_txstatistics_header(FAR struct netprocfs_file_s *netfile)
 {
   DEBUGASSERT(netfile != NULL);
 
-  return snprintf(netfile->line, NET_LINELEN, "\tTX: %-8s %-8s %-8s %-8s\n",
-                 "Queued", "Sent", "Errors", "Timeouts");
+  return snprintf(netfile->line, NET_LINELEN,
+                 "\tTX: %-8s %-8s %-8s %-8s %-8s\n",
+                 "Queued", "Sent", "Errors", "Timeouts", "Polls");
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
@@ -515,11 +516,13 @@ static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile)
   dev = netfile->dev;
   stats = &dev->d_statistics;
 
-  return snprintf(netfile->line, NET_LINELEN, "\t    %08lx %08lx %08lx %08lx\n",
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\t    %08lx %08lx %08lx %08lx %08lx\n",
                   (unsigned long)stats->tx_packets,
                   (unsigned long)stats->tx_done,
                   (unsigned long)stats->tx_errors,
-                  (unsigned long)stats->tx_timeouts);
+                  (unsigned long)stats->tx_timeouts,
+                  (unsigned long)stats->tx_polls);
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
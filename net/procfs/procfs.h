@@ -75,6 +75,12 @@ enum netprocfs_entry_e
   , NETPROCFS_SUBDIR_MLD             /* /proc/net/mld */
 #endif
 #endif
+#ifdef CONFIG_NET_ARP
+  , NETPROCFS_SUBDIR_ARP             /* /proc/net/arp */
+#endif
+#ifdef CONFIG_NET_IPv6
+  , NETPROCFS_SUBDIR_NEIGHBOR        /* /proc/net/neighbor */
+#endif
 #ifdef CONFIG_NET_ROUTE
   , NETPROCFS_SUBDIR_ROUTE           /* /proc/net/route */
 #endif
@@ -195,6 +201,56 @@ ssize_t netprocfs_read_mldstats(FAR struct netprocfs_file_s *priv,
                                 FAR char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: netprocfs_read_arptable
+ *
+ * Description:
+ *   Read and format the ARP table.
+ *
+ * Input Parameters:
+ *   priv   - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the ARP table will be
+ *            returned.
+ *   buflen - The size in bytes of the user provided buffer.
+ *   offset - The file offset of the read.
+ *
+ * Returned Value:
+ *   The number of bytes returned on success; a negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP
+ssize_t netprocfs_read_arptable(FAR struct netprocfs_file_s *priv,
+                                FAR char *buffer, size_t buflen,
+                                off_t offset);
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_read_neighbors
+ *
+ * Description:
+ *   Read and format the IPv6 Neighbor Table.
+ *
+ * Input Parameters:
+ *   priv   - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the Neighbor Table will
+ *            be returned.
+ *   buflen - The size in bytes of the user provided buffer.
+ *   offset - The file offset of the read.
+ *
+ * Returned Value:
+ *   The number of bytes returned on success; a negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+ssize_t netprocfs_read_neighbors(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen,
+                                 off_t offset);
+#endif
+
 /****************************************************************************
  * Name: netprocfs_read_routes
  *
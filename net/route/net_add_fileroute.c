@@ -49,6 +49,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -99,6 +100,10 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   (void)net_closeroute_ipv4(&fshandle);
+
+  /* Rebuild the route look-up trie from the modified table */
+
+  (void)net_update_trieroute_ipv4();
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -133,6 +138,10 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   (void)net_closeroute_ipv6(&fshandle);
+
+  /* Rebuild the route look-up trie from the modified table */
+
+  (void)net_update_trieroute_ipv6();
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
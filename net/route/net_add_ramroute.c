@@ -50,6 +50,7 @@
 #include <arch/irq.h>
 
 #include "route/ramroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -101,6 +102,10 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
   net_unlock();
+
+  /* Rebuild the route look-up trie from the modified table */
+
+  (void)net_update_trieroute_ipv4();
   return OK;
 }
 #endif
@@ -136,6 +141,10 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
   net_unlock();
+
+  /* Rebuild the route look-up trie from the modified table */
+
+  (void)net_update_trieroute_ipv6();
   return OK;
 }
 #endif
@@ -53,6 +53,7 @@
 
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -329,6 +330,10 @@ errout_with_fshandle:
 
 errout_with_lock:
   (void)net_unlockroute_ipv4();
+
+  /* Rebuild the route look-up trie from the modified table */
+
+  (void)net_update_trieroute_ipv4();
   return ret;
 }
 #endif
@@ -478,6 +483,10 @@ errout_with_fshandle:
 
 errout_with_lock:
   (void)net_unlockroute_ipv6();
+
+  /* Rebuild the route look-up trie from the modified table */
+
+  (void)net_update_trieroute_ipv6();
   return ret;
 }
 #endif
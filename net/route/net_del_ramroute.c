@@ -48,6 +48,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -212,6 +213,7 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
 int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 {
   struct route_match_ipv4_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -221,7 +223,15 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+  ret = net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+  if (ret == OK)
+    {
+      /* Rebuild the route look-up trie from the modified table */
+
+      (void)net_update_trieroute_ipv4();
+    }
+
+  return ret;
 }
 #endif
 
@@ -229,6 +239,7 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 {
   struct route_match_ipv6_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -238,7 +249,15 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+  ret = net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+  if (ret == OK)
+    {
+      /* Rebuild the route look-up trie from the modified table */
+
+      (void)net_update_trieroute_ipv6();
+    }
+
+  return ret;
 }
 #endif
 
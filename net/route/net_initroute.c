@@ -42,6 +42,7 @@
 #include "route/ramroute.h"
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #ifdef CONFIG_NET_ROUTE
@@ -77,6 +78,10 @@ void net_init_route(void)
 #if defined(CONFIG_ROUTE_IPv4_CACHEROUTE) || defined(CONFIG_ROUTE_IPv6_CACHEROUTE)
   net_init_cacheroute();
 #endif
+
+#ifdef CONFIG_ROUTE_TRIE
+  net_init_trieroute();
+#endif
 }
 
 #endif /* CONFIG_NET_ROUTE */
@@ -49,6 +49,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -221,6 +222,16 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
       return -ENOENT;
     }
 
+#ifdef CONFIG_ROUTE_TRIE
+  /* Use the longest-prefix-match trie if it is available */
+
+  ret = net_trieroute_ipv4(NULL, target, router);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -296,6 +307,16 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
       return -ENOENT;
     }
 
+#ifdef CONFIG_ROUTE_TRIE
+  /* Use the longest-prefix-match trie if it is available */
+
+  ret = net_trieroute_ipv6(NULL, target, router);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
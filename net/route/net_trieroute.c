@@ -0,0 +1,864 @@
+/****************************************************************************
+ * net/route/net_trieroute.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+
+#include "route/trieroute.h"
+#include "route/route.h"
+
+#if defined(CONFIG_NET) && defined(CONFIG_ROUTE_TRIE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the largest key (i.e., address) in bytes */
+
+#ifdef CONFIG_NET_IPv6
+#  define TRIE_MAXKEY       16
+#else
+#  define TRIE_MAXKEY       4
+#endif
+
+/* Null node or route index */
+
+#define TRIE_NIL            (-1)
+
+/* Return bit 'n' of a key in network order (bit 0 is the MS bit) */
+
+#define TRIE_BIT(k,n)       (((k)[(n) >> 3] >> (7 - ((n) & 7))) & 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of a path-compressed binary trie.  Each node holds a complete
+ * prefix so that chains of single-child nodes are never needed.  A node
+ * may or may not correspond to routes.  Several routes (e.g., on different
+ * devices) may share a prefix; they are chained through 'rnext' in the
+ * order in which they were added.
+ */
+
+struct route_trie_node_s
+{
+  uint8_t  prefix[TRIE_MAXKEY];      /* Masked prefix in network order */
+  uint8_t  plen;                     /* Prefix length in bits */
+  int16_t  route;                    /* Index of the first route or TRIE_NIL */
+  int16_t  child[2];                 /* Sub-tries selected by the next bit */
+};
+
+/* One trie together with a private copy of the routes that it refers to.
+ * The trie, the routes and the nodes are allocated as one block so that a
+ * trie can be replaced or freed in a single operation.
+ */
+
+struct route_trie_s
+{
+  FAR uint8_t *routes;               /* Array of routing table entries */
+  FAR struct route_trie_node_s *nodes; /* Array of trie nodes */
+  FAR int16_t *rnext;                /* Next route with the same prefix */
+  uint16_t rsize;                    /* Size of one routing table entry */
+  uint16_t nroutes;                  /* Number of routes in use */
+  uint16_t maxroutes;                /* Number of routes allocated */
+  uint16_t nnodes;                   /* Number of nodes in use */
+  uint16_t maxnodes;                 /* Number of nodes allocated */
+  int16_t  root;                     /* Index of the root node */
+};
+
+/* Route filter used to constrain a look-up to one device */
+
+typedef bool (*route_trie_filter_t)(FAR struct route_trie_s *trie,
+                                    int index, FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The current tries.  NULL means that no trie is available and that
+ * look-ups must walk the routing table instead.  These are only modified
+ * with the network locked.
+ */
+
+#ifdef CONFIG_NET_IPv4
+static FAR struct route_trie_s *g_ipv4_trie;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static FAR struct route_trie_s *g_ipv6_trie;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: route_trie_alloc
+ *
+ * Description:
+ *   Allocate an empty trie with room for 'nroutes' routes.  Each insertion
+ *   adds at most two nodes.
+ *
+ ****************************************************************************/
+
+static FAR struct route_trie_s *route_trie_alloc(int nroutes, size_t rsize)
+{
+  FAR struct route_trie_s *trie;
+  size_t allocsize;
+  int nnodes = 2 * nroutes;
+
+  if (nnodes > INT16_MAX)
+    {
+      return NULL;
+    }
+
+  /* Routes come first since their alignment is at least that of the
+   * nodes, which is at least that of the route chain links.
+   */
+
+  allocsize = sizeof(struct route_trie_s) + nroutes * rsize +
+              nnodes * sizeof(struct route_trie_node_s) +
+              nroutes * sizeof(int16_t);
+
+  trie = (FAR struct route_trie_s *)kmm_malloc(allocsize);
+  if (trie != NULL)
+    {
+      trie->routes    = (FAR uint8_t *)(trie + 1);
+      trie->nodes     = (FAR struct route_trie_node_s *)
+                        (trie->routes + nroutes * rsize);
+      trie->rnext     = (FAR int16_t *)(trie->nodes + nnodes);
+      trie->rsize     = rsize;
+      trie->nroutes   = 0;
+      trie->maxroutes = nroutes;
+      trie->nnodes    = 0;
+      trie->maxnodes  = nnodes;
+      trie->root      = TRIE_NIL;
+    }
+
+  return trie;
+}
+
+/****************************************************************************
+ * Name: route_trie_prefixlen
+ *
+ * Description:
+ *   Convert a netmask in network order to a prefix length.  Returns a
+ *   negated errno value if the netmask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int route_trie_prefixlen(FAR const uint8_t *mask, int keylen)
+{
+  int plen = 0;
+  int i;
+
+  for (i = 0; i < keylen && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < keylen)
+    {
+      uint8_t bits = mask[i];
+
+      while ((bits & 0x80) != 0)
+        {
+          bits <<= 1;
+          plen++;
+        }
+
+      if (bits != 0)
+        {
+          return -EINVAL;
+        }
+
+      for (i++; i < keylen; i++)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: route_trie_common
+ *
+ * Description:
+ *   Compare two keys from bit 'start' up to (but not including) bit 'end'
+ *   and return the position of the first differing bit, or 'end' if all of
+ *   the bits are the same.
+ *
+ ****************************************************************************/
+
+static unsigned int route_trie_common(FAR const uint8_t *a,
+                                      FAR const uint8_t *b,
+                                      unsigned int start, unsigned int end)
+{
+  unsigned int i = start;
+
+  while (i < end)
+    {
+      /* Compare whole bytes when we can */
+
+      if ((i & 7) == 0 && end - i >= 8 && a[i >> 3] == b[i >> 3])
+        {
+          i += 8;
+        }
+      else if (TRIE_BIT(a, i) == TRIE_BIT(b, i))
+        {
+          i++;
+        }
+      else
+        {
+          break;
+        }
+    }
+
+  return i;
+}
+
+/****************************************************************************
+ * Name: route_trie_newnode
+ *
+ * Description:
+ *   Allocate and initialize a new trie node.
+ *
+ ****************************************************************************/
+
+static int route_trie_newnode(FAR struct route_trie_s *trie,
+                              FAR const uint8_t *key, unsigned int plen,
+                              int route)
+{
+  FAR struct route_trie_node_s *node;
+  unsigned int nbytes;
+  int ndx;
+
+  if (trie->nnodes >= trie->maxnodes)
+    {
+      return TRIE_NIL;
+    }
+
+  ndx  = trie->nnodes++;
+  node = &trie->nodes[ndx];
+
+  /* Keep only the significant bits of the key */
+
+  memset(node->prefix, 0, TRIE_MAXKEY);
+  nbytes = plen >> 3;
+  memcpy(node->prefix, key, nbytes);
+
+  if ((plen & 7) != 0)
+    {
+      node->prefix[nbytes] = key[nbytes] & (uint8_t)(0xff << (8 - (plen & 7)));
+    }
+
+  node->plen     = plen;
+  node->route    = route;
+  node->child[0] = TRIE_NIL;
+  node->child[1] = TRIE_NIL;
+  return ndx;
+}
+
+/****************************************************************************
+ * Name: route_trie_insert
+ *
+ * Description:
+ *   Insert the prefix 'key/plen' for route index 'route' into the trie.
+ *
+ ****************************************************************************/
+
+static int route_trie_insert(FAR struct route_trie_s *trie,
+                             FAR const uint8_t *key, unsigned int plen,
+                             int route)
+{
+  FAR struct route_trie_node_s *node;
+  FAR int16_t *link = &trie->root;
+  unsigned int depth = 0;
+  unsigned int common;
+  int newndx;
+  int leaf;
+  int ndx;
+
+  trie->rnext[route] = TRIE_NIL;
+
+  for (; ; )
+    {
+      ndx = *link;
+      if (ndx == TRIE_NIL)
+        {
+          /* Empty sub-trie.  The new prefix becomes a leaf. */
+
+          ndx = route_trie_newnode(trie, key, plen, route);
+          if (ndx == TRIE_NIL)
+            {
+              return -ENOMEM;
+            }
+
+          *link = ndx;
+          return OK;
+        }
+
+      node   = &trie->nodes[ndx];
+      common = route_trie_common(key, node->prefix, depth,
+                                 plen < node->plen ? plen : node->plen);
+
+      if (common == node->plen)
+        {
+          if (plen == node->plen)
+            {
+              /* Same prefix.  Append the route to the node's chain.  As
+               * with the table walk, the first route added for a prefix
+               * that is accepted by the look-up filter takes precedence.
+               */
+
+              if (node->route == TRIE_NIL)
+                {
+                  node->route = route;
+                }
+              else
+                {
+                  ndx = node->route;
+                  while (trie->rnext[ndx] != TRIE_NIL)
+                    {
+                      ndx = trie->rnext[ndx];
+                    }
+
+                  trie->rnext[ndx] = route;
+                }
+
+              return OK;
+            }
+
+          /* The node's prefix is a prefix of the key.  Descend. */
+
+          depth = node->plen;
+          link  = &node->child[TRIE_BIT(key, depth)];
+          continue;
+        }
+
+      /* The key and the node's prefix diverge at bit 'common' or the key
+       * is a prefix of the node's prefix.  Insert a new node holding the
+       * common prefix above the existing node.
+       */
+
+      newndx = route_trie_newnode(trie, key, common,
+                                  common == plen ? route : TRIE_NIL);
+      if (newndx == TRIE_NIL)
+        {
+          return -ENOMEM;
+        }
+
+      trie->nodes[newndx].child[TRIE_BIT(node->prefix, common)] = ndx;
+
+      if (common < plen)
+        {
+          leaf = route_trie_newnode(trie, key, plen, route);
+          if (leaf == TRIE_NIL)
+            {
+              return -ENOMEM;
+            }
+
+          trie->nodes[newndx].child[TRIE_BIT(key, common)] = leaf;
+        }
+
+      *link = newndx;
+      return OK;
+    }
+}
+
+/****************************************************************************
+ * Name: route_trie_lookup
+ *
+ * Description:
+ *   Return the index of the route with the longest prefix matching 'key'
+ *   and accepted by the optional filter, or TRIE_NIL if there is none.
+ *   The cost is proportional to the length of the key.
+ *
+ ****************************************************************************/
+
+static int route_trie_lookup(FAR struct route_trie_s *trie,
+                             FAR const uint8_t *key, unsigned int keybits,
+                             route_trie_filter_t filter, FAR void *arg)
+{
+  FAR struct route_trie_node_s *node;
+  unsigned int depth = 0;
+  int best = TRIE_NIL;
+  int ndx  = trie->root;
+  int route;
+
+  while (ndx != TRIE_NIL)
+    {
+      node = &trie->nodes[ndx];
+
+      /* Stop at the first node whose prefix does not match the key */
+
+      if (route_trie_common(key, node->prefix, depth, node->plen) <
+          node->plen)
+        {
+          break;
+        }
+
+      /* Remember the longest matching route seen so far.  Check each
+       * route with this prefix until one is accepted by the filter.
+       */
+
+      for (route = node->route; route != TRIE_NIL;
+           route = trie->rnext[route])
+        {
+          if (filter == NULL || filter(trie, route, arg))
+            {
+              best = route;
+              break;
+            }
+        }
+
+      depth = node->plen;
+      if (depth >= keybits)
+        {
+          break;
+        }
+
+      ndx = node->child[TRIE_BIT(key, depth)];
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: route_trie_count
+ *
+ * Description:
+ *   Routing table callback that counts the routes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static int route_trie_count_ipv4(FAR struct net_route_ipv4_s *route,
+                                 FAR void *arg)
+{
+  (*(FAR int *)arg)++;
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static int route_trie_count_ipv6(FAR struct net_route_ipv6_s *route,
+                                 FAR void *arg)
+{
+  (*(FAR int *)arg)++;
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: route_trie_add_ipv4 and route_trie_add_ipv6
+ *
+ * Description:
+ *   Routing table callback that copies one route into the new trie.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static int route_trie_add_ipv4(FAR struct net_route_ipv4_s *route,
+                               FAR void *arg)
+{
+  FAR struct route_trie_s *trie = (FAR struct route_trie_s *)arg;
+  FAR struct net_route_ipv4_s *copy;
+  int plen;
+  int ndx;
+
+  plen = route_trie_prefixlen((FAR const uint8_t *)&route->netmask,
+                              sizeof(in_addr_t));
+  if (plen < 0)
+    {
+      nwarn("WARNING: Non-contiguous netmask %08lx\n",
+            (unsigned long)route->netmask);
+      return plen;
+    }
+
+  if (trie->nroutes >= trie->maxroutes)
+    {
+      return -ENOMEM;
+    }
+
+  ndx  = trie->nroutes++;
+  copy = &((FAR struct net_route_ipv4_s *)trie->routes)[ndx];
+  memcpy(copy, route, sizeof(struct net_route_ipv4_s));
+
+  return route_trie_insert(trie, (FAR const uint8_t *)&copy->target, plen,
+                           ndx);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static int route_trie_add_ipv6(FAR struct net_route_ipv6_s *route,
+                               FAR void *arg)
+{
+  FAR struct route_trie_s *trie = (FAR struct route_trie_s *)arg;
+  FAR struct net_route_ipv6_s *copy;
+  int plen;
+  int ndx;
+
+  plen = route_trie_prefixlen((FAR const uint8_t *)route->netmask,
+                              sizeof(net_ipv6addr_t));
+  if (plen < 0)
+    {
+      nwarn("WARNING: Non-contiguous IPv6 netmask\n");
+      return plen;
+    }
+
+  if (trie->nroutes >= trie->maxroutes)
+    {
+      return -ENOMEM;
+    }
+
+  ndx  = trie->nroutes++;
+  copy = &((FAR struct net_route_ipv6_s *)trie->routes)[ndx];
+  memcpy(copy, route, sizeof(struct net_route_ipv6_s));
+
+  return route_trie_insert(trie, (FAR const uint8_t *)copy->target, plen,
+                           ndx);
+}
+#endif
+
+/****************************************************************************
+ * Name: route_trie_devmatch_ipv4 and route_trie_devmatch_ipv6
+ *
+ * Description:
+ *   Look-up filter that accepts only routes whose router lies on the
+ *   network of the device.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static bool route_trie_devmatch_ipv4(FAR struct route_trie_s *trie,
+                                     int index, FAR void *arg)
+{
+  FAR struct net_driver_s *dev = (FAR struct net_driver_s *)arg;
+  FAR struct net_route_ipv4_s *route =
+    &((FAR struct net_route_ipv4_s *)trie->routes)[index];
+
+  return net_ipv4addr_maskcmp(route->router, dev->d_ipaddr, dev->d_netmask);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static bool route_trie_devmatch_ipv6(FAR struct route_trie_s *trie,
+                                     int index, FAR void *arg)
+{
+  FAR struct net_driver_s *dev = (FAR struct net_driver_s *)arg;
+  FAR struct net_route_ipv6_s *route =
+    &((FAR struct net_route_ipv6_s *)trie->routes)[index];
+
+  return net_ipv6addr_maskcmp(route->router, dev->d_ipv6addr,
+                              dev->d_ipv6netmask);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_trieroute
+ *
+ * Description:
+ *   Build the initial longest-prefix-match tries from the routing tables.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_init_trieroute(void)
+{
+#ifdef CONFIG_NET_IPv4
+  (void)net_update_trieroute_ipv4();
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  (void)net_update_trieroute_ipv6();
+#endif
+}
+
+/****************************************************************************
+ * Name: net_update_trieroute_ipv4 and net_update_trieroute_ipv6
+ *
+ * Description:
+ *   Rebuild the longest-prefix-match trie from the current content of the
+ *   routing table.  The new trie is built aside and then replaces the old
+ *   one in a single step so that look-ups never see a partially updated
+ *   trie.  This must be called after each modification of the routing
+ *   table and must not be called with the routing table locked.
+ *
+ *   If the trie cannot be built (for example, because memory is exhausted
+ *   or because a route has a non-contiguous netmask), look-ups fall back to
+ *   walking the routing table.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   OK on success; Negated errno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_update_trieroute_ipv4(void)
+{
+  FAR struct route_trie_s *newtrie = NULL;
+  FAR struct route_trie_s *oldtrie;
+  int nroutes = 0;
+  int ret;
+
+  /* Size and build the new trie.  Look-ups continue to use the old trie
+   * in the meantime.
+   */
+
+  ret = net_foreachroute_ipv4(route_trie_count_ipv4, &nroutes);
+  if (ret >= 0)
+    {
+      newtrie = route_trie_alloc(nroutes, sizeof(struct net_route_ipv4_s));
+      if (newtrie == NULL)
+        {
+          ret = -ENOMEM;
+        }
+      else
+        {
+          ret = net_foreachroute_ipv4(route_trie_add_ipv4, newtrie);
+          if (ret < 0)
+            {
+              kmm_free(newtrie);
+              newtrie = NULL;
+            }
+        }
+    }
+
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to build IPv4 route trie: %d\n", ret);
+    }
+
+  /* Then replace the old trie.  Look-ups are performed with the network
+   * locked so no one can still be using the old trie after this.
+   */
+
+  net_lock();
+  oldtrie     = g_ipv4_trie;
+  g_ipv4_trie = newtrie;
+  net_unlock();
+
+  if (oldtrie != NULL)
+    {
+      kmm_free(oldtrie);
+    }
+
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_update_trieroute_ipv6(void)
+{
+  FAR struct route_trie_s *newtrie = NULL;
+  FAR struct route_trie_s *oldtrie;
+  int nroutes = 0;
+  int ret;
+
+  /* Size and build the new trie.  Look-ups continue to use the old trie
+   * in the meantime.
+   */
+
+  ret = net_foreachroute_ipv6(route_trie_count_ipv6, &nroutes);
+  if (ret >= 0)
+    {
+      newtrie = route_trie_alloc(nroutes, sizeof(struct net_route_ipv6_s));
+      if (newtrie == NULL)
+        {
+          ret = -ENOMEM;
+        }
+      else
+        {
+          ret = net_foreachroute_ipv6(route_trie_add_ipv6, newtrie);
+          if (ret < 0)
+            {
+              kmm_free(newtrie);
+              newtrie = NULL;
+            }
+        }
+    }
+
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to build IPv6 route trie: %d\n", ret);
+    }
+
+  /* Then replace the old trie.  Look-ups are performed with the network
+   * locked so no one can still be using the old trie after this.
+   */
+
+  net_lock();
+  oldtrie     = g_ipv6_trie;
+  g_ipv6_trie = newtrie;
+  net_unlock();
+
+  if (oldtrie != NULL)
+    {
+      kmm_free(oldtrie);
+    }
+
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_trieroute_ipv4 and net_trieroute_ipv6
+ *
+ * Description:
+ *   Find the router for the longest prefix in the routing table that
+ *   matches the target address.  If a device is provided, only routes
+ *   whose router lies on the device's local network are considered.
+ *
+ * Input Parameters:
+ *   dev    - Constrain the search to routers reachable through this
+ *            device.  May be NULL.
+ *   target - The address on a remote network to use in the look-up.
+ *   router - The location to return the router address.
+ *
+ * Returned Value:
+ *   OK if a route was found; -ENOENT if there is no matching route;
+ *   -ENOSYS if the trie is not available and the caller must fall back to
+ *   walking the routing table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_trieroute_ipv4(FAR struct net_driver_s *dev, in_addr_t target,
+                       FAR in_addr_t *router)
+{
+  FAR struct net_route_ipv4_s *route;
+  int ndx;
+  int ret;
+
+  net_lock();
+  if (g_ipv4_trie == NULL)
+    {
+      ret = -ENOSYS;
+    }
+  else
+    {
+      ndx = route_trie_lookup(g_ipv4_trie, (FAR const uint8_t *)&target,
+                              32,
+                              dev != NULL ? route_trie_devmatch_ipv4 : NULL,
+                              dev);
+      if (ndx == TRIE_NIL)
+        {
+          ret = -ENOENT;
+        }
+      else
+        {
+          route = &((FAR struct net_route_ipv4_s *)g_ipv4_trie->routes)[ndx];
+          net_ipv4addr_copy(*router, route->router);
+          ret = OK;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_trieroute_ipv6(FAR struct net_driver_s *dev,
+                       FAR const net_ipv6addr_t target,
+                       FAR net_ipv6addr_t router)
+{
+  FAR struct net_route_ipv6_s *route;
+  int ndx;
+  int ret;
+
+  net_lock();
+  if (g_ipv6_trie == NULL)
+    {
+      ret = -ENOSYS;
+    }
+  else
+    {
+      ndx = route_trie_lookup(g_ipv6_trie, (FAR const uint8_t *)target,
+                              128,
+                              dev != NULL ? route_trie_devmatch_ipv6 : NULL,
+                              dev);
+      if (ndx == TRIE_NIL)
+        {
+          ret = -ENOENT;
+        }
+      else
+        {
+          route = &((FAR struct net_route_ipv6_s *)g_ipv6_trie->routes)[ndx];
+          net_ipv6addr_copy(router, route->router);
+          ret = OK;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_NET && CONFIG_ROUTE_TRIE */
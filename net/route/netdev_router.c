@@ -48,6 +48,7 @@
 
 #include "netdev/netdev.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -233,6 +234,23 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
   struct route_ipv4_devmatch_s match;
   int ret;
 
+#ifdef CONFIG_ROUTE_TRIE
+  /* Use the longest-prefix-match trie if it is available */
+
+  ret = net_trieroute_ipv4(dev, target, router);
+  if (ret == -ENOENT)
+    {
+      /* No matching route.. use the default router of the device */
+
+      net_ipv4addr_copy(*router, dev->d_draddr);
+    }
+
+  if (ret != -ENOSYS)
+    {
+      return;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_devmatch_s));
@@ -312,6 +330,23 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
   struct route_ipv6_devmatch_s match;
   int ret;
 
+#ifdef CONFIG_ROUTE_TRIE
+  /* Use the longest-prefix-match trie if it is available */
+
+  ret = net_trieroute_ipv6(dev, target, router);
+  if (ret == -ENOENT)
+    {
+      /* No matching route.. use the default router of the device */
+
+      net_ipv6addr_copy(router, dev->d_ipv6draddr);
+    }
+
+  if (ret != -ENOSYS)
+    {
+      return;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_devmatch_s));
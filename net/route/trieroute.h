@@ -0,0 +1,140 @@
+/****************************************************************************
+ * net/route/trieroute.h
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_TRIEROUTE_H
+#define __NET_ROUTE_TRIEROUTE_H 1
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_TRIE
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+struct net_driver_s; /* Forward reference */
+
+/****************************************************************************
+ * Name: net_init_trieroute
+ *
+ * Description:
+ *   Build the initial longest-prefix-match tries from the routing tables.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void net_init_trieroute(void);
+
+/****************************************************************************
+ * Name: net_update_trieroute_ipv4 and net_update_trieroute_ipv6
+ *
+ * Description:
+ *   Rebuild the longest-prefix-match trie from the current content of the
+ *   routing table.  The new trie is built aside and then replaces the old
+ *   one in a single step so that look-ups never see a partially updated
+ *   trie.  This must be called after each modification of the routing
+ *   table and must not be called with the routing table locked.
+ *
+ *   If the trie cannot be built (for example, because memory is exhausted
+ *   or because a route has a non-contiguous netmask), look-ups fall back to
+ *   walking the routing table.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   OK on success; Negated errno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_update_trieroute_ipv4(void);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_update_trieroute_ipv6(void);
+#endif
+
+/****************************************************************************
+ * Name: net_trieroute_ipv4 and net_trieroute_ipv6
+ *
+ * Description:
+ *   Find the router for the longest prefix in the routing table that
+ *   matches the target address.  If a device is provided, only routes
+ *   whose router lies on the device's local network are considered.
+ *
+ * Input Parameters:
+ *   dev    - Constrain the search to routers reachable through this
+ *            device.  May be NULL.
+ *   target - The address on a remote network to use in the look-up.
+ *   router - The location to return the router address.
+ *
+ * Returned Value:
+ *   OK if a route was found; -ENOENT if there is no matching route;
+ *   -ENOSYS if the trie is not available and the caller must fall back to
+ *   walking the routing table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_trieroute_ipv4(FAR struct net_driver_s *dev, in_addr_t target,
+                       FAR in_addr_t *router);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_trieroute_ipv6(FAR struct net_driver_s *dev,
+                       FAR const net_ipv6addr_t target,
+                       FAR net_ipv6addr_t router);
+#endif
+
+#else /* CONFIG_ROUTE_TRIE */
+
+#  define net_init_trieroute()
+#  define net_update_trieroute_ipv4() (0)
+#  define net_update_trieroute_ipv6() (0)
+
+#endif /* CONFIG_ROUTE_TRIE */
+#endif /* __NET_ROUTE_TRIEROUTE_H */
@@ -152,6 +152,7 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
 #endif
       case SO_OOBINLINE:  /* Leaves received out-of-band data inline */
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
+      case SO_REUSEPORT:  /* Allow reuse of local address and port */
         {
           sockopt_t optionset;
 
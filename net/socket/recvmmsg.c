@@ -0,0 +1,232 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "usrsock/usrsock.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' datagrams from a socket with a
+ *   single call.  See include/nuttx/net/net.h for details.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message headers
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Receive flags
+ *   timeout - Optional limit on the time spent in the call
+ *
+ * Returned Value:
+ *   The number of messages received or, if none were received, a negated
+ *   errno value.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  FAR struct msghdr *msg;
+  FAR socklen_t *fromlen;
+  clock_t start = 0;
+  clock_t limit = 0;
+  unsigned int count;
+  ssize_t nrecvd;
+  bool locked;
+  int ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      limit = SEC2TICK(timeout->tv_sec) + NSEC2TICK(timeout->tv_nsec);
+      start = clock_systimer();
+    }
+
+  /* Lock the network once for the whole batch.  The lock is re-entrant so
+   * each receive operation will not have to re-acquire it; it is released
+   * only while a receive operation waits for new data.  Other socket
+   * families may wait with the lock held, so they are handled one message
+   * at a time like recvmsg().
+   */
+
+  locked = psock != NULL && _PS_BATCHLOCK(psock);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (count = 0; count < vlen; )
+    {
+      msg = &msgvec[count].msg_hdr;
+
+      /* Like recvmsg(), only a single I/O vector is supported */
+
+      if (msg->msg_iov == NULL || msg->msg_iovlen != 1)
+        {
+          ret = -ENOTSUP;
+          break;
+        }
+
+      fromlen = NULL;
+      if (msg->msg_name != NULL)
+        {
+          fromlen = (FAR socklen_t *)&msg->msg_namelen;
+        }
+
+      nrecvd = psock_recvfrom(psock, msg->msg_iov->iov_base,
+                              msg->msg_iov->iov_len,
+                              flags & ~MSG_WAITFORONE,
+                              (FAR struct sockaddr *)msg->msg_name,
+                              fromlen);
+      if (nrecvd < 0)
+        {
+          ret = (int)nrecvd;
+          break;
+        }
+
+      msgvec[count].msg_len = (unsigned int)nrecvd;
+      msg->msg_flags        = 0;
+      count++;
+
+      /* With MSG_WAITFORONE, only the first datagram may block */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      /* The timeout is only checked after a datagram has been received */
+
+      if (timeout != NULL && clock_systimer() - start >= limit)
+        {
+          break;
+        }
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Errors are reported only if nothing was received.  A subsequent call
+   * will report a persistent error.
+   */
+
+  return count > 0 ? (int)count : ret;
+}
+
+/****************************************************************************
+ * Name: recvmmsg
+ *
+ * Description:
+ *   The recvmmsg() call receives up to 'vlen' messages from a socket.  It
+ *   is equivalent to calling recvmsg() for each message, but, for inet and
+ *   packet sockets, takes the network lock only once for the whole batch.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - The array of message headers
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Receive flags (MSG_DONTWAIT, MSG_WAITFORONE, ...)
+ *   timeout - Optional limit on the time spent in the call
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On failure,
+ *   -1 is returned and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_recvmmsg do all of the work */
+
+  ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
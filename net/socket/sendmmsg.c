@@ -0,0 +1,186 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "usrsock/usrsock.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' datagrams on a socket with a
+ *   single call.  See include/nuttx/net/net.h for details.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The array of message headers
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   The number of messages sent or, if none were sent, a negated errno
+ *   value.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  FAR struct msghdr *msg;
+  unsigned int count;
+  ssize_t nsent;
+  bool locked;
+  int ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Lock the network once for the whole batch.  With write buffering, the
+   * datagrams are all queued before the device is given a chance to poll
+   * for them.  Other socket families may wait with the lock held, so they
+   * are handled one message at a time like sendmsg().
+   */
+
+  locked = psock != NULL && _PS_BATCHLOCK(psock);
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (count = 0; count < vlen; count++)
+    {
+      msg = &msgvec[count].msg_hdr;
+
+      /* Like sendmsg(), only a single I/O vector is supported */
+
+      if (msg->msg_iov == NULL || msg->msg_iovlen != 1)
+        {
+          ret = -ENOTSUP;
+          break;
+        }
+
+      nsent = psock_sendto(psock, msg->msg_iov->iov_base,
+                           msg->msg_iov->iov_len, flags,
+                           (FAR const struct sockaddr *)msg->msg_name,
+                           (socklen_t)msg->msg_namelen);
+      if (nsent < 0)
+        {
+          ret = (int)nsent;
+          break;
+        }
+
+      msgvec[count].msg_len = (unsigned int)nsent;
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Errors are reported only if nothing was sent */
+
+  return count > 0 ? (int)count : ret;
+}
+
+/****************************************************************************
+ * Name: sendmmsg
+ *
+ * Description:
+ *   The sendmmsg() call sends up to 'vlen' messages on a socket.  It is
+ *   equivalent to calling sendmsg() for each message, but, for inet and
+ *   packet sockets, takes the network lock only once for the whole batch.
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - The array of message headers
+ *   vlen    - The number of entries in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  On failure, -1 is
+ *   returned and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* sendmmsg() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* And let psock_sendmmsg do all of the work */
+
+  ret = psock_sendmmsg(psock, msgvec, vlen, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -111,10 +111,11 @@
 #define _SO_SNDLOWAT     _SO_BIT(SO_SNDLOWAT)
 #define _SO_SNDTIMEO     _SO_BIT(SO_SNDTIMEO)
 #define _SO_TYPE         _SO_BIT(SO_TYPE)
+#define _SO_REUSEPORT    _SO_BIT(SO_REUSEPORT)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (15)
+#define _SO_MAXOPT       (16)
 
 /* Macros to set, test, clear options */
 
@@ -131,6 +132,24 @@
 #define _SO_GETVALID(o)  (((unsigned int)(o)) <= _SO_MAXOPT)
 #define _SO_SETVALID(o)  ((((unsigned int)(o)) <= _SO_MAXOPT) && !_SO_GETONLY(o))
 
+/* _PS_BATCHLOCK() is true if a batch of send or receive operations on the
+ * socket may hold the network lock for the whole batch.  Only the inet and
+ * packet socket interfaces release the network lock whenever they wait.
+ * Local sockets and sockets provided by usrsock may block with the lock
+ * held.  The caller must include usrsock/usrsock.h if CONFIG_NET_USRSOCK
+ * is selected.
+ */
+
+#ifdef CONFIG_NET_USRSOCK
+#  define _PS_ISUSRSOCK(p) ((p)->s_sockif == &g_usrsock_sockif)
+#else
+#  define _PS_ISUSRSOCK(p) (false)
+#endif
+
+#define _PS_BATCHLOCK(p) \
+  (((p)->s_domain == PF_INET || (p)->s_domain == PF_INET6 || \
+    (p)->s_domain == PF_PACKET) && !_PS_ISUSRSOCK(p))
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
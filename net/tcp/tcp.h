@@ -67,6 +67,46 @@
 #  define HAVE_TCP_POLL
 #endif
 
+/* Sequence number comparisons that are safe across wrap-around */
+
+#define TCP_SEQ_LT(a,b)   ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_LTE(a,b)  ((int32_t)((a) - (b)) <= 0)
+#define TCP_SEQ_GT(a,b)   ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GTE(a,b)  ((int32_t)((a) - (b)) >= 0)
+
+/* Values of the tcpopts field:  TCP options negotiated during the 3-way
+ * handshake.
+ */
+
+#define TCP_OPTS_WSCALE   (1 << 0) /* Peer sent the window scale option */
+#define TCP_OPTS_SACK     (1 << 1) /* Peer sent the SACK permitted option */
+
+#ifdef CONFIG_NET_TCP_CC
+/* Number of duplicate ACKs that trigger a fast retransmit (RFC 5681) */
+
+#  define TCP_DUPACK_THRESH     3
+
+/* Values of the ccflags field */
+
+#  define TCP_CCFLAG_RTTPEND    (1 << 0) /* An RTT measurement is running */
+#  define TCP_CCFLAG_FASTREXMIT (1 << 1) /* Retransmit first unACKed segment */
+#  define TCP_CCFLAG_SACKREXMIT (1 << 2) /* Retransmit next SACK hole */
+
+/* Values of the wb_ccflags write buffer field */
+
+#  define TCP_WBFLAG_SACKED     (1 << 0) /* Selectively ACKed by the peer */
+#  define TCP_WBFLAG_REXMIT     (1 << 1) /* Fast retransmitted in this
+                                          * recovery episode */
+
+/* The congestion control algorithm used for new connections */
+
+#  ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+#    define TCP_CC_DEFAULT      (&g_tcp_cubic)
+#  else
+#    define TCP_CC_DEFAULT      (&g_tcp_newreno)
+#  endif
+#endif
+
 /* Allocate a new TCP data callback */
 
 /* These macros allocate and free callback structures used for receiving
@@ -120,6 +160,39 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_cc_ops_s;      /* Forward reference */
+
+#ifdef CONFIG_NET_TCP_CC
+/* Private state of each congestion control algorithm.  It is kept in the
+ * connection structure so that no allocation is needed when an algorithm
+ * is selected.
+ */
+
+struct tcp_newreno_s
+{
+  uint32_t acked;         /* Bytes ACKed in congestion avoidance */
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+struct tcp_cubic_s
+{
+  clock_t  epoch;         /* Start of the current epoch (0: none) */
+  uint32_t wmax;          /* Window before the last reduction (bytes) */
+  uint32_t origin;        /* Origin point of the cubic function (bytes) */
+  uint32_t k;             /* Time to reach origin (msec) */
+  uint32_t west;          /* TCP-friendly window estimate (bytes) */
+  uint32_t acked;         /* Remainder of the per-ACK increment */
+};
+#endif
+
+union tcp_ccpriv_u
+{
+  struct tcp_newreno_s newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  struct tcp_cubic_s   cubic;
+#endif
+};
+#endif
 
 struct tcp_conn_s
 {
@@ -145,7 +218,16 @@ struct tcp_conn_s
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current window size of the connection */
+  uint8_t  snd_wscale;    /* Shift applied to the peer's window */
+  uint8_t  rcv_wscale;    /* Shift applied to our advertised window */
+#else
   uint16_t winsize;       /* Current window size of the connection */
+#endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+  uint8_t  tcpopts;       /* TCP options negotiated (see TCP_OPTS_*) */
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t unacked;       /* Number bytes sent but not yet ACKed */
 #else
@@ -188,6 +270,33 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control (RFC 5681, RFC 6582) and RTT estimation (RFC 6298).
+   * Windows are in bytes, round trip times in microseconds.
+   *
+   *   cc_ops  - The selected congestion control algorithm.
+   *   cc_priv - State private to that algorithm.
+   */
+
+  FAR const struct tcp_cc_ops_s *cc_ops;
+  union tcp_ccpriv_u cc_priv;
+  uint32_t   cwnd;        /* Congestion window */
+  uint32_t   ssthresh;    /* Slow start threshold */
+  uint32_t   snd_una;     /* Oldest unacknowledged sequence number */
+  uint32_t   recover;     /* Highest sequence sent when recovery began */
+  uint32_t   srtt;        /* Smoothed RTT, scaled by 8 */
+  uint32_t   rttvar;      /* RTT variation, scaled by 4 */
+  uint32_t   rtt_seq;     /* ACK that ends the running RTT measurement */
+  clock_t    rtt_time;    /* Time when the timed segment was sent */
+  uint32_t   total_retrans; /* Total number of retransmitted segments */
+#ifdef CONFIG_NET_TCP_SACK
+  uint32_t   sack_high;   /* Highest sequence number SACKed by the peer */
+#endif
+  uint8_t    dupacks;     /* Count of consecutive duplicate ACKs */
+  uint8_t    castate;     /* TCP_CA_* state (see netinet/tcp.h) */
+  uint8_t    ccflags;     /* See TCP_CCFLAG_* definitions */
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -244,6 +353,13 @@ struct tcp_conn_s
 
   FAR struct devif_callback_s *list;
 
+#ifdef CONFIG_NET_TXPENDING
+  /* Supports the list of connections with pending Tx output */
+
+  dq_entry_t txnode;      /* Link in the pending Tx list */
+  bool txpending;         /* True: In the pending Tx list */
+#endif
+
   /* connevents is a list of callbacks for each socket the uses this
    * connection (there can be more that one in the event that the the socket
    * was dup'ed).  It is used with the network monitor to handle
@@ -274,10 +390,35 @@ struct tcp_wrbuffer_s
   uint16_t   wb_sent;      /* Number of bytes sent from the I/O buffer chain */
   uint8_t    wb_nrtx;      /* The number of retransmissions for the last
                             * segment sent */
+#ifdef CONFIG_NET_TCP_CC
+  uint8_t    wb_ccflags;   /* See TCP_WBFLAG_* definitions */
+#endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* A congestion control algorithm.  The common logic in tcp_cc.c handles
+ * slow start, duplicate ACKs and fast recovery; the algorithm supplies the
+ * window growth in congestion avoidance and the reduction on loss.
+ *
+ *   name       - Name used with the TCP_CONGESTION socket option.
+ *   init       - Reset the private state.  Called when the connection is
+ *                established or the algorithm is changed.
+ *   cong_avoid - Grow cwnd after nacked new bytes were ACKed while cwnd is
+ *                at or above ssthresh.
+ *   ssthresh   - Return the slow start threshold to use after a loss.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void     (*init)(FAR struct tcp_conn_s *conn);
+  CODE void     (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t nacked);
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
 /* Support for listen backlog:
  *
  *   struct tcp_blcontainer_s describes one backlogged connection
@@ -319,6 +460,15 @@ extern "C"
 
 EXTERN struct net_driver_s *g_netdevices;
 
+#ifdef CONFIG_NET_TCP_CC
+/* Available congestion control algorithms */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -391,6 +541,59 @@ FAR struct tcp_conn_s *tcp_active(FAR struct net_driver_s *dev,
 
 FAR struct tcp_conn_s *tcp_nextconn(FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_txpending
+ *
+ * Description:
+ *   Add a TCP connection to the list of connections that have pending
+ *   output.  devif_poll() visits only the connections in this list.  This
+ *   must be called before notifying the device of the availability of Tx
+ *   data.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+void tcp_txpending(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_txpending(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_txdone
+ *
+ * Description:
+ *   Remove a TCP connection from the list of connections with pending
+ *   output.  It is not an error if the connection is not in the list.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+void tcp_txdone(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_txdone(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_nextpending
+ *
+ * Description:
+ *   Traverse the list of TCP connections with pending output
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+FAR struct tcp_conn_s *tcp_nextpending(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_local_ipv4_device
  *
@@ -1367,14 +1570,169 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
  *   Calculate the TCP receive window for the specified device.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The connection whose window scale applies.
+ *
+ * Returned Value:
+ *   The value to place in the window field of the TCP header, i.e. the
+ *   receive window already scaled down by the connection's window scale.
+ *
+ ****************************************************************************/
+
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_get_wscale
+ *
+ * Description:
+ *   Select the window scale shift to offer in a SYN or SYN-ACK.  This is
+ *   the smallest shift that lets the largest possible receive window be
+ *   advertised.
+ *
+ * Input Parameters:
+ *   dev - The device that the connection uses.
+ *
+ * Returned Value:
+ *   The window scale shift (0..TCP_WS_MAXSHIFT).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_wscale(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize congestion control when the connection enters the
+ *   ESTABLISHED state.  conn->isn and conn->mss must already be valid.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm with the given name for the
+ *   connection.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   OK on success; -ENOENT if no such algorithm is configured.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_TCP_CC
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion state for an incoming ACK on an ESTABLISHED
+ *   connection with outstanding data.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackno  - The acknowledgement number of the segment
+ *   dupack - True if the segment is a duplicate ACK (RFC 5681)
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool dupack);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission time-out.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Account for a data segment handed to the device.  Starts an RTT
+ *   measurement if none is running; retransmissions abort the measurement
+ *   (Karn's algorithm).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seqno, uint32_t len,
+                 bool rexmit);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_sendwindow
+ *
+ * Description:
+ *   Return the number of new bytes that may be sent now:  the smaller of
+ *   the congestion window and the peer's receive window, less the bytes
+ *   already in flight.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_sendwindow(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_getinfo
+ *
+ * Description:
+ *   Fill in the TCP_INFO socket option for the connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+struct tcp_info;
+void tcp_cc_getinfo(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info);
+#endif
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Process the blocks of a received SACK option, marking the un-ACKed
+ *   write buffers that they cover.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   blocks - The SACK blocks (left and right edges in network order)
+ *   len    - Length of the blocks in bytes
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_input(FAR struct tcp_conn_s *conn, FAR const uint8_t *blocks,
+                    unsigned int len);
+#endif
 
 /****************************************************************************
  * Name: psock_tcp_cansend
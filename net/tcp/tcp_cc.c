@@ -0,0 +1,580 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netinet/tcp.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Upper bound on the congestion window so that it can never overflow */
+
+#define TCP_CC_MAXCWND  0x3fffffff
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All configured congestion control algorithms */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algorithms[] =
+{
+  &g_tcp_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cubic,
+#endif
+};
+
+#define TCP_CC_NALGORITHMS \
+  (sizeof(g_tcp_cc_algorithms) / sizeof(g_tcp_cc_algorithms[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_rttsample
+ *
+ * Description:
+ *   Update the smoothed RTT and RTT variation with a new measurement as
+ *   described in RFC 6298.
+ *
+ ****************************************************************************/
+
+static void tcp_cc_rttsample(FAR struct tcp_conn_s *conn, uint32_t rtt)
+{
+  int32_t delta;
+
+  if (conn->srtt == 0)
+    {
+      /* First measurement: SRTT = R, RTTVAR = R/2 */
+
+      conn->srtt   = rtt << 3;
+      conn->rttvar = rtt << 1;
+    }
+  else
+    {
+      /* SRTT += (R - SRTT) / 8, RTTVAR += (|R - SRTT| - RTTVAR) / 4 */
+
+      delta         = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+      conn->srtt   += delta;
+      if (delta < 0)
+        {
+          delta = -delta;
+        }
+
+      delta        -= (int32_t)(conn->rttvar >> 2);
+      conn->rttvar += delta;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_setcwnd
+ ****************************************************************************/
+
+static inline void tcp_cc_setcwnd(FAR struct tcp_conn_s *conn, uint32_t cwnd)
+{
+  conn->cwnd = cwnd > TCP_CC_MAXCWND ? TCP_CC_MAXCWND : cwnd;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize congestion control when the connection enters the
+ *   ESTABLISHED state.  conn->isn and conn->mss must already be valid.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  uint32_t mss = conn->mss;
+
+  if (conn->cc_ops == NULL)
+    {
+      conn->cc_ops = TCP_CC_DEFAULT;
+    }
+
+  /* Initial window per RFC 5681, section 3.1 */
+
+  if (mss > 2190)
+    {
+      conn->cwnd = 2 * mss;
+    }
+  else if (mss > 1095)
+    {
+      conn->cwnd = 3 * mss;
+    }
+  else
+    {
+      conn->cwnd = 4 * mss;
+    }
+
+  conn->ssthresh = TCP_CC_MAXCWND;
+  conn->snd_una  = conn->isn;
+  conn->recover  = conn->isn - 1;
+  conn->srtt     = 0;
+  conn->rttvar   = 0;
+  conn->dupacks  = 0;
+  conn->castate  = TCP_CA_OPEN;
+  conn->ccflags  = 0;
+#ifdef CONFIG_NET_TCP_SACK
+  conn->sack_high = conn->isn;
+#endif
+
+  conn->cc_ops->init(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm with the given name for the
+ *   connection.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if no such algorithm is configured.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  int i;
+
+  for (i = 0; i < TCP_CC_NALGORITHMS; i++)
+    {
+      ops = g_tcp_cc_algorithms[i];
+      if (strncmp(ops->name, name, TCP_CA_NAME_MAX) == 0)
+        {
+          conn->cc_ops = ops;
+
+          /* If the connection is already running, start the new
+           * algorithm from the current window.
+           */
+
+          if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+            {
+              ops->init(conn);
+            }
+
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion state for an incoming ACK on an ESTABLISHED
+ *   connection with outstanding data.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   ackno  - The acknowledgement number of the segment
+ *   dupack - True if the segment is a duplicate ACK (RFC 5681)
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool dupack)
+{
+  uint32_t mss = conn->mss;
+  uint32_t nacked;
+
+  if (TCP_SEQ_GT(ackno, conn->snd_una))
+    {
+      /* New data has been ACKed */
+
+      nacked        = ackno - conn->snd_una;
+      conn->snd_una = ackno;
+      conn->dupacks = 0;
+
+      /* Complete any running RTT measurement */
+
+      if ((conn->ccflags & TCP_CCFLAG_RTTPEND) != 0 &&
+          TCP_SEQ_GTE(ackno, conn->rtt_seq))
+        {
+          conn->ccflags &= ~TCP_CCFLAG_RTTPEND;
+          tcp_cc_rttsample(conn, TICK2USEC(clock_systimer() - conn->rtt_time));
+        }
+
+      if (conn->castate == TCP_CA_RECOVERY)
+        {
+          if (TCP_SEQ_GTE(ackno, conn->recover))
+            {
+              /* Full ACK:  Deflate the window and leave fast recovery
+               * (RFC 6582, section 3.2, step 3).
+               */
+
+              uint32_t flight = conn->unacked + mss;
+
+              tcp_cc_setcwnd(conn, flight < conn->ssthresh ?
+                                   flight : conn->ssthresh);
+              conn->castate = TCP_CA_OPEN;
+              ninfo("Exit recovery: cwnd=%u\n", conn->cwnd);
+            }
+          else
+            {
+              /* Partial ACK:  Retransmit the first unACKed segment and
+               * deflate the window by the amount ACKed, adding back one
+               * MSS (RFC 6582, section 3.2, step 4).
+               */
+
+              conn->cwnd     = conn->cwnd > nacked ? conn->cwnd - nacked : 0;
+              if (nacked >= mss)
+                {
+                  conn->cwnd += mss;
+                }
+
+              if (conn->cwnd < mss)
+                {
+                  conn->cwnd = mss;
+                }
+
+              conn->ccflags |= TCP_CCFLAG_FASTREXMIT;
+            }
+
+          return;
+        }
+
+      if (conn->castate == TCP_CA_LOSS && TCP_SEQ_GTE(ackno, conn->recover))
+        {
+          /* Everything outstanding at the time-out has been recovered */
+
+          conn->castate = TCP_CA_OPEN;
+        }
+      else if (conn->castate == TCP_CA_DISORDER)
+        {
+          conn->castate = TCP_CA_OPEN;
+        }
+
+      if (conn->cwnd < conn->ssthresh)
+        {
+          /* Slow start with appropriate byte counting, L = 1 (RFC 3465) */
+
+          tcp_cc_setcwnd(conn, conn->cwnd + (nacked < mss ? nacked : mss));
+        }
+      else
+        {
+          conn->cc_ops->cong_avoid(conn, nacked);
+          tcp_cc_setcwnd(conn, conn->cwnd);
+        }
+    }
+  else if (dupack)
+    {
+      if (conn->castate == TCP_CA_RECOVERY)
+        {
+          /* Each further duplicate ACK means that a segment has left the
+           * network:  inflate the window.  With SACK, the ACK may also
+           * report a new hole to fill.
+           */
+
+          tcp_cc_setcwnd(conn, conn->cwnd + mss);
+#ifdef CONFIG_NET_TCP_SACK
+          if ((conn->tcpopts & TCP_OPTS_SACK) != 0)
+            {
+              conn->ccflags |= TCP_CCFLAG_SACKREXMIT;
+            }
+#endif
+        }
+      else if (++conn->dupacks < TCP_DUPACK_THRESH)
+        {
+          conn->castate = TCP_CA_DISORDER;
+        }
+      else if (conn->dupacks == TCP_DUPACK_THRESH &&
+               TCP_SEQ_GT(ackno, conn->recover))
+        {
+          /* Fast retransmit and enter fast recovery (RFC 6582, section
+           * 3.2, step 2).
+           */
+
+          conn->ssthresh = conn->cc_ops->ssthresh(conn);
+          conn->recover  = conn->sndseq_max;
+          conn->castate  = TCP_CA_RECOVERY;
+          tcp_cc_setcwnd(conn, conn->ssthresh + TCP_DUPACK_THRESH * mss);
+
+          conn->ccflags |= TCP_CCFLAG_FASTREXMIT;
+          conn->ccflags &= ~TCP_CCFLAG_RTTPEND;
+
+          ninfo("Fast retransmit: ssthresh=%u cwnd=%u recover=%u\n",
+                conn->ssthresh, conn->cwnd, conn->recover);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission time-out.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  /* Only the first time-out of a loss episode reduces ssthresh
+   * (RFC 5681, section 3.1).
+   */
+
+  if (conn->castate != TCP_CA_LOSS)
+    {
+      conn->ssthresh = conn->cc_ops->ssthresh(conn);
+    }
+
+  conn->cwnd     = conn->mss;
+  conn->recover  = conn->sndseq_max;
+  conn->castate  = TCP_CA_LOSS;
+  conn->dupacks  = 0;
+  conn->ccflags &= ~(TCP_CCFLAG_RTTPEND | TCP_CCFLAG_FASTREXMIT |
+                     TCP_CCFLAG_SACKREXMIT);
+
+  ninfo("RTO: ssthresh=%u cwnd=%u\n", conn->ssthresh, conn->cwnd);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Account for a data segment handed to the device.  Starts an RTT
+ *   measurement if none is running; retransmissions abort the measurement
+ *   (Karn's algorithm).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seqno, uint32_t len,
+                 bool rexmit)
+{
+  if (rexmit)
+    {
+      conn->ccflags &= ~TCP_CCFLAG_RTTPEND;
+      conn->total_retrans++;
+    }
+  else if ((conn->ccflags & TCP_CCFLAG_RTTPEND) == 0)
+    {
+      conn->rtt_seq  = seqno + len;
+      conn->rtt_time = clock_systimer();
+      conn->ccflags |= TCP_CCFLAG_RTTPEND;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sendwindow
+ *
+ * Description:
+ *   Return the number of new bytes that may be sent now:  the smaller of
+ *   the congestion window and the peer's receive window, less the bytes
+ *   already in flight.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_sendwindow(FAR struct tcp_conn_s *conn)
+{
+  uint32_t wnd = conn->cwnd;
+
+  if (wnd > conn->winsize)
+    {
+      wnd = conn->winsize;
+    }
+
+  return wnd > conn->unacked ? wnd - conn->unacked : 0;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_getinfo
+ *
+ * Description:
+ *   Fill in the TCP_INFO socket option for the connection.
+ *
+ ****************************************************************************/
+
+void tcp_cc_getinfo(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info)
+{
+  FAR sq_entry_t *entry;
+  uint32_t mss = conn->mss > 0 ? conn->mss : 1;
+
+  memset(info, 0, sizeof(struct tcp_info));
+
+  info->tcpi_state       = conn->tcpstateflags & TCP_STATE_MASK;
+  info->tcpi_ca_state    = conn->castate;
+  info->tcpi_retransmits = conn->nrtx;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if ((conn->tcpopts & TCP_OPTS_WSCALE) != 0)
+    {
+      info->tcpi_options   |= TCPI_OPT_WSCALE;
+      info->tcpi_snd_wscale = conn->snd_wscale;
+      info->tcpi_rcv_wscale = conn->rcv_wscale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  if ((conn->tcpopts & TCP_OPTS_SACK) != 0)
+    {
+      info->tcpi_options |= TCPI_OPT_SACK;
+    }
+#endif
+
+  /* The retransmission timer runs in half-second units */
+
+  info->tcpi_rto         = (uint32_t)conn->rto * (USEC_PER_SEC / 2);
+  info->tcpi_snd_mss     = conn->mss;
+  info->tcpi_rcv_mss     = conn->mss;
+  info->tcpi_advmss      = conn->mss;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      FAR struct tcp_wrbuffer_s *wrb = (FAR struct tcp_wrbuffer_s *)entry;
+
+      info->tcpi_unacked++;
+      if ((wrb->wb_ccflags & TCP_WBFLAG_SACKED) != 0)
+        {
+          info->tcpi_sacked++;
+        }
+
+      if ((wrb->wb_ccflags & TCP_WBFLAG_REXMIT) != 0)
+        {
+          info->tcpi_retrans++;
+        }
+    }
+
+  info->tcpi_rtt           = conn->srtt >> 3;
+  info->tcpi_rttvar        = conn->rttvar >> 2;
+  info->tcpi_snd_ssthresh  = conn->ssthresh / mss;
+  info->tcpi_snd_cwnd      = conn->cwnd / mss;
+  info->tcpi_total_retrans = conn->total_retrans;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_input
+ *
+ * Description:
+ *   Process the blocks of a received SACK option, marking the un-ACKed
+ *   write buffers that they cover.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   blocks - The SACK blocks (left and right edges in network order)
+ *   len    - Length of the blocks in bytes
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+void tcp_sack_input(FAR struct tcp_conn_s *conn, FAR const uint8_t *blocks,
+                    unsigned int len)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  uint32_t left;
+  uint32_t right;
+
+  for (; len >= 8; blocks += 8, len -= 8)
+    {
+      left  = ((uint32_t)blocks[0] << 24) | ((uint32_t)blocks[1] << 16) |
+              ((uint32_t)blocks[2] << 8)  |  (uint32_t)blocks[3];
+      right = ((uint32_t)blocks[4] << 24) | ((uint32_t)blocks[5] << 16) |
+              ((uint32_t)blocks[6] << 8)  |  (uint32_t)blocks[7];
+
+      /* Ignore blocks that are below the cumulative ACK (D-SACK) or
+       * beyond anything that we have sent.
+       */
+
+      if (TCP_SEQ_LTE(right, conn->snd_una) ||
+          TCP_SEQ_GT(right, conn->sndseq_max))
+        {
+          continue;
+        }
+
+      if (TCP_SEQ_GT(right, conn->sack_high))
+        {
+          conn->sack_high = right;
+        }
+
+      /* Mark every write buffer that lies entirely within the block */
+
+      for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+        {
+          wrb = (FAR struct tcp_wrbuffer_s *)entry;
+
+          if (TCP_SEQ_GTE(TCP_WBSEQNO(wrb), left) &&
+              TCP_SEQ_LTE(TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb), right))
+            {
+              wrb->wb_ccflags |= TCP_WBFLAG_SACKED;
+            }
+        }
+    }
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+#endif /* CONFIG_NET_TCP_CC */
@@ -45,6 +45,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TCP)
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -88,6 +89,12 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TXPENDING
+/* A list of TCP connections with pending Tx output */
+
+static dq_queue_t g_pending_tcp_connections;
+#endif
+
 /* Last port used by a TCP connection connection. */
 
 static uint16_t g_last_tcp_port;
@@ -723,6 +730,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       conn->keepidle      = 2 * DSEC_PER_HOUR;
       conn->keepintvl     = 2 * DSEC_PER_SEC;
       conn->keepcnt       = 3;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+      conn->cc_ops        = TCP_CC_DEFAULT;
 #endif
     }
 
@@ -775,6 +785,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       dq_rem(&conn->node, &g_active_tcp_connections);
     }
 
+  /* Remove the connection from the pending Tx list */
+
+  tcp_txdone(conn);
+
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Release any read-ahead buffers attached to the connection */
 
@@ -879,6 +893,76 @@ FAR struct tcp_conn_s *tcp_nextconn(FAR struct tcp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: tcp_txpending
+ *
+ * Description:
+ *   Add a TCP connection to the list of connections that have pending
+ *   output.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+void tcp_txpending(FAR struct tcp_conn_s *conn)
+{
+  if (!conn->txpending)
+    {
+      dq_addlast(&conn->txnode, &g_pending_tcp_connections);
+      conn->txpending = true;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_txdone
+ *
+ * Description:
+ *   Remove a TCP connection from the list of connections with pending
+ *   output.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_txdone(FAR struct tcp_conn_s *conn)
+{
+  if (conn->txpending)
+    {
+      dq_rem(&conn->txnode, &g_pending_tcp_connections);
+      conn->txpending = false;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_nextpending
+ *
+ * Description:
+ *   Traverse the list of TCP connections with pending output
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct tcp_conn_s *tcp_nextpending(FAR struct tcp_conn_s *conn)
+{
+  FAR dq_entry_t *node;
+
+  node = (conn == NULL) ? g_pending_tcp_connections.head :
+                          conn->txnode.flink;
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  return (FAR struct tcp_conn_s *)
+    ((FAR uint8_t *)node - offsetof(struct tcp_conn_s, txnode));
+}
+#endif /* CONFIG_NET_TXPENDING */
+
 /****************************************************************************
  * Name: tcp_alloc_accept
  *
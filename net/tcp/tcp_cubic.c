@@ -0,0 +1,276 @@
+/****************************************************************************
+ * net/tcp/tcp_cubic.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CUBIC parameters (RFC 8312):  C = 0.4 and beta = 0.7.
+ *
+ * With the time t in milliseconds and windows in segments:
+ *
+ *   W(t) = C * (t - K)^3 + Wmax
+ *        = (t - K)^3 / CUBIC_CDIV + Wmax,  CUBIC_CDIV = 1e9 / 0.4
+ *
+ *   K    = cbrt(Wmax * (1 - beta) / C)
+ *        = cbrt((Wmax - cwnd) * CUBIC_CDIV)
+ */
+
+#define CUBIC_CDIV          2500000000ull
+#define CUBIC_BETA_NUM      7
+#define CUBIC_BETA_DEN      10
+
+/* Fast convergence releases bandwidth by using Wmax * (1 + beta) / 2 */
+
+#define CUBIC_FC_NUM        17
+#define CUBIC_FC_DEN        20
+
+/* Limit on |t - K| so that the cube cannot overflow 64 bits */
+
+#define CUBIC_MAXDELTA      1000000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t nacked);
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cubic =
+{
+  "cubic",                /* name */
+  tcp_cubic_init,         /* init */
+  tcp_cubic_cong_avoid,   /* cong_avoid */
+  tcp_cubic_ssthresh      /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b   = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc_priv.cubic;
+
+  cubic->epoch  = 0;
+  cubic->wmax   = 0;
+  cubic->origin = 0;
+  cubic->k      = 0;
+  cubic->west   = 0;
+  cubic->acked  = 0;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd toward the cubic target W(t + RTT), but never more slowly
+ *   than standard TCP would (RFC 8312, sections 4.1 to 4.4).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 uint32_t nacked)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc_priv.cubic;
+  uint32_t mss = conn->mss;
+  uint32_t target;
+  uint64_t incr;
+  int64_t delta;
+  int64_t offs;
+  clock_t now = clock_systimer();
+
+  if (cubic->epoch == 0)
+    {
+      /* Start of a new congestion avoidance epoch */
+
+      cubic->epoch = now != 0 ? now : 1;
+      cubic->acked = 0;
+      cubic->west  = conn->cwnd;
+
+      if (cubic->wmax > conn->cwnd)
+        {
+          cubic->k = tcp_cubic_cbrt((uint64_t)((cubic->wmax - conn->cwnd) /
+                                               mss) * CUBIC_CDIV);
+          cubic->origin = cubic->wmax;
+        }
+      else
+        {
+          cubic->k      = 0;
+          cubic->origin = conn->cwnd;
+        }
+    }
+
+  /* Elapsed time in the epoch plus one RTT, in milliseconds */
+
+  delta = (int64_t)TICK2MSEC(now - cubic->epoch) + (conn->srtt >> 3) / 1000 -
+          (int64_t)cubic->k;
+
+  if (delta > CUBIC_MAXDELTA)
+    {
+      delta = CUBIC_MAXDELTA;
+    }
+  else if (delta < -CUBIC_MAXDELTA)
+    {
+      delta = -CUBIC_MAXDELTA;
+    }
+
+  /* Offset from the origin in bytes.  The cube is computed in segments
+   * scaled by 1000 to keep precision for small |t - K|.
+   */
+
+  offs = delta * delta * delta / (int64_t)(CUBIC_CDIV / 1000);
+  offs = offs * (int64_t)mss / 1000;
+
+  if (offs < -(int64_t)cubic->origin)
+    {
+      target = 0;
+    }
+  else
+    {
+      offs  += cubic->origin;
+      target = offs > 0x3fffffff ? 0x3fffffff : (uint32_t)offs;
+    }
+
+  /* Increase by (target - cwnd) / cwnd per byte ACKed, carrying the
+   * remainder between ACKs.
+   */
+
+  if (target > conn->cwnd)
+    {
+      incr = (uint64_t)(target - conn->cwnd) * nacked + cubic->acked;
+      conn->cwnd  += (uint32_t)(incr / conn->cwnd);
+      cubic->acked = (uint32_t)(incr % conn->cwnd);
+    }
+
+  /* TCP-friendly region:  Track the window that standard TCP with the
+   * same beta would reach, 3 * (1 - beta) / (1 + beta) = 9 / 17 segments
+   * per RTT.
+   */
+
+  cubic->west += (uint32_t)((uint64_t)mss * nacked * 9 /
+                            (17 * (uint64_t)conn->cwnd));
+  if (cubic->west > conn->cwnd)
+    {
+      conn->cwnd = cubic->west;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window at the loss and reduce by beta (RFC 8312,
+ *   sections 4.5 and 4.6).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc_priv.cubic;
+  uint32_t min = 2 * (uint32_t)conn->mss;
+  uint32_t ssthresh;
+
+  if (conn->cwnd < cubic->wmax)
+    {
+      cubic->wmax = (uint32_t)((uint64_t)conn->cwnd * CUBIC_FC_NUM /
+                               CUBIC_FC_DEN);
+    }
+  else
+    {
+      cubic->wmax = conn->cwnd;
+    }
+
+  cubic->epoch = 0;
+
+  ssthresh = (uint32_t)((uint64_t)conn->cwnd * CUBIC_BETA_NUM /
+                        CUBIC_BETA_DEN);
+  return ssthresh > min ? ssthresh : min;
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -41,6 +41,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -97,9 +98,9 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC)
+  /* Keep alive and congestion control options are the only TCP protocol
+   * socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -120,10 +121,11 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
+  /* Handle the TCP protocol options */
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -152,12 +154,14 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret                = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
 
       case TCP_NODELAY:  /* Avoid coalescing of small segments. */
         nerr("ERROR: TCP_NODELAY not supported\n");
         ret = -ENOSYS;
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (*value_len < sizeof(struct timeval))
           {
@@ -238,6 +242,49 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret              = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_INFO:      /* Connection state and congestion information */
+        {
+          struct tcp_info info;
+
+          /* As on other systems, a short buffer receives the leading part
+           * of the structure so that older callers keep working.
+           */
+
+          net_lock();
+          tcp_cc_getinfo(conn, &info);
+          net_unlock();
+
+          if (*value_len > sizeof(struct tcp_info))
+            {
+              *value_len = sizeof(struct tcp_info);
+            }
+
+          memcpy(value, &info, *value_len);
+          ret = OK;
+        }
+        break;
+
+      case TCP_CONGESTION: /* Name of the congestion control algorithm */
+        {
+          FAR const char *name = conn->cc_ops->name;
+          socklen_t len = strlen(name) + 1;
+
+          if (*value_len < len)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              strcpy((FAR char *)value, name);
+              *value_len = len;
+              ret        = OK;
+            }
+        }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -248,7 +295,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
@@ -66,6 +66,118 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_parse_option
+ *
+ * Description:
+ *   Parse the options of an incoming TCP segment.  The MSS, window scale
+ *   and SACK permitted options are only honored in a SYN; SACK blocks are
+ *   only processed on an established connection that negotiated SACK.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received TCP packet.
+ *   conn  - The TCP connection of the segment
+ *   iplen - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_parse_option(FAR struct net_driver_s *dev,
+                             FAR struct tcp_conn_s *conn,
+                             unsigned int iplen)
+{
+  FAR struct tcp_hdr_s *tcp;
+  FAR uint8_t *opts;
+  unsigned int optlen;
+  uint16_t tmp16;
+  uint8_t opt;
+  int i;
+
+  tcp    = (FAR struct tcp_hdr_s *)&dev->d_buf[iplen + NET_LL_HDRLEN(dev)];
+  opts   = tcp->optdata;
+  optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+
+  for (i = 0; i < optlen; )
+    {
+      opt = opts[i];
+      if (opt == TCP_OPT_END)
+        {
+          /* End of options. */
+
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          /* NOP option. */
+
+          ++i;
+          continue;
+        }
+
+      /* All other options have a length field, so that we easily can skip
+       * past them.
+       */
+
+      if (i + 1 >= optlen || opts[i + 1] < 2 || i + opts[i + 1] > optlen)
+        {
+          /* If the length field is invalid, the options are malformed and
+           * we don't process them further.
+           */
+
+          break;
+        }
+
+      if ((tcp->flags & TCP_SYN) != 0)
+        {
+          if (opt == TCP_OPT_MSS && opts[i + 1] == TCP_OPT_MSS_LEN)
+            {
+              uint16_t tcp_mss = TCP_MSS(dev, iplen);
+
+              /* An MSS option with the right option length. */
+
+              tmp16 = ((uint16_t)opts[i + 2] << 8) | (uint16_t)opts[i + 3];
+              conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+            }
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+          else if (opt == TCP_OPT_WS && opts[i + 1] == TCP_OPT_WS_LEN)
+            {
+              /* Window scale option (RFC 7323, section 2.3) */
+
+              conn->snd_wscale = opts[i + 2] > TCP_WS_MAXSHIFT ?
+                                 TCP_WS_MAXSHIFT : opts[i + 2];
+              conn->tcpopts   |= TCP_OPTS_WSCALE;
+            }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+          else if (opt == TCP_OPT_SACK_PERM &&
+                   opts[i + 1] == TCP_OPT_SACK_PERM_LEN)
+            {
+              /* SACK permitted option (RFC 2018, section 2) */
+
+              conn->tcpopts |= TCP_OPTS_SACK;
+            }
+#endif
+        }
+#ifdef CONFIG_NET_TCP_SACK
+      else if (opt == TCP_OPT_SACK &&
+               (conn->tcpopts & TCP_OPTS_SACK) != 0 &&
+               (conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+        {
+          /* SACK blocks (RFC 2018, section 3) */
+
+          tcp_sack_input(conn, &opts[i + 2], opts[i + 1] - 2);
+        }
+#endif
+
+      i += opts[i + 1];
+    }
+}
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -91,13 +203,13 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   FAR struct tcp_hdr_s *tcp;
   FAR struct tcp_conn_s *conn = NULL;
   unsigned int tcpiplen;
-  unsigned int hdrlen;
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
-  uint8_t  opt;
   int      len;
-  int      i;
+#ifdef CONFIG_NET_TCP_CC
+  uint32_t oldwnd;
+#endif
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -121,10 +233,6 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcpiplen = iplen + TCP_HDRLEN;
 
-  /* Get the size of the link layer header, the IP header, and the TCP header */
-
-  hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
-
   /* Start of TCP input header processing code. */
 
   if (tcp_chksum(dev) != 0xffff)
@@ -233,57 +341,11 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP options, if present. */
 
           if ((tcp->tcpoffset & 0xf0) > 0x50)
             {
-              for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                {
-                  opt = dev->d_buf[hdrlen + i];
-                  if (opt == TCP_OPT_END)
-                    {
-                      /* End of options. */
-
-                      break;
-                    }
-                  else if (opt == TCP_OPT_NOOP)
-                    {
-                      /* NOP option. */
-
-                      ++i;
-                    }
-                  else if (opt == TCP_OPT_MSS &&
-                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                    {
-                      uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                      /* An MSS option with the right option length. */
-
-                      tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
-                               (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                      /* And we are done processing options. */
-
-                      break;
-                    }
-                  else
-                    {
-                      /* All other options have a length field, so that we
-                       * easily can skip past them.
-                       */
-
-                      if (dev->d_buf[hdrlen + 1 + i] == 0)
-                        {
-                          /* If the length field is zero, the options are
-                           * malformed and we don't process them further.
-                           */
-
-                          break;
-                        }
-                      i += dev->d_buf[hdrlen + 1 + i];
-                    }
-                }
+              tcp_parse_option(dev, conn, iplen);
             }
 
           /* Our response will be a SYNACK. */
@@ -318,8 +380,20 @@ found:
 
   /* Update the connection's window size */
 
+#ifdef CONFIG_NET_TCP_CC
+  oldwnd        = conn->winsize;
+#endif
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window field of a SYN is never scaled (RFC 7323, section 2.2) */
+
+  if ((tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_wscale;
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -391,6 +465,30 @@ found:
 
   dev->d_len -= (len + iplen);
 
+  /* The application data follows the TCP options, if any.  Process the
+   * options of a non-SYN segment or of the SYNACK that completes an active
+   * open, then move the data to d_appdata where the application expects
+   * it.  The move overwrites the options, so they must be parsed first.
+   * The options of a SYN to a listening socket were handled when the
+   * connection was created.
+   */
+
+  if (len > TCP_HDRLEN)
+    {
+      if ((tcp->flags & TCP_SYN) == 0 ||
+          ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_SYN_SENT &&
+           (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK)))
+        {
+          tcp_parse_option(dev, conn, iplen);
+        }
+
+      if (dev->d_len > 0)
+        {
+          memmove(dev->d_appdata, (FAR uint8_t *)dev->d_appdata +
+                  (len - TCP_HDRLEN), dev->d_len);
+        }
+    }
+
 #ifdef CONFIG_NET_TCP_KEEPALIVE
   /* Check for a to KeepAlive probes.  These packets have these properties:
    *
@@ -527,6 +625,21 @@ found:
             conn->sndseq, ackseq, unackseq, conn->unacked);
       tcp_setsequence(conn->sndseq, ackseq);
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Let congestion control see the ACK.  A duplicate ACK carries no
+       * data, no SYN or FIN, does not move the ACK point and does not
+       * change the window (RFC 5681, section 2).
+       */
+
+      if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+        {
+          tcp_cc_ack(conn, ackseq,
+                     ackseq == conn->snd_una && dev->d_len == 0 &&
+                     (tcp->flags & (TCP_SYN | TCP_FIN)) == 0 &&
+                     conn->winsize == oldwnd);
+        }
+#endif
+
       /* Do RTT estimation, unless we have done retransmissions. */
 
       if (conn->nrtx == 0)
@@ -613,6 +726,9 @@ found:
             conn->sndseq_max    = 0;
 #endif
             conn->unacked       = 0;
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
+#endif
             flags               = TCP_CONNECTED;
             ninfo("TCP state: TCP_ESTABLISHED\n");
 
@@ -648,59 +764,17 @@ found:
         if ((flags & TCP_ACKDATA) != 0 &&
             (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+            /* The options of the SYNACK were parsed above.  Window scaling
+             * is only in effect if both sides sent the option (RFC 7323,
+             * section 2.2).
+             */
 
-            if ((tcp->tcpoffset & 0xf0) > 0x50)
+            if ((conn->tcpopts & TCP_OPTS_WSCALE) == 0)
               {
-                for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                  {
-                    opt = dev->d_buf[hdrlen + i];
-                    if (opt == TCP_OPT_END)
-                      {
-                        /* End of options. */
-
-                        break;
-                      }
-                    else if (opt == TCP_OPT_NOOP)
-                      {
-                        /* NOP option. */
-
-                        ++i;
-                      }
-                    else if (opt == TCP_OPT_MSS &&
-                              dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                      {
-                        uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                        /* An MSS option with the right option length. */
-
-                        tmp16 =
-                          (dev->d_buf[hdrlen + 2 + i] << 8) |
-                          dev->d_buf[hdrlen + 3 + i];
-                        conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                        /* And we are done processing options. */
-
-                        break;
-                      }
-                    else
-                      {
-                        /* All other options have a length field, so that we
-                         * easily can skip past them.
-                         */
-
-                        if (dev->d_buf[hdrlen + 1 + i] == 0)
-                          {
-                            /* If the length field is zero, the options are
-                             * malformed and we don't process them further.
-                             */
-
-                            break;
-                          }
-                        i += dev->d_buf[hdrlen + 1 + i];
-                      }
-                  }
+                conn->rcv_wscale = 0;
               }
+#endif
 
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
@@ -711,6 +785,9 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -0,0 +1,123 @@
+/****************************************************************************
+ * net/tcp/tcp_newreno.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/net/netconfig.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_newreno_init(FAR struct tcp_conn_s *conn);
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t nacked);
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_newreno =
+{
+  "reno",                 /* name */
+  tcp_newreno_init,       /* init */
+  tcp_newreno_cong_avoid, /* cong_avoid */
+  tcp_newreno_ssthresh    /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_newreno_init
+ ****************************************************************************/
+
+static void tcp_newreno_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cc_priv.newreno.acked = 0;
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd by one MSS per window of data ACKed, counting bytes rather
+ *   than ACKs (RFC 5681, section 3.1, and RFC 3465).
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t nacked)
+{
+  FAR struct tcp_newreno_s *reno = &conn->cc_priv.newreno;
+
+  reno->acked += nacked;
+  if (reno->acked >= conn->cwnd)
+    {
+      reno->acked -= conn->cwnd;
+      conn->cwnd  += conn->mss;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max(FlightSize / 2, 2 * SMSS) (RFC 5681, equation 4).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t half = conn->unacked >> 1;
+  uint32_t min  = 2 * (uint32_t)conn->mss;
+
+  conn->cc_priv.newreno.acked = 0;
+  return half > min ? half : min;
+}
+
+#endif /* CONFIG_NET_TCP_CC */
@@ -63,18 +63,22 @@
  *   Calculate the TCP receive window for the specified device.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The connection whose window scale applies.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value to place in the window field of the TCP header, i.e. the
+ *   receive window already scaled down by the connection's window scale.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
 {
   uint16_t iplen;
   uint16_t mss;
-  uint16_t recvwndo;
+  uint32_t recvwndo;
+  uint8_t shift = 0;
 #ifdef CONFIG_NET_TCP_READAHEAD
   int  niob_avail;
   int  nqentry_avail;
@@ -106,6 +110,18 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
 
   mss = dev->d_pktsize - (NET_LL_HDRLEN(dev) + iplen + TCP_HDRLEN);
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window in a SYN or SYN-ACK is never scaled (RFC 7323, section
+   * 2.2).
+   */
+
+  if ((conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_RCVD &&
+      (conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_SENT)
+    {
+      shift = conn->rcv_wscale;
+    }
+#endif
+
 #ifdef CONFIG_NET_TCP_READAHEAD
   /* Update the TCP received window based on read-ahead I/O buffer
    * and IOB chain availability.  At least one queue entry is required.
@@ -158,14 +174,14 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        */
 
       rwnd = (niob_avail * CONFIG_IOB_BUFSIZE) + mss;
-      if (rwnd > UINT16_MAX)
+      if (rwnd > ((uint32_t)UINT16_MAX << shift))
         {
-          rwnd = UINT16_MAX;
+          rwnd = (uint32_t)UINT16_MAX << shift;
         }
 
       /* Save the new receive window size */
 
-      recvwndo = (uint16_t)rwnd;
+      recvwndo = rwnd;
     }
   else /* nqentry_avail == 0 || niob_avail == 0 */
 #endif
@@ -181,5 +197,44 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
       recvwndo = mss;
     }
 
-  return recvwndo;
+  return (uint16_t)(recvwndo >> shift);
 }
+
+/****************************************************************************
+ * Name: tcp_get_wscale
+ *
+ * Description:
+ *   Select the window scale shift to offer in a SYN or SYN-ACK.  This is
+ *   the smallest shift that lets the largest possible receive window be
+ *   advertised.
+ *
+ * Input Parameters:
+ *   dev - The device that the connection uses.
+ *
+ * Returned Value:
+ *   The window scale shift (0..TCP_WS_MAXSHIFT).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_wscale(FAR struct net_driver_s *dev)
+{
+  uint32_t maxwnd;
+  uint8_t shift;
+
+  /* The largest window that tcp_get_recvwindow() can return is all of the
+   * IOBs plus the device packet buffer.
+   */
+
+  maxwnd = (uint32_t)CONFIG_IOB_NBUFFERS * CONFIG_IOB_BUFSIZE +
+           dev->d_pktsize;
+
+  shift = 0;
+  while (shift < TCP_WS_MAXSHIFT && (maxwnd >> shift) > UINT16_MAX)
+    {
+      shift++;
+    }
+
+  return shift;
+}
+#endif
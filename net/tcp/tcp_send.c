@@ -359,7 +359,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -547,6 +547,11 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 {
   struct tcp_hdr_s *tcp;
   uint16_t tcp_mss;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+  FAR uint8_t *opts;
+  unsigned int optlen;
+  bool active;
+#endif
 
   /* Get values that vary with the underlying IP domain */
 
@@ -592,7 +597,43 @@ void tcp_ack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->optdata[1] = TCP_OPT_MSS_LEN;
   tcp->optdata[2] = tcp_mss >> 8;
   tcp->optdata[3] = tcp_mss & 0xff;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) || defined(CONFIG_NET_TCP_SACK)
+  /* Offer the window scale and SACK options in our SYN.  In a SYN-ACK,
+   * they may only be sent if the peer offered them first.
+   */
+
+  opts   = &tcp->optdata[TCP_OPT_MSS_LEN];
+  optlen = 0;
+  active = (conn->tcpstateflags & TCP_STATE_MASK) == TCP_SYN_SENT;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if (active || (conn->tcpopts & TCP_OPTS_WSCALE) != 0)
+    {
+      conn->rcv_wscale = tcp_get_wscale(dev);
+
+      opts[optlen++]   = TCP_OPT_NOOP;
+      opts[optlen++]   = TCP_OPT_WS;
+      opts[optlen++]   = TCP_OPT_WS_LEN;
+      opts[optlen++]   = conn->rcv_wscale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  if (active || (conn->tcpopts & TCP_OPTS_SACK) != 0)
+    {
+      opts[optlen++]   = TCP_OPT_NOOP;
+      opts[optlen++]   = TCP_OPT_NOOP;
+      opts[optlen++]   = TCP_OPT_SACK_PERM;
+      opts[optlen++]   = TCP_OPT_SACK_PERM_LEN;
+    }
+#endif
+
+  dev->d_len     += optlen;
+  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN + optlen) / 4) << 4;
+#else
   tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+#endif
 
   /* Complete the common portions of the TCP message */
 
@@ -93,6 +93,17 @@
 #define TCPIPv4BUF ((struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv4_HDRLEN])
 #define TCPIPv6BUF ((struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv6_HDRLEN])
 
+/* With congestion control, an incoming ACK that carries no data may clock
+ * out new segments immediately rather than waiting for the next poll.
+ */
+
+#ifdef CONFIG_NET_TCP_CC
+#  define TCP_CC_ACKCLOCK(f) \
+     (((f) & (TCP_ACKDATA | TCP_NEWDATA)) == TCP_ACKDATA)
+#else
+#  define TCP_CC_ACKCLOCK(f) (false)
+#endif
+
 /* Debug */
 
 #ifdef CONFIG_NET_TCP_WRBUFFER_DUMP
@@ -156,6 +167,95 @@ static void psock_insert_segment(FAR struct tcp_wrbuffer_s *wrb,
     }
 }
 
+/****************************************************************************
+ * Name: psock_send_fastrexmit
+ *
+ * Description:
+ *   Schedule the retransmission of one lost segment without waiting for
+ *   the retransmission timer.  Without SACK, this is the oldest un-ACKed
+ *   segment (RFC 6582).  With SACK, it is the oldest segment below the
+ *   highest SACKed sequence number that has been neither SACKed nor
+ *   retransmitted yet (RFC 6675).
+ *
+ * Input Parameters:
+ *   conn  The TCP connection
+ *   sack  True: Select the next SACK hole
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+static void psock_send_fastrexmit(FAR struct tcp_conn_s *conn, bool sack)
+{
+  FAR struct tcp_wrbuffer_s *wrb = NULL;
+  FAR sq_entry_t *entry;
+  uint16_t sent;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      FAR struct tcp_wrbuffer_s *tmp = (FAR struct tcp_wrbuffer_s *)entry;
+
+      if ((tmp->wb_ccflags & TCP_WBFLAG_SACKED) != 0)
+        {
+          continue;
+        }
+
+#ifdef CONFIG_NET_TCP_SACK
+      if (sack && ((tmp->wb_ccflags & TCP_WBFLAG_REXMIT) != 0 ||
+                   TCP_SEQ_GTE(TCP_WBSEQNO(tmp), conn->sack_high)))
+        {
+          continue;
+        }
+#endif
+
+      wrb = tmp;
+      break;
+    }
+
+  if (wrb != NULL)
+    {
+      /* Move the segment back to the write queue (in sequence number
+       * order) so that it is the next one sent.
+       */
+
+      sq_rem(entry, &conn->unacked_q);
+      psock_insert_segment(wrb, &conn->write_q);
+    }
+  else if (!sack)
+    {
+      /* Everything un-ACKed may still be at the head of the write_q */
+
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+      if (wrb == NULL || TCP_WBSENT(wrb) == 0)
+        {
+          return;
+        }
+    }
+  else
+    {
+      return;
+    }
+
+  /* Reset the number of bytes sent from the write buffer */
+
+  sent = TCP_WBSENT(wrb);
+  conn->unacked = conn->unacked > sent ? conn->unacked - sent : 0;
+  conn->sent    = conn->sent > sent ? conn->sent - sent : 0;
+
+  TCP_WBSENT(wrb) = 0;
+  TCP_WBNRTX(wrb)++;
+  wrb->wb_ccflags |= TCP_WBFLAG_REXMIT;
+
+  ninfo("FASTREXMIT: wrb=%p seqno=%u sack=%d\n",
+        wrb, TCP_WBSEQNO(wrb), sack);
+}
+#endif
+
 /****************************************************************************
  * Name: psock_lost_connection
  *
@@ -571,6 +671,23 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Has congestion control detected a lost segment? */
+
+      if ((conn->ccflags & TCP_CCFLAG_FASTREXMIT) != 0)
+        {
+          conn->ccflags &= ~(TCP_CCFLAG_FASTREXMIT | TCP_CCFLAG_SACKREXMIT);
+          psock_send_fastrexmit(conn, false);
+        }
+#ifdef CONFIG_NET_TCP_SACK
+      else if ((conn->ccflags & TCP_CCFLAG_SACKREXMIT) != 0)
+        {
+          conn->ccflags &= ~TCP_CCFLAG_SACKREXMIT;
+          psock_send_fastrexmit(conn, true);
+        }
+#endif
+#endif
     }
 
   /* Check for a loss of connection */
@@ -640,6 +757,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
 
           TCP_WBSENT(wrb) = 0;
+#ifdef CONFIG_NET_TCP_CC
+          wrb->wb_ccflags = 0;
+#endif
           ninfo("REXMIT: wrb=%p sent=%u, conn unacked=%d sent=%d\n",
                 wrb, TCP_WBSENT(wrb), conn->unacked, conn->sent);
 
@@ -706,6 +826,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
 
           TCP_WBSENT(wrb) = 0;
+#ifdef CONFIG_NET_TCP_CC
+          wrb->wb_ccflags = 0;
+#endif
           ninfo("REXMIT: wrb=%p sent=%u, conn unacked=%d sent=%d\n",
                 wrb, TCP_WBSENT(wrb), conn->unacked, conn->sent);
 
@@ -766,7 +889,8 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
    */
 
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
-      (flags & (TCP_POLL | TCP_REXMIT)) &&
+      ((flags & (TCP_POLL | TCP_REXMIT)) != 0 ||
+       TCP_CC_ACKCLOCK(flags)) &&
       !(sq_empty(&conn->write_q)) &&
       conn->winsize > 0)
     {
@@ -806,6 +930,28 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = conn->winsize;
             }
 
+#ifdef CONFIG_NET_TCP_CC
+          /* New data is also limited by the congestion window.  A fast
+           * retransmission is sent regardless (RFC 5681, section 3.2).
+           */
+
+          if ((wrb->wb_ccflags & TCP_WBFLAG_REXMIT) == 0 ||
+              TCP_WBSENT(wrb) > 0)
+            {
+              uint32_t cwnd = tcp_cc_sendwindow(conn);
+
+              if (sndlen > cwnd)
+                {
+                  sndlen = cwnd;
+                }
+
+              if (sndlen == 0)
+                {
+                  return flags;
+                }
+            }
+#endif
+
           ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u mss=%u "
                 "winsize=%u\n",
                 wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen, conn->mss,
@@ -846,6 +992,11 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
           devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
 
+#ifdef CONFIG_NET_TCP_CC
+          tcp_cc_sent(conn, TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb), sndlen,
+                      TCP_WBNRTX(wrb) > 0);
+#endif
+
           /* Remember how much data we send out now so that we know
            * when everything has been acknowledged.  Just increment
            * the amount of data sent. This will be needed in sequence
@@ -929,6 +1080,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 static inline void send_txnotify(FAR struct socket *psock,
                                  FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TXPENDING
+  /* Make sure that devif_poll() will visit this connection */
+
+  tcp_txpending(conn);
+#endif
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   /* If both IPv4 and IPv6 support are enabled, then we will need to select
@@ -699,6 +699,12 @@ end_wait:
 static inline void send_txnotify(FAR struct socket *psock,
                                  FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TXPENDING
+  /* Make sure that devif_poll() will visit this connection */
+
+  tcp_txpending(conn);
+#endif
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   /* If both IPv4 and IPv6 support are enabled, then we will need to select
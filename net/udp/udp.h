@@ -92,8 +92,10 @@
 /* Definitions for the UDP connection struct flag field */
 
 #define _UDP_FLAG_CONNECTMODE (1 << 0) /* Bit 0:  UDP connection-mode */
+#define _UDP_FLAG_REUSEPORT   (1 << 1) /* Bit 1:  SO_REUSEPORT at bind time */
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
+#define _UDP_ISREUSEPORT(f)   (((f) & _UDP_FLAG_REUSEPORT) != 0)
 
 /****************************************************************************
  * Public Type Definitions
@@ -115,6 +117,10 @@ struct udp_conn_s
   uint8_t  ttl;           /* Default time-to-live */
   uint8_t  crefs;         /* Reference counts on this instance */
 
+#ifdef CONFIG_NET_UDP_HASH
+  FAR struct udp_conn_s *hnext; /* Next connection in the same hash bucket */
+#endif
+
 #ifdef CONFIG_NET_UDP_BINDTODEVICE
   uint8_t  boundto;       /* Index of the interface we are bound to.
                            * Unbound: 0, Bound: 1-MAX_IFINDEX */
@@ -144,6 +150,13 @@ struct udp_conn_s
   /* Defines the list of UDP callbacks */
 
   FAR struct devif_callback_s *list;
+
+#ifdef CONFIG_NET_TXPENDING
+  /* Supports the list of connections with pending Tx output */
+
+  dq_entry_t txnode;              /* Link in the pending Tx list */
+  bool txpending;                 /* True: In the pending Tx list */
+#endif
 };
 
 /* This structure supports UDP write buffering.  It is simply a container
@@ -244,6 +257,59 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
 
 FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_txpending
+ *
+ * Description:
+ *   Add a UDP connection to the list of connections that have pending
+ *   output.  devif_poll() visits only the connections in this list.  This
+ *   must be called before notifying the device of the availability of Tx
+ *   data.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+void udp_txpending(FAR struct udp_conn_s *conn);
+#else
+#  define udp_txpending(conn)
+#endif
+
+/****************************************************************************
+ * Name: udp_txdone
+ *
+ * Description:
+ *   Remove a UDP connection from the list of connections with pending
+ *   output.  It is not an error if the connection is not in the list.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+void udp_txdone(FAR struct udp_conn_s *conn);
+#else
+#  define udp_txdone(conn)
+#endif
+
+/****************************************************************************
+ * Name: udp_nextpending
+ *
+ * Description:
+ *   Traverse the list of UDP connections with pending output
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+FAR struct udp_conn_s *udp_nextpending(FAR struct udp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: udp_bind
  *
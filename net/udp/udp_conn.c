@@ -45,6 +45,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_UDP)
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -73,6 +74,21 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Traversal of the connections that may be bound to a local port */
+
+#ifdef CONFIG_NET_UDP_HASH
+#  define UDP_HASH(p)       ((unsigned int)ntohs(p) % CONFIG_NET_UDP_HASHSIZE)
+#  define UDP_FIRSTCONN(p)  g_udp_hashtab[UDP_HASH(p)]
+#  define UDP_NEXTCONN(c)   ((c)->hnext)
+#else
+#  define UDP_FIRSTCONN(p)  ((FAR struct udp_conn_s *)g_active_udp_connections.head)
+#  define UDP_NEXTCONN(c)   ((FAR struct udp_conn_s *)(c)->node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,6 +106,18 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_TXPENDING
+/* A list of UDP connections with pending Tx output */
+
+static dq_queue_t g_pending_udp_connections;
+#endif
+
+#ifdef CONFIG_NET_UDP_HASH
+/* Bound UDP connections hashed by local port number */
+
+static FAR struct udp_conn_s *g_udp_hashtab[CONFIG_NET_UDP_HASHSIZE];
+#endif
+
 /* Last port used by a UDP connection connection. */
 
 static uint16_t g_last_udp_port;
@@ -126,11 +154,91 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_hash_insert and udp_hash_remove
+ *
+ * Description:
+ *   Add a bound UDP connection to, or remove it from, the hash table of
+ *   connections indexed by local port number.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_HASH
+static void udp_hash_insert(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **head = &g_udp_hashtab[UDP_HASH(conn->lport)];
+
+  /* Add at the tail so that the bucket preserves bind order */
+
+  while (*head != NULL)
+    {
+      head = &(*head)->hnext;
+    }
+
+  conn->hnext = NULL;
+  *head       = conn;
+}
+
+static void udp_hash_remove(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **head = &g_udp_hashtab[UDP_HASH(conn->lport)];
+
+  while (*head != NULL)
+    {
+      if (*head == conn)
+        {
+          *head       = conn->hnext;
+          conn->hnext = NULL;
+          break;
+        }
+
+      head = &(*head)->hnext;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Assign the local port number of a UDP connection, keeping the hash
+ *   table consistent.
+ *
+ ****************************************************************************/
+
+static void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+  net_lock();
+
+#ifdef CONFIG_NET_UDP_HASH
+  if (conn->lport != 0)
+    {
+      udp_hash_remove(conn);
+    }
+#endif
+
+  conn->lport = portno;
+
+#ifdef CONFIG_NET_UDP_HASH
+  if (portno != 0)
+    {
+      udp_hash_insert(conn);
+    }
+#endif
+
+  net_unlock();
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
  * Description:
- *   Find the UDP connection that uses this local port number.
+ *   Find the UDP connection that uses this local port number.  If 'reuse'
+ *   is true, then connections that were bound with SO_REUSEPORT do not
+ *   count as users of the port.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -139,31 +247,33 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
-                                            uint16_t portno)
+                                            uint16_t portno, bool reuse)
 {
   FAR struct udp_conn_s *conn;
-  int i;
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure that may be bound to the port. */
 
-  for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
+  for (conn = UDP_FIRSTCONN(portno); conn != NULL;
+       conn = UDP_NEXTCONN(conn))
     {
-      conn = &g_udp_connections[i];
-
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
        * reference to the connection structure.  INADDR_ANY is a special
        * case:  There can only be instance of a port number with INADDR_ANY.
        */
 
+      if (conn->lport != portno || (reuse && _UDP_ISREUSEPORT(conn->flags)))
+        {
+          continue;
+        }
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
       if (domain == PF_INET)
 #endif
         {
-          if (conn->lport == portno &&
-              (net_ipv4addr_cmp(conn->u.ipv4.laddr, ipaddr->ipv4.laddr) ||
-               net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY)))
+          if (net_ipv4addr_cmp(conn->u.ipv4.laddr, ipaddr->ipv4.laddr) ||
+              net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY))
             {
               return conn;
             }
@@ -175,9 +285,8 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
       else
 #endif
         {
-          if (conn->lport == portno &&
-              (net_ipv6addr_cmp(conn->u.ipv6.laddr, ipaddr->ipv6.laddr) ||
-               net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr)))
+          if (net_ipv6addr_cmp(conn->u.ipv6.laddr, ipaddr->ipv6.laddr) ||
+              net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr))
             {
               return conn;
             }
@@ -188,6 +297,116 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   return NULL;
 }
 
+/****************************************************************************
+ * Name: udp_reuseport_peer
+ *
+ * Description:
+ *   Return true if 'conn' belongs to the same SO_REUSEPORT group as
+ *   'first':  It is unconnected, was bound with SO_REUSEPORT, and has the
+ *   same local address and port.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_REUSEPORT
+static bool udp_reuseport_peer(FAR struct udp_conn_s *first,
+                               FAR struct udp_conn_s *conn)
+{
+  if (conn->lport != first->lport || !_UDP_ISREUSEPORT(conn->flags) ||
+      _UDP_ISCONNECTMODE(conn->flags))
+    {
+      return false;
+    }
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  if (conn->domain != first->domain)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (first->domain == PF_INET)
+#endif
+    {
+      return net_ipv4addr_cmp(conn->u.ipv4.laddr, first->u.ipv4.laddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return net_ipv6addr_cmp(conn->u.ipv6.laddr, first->u.ipv6.laddr);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   'first' is the first matching connection that was bound with
+ *   SO_REUSEPORT.  Select one member of its group using the flow hash so
+ *   that all datagrams of one flow go to the same socket.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *
+  udp_reuseport_select(FAR struct udp_conn_s *first,
+                       FAR const uint16_t *srcaddr, int nwords,
+                       uint16_t srcport)
+{
+  FAR struct udp_conn_s *conn;
+  unsigned int nconns = 0;
+  uint32_t hash = srcport;
+  int i;
+
+  /* Count the members of the group.  Connections earlier in the list than
+   * 'first' did not match, so only those that follow need to be examined.
+   */
+
+  for (conn = first; conn != NULL; conn = UDP_NEXTCONN(conn))
+    {
+      if (udp_reuseport_peer(first, conn))
+        {
+          nconns++;
+        }
+    }
+
+  if (nconns <= 1)
+    {
+      return first;
+    }
+
+  /* Hash the source address and port (FNV-1a over 16-bit words) */
+
+  for (i = 0; i < nwords; i++)
+    {
+      hash = (hash ^ srcaddr[i]) * 16777619u;
+    }
+
+  hash ^= hash >> 16;
+
+  /* And pick the corresponding member */
+
+  i = (int)(hash % nconns);
+  for (conn = first; conn != NULL; conn = UDP_NEXTCONN(conn))
+    {
+      if (udp_reuseport_peer(first, conn) && i-- == 0)
+        {
+          break;
+        }
+    }
+
+  return conn;
+}
+#endif /* CONFIG_NET_UDP_REUSEPORT */
+
 /****************************************************************************
  * Name: udp_select_port
  *
@@ -232,7 +451,7 @@ static uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
           g_last_udp_port = 4096;
         }
     }
-  while (udp_find_conn(domain, u, htons(g_last_udp_port)) != NULL);
+  while (udp_find_conn(domain, u, htons(g_last_udp_port), false) != NULL);
 
   /* Initialize and return the connection structure, bind it to the
    * port number
@@ -266,7 +485,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = UDP_FIRSTCONN(udp->destport);
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -379,9 +598,19 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+      conn = UDP_NEXTCONN(conn);
     }
 
+#ifdef CONFIG_NET_UDP_REUSEPORT
+  /* Distribute the datagrams among the sockets sharing the port */
+
+  if (conn != NULL && _UDP_ISREUSEPORT(conn->flags) &&
+      !_UDP_ISCONNECTMODE(conn->flags))
+    {
+      conn = udp_reuseport_select(conn, ip->srcipaddr, 2, udp->srcport);
+    }
+#endif
+
   return conn;
 }
 #endif /* CONFIG_NET_IPv4 */
@@ -405,7 +634,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = UDP_FIRSTCONN(udp->destport);
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -518,8 +747,18 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+      conn = UDP_NEXTCONN(conn);
+    }
+
+#ifdef CONFIG_NET_UDP_REUSEPORT
+  /* Distribute the datagrams among the sockets sharing the port */
+
+  if (conn != NULL && _UDP_ISREUSEPORT(conn->flags) &&
+      !_UDP_ISCONNECTMODE(conn->flags))
+    {
+      conn = udp_reuseport_select(conn, ip->srcipaddr, 8, udp->srcport);
     }
+#endif
 
   return conn;
 }
@@ -595,6 +834,10 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
 
       sq_init(&conn->write_q);
 #endif
+#ifdef CONFIG_NET_TXPENDING
+      conn->txpending = false;
+#endif
+
       /* Enqueue the connection into the active list */
 
       dq_addlast(&conn->node, &g_active_udp_connections);
@@ -624,12 +867,22 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_setport(conn, 0);
 
   /* Remove the connection from the active list */
 
   dq_rem(&conn->node, &g_active_udp_connections);
 
+#ifdef CONFIG_NET_TXPENDING
+  /* Remove the connection from the pending Tx list.  That list is
+   * traversed by devif_poll() with the network locked.
+   */
+
+  net_lock();
+  udp_txdone(conn);
+  net_unlock();
+#endif
+
 #ifdef CONFIG_NET_UDP_READAHEAD
   /* Release any read-ahead buffers attached to the connection */
 
@@ -709,6 +962,76 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: udp_txpending
+ *
+ * Description:
+ *   Add a UDP connection to the list of connections that have pending
+ *   output.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXPENDING
+void udp_txpending(FAR struct udp_conn_s *conn)
+{
+  if (!conn->txpending)
+    {
+      dq_addlast(&conn->txnode, &g_pending_udp_connections);
+      conn->txpending = true;
+    }
+}
+
+/****************************************************************************
+ * Name: udp_txdone
+ *
+ * Description:
+ *   Remove a UDP connection from the list of connections with pending
+ *   output.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void udp_txdone(FAR struct udp_conn_s *conn)
+{
+  if (conn->txpending)
+    {
+      dq_rem(&conn->txnode, &g_pending_udp_connections);
+      conn->txpending = false;
+    }
+}
+
+/****************************************************************************
+ * Name: udp_nextpending
+ *
+ * Description:
+ *   Traverse the list of UDP connections with pending output
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct udp_conn_s *udp_nextpending(FAR struct udp_conn_s *conn)
+{
+  FAR dq_entry_t *node;
+
+  node = (conn == NULL) ? g_pending_udp_connections.head :
+                          conn->txnode.flink;
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  return (FAR struct udp_conn_s *)
+    ((FAR uint8_t *)node - offsetof(struct udp_conn_s, txnode));
+}
+#endif /* CONFIG_NET_TXPENDING */
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -775,8 +1098,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setport(conn, htons(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -784,14 +1107,18 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
 
       net_lock();
 
-      /* Is any other UDP connection already bound to this address and port? */
+      /* Is any other UDP connection already bound to this address and port?
+       * Connections bound with SO_REUSEPORT may share the port with other
+       * connections that also select SO_REUSEPORT.
+       */
 
-      if (udp_find_conn(conn->domain, &conn->u, portno) == NULL)
+      if (udp_find_conn(conn->domain, &conn->u, portno,
+                        _UDP_ISREUSEPORT(conn->flags)) == NULL)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
-          ret         = OK;
+          udp_setport(conn, portno);
+          ret = OK;
         }
       else
         {
@@ -843,7 +1170,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, htons(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
@@ -237,6 +237,12 @@ static inline void udp_poll_txnotify(FAR struct socket *psock)
 {
   FAR struct udp_conn_s *conn = psock->s_conn;
 
+#ifdef CONFIG_NET_TXPENDING
+  /* Make sure that devif_poll() will visit this connection */
+
+  udp_txpending(conn);
+#endif
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   /* If both IPv4 and IPv6 support are enabled, then we will need to select
@@ -441,6 +447,7 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
             {
               /* And request a poll from the device */
 
+              udp_txpending(conn);
               netdev_txnotify_dev(dev);
             }
         }
@@ -448,6 +448,7 @@ static int sendto_next_transfer(FAR struct socket *psock,
 
   /* Notify the device driver of the availability of TX data */
 
+  udp_txpending(conn);
   netdev_txnotify_dev(dev);
   return OK;
 }
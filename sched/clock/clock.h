@@ -94,6 +94,14 @@ void weak_function clock_initialize(void);
 void weak_function clock_timer(void);
 #endif
 
+#ifdef CONFIG_CLOCK_TIMEPAGE
+void clock_timepage_update(void);
+void clock_timepage_tick(void);
+#else
+#  define clock_timepage_update()
+#  define clock_timepage_tick()
+#endif
+
 int  clock_abstime2ticks(clockid_t clockid,
                          FAR const struct timespec *abstime,
                          FAR sclock_t *ticks);
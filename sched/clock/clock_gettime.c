@@ -74,6 +74,17 @@ int clock_gettime(clockid_t clock_id, struct timespec *tp)
   sinfo("clock_id=%d\n", clock_id);
   DEBUGASSERT(tp != NULL);
 
+#if defined(CONFIG_CLOCK_TIMEPAGE) && !defined(CONFIG_BUILD_PROTECTED)
+  /* Try the lock-free read of the shared time page first.  This fails
+   * only before the page is first written or for unsupported clocks.
+   */
+
+  if (clock_timepage_read(clock_id, tp) == OK)
+    {
+      return OK;
+    }
+#endif
+
 #ifdef CONFIG_CLOCK_MONOTONIC
   /* CLOCK_MONOTONIC is an optional under POSIX: "If the Monotonic Clock
    * option is supported, all implementations shall support a clock_id
@@ -190,6 +190,8 @@ static void clock_inittime(void)
       g_basetime.tv_nsec += NSEC_PER_SEC;
       g_basetime.tv_sec--;
     }
+
+  clock_timepage_update();
 #else
   clock_inittimekeeping();
 #endif
@@ -393,6 +395,7 @@ void clock_resynchronize(FAR struct timespec *rtc_diff)
 
       g_system_timer += SEC2TICK(rtc_diff->tv_sec);
       g_system_timer += NSEC2TICK(rtc_diff->tv_nsec);
+      clock_timepage_update();
     }
 
 skip:
@@ -416,5 +419,9 @@ void clock_timer(void)
   /* Increment the per-tick system counter */
 
   g_system_timer++;
+
+  /* And advance the shared time page with it */
+
+  clock_timepage_tick();
 }
 #endif
@@ -114,6 +114,10 @@ int clock_settime(clockid_t clock_id, FAR const struct timespec *tp)
       g_basetime.tv_nsec -= bias.tv_nsec;
       g_basetime.tv_sec  -= bias.tv_sec;
 
+      /* Publish the new base time in the shared time page */
+
+      clock_timepage_update();
+
       /* Setup the RTC (lo- or high-res) */
 
 #ifdef CONFIG_RTC
@@ -0,0 +1,196 @@
+/****************************************************************************
+ * sched/clock/clock_timepage.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/userspace.h>
+
+#include "clock/clock.h"
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Memory barriers are only needed (and only provided by nuttx/spinlock.h)
+ * when other CPUs may access the time page concurrently.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_timepage
+ *
+ * Description:
+ *   Return the time page that the kernel should write.  In the PROTECTED
+ *   build, this is the one published in the user-space header.
+ *
+ ****************************************************************************/
+
+static inline FAR volatile struct clock_timepage_s *clock_timepage(void)
+{
+#ifdef CONFIG_BUILD_PROTECTED
+  return USERSPACE->us_timepage;
+#else
+  return &g_timepage;
+#endif
+}
+
+/****************************************************************************
+ * Name: timepage_begin and timepage_end
+ *
+ * Description:
+ *   Open and close a write to the time page.  The sequence count is odd
+ *   for the duration of the write.
+ *
+ ****************************************************************************/
+
+static inline void timepage_begin(FAR volatile struct clock_timepage_s *page)
+{
+  page->seq++;
+  SP_DMB();
+}
+
+static inline void timepage_end(FAR volatile struct clock_timepage_s *page)
+{
+  SP_DMB();
+  page->seq++;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_timepage_update
+ *
+ * Description:
+ *   Re-write the whole time page from the current system time and base
+ *   time.  This must be called whenever either of them is changed other
+ *   than by the normal advance of the system timer.
+ *
+ ****************************************************************************/
+
+void clock_timepage_update(void)
+{
+  FAR volatile struct clock_timepage_s *page = clock_timepage();
+  struct timespec ts;
+  irqstate_t flags;
+
+  if (page == NULL)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave();
+
+  (void)clock_systimespec(&ts);
+
+  timepage_begin(page);
+
+  page->mono_sec  = ts.tv_sec;
+  page->mono_nsec = ts.tv_nsec;
+  page->base_sec  = g_basetime.tv_sec;
+  page->base_nsec = g_basetime.tv_nsec;
+
+  timepage_end(page);
+
+  spin_unlock_irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: clock_timepage_tick
+ *
+ * Description:
+ *   Advance the time page by one system timer tick.  This is called from
+ *   clock_timer() and avoids the divisions of clock_systimespec().
+ *
+ ****************************************************************************/
+
+void clock_timepage_tick(void)
+{
+  FAR volatile struct clock_timepage_s *page = clock_timepage();
+  irqstate_t flags;
+  long nsec;
+
+  if (page == NULL)
+    {
+      return;
+    }
+
+  /* The page is brought up to date by clock_timepage_update() first */
+
+  if (page->seq == 0)
+    {
+      clock_timepage_update();
+      return;
+    }
+
+  flags = spin_lock_irqsave();
+
+  timepage_begin(page);
+
+  nsec = page->mono_nsec + NSEC_PER_TICK;
+  while (nsec >= NSEC_PER_SEC)
+    {
+      page->mono_sec++;
+      nsec -= NSEC_PER_SEC;
+    }
+
+  page->mono_nsec = nsec;
+
+  timepage_end(page);
+
+  spin_unlock_irqrestore(flags);
+}
+
+#endif /* CONFIG_CLOCK_TIMEPAGE */
@@ -43,6 +43,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/irq.h>
 #include <nuttx/random.h>
+#include <nuttx/sched_latency.h>
 
 #include "irq/irq.h"
 #include "clock/clock.h"
@@ -165,6 +166,10 @@ void irq_dispatch(int irq, FAR void *context)
     }
 #endif
 
+  /* Record the interrupt entry time for the wakeup latency tracer */
+
+  sched_latency_irq();
+
 #ifdef CONFIG_CRYPTO_RANDOM_POOL_COLLECT_IRQ_RANDOMNESS
   /* Add interrupt timing randomness to entropy pool */
 
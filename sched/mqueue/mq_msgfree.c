@@ -57,9 +57,11 @@
  * Description:
  *   The nxmq_free_msg function will return a message to the free pool of
  *   messages if it was a pre-allocated message. If the message was
- *   allocated dynamically it will be deallocated.
+ *   allocated dynamically it will be deallocated.  Messages from the
+ *   message queue's own slab are returned to that slab.
  *
  * Input Parameters:
+ *   msgq  - The message queue that the message was allocated for
  *   mqmsg - message to free
  *
  * Returned Value:
@@ -67,10 +69,25 @@
  *
  ****************************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg)
 {
   irqstate_t flags;
 
+#ifdef CONFIG_MQ_MSGSLAB
+  /* If this message came from the message queue's own slab, then return
+   * it there.
+   */
+
+  if (mqmsg->type == MQ_ALLOC_SLAB)
+    {
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->slabfree);
+      leave_critical_section(flags);
+      return;
+    }
+#endif
+
   /* If this is a generally available pre-allocated message,
    * then just put it back in the free list.
    */
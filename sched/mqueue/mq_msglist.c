@@ -0,0 +1,198 @@
+/****************************************************************************
+ * sched/mqueue/mq_msglist.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_MQ_PRIOBUCKETS
+/* The last bucket holds all priorities from MQ_TOPBUCKET up */
+
+#  define MQ_TOPBUCKET (CONFIG_MQ_NPRIOBUCKETS - 1)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_insert_sorted
+ *
+ * Description:
+ *   Insert a message into a list maintained in descending priority order,
+ *   after any messages of the same priority.
+ *
+ ****************************************************************************/
+
+static void nxmq_insert_sorted(FAR sq_queue_t *list,
+                               FAR struct mqueue_msg_s *mqmsg)
+{
+  FAR struct mqueue_msg_s *next;
+  FAR struct mqueue_msg_s *prev;
+
+  for (prev = NULL, next = (FAR struct mqueue_msg_s *)list->head;
+       next && mqmsg->priority <= next->priority;
+       prev = next, next = next->next);
+
+  /* Add the message at the right place */
+
+  if (prev)
+    {
+      sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)mqmsg, list);
+    }
+  else
+    {
+      sq_addfirst((FAR sq_entry_t *)mqmsg, list);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_add_msg
+ *
+ * Description:
+ *   Add a message to a message queue behind all messages of the same or
+ *   higher priority.  With CONFIG_MQ_PRIOBUCKETS, this takes constant time
+ *   for all priorities below CONFIG_MQ_NPRIOBUCKETS-1.
+ *
+ * Input Parameters:
+ *   msgq  - The message queue
+ *   mqmsg - The message to add.  The priority must already be set.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section.  The caller updates nmsgs.
+ *
+ ****************************************************************************/
+
+void nxmq_add_msg(FAR struct mqueue_inode_s *msgq,
+                  FAR struct mqueue_msg_s *mqmsg)
+{
+#ifdef CONFIG_MQ_PRIOBUCKETS
+  int bucket = mqmsg->priority;
+
+  if (bucket >= MQ_TOPBUCKET)
+    {
+      nxmq_insert_sorted(&msgq->msgbucket[MQ_TOPBUCKET], mqmsg);
+      bucket = MQ_TOPBUCKET;
+    }
+  else
+    {
+      sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgbucket[bucket]);
+    }
+
+  msgq->prioset[bucket >> 5] |= (uint32_t)1 << (bucket & 31);
+#else
+  nxmq_insert_sorted(&msgq->msglist, mqmsg);
+#endif
+}
+
+/****************************************************************************
+ * Name: nxmq_rem_msg
+ *
+ * Description:
+ *   Remove the oldest of the highest priority messages from a message
+ *   queue.
+ *
+ * Input Parameters:
+ *   msgq  - The message queue
+ *
+ * Returned Value:
+ *   The removed message or NULL if the message queue is empty.
+ *
+ * Assumptions:
+ *   Called from within a critical section.  The caller updates nmsgs.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_rem_msg(FAR struct mqueue_inode_s *msgq)
+{
+#ifdef CONFIG_MQ_PRIOBUCKETS
+  FAR struct mqueue_msg_s *mqmsg;
+  FAR sq_queue_t *list;
+  int bucket;
+  int ndx;
+
+  /* Find the highest non-empty bucket */
+
+  for (ndx = MQ_NPRIOWORDS - 1; ndx >= 0; ndx--)
+    {
+      if (msgq->prioset[ndx] != 0)
+        {
+          break;
+        }
+    }
+
+  if (ndx < 0)
+    {
+      return NULL;
+    }
+
+  bucket = (ndx << 5) + flsl((long)msgq->prioset[ndx]) - 1;
+  list   = &msgq->msgbucket[bucket];
+
+  mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(list);
+  DEBUGASSERT(mqmsg != NULL);
+
+  if (sq_empty(list))
+    {
+      msgq->prioset[ndx] &= ~((uint32_t)1 << (bucket & 31));
+    }
+
+  return mqmsg;
+#else
+  return (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist);
+#endif
+}
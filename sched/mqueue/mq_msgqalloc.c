@@ -96,7 +96,9 @@ FAR struct mqueue_inode_s *nxmq_alloc_msgq(mode_t mode,
     {
       /* Initialize the new named message queue */
 
+#ifndef CONFIG_MQ_PRIOBUCKETS
       sq_init(&msgq->msglist);
+#endif
       if (attr)
         {
           msgq->maxmsgs    = (int16_t)attr->mq_maxmsg;
@@ -111,6 +113,32 @@ FAR struct mqueue_inode_s *nxmq_alloc_msgq(mode_t mode,
 #ifndef CONFIG_DISABLE_SIGNALS
       msgq->ntpid = INVALID_PROCESS_ID;
 #endif
+
+#ifdef CONFIG_MQ_MSGSLAB
+      /* Pre-allocate one message for each slot in the queue */
+
+      if (msgq->maxmsgs > 0)
+        {
+          FAR struct mqueue_msg_s *mqmsg;
+          int i;
+
+          mqmsg = (FAR struct mqueue_msg_s *)
+            kmm_malloc(sizeof(struct mqueue_msg_s) * msgq->maxmsgs);
+
+          if (mqmsg == NULL)
+            {
+              sched_kfree(msgq);
+              return NULL;
+            }
+
+          msgq->msgslab = mqmsg;
+          for (i = 0; i < msgq->maxmsgs; i++, mqmsg++)
+            {
+              mqmsg->type = MQ_ALLOC_SLAB;
+              sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->slabfree);
+            }
+        }
+#endif
     }
 
   return msgq;
@@ -68,20 +68,25 @@
 void nxmq_free_msgq(FAR struct mqueue_inode_s *msgq)
 {
   FAR struct mqueue_msg_s *curr;
-  FAR struct mqueue_msg_s *next;
 
   /* Deallocate any stranded messages in the message queue. */
 
-  curr = (FAR struct mqueue_msg_s *)msgq->msglist.head;
-  while (curr)
+  while ((curr = nxmq_rem_msg(msgq)) != NULL)
     {
       /* Deallocate the message structure. */
 
-      next = curr->next;
-      nxmq_free_msg(curr);
-      curr = next;
+      nxmq_free_msg(msgq, curr);
     }
 
+#ifdef CONFIG_MQ_MSGSLAB
+  /* All slab messages are now back in the slab */
+
+  if (msgq->msgslab != NULL)
+    {
+      sched_kfree(msgq->msgslab);
+    }
+#endif
+
   /* Then deallocate the message queue itself */
 
   sched_kfree(msgq);
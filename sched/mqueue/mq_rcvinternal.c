@@ -115,14 +115,25 @@ int nxmq_verify_receive(mqd_t mqdes, FAR char *msg, size_t msglen)
  *   on the specified message queue, removes the message from the queue, and
  *   returns it.
  *
+ *   With CONFIG_MQ_HANDOFF, a sender may instead copy the message directly
+ *   into the caller's buffer while the caller is blocked.  In that case,
+ *   no message is returned in 'rcvmsg' and the message is already
+ *   complete.
+ *
  * Input Parameters:
- *   mqdes  - Message queue descriptor
- *   rcvmsg - The caller-provided location in which to return the newly
- *            received message.
+ *   mqdes   - Message queue descriptor
+ *   rcvmsg  - The caller-provided location in which to return the newly
+ *             received message.
+ *   ubuffer - The address of the user provided buffer to receive the
+ *             message (used only for direct hand-off)
+ *   prio    - The user-provided location to return the message priority
+ *             (used only for direct hand-off)
  *
  * Returned Value:
- *   One success, zero (OK) is returned.  A negated errno value is returned
- *   on any failure.
+ *   One success, zero (OK) is returned with the message in 'rcvmsg'.  If
+ *   the message was handed off directly, the length of the message is
+ *   returned and 'rcvmsg' is NULL.  A negated errno value is returned on
+ *   any failure.
  *
  * Assumptions:
  * - The caller has provided all validity checking of the input parameters
@@ -133,7 +144,8 @@ int nxmq_verify_receive(mqd_t mqdes, FAR char *msg, size_t msglen)
  *
  ****************************************************************************/
 
-int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg)
+int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg,
+                      FAR char *ubuffer, FAR unsigned int *prio)
 {
   FAR struct tcb_s *rtcb;
   FAR struct mqueue_inode_s *msgq;
@@ -164,7 +176,7 @@ int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg)
 
   /* Get the message from the head of the queue */
 
-  while ((newmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist)) == NULL)
+  while ((newmsg = nxmq_rem_msg(msgq)) == NULL)
     {
       /* The queue is empty!  Should we block until there the above condition
        * has been satisfied?
@@ -187,6 +199,12 @@ int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg)
           saved_errno    = rtcb->pterrno;
           rtcb->pterrno  = OK;
 
+#ifdef CONFIG_MQ_HANDOFF
+          /* Let a sender copy the message directly into our buffer */
+
+          rtcb->msgrcvbuf = ubuffer;
+#endif
+
           /* Make sure this is not the idle task, descheduling that
            * isn't going to end well.
            */
@@ -194,6 +212,25 @@ int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg)
           DEBUGASSERT(NULL != rtcb->flink);
           up_block_task(rtcb, TSTATE_WAIT_MQNOTEMPTY);
 
+#ifdef CONFIG_MQ_HANDOFF
+          /* A NULL buffer means that a sender has already delivered the
+           * message.
+           */
+
+          if (rtcb->msgrcvbuf == NULL)
+            {
+              rtcb->pterrno = saved_errno;
+              if (prio)
+                {
+                  *prio = rtcb->msgrcvprio;
+                }
+
+              return (int)rtcb->msgrcvlen;
+            }
+
+          rtcb->msgrcvbuf = NULL;
+#endif
+
           /* When we resume at this point, either (1) the message queue
            * is no longer empty, or (2) the wait has been interrupted by
            * a signal.  We can detect the latter case be examining the
@@ -284,11 +321,11 @@ ssize_t nxmq_do_receive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 
   /* We are done with the message.  Deallocate it now. */
 
-  nxmq_free_msg(mqmsg);
+  msgq = mqdes->msgq;
+  nxmq_free_msg(msgq, mqmsg);
 
   /* Check if any tasks are waiting for the MQ not full event. */
 
-  msgq = mqdes->msgq;
   if (msgq->nwaitnotfull > 0)
     {
       /* Find the highest priority task that is waiting for
@@ -120,7 +120,7 @@ ssize_t nxmq_receive(mqd_t mqdes, FAR char *msg, size_t msglen,
 
   /* Get the message from the message queue */
 
-  ret = nxmq_wait_receive(mqdes, &mqmsg);
+  ret = nxmq_wait_receive(mqdes, &mqmsg, msg, prio);
   leave_critical_section(flags);
 
   /* Check if we got a message from the message queue.  We might
@@ -128,11 +128,12 @@ ssize_t nxmq_receive(mqd_t mqdes, FAR char *msg, size_t msglen,
    *
    * - The message queue is empty and O_NONBLOCK is set in the mqdes
    * - The wait was interrupted by a signal
+   *
+   * Nor do we have one if a sender handed the message to us directly.
    */
 
-  if (ret >= 0)
+  if (ret >= 0 && mqmsg != NULL)
     {
-      DEBUGASSERT(mqmsg != NULL);
       ret = nxmq_do_receive(mqdes, mqmsg, msg, prio);
     }
 
@@ -130,6 +130,17 @@ int nxmq_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
         }
     }
 
+#ifdef CONFIG_MQ_HANDOFF
+  /* If a receiver is already waiting, give the message directly to it */
+
+  if (ret >= 0 && nxmq_do_handoff(msgq, msg, msglen, prio))
+    {
+      leave_critical_section(flags);
+      sched_unlock();
+      return OK;
+    }
+#endif
+
   /* ret can only be negative if nxmq_wait_send failed */
 
   leave_critical_section(flags);
@@ -137,7 +148,7 @@ int nxmq_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
     {
       /* Now allocate the message. */
 
-      mqmsg = nxmq_alloc_msg();
+      mqmsg = nxmq_alloc_msg(msgq);
 
       /* Check if the message was successfully allocated */
 
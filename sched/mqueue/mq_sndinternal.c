@@ -114,8 +114,9 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be allocated from the message
+ *   queue's own slab (if CONFIG_MQ_MSGSLAB is selected) or from the
+ *   g_msgfree list.
  *
  *   If the list is empty AND the message is NOT being allocated from the
  *   interrupt level, then the message will be allocated.  If a message
@@ -128,7 +129,7 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
  *   handler will be notified.
  *
  * Input Parameters:
- *   None
+ *   msgq - The message queue that the message will be sent to
  *
  * Returned Value:
  *   A reference to the allocated msg structure.  On a failure to allocate,
@@ -136,11 +137,24 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
+FAR struct mqueue_msg_s *nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq)
 {
   FAR struct mqueue_msg_s *mqmsg;
   irqstate_t flags;
 
+#ifdef CONFIG_MQ_MSGSLAB
+  /* Try the message queue's own slab first */
+
+  flags = enter_critical_section();
+  mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->slabfree);
+  leave_critical_section(flags);
+
+  if (mqmsg != NULL)
+    {
+      return mqmsg;
+    }
+#endif
+
   /* If we were called from an interrupt handler, then try to get the message
    * from generally available list of messages. If this fails, then try the
    * list of messages reserved for interrupt handlers
@@ -317,6 +331,76 @@ int nxmq_wait_send(mqd_t mqdes)
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxmq_do_handoff
+ *
+ * Description:
+ *   This is internal, common logic shared by both [nx]mq_send and
+ *   [nx]mq_timesend.  If the message queue is empty and a receiver is
+ *   blocked waiting for it to become non-empty, copy the message directly
+ *   into that receiver's buffer and wake it up.  No message structure is
+ *   allocated and the message is never queued.
+ *
+ *   Message queue notifications are not generated for messages that are
+ *   handed off:  POSIX only notifies when no thread is blocked receiving.
+ *
+ * Input Parameters:
+ *   msgq   - The message queue
+ *   msg    - Message to send
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   true if the message was handed off; false if it must be queued
+ *
+ * Assumptions/restrictions:
+ * - The caller has verified the input parameters using nxmq_verify_send().
+ * - Executes within a critical section and with pre-emption disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MQ_HANDOFF
+bool nxmq_do_handoff(FAR struct mqueue_inode_s *msgq, FAR const char *msg,
+                     size_t msglen, unsigned int prio)
+{
+  FAR struct tcb_s *btcb;
+
+  /* Queued messages must be received first to keep the priority order */
+
+  if (msgq->nmsgs > 0 || msgq->nwaitnotempty <= 0)
+    {
+      return false;
+    }
+
+  /* Find the highest priority task that is waiting for this queue to be
+   * non-empty.
+   */
+
+  for (btcb = (FAR struct tcb_s *)g_waitingformqnotempty.head;
+       btcb && btcb->msgwaitq != msgq;
+       btcb = btcb->flink);
+
+  if (btcb == NULL || btcb->msgrcvbuf == NULL)
+    {
+      return false;
+    }
+
+  /* Copy the message straight into the receiver's buffer.  A NULL
+   * msgrcvbuf tells the receiver that it has been served.
+   */
+
+  memcpy(btcb->msgrcvbuf, msg, msglen);
+  btcb->msgrcvlen  = msglen;
+  btcb->msgrcvprio = prio;
+  btcb->msgrcvbuf  = NULL;
+
+  btcb->msgwaitq   = NULL;
+  msgq->nwaitnotempty--;
+  up_unblock_task(btcb);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: nxmq_do_send
  *
@@ -343,8 +427,6 @@ int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 {
   FAR struct tcb_s *btcb;
   FAR struct mqueue_inode_s *msgq;
-  FAR struct mqueue_msg_s *next;
-  FAR struct mqueue_msg_s *prev;
   irqstate_t flags;
 
   /* Get a pointer to the message queue */
@@ -364,26 +446,7 @@ int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
   /* Insert the new message in the message queue */
 
   flags = enter_critical_section();
-
-  /* Search the message list to find the location to insert the new
-   * message. Each is list is maintained in ascending priority order.
-   */
-
-  for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head;
-       next && prio <= next->priority;
-       prev = next, next = next->next);
-
-  /* Add the message at the right place */
-
-  if (prev)
-    {
-      sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)mqmsg,
-                  &msgq->msglist);
-    }
-  else
-    {
-      sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
-    }
+  nxmq_add_msg(msgq, mqmsg);
 
   /* Increment the count of messages in the queue */
 
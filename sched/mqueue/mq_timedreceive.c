@@ -206,7 +206,7 @@ ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
    * will not need to start timer.
    */
 
-  if (mqdes->msgq->msglist.head == NULL)
+  if (mqdes->msgq->nmsgs <= 0)
     {
       sclock_t ticks;
 
@@ -246,7 +246,7 @@ ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
 
   /* Get the message from the message queue */
 
-  ret = nxmq_wait_receive(mqdes, &mqmsg);
+  ret = nxmq_wait_receive(mqdes, &mqmsg, msg, prio);
 
   /* Stop the watchdog timer (this is not harmful in the case where
    * it was never started)
@@ -264,11 +264,12 @@ ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
    * - The message queue is empty and O_NONBLOCK is set in the mqdes
    * - The wait was interrupted by a signal
    * - The watchdog timeout expired
+   *
+   * Nor do we have one if a sender handed the message to us directly.
    */
 
-  if (ret >= 0)
+  if (ret >= 0 && mqmsg != NULL)
     {
-      DEBUGASSERT(mqmsg != NULL);
       ret = nxmq_do_receive(mqdes, mqmsg, msg, prio);
     }
 
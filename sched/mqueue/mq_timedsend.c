@@ -178,9 +178,28 @@ int nxmq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen,
       return ret;
     }
 
+#ifdef CONFIG_MQ_HANDOFF
+  /* If a receiver is already waiting, give the message directly to it.
+   * There is then no need for a message structure or a timeout.
+   */
+
+  sched_lock();
+  flags = enter_critical_section();
+
+  if (nxmq_do_handoff(mqdes->msgq, msg, msglen, prio))
+    {
+      leave_critical_section(flags);
+      sched_unlock();
+      return OK;
+    }
+
+  leave_critical_section(flags);
+  sched_unlock();
+#endif
+
   /* Pre-allocate a message structure */
 
-  mqmsg = nxmq_alloc_msg();
+  mqmsg = nxmq_alloc_msg(mqdes->msgq);
   if (mqmsg == NULL)
     {
       /* Failed to allocate the message. nxmq_alloc_msg() does not set the
@@ -326,7 +345,7 @@ errout_in_critical_section:
    */
 
 errout_with_mqmsg:
-  nxmq_free_msg(mqmsg);
+  nxmq_free_msg(msgq, mqmsg);
   sched_unlock();
   return ret;
 }
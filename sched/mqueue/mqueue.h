@@ -82,7 +82,8 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_SLAB        /* Preallocated with the message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -142,7 +143,17 @@ struct task_group_s; /* Forward reference */
 
 void weak_function nxmq_initialize(void);
 void nxmq_alloc_desblock(void);
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
+
+/* mq_msgfree.c ************************************************************/
+
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg);
+
+/* mq_msglist.c ************************************************************/
+
+void nxmq_add_msg(FAR struct mqueue_inode_s *msgq,
+                  FAR struct mqueue_msg_s *mqmsg);
+FAR struct mqueue_msg_s *nxmq_rem_msg(FAR struct mqueue_inode_s *msgq);
 
 /* mq_waitirq.c ************************************************************/
 
@@ -151,7 +162,8 @@ void nxmq_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 /* mq_rcvinternal.c ********************************************************/
 
 int nxmq_verify_receive(mqd_t mqdes, FAR char *msg, size_t msglen);
-int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg);
+int nxmq_wait_receive(mqd_t mqdes, FAR struct mqueue_msg_s **rcvmsg,
+                      FAR char *ubuffer, FAR unsigned int *prio);
 ssize_t nxmq_do_receive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
                         FAR char *ubuffer, FAR unsigned int *prio);
 
@@ -159,8 +171,12 @@ ssize_t nxmq_do_receive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 
 int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
                      unsigned int prio);
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void);
+FAR struct mqueue_msg_s *nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq);
 int nxmq_wait_send(mqd_t mqdes);
+#ifdef CONFIG_MQ_HANDOFF
+bool nxmq_do_handoff(FAR struct mqueue_inode_s *msgq, FAR const char *msg,
+                     size_t msglen, unsigned int prio);
+#endif
 int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
                  FAR const char *msg, size_t msglen, unsigned int prio);
 
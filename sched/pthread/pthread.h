@@ -116,18 +116,21 @@ int pthread_sem_trytake(sem_t *sem);
 #endif
 int pthread_sem_give(sem_t *sem);
 
-#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+#if !defined(CONFIG_PTHREAD_MUTEX_UNSAFE) || defined(CONFIG_SEM_FASTPATH)
 int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
                        FAR const struct timespec *abs_timeout, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
-void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
 #else
 #  define pthread_mutex_take(m,abs_timeout,i)  pthread_sem_take(&(m)->sem,(abs_timeout),(i))
 #  define pthread_mutex_trytake(m)             pthread_sem_trytake(&(m)->sem)
 #  define pthread_mutex_give(m)                pthread_sem_give(&(m)->sem)
 #endif
 
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
+#endif
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 int pthread_mutexattr_verifytype(int type);
 #endif
@@ -47,14 +47,17 @@
 #include <nuttx/irq.h>
 #include <nuttx/sched.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/pthread.h>
 
 #include "sched/sched.h"
+#include "semaphore/semaphore.h"
 #include "pthread/pthread.h"
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
 /****************************************************************************
  * Name: pthread_mutex_add
  *
@@ -156,6 +159,102 @@ static void pthread_mutex_remove(FAR struct pthread_mutex_s *mutex)
     }
 }
 
+#endif /* !CONFIG_PTHREAD_MUTEX_UNSAFE */
+
+#ifdef CONFIG_SEM_FASTPATH
+/****************************************************************************
+ * Name: pthread_mutex_fasttake
+ *
+ * Description:
+ *   Reconcile the fast path lock word with the semaphore underlying the
+ *   mutex.  If the mutex is free, it is taken via the lock word.  If the
+ *   mutex is held via the fast path, then the mutex is handed over to the
+ *   OS:  The semaphore count is adjusted to account for the holder and the
+ *   holder is registered with the semaphore so that its priority may be
+ *   boosted while the caller waits.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be locked
+ *
+ * Returned Value:
+ *   true if the mutex was taken; false if the caller must take the
+ *   underlying semaphore.
+ *
+ * Assumptions:
+ *   The scheduler is locked.
+ *
+ ****************************************************************************/
+
+static bool pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex)
+{
+  FAR struct tcb_s *htcb;
+  irqstate_t flags;
+  uint32_t owner;
+  bool taken = false;
+
+  flags = enter_critical_section();
+
+  owner = mutex->owner;
+  if (owner == 0)
+    {
+      /* The mutex is free.  Take it via the lock word. */
+
+      mutex->owner = ((uint32_t)this_task()->pid & _PTHREAD_MOWNER_PIDMASK) |
+                     _PTHREAD_MOWNER_LOCKED;
+      taken        = true;
+    }
+  else if ((owner & _PTHREAD_MOWNER_KERNEL) == 0)
+    {
+      /* The mutex is held via the fast path.  From now on the semaphore is
+       * authoritative:  The holder will not be able to release the mutex
+       * without calling into the OS.
+       */
+
+      mutex->owner = _PTHREAD_MOWNER_KERNEL;
+      mutex->sem.semcount--;
+
+      htcb = sched_gettcb((pid_t)(owner & _PTHREAD_MOWNER_PIDMASK));
+      if (htcb != NULL)
+        {
+          nxsem_addholder_tcb(htcb, &mutex->sem);
+        }
+    }
+
+  leave_critical_section(flags);
+  return taken;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastgive
+ *
+ * Description:
+ *   Release a mutex that was taken via the fast path lock word.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be unlocked
+ *
+ * Returned Value:
+ *   true if the mutex was released; false if the mutex is managed by the
+ *   underlying semaphore.
+ *
+ ****************************************************************************/
+
+static bool pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex)
+{
+  uint32_t owner = mutex->owner;
+
+  while (owner != 0 && (owner & _PTHREAD_MOWNER_KERNEL) == 0)
+    {
+      if (SEM_CMPXCHG(&mutex->owner, &owner, 0))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif /* CONFIG_SEM_FASTPATH */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -191,6 +290,7 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
 
       sched_lock();
 
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
       /* Error out if the mutex is already in an inconsistent state. */
 
       if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
@@ -198,12 +298,25 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
           ret = EOWNERDEAD;
         }
       else
+#endif
+#ifdef CONFIG_SEM_FASTPATH
+      /* Try the fast path lock word.  This also hands a mutex that is held
+       * via the fast path over to the semaphore.
+       */
+
+      if (PTHREAD_MUTEX_ISFAST(mutex) && pthread_mutex_fasttake(mutex))
+        {
+          ret = OK;
+        }
+      else
+#endif
         {
           /* Take semaphore underlying the mutex.  pthread_sem_take
            * returns zero on success and a positive errno value on failure.
            */
 
           ret = pthread_sem_take(&mutex->sem, abs_timeout, intr);
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
           if (ret == OK)
             {
               /* Check if the holder of the mutex has terminated without
@@ -216,13 +329,20 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
                   ret = EOWNERDEAD;
                 }
 
-              /* Add the mutex to the list of mutexes held by this task */
+              /* Add the mutex to the list of mutexes held by this task.
+               * Mutexes that use the fast path are not tracked.
+               */
 
+#ifdef CONFIG_SEM_FASTPATH
+              else if (!PTHREAD_MUTEX_ISFAST(mutex))
+#else
               else
+#endif
                 {
                   pthread_mutex_add(mutex);
                 }
             }
+#endif
         }
 
       sched_unlock();
@@ -261,6 +381,7 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
 
       sched_lock();
 
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
       /* Error out if the mutex is already in an inconsistent state. */
 
       if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
@@ -268,6 +389,24 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
           ret = EOWNERDEAD;
         }
       else
+#endif
+#ifdef CONFIG_SEM_FASTPATH
+      /* If the mutex is not managed by the semaphore, then it is either
+       * free or held via the fast path.
+       */
+
+      if (PTHREAD_MUTEX_ISFAST(mutex) &&
+          (mutex->owner & _PTHREAD_MOWNER_KERNEL) == 0)
+        {
+          uint32_t owner = 0;
+          uint32_t mine  = ((uint32_t)this_task()->pid &
+                            _PTHREAD_MOWNER_PIDMASK) |
+                           _PTHREAD_MOWNER_LOCKED;
+
+          ret = SEM_CMPXCHG(&mutex->owner, &owner, mine) ? OK : EAGAIN;
+        }
+      else
+#endif
         {
           /* Try to take the semaphore underlying the mutex */
 
@@ -276,12 +415,18 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
             {
               ret = -ret;
             }
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+#ifdef CONFIG_SEM_FASTPATH
+          else if (!PTHREAD_MUTEX_ISFAST(mutex))
+#else
           else
+#endif
             {
               /* Add the mutex to the list of mutexes held by this task */
 
               pthread_mutex_add(mutex);
             }
+#endif
         }
 
       sched_unlock();
@@ -314,9 +459,36 @@ int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
   DEBUGASSERT(mutex != NULL);
   if (mutex != NULL)
     {
+#ifdef CONFIG_SEM_FASTPATH
+      if (PTHREAD_MUTEX_ISFAST(mutex))
+        {
+          /* Release the lock word if the mutex was taken via the fast
+           * path.  Otherwise, release the underlying semaphore and return
+           * the mutex to the fast path once it is no longer contended.
+           */
+
+          if (pthread_mutex_fastgive(mutex))
+            {
+              return OK;
+            }
+
+          sched_lock();
+          ret = pthread_sem_give(&mutex->sem);
+          if (ret == OK && mutex->sem.semcount > 0)
+            {
+              mutex->owner = 0;
+            }
+
+          sched_unlock();
+          return ret;
+        }
+#endif
+
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
       /* Remove the mutex from the list of mutexes held by this task */
 
       pthread_mutex_remove(mutex);
+#endif
 
       /* Now release the underlying semaphore */
 
@@ -147,6 +147,12 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
       mutex->type   = type;
       mutex->nlocks = 0;
 #endif
+
+#ifdef CONFIG_SEM_FASTPATH
+      /* The mutex is initially free for the fast path */
+
+      mutex->owner  = 0;
+#endif
     }
 
   sinfo("Returning %d\n", ret);
@@ -47,6 +47,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/pthread.h>
+
 #include "pthread/pthread.h"
 
 /****************************************************************************
@@ -62,6 +64,11 @@
  *   (by any thread, including the current thread), the call returns immediately
  *   with the errno EBUSY.
  *
+ *   When CONFIG_SEM_FASTPATH is selected, this is
+ *   pthread_mutex_trylock_slow() which is called from the C library
+ *   pthread_mutex_trylock() only when the mutex is contended or must be
+ *   managed by the OS.
+ *
  *   If a signal is delivered to a thread waiting for a mutex, upon return from
  *   the signal handler the thread resumes waiting for the mutex as if it was
  *   not interrupted.
@@ -82,7 +89,11 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SEM_FASTPATH
+int pthread_mutex_trylock_slow(FAR pthread_mutex_t *mutex)
+#else
 int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+#endif
 {
   int status;
   int ret = EINVAL;
@@ -46,6 +46,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/pthread.h>
+
 #include "pthread/pthread.h"
 
 /****************************************************************************
@@ -70,6 +72,16 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
 {
   int semcount = mutex->sem.semcount;
 
+#ifdef CONFIG_SEM_FASTPATH
+  /* A mutex that is held via the fast path does not use the semaphore */
+
+  uint32_t owner = mutex->owner;
+  if (owner != 0 && (owner & _PTHREAD_MOWNER_KERNEL) == 0)
+    {
+      return true;
+    }
+#endif
+
   /* The underlying semaphore should have a count less than 2:
    *
    *  1 == mutex is unlocked.
@@ -98,6 +110,10 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *   mutexes, the mutex becomes available when the count reaches zero and the
  *   calling thread no longer has any locks on this mutex).
  *
+ *   When CONFIG_SEM_FASTPATH is selected, this is pthread_mutex_unlock_slow()
+ *   which is called from the C library pthread_mutex_unlock() only when the
+ *   mutex is contended or must be managed by the OS.
+ *
  *   If a signal is delivered to a thread waiting for a mutex, upon return from
  *   the signal handler the thread resumes waiting for the mutex as if it was
  *   not interrupted.
@@ -112,7 +128,11 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SEM_FASTPATH
+int pthread_mutex_unlock_slow(FAR pthread_mutex_t *mutex)
+#else
 int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+#endif
 {
   int ret = EPERM;
 
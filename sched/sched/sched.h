@@ -96,6 +96,17 @@
 #define running_task() \
   (up_interrupt_context() ? g_running_tasks[this_cpu()] : this_task())
 
+/* The return address of the function that uses this macro.  The critical
+ * section monitor uses it to identify who disabled pre-emption or entered
+ * the critical section.
+ */
+
+#if defined(CONFIG_SCHED_CRITMONITOR_HISTOGRAM) && defined(__GNUC__)
+#  define CRITMON_CALLER()       __builtin_return_address(0)
+#else
+#  define CRITMON_CALLER()       NULL
+#endif
+
 /* List attribute flags */
 
 #define TLIST_ATTR_PRIORITIZED   (1 << 0) /* Bit 0: List is prioritized */
@@ -499,8 +510,10 @@ void weak_function nxsched_process_cpuload(void);
 /* Critical section monitor */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
-void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state);
-void sched_critmon_csection(FAR struct tcb_s *tcb, bool state);
+void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state,
+                              FAR void *caller);
+void sched_critmon_csection(FAR struct tcb_s *tcb, bool state,
+                            FAR void *caller);
 void sched_critmon_resume(FAR struct tcb_s *tcb);
 void sched_critmon_suspend(FAR struct tcb_s *tcb);
 #endif
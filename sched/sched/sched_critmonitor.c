@@ -41,23 +41,45 @@
 
 #include <sys/types.h>
 #include <sched.h>
+#include <string.h>
+
+#include <nuttx/irq.h>
 
 #include "sched/sched.h"
 
 #ifdef CONFIG_SCHED_CRITMONITOR
 
+/************************************************************************************
+ * Pre-processor Definitions
+ ************************************************************************************/
+
+#ifdef CONFIG_SMP_NCPUS
+#  define CRITMON_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define CRITMON_NCPUS 1
+#endif
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+#  define CRITMON_NBUCKETS CONFIG_SCHED_CRITMONITOR_NBUCKETS
+#  define CRITMON_NWORST   CONFIG_SCHED_CRITMONITOR_NWORST
+#endif
+
 /************************************************************************************
  * Private Data
  ************************************************************************************/
 
 /* Start time when pre-emption disabled or critical section entered. */
 
-#ifdef CONFIG_SMP_NCPUS
-static uint32_t g_premp_start[CONFIG_SMP_NCPUS];
-static uint32_t g_crit_start[CONFIG_SMP_NCPUS];
-#else
-static uint32_t g_premp_start[1];
-static uint32_t g_crit_start[1];
+static uint32_t g_premp_start[CRITMON_NCPUS];
+static uint32_t g_crit_start[CRITMON_NCPUS];
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Caller and thread that started the current per CPU interval */
+
+static FAR void *g_premp_from[CRITMON_NCPUS];
+static FAR void *g_crit_from[CRITMON_NCPUS];
+static pid_t g_premp_pid[CRITMON_NCPUS];
+static pid_t g_crit_pid[CRITMON_NCPUS];
 #endif
 
 /************************************************************************************
@@ -66,14 +88,250 @@ static uint32_t g_crit_start[1];
 
 /* Maximum time with pre-emption disabled or within critical section. */
 
-#ifdef CONFIG_SMP_NCPUS
-uint32_t g_premp_max[CONFIG_SMP_NCPUS];
-uint32_t g_crit_max[CONFIG_SMP_NCPUS];
-#else
-uint32_t g_premp_max[1];
-uint32_t g_crit_max[1];
+uint32_t g_premp_max[CRITMON_NCPUS];
+uint32_t g_crit_max[CRITMON_NCPUS];
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Histograms and the worst offenders for each CPU */
+
+struct critmon_hist_s g_premp_hist[CRITMON_NCPUS];
+struct critmon_hist_s g_crit_hist[CRITMON_NCPUS];
+struct critmon_worst_s g_premp_worst[CRITMON_NCPUS][CRITMON_NWORST];
+struct critmon_worst_s g_crit_worst[CRITMON_NCPUS][CRITMON_NWORST];
 #endif
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/****************************************************************************
+ * Name: critmon_hist_add
+ *
+ * Description:
+ *   Count one duration in the log2 bucket it belongs to.
+ *
+ ****************************************************************************/
+
+static void critmon_hist_add(FAR struct critmon_hist_s *hist,
+                             uint32_t elapsed)
+{
+  unsigned int bucket = 0;
+
+  elapsed >>= CONFIG_SCHED_CRITMONITOR_BUCKETSHIFT;
+
+  /* Find the most significant bit set with a binary search */
+
+  if (elapsed >= (1ul << 16))
+    {
+      elapsed >>= 16;
+      bucket   += 16;
+    }
+
+  if (elapsed >= (1ul << 8))
+    {
+      elapsed >>= 8;
+      bucket   += 8;
+    }
+
+  if (elapsed >= (1ul << 4))
+    {
+      elapsed >>= 4;
+      bucket   += 4;
+    }
+
+  if (elapsed >= (1ul << 2))
+    {
+      elapsed >>= 2;
+      bucket   += 2;
+    }
+
+  if (elapsed >= (1ul << 1))
+    {
+      bucket   += 1;
+    }
+
+  if (bucket >= CRITMON_NBUCKETS)
+    {
+      bucket = CRITMON_NBUCKETS - 1;
+    }
+
+  hist->count[bucket]++;
+}
+
+/****************************************************************************
+ * Name: critmon_worst_add
+ *
+ * Description:
+ *   Remember the caller if the duration is one of the longest seen on this
+ *   CPU.  Each caller appears only once in the table so that one frequent
+ *   offender does not hide all of the others.
+ *
+ ****************************************************************************/
+
+static void critmon_worst_add(FAR struct critmon_worst_s *worst,
+                              FAR void *caller, uint32_t elapsed, pid_t pid)
+{
+  FAR struct critmon_worst_s *min = &worst[0];
+  int i;
+
+  for (i = 0; i < CRITMON_NWORST; i++)
+    {
+      if (worst[i].caller == caller && worst[i].elapsed != 0)
+        {
+          /* Already in the table.. just update the duration */
+
+          if (elapsed > worst[i].elapsed)
+            {
+              worst[i].elapsed = elapsed;
+              worst[i].pid     = pid;
+            }
+
+          return;
+        }
+
+      if (worst[i].elapsed < min->elapsed)
+        {
+          min = &worst[i];
+        }
+    }
+
+  /* Replace the shortest entry in the table */
+
+  if (elapsed > min->elapsed)
+    {
+      min->caller  = caller;
+      min->elapsed = elapsed;
+      min->pid     = pid;
+    }
+}
+
+/****************************************************************************
+ * Name: critmon_reset_tcb
+ *
+ * Description:
+ *   sched_foreach() callback that clears the data of one thread.
+ *
+ ****************************************************************************/
+
+static void critmon_reset_tcb(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  tcb->premp_caller = NULL;
+  tcb->crit_caller  = NULL;
+
+  memset(&tcb->premp_hist, 0, sizeof(struct critmon_hist_s));
+  memset(&tcb->crit_hist, 0, sizeof(struct critmon_hist_s));
+}
+#endif /* CONFIG_SCHED_CRITMONITOR_HISTOGRAM */
+
+/****************************************************************************
+ * Name: critmon_premp_thread and critmon_crit_thread
+ *
+ * Description:
+ *   Account one interval of a thread with pre-emption disabled or within a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void critmon_premp_thread(FAR struct tcb_s *tcb, uint32_t elapsed)
+{
+  if (elapsed > tcb->premp_max)
+    {
+      tcb->premp_max = elapsed;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      tcb->premp_caller = tcb->premp_from;
+#endif
+    }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  critmon_hist_add(&tcb->premp_hist, elapsed);
+#endif
+}
+
+static void critmon_crit_thread(FAR struct tcb_s *tcb, uint32_t elapsed)
+{
+  if (elapsed > tcb->crit_max)
+    {
+      tcb->crit_max = elapsed;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      tcb->crit_caller = tcb->crit_from;
+#endif
+    }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  critmon_hist_add(&tcb->crit_hist, elapsed);
+#endif
+}
+
+/****************************************************************************
+ * Name: critmon_premp_global and critmon_crit_global
+ *
+ * Description:
+ *   Account one interval of a CPU with pre-emption disabled or within a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void critmon_premp_global(int cpu, uint32_t elapsed)
+{
+  if (elapsed > g_premp_max[cpu])
+    {
+      g_premp_max[cpu] = elapsed;
+    }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  critmon_hist_add(&g_premp_hist[cpu], elapsed);
+  critmon_worst_add(g_premp_worst[cpu], g_premp_from[cpu], elapsed,
+                    g_premp_pid[cpu]);
+#endif
+}
+
+static void critmon_crit_global(int cpu, uint32_t elapsed)
+{
+  if (elapsed > g_crit_max[cpu])
+    {
+      g_crit_max[cpu] = elapsed;
+    }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  critmon_hist_add(&g_crit_hist[cpu], elapsed);
+  critmon_worst_add(g_crit_worst[cpu], g_crit_from[cpu], elapsed,
+                    g_crit_pid[cpu]);
+#endif
+}
+
+/****************************************************************************
+ * Name: critmon_premp_begin and critmon_crit_begin
+ *
+ * Description:
+ *   Start the per CPU interval if it is not running yet.
+ *
+ ****************************************************************************/
+
+static void critmon_premp_begin(FAR struct tcb_s *tcb, int cpu)
+{
+  if (g_premp_start[cpu] == 0)
+    {
+      g_premp_start[cpu] = tcb->premp_start;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      g_premp_from[cpu]  = tcb->premp_from;
+      g_premp_pid[cpu]   = tcb->pid;
+#endif
+    }
+}
+
+static void critmon_crit_begin(FAR struct tcb_s *tcb, int cpu)
+{
+  if (g_crit_start[cpu] == 0)
+    {
+      g_crit_start[cpu] = tcb->crit_start;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      g_crit_from[cpu]  = tcb->crit_from;
+      g_crit_pid[cpu]   = tcb->pid;
+#endif
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -84,13 +342,19 @@ uint32_t g_crit_max[1];
  * Description:
  *   Called when there is any change in pre-emptible state of a thread.
  *
+ * Input Parameters:
+ *   tcb    - The thread whose pre-emptible state changes
+ *   state  - True if pre-emption is being disabled
+ *   caller - The caller of sched_lock() when disabling
+ *
  * Assumptions:
  *   - Called within a critical section.
  *   - Never called from an interrupt handler
  *
  ****************************************************************************/
 
-void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
+void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state,
+                              FAR void *caller)
 {
   int cpu = this_cpu();
 
@@ -103,42 +367,36 @@ void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
       /* Disabling.. Save the thread start time */
 
       tcb->premp_start = up_critmon_gettime();
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      tcb->premp_from  = caller;
+#endif
 
       /* Zero means that the timer is not ready */
 
-      if (tcb->premp_start != 0 && g_premp_start[cpu] == 0)
+      if (tcb->premp_start != 0)
         {
           /* Save the global start time */
 
-          g_premp_start[cpu] = tcb->premp_start;
+          critmon_premp_begin(tcb, cpu);
         }
     }
   else if (tcb->premp_start != 0)
     {
       /* Re-enabling.. Check for the max elapsed time */
 
-      uint32_t now     = up_critmon_gettime();
-      uint32_t elapsed = now - tcb->premp_start;
+      uint32_t now = up_critmon_gettime();
 
       DEBUGASSERT(now != 0);
 
+      critmon_premp_thread(tcb, now - tcb->premp_start);
       tcb->premp_start = 0;
-      if (elapsed > tcb->premp_max)
-        {
-          tcb->premp_max = elapsed;
-        }
 
       /* Check for the global max elapsed time */
 
       if (g_premp_start[cpu] != 0)
         {
-          elapsed            = now - g_premp_start[cpu];
+          critmon_premp_global(cpu, now - g_premp_start[cpu]);
           g_premp_start[cpu] = 0;
-
-          if (elapsed > g_premp_max[cpu])
-            {
-              g_premp_max[cpu] = elapsed;
-            }
         }
     }
 }
@@ -149,13 +407,19 @@ void sched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
  * Description:
  *   Called when a thread enters or leaves a critical section.
  *
+ * Input Parameters:
+ *   tcb    - The thread entering or leaving the critical section
+ *   state  - True if the critical section is being entered
+ *   caller - The caller of enter_critical_section() when entering
+ *
  * Assumptions:
  *   - Called within a critical section.
  *   - Never called from an interrupt handler
  *
  ****************************************************************************/
 
-void sched_critmon_csection(FAR struct tcb_s *tcb, bool state)
+void sched_critmon_csection(FAR struct tcb_s *tcb, bool state,
+                            FAR void *caller)
 {
   int cpu = this_cpu();
 
@@ -167,42 +431,36 @@ void sched_critmon_csection(FAR struct tcb_s *tcb, bool state)
 
       DEBUGASSERT(tcb->crit_start == 0);
       tcb->crit_start = up_critmon_gettime();
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      tcb->crit_from  = caller;
+#endif
 
       /* Zero means that the timer is not ready */
 
-      if (tcb->crit_start != 0 && g_crit_start[cpu] == 0)
+      if (tcb->crit_start != 0)
         {
           /* Set the global start time */
 
-          g_crit_start[cpu] = tcb->crit_start;
+          critmon_crit_begin(tcb, cpu);
         }
     }
   else if (tcb->crit_start != 0)
     {
       /* Leaving .. Check for the max elapsed time */
 
-      uint32_t now     = up_critmon_gettime();
-      uint32_t elapsed = now - tcb->crit_start;
+      uint32_t now = up_critmon_gettime();
 
       DEBUGASSERT(now != 0);
 
+      critmon_crit_thread(tcb, now - tcb->crit_start);
       tcb->crit_start = 0;
-      if (elapsed > tcb->crit_max)
-        {
-          tcb->crit_max = elapsed;
-        }
 
       /* Check for the global max elapsed time */
 
       if (g_crit_start[cpu] != 0)
         {
-          elapsed           = now - g_crit_start[cpu];
+          critmon_crit_global(cpu, now - g_crit_start[cpu]);
           g_crit_start[cpu] = 0;
-
-          if (elapsed > g_crit_max[cpu])
-            {
-              g_crit_max[cpu] = elapsed;
-            }
         }
     }
 }
@@ -222,7 +480,6 @@ void sched_critmon_csection(FAR struct tcb_s *tcb, bool state)
 
 void sched_critmon_resume(FAR struct tcb_s *tcb)
 {
-  uint32_t elapsed;
   int cpu = this_cpu();
 
   DEBUGASSERT(tcb->premp_start == 0 && tcb->crit_start == 0);
@@ -236,24 +493,14 @@ void sched_critmon_resume(FAR struct tcb_s *tcb)
       tcb->premp_start = up_critmon_gettime();
       DEBUGASSERT(tcb->premp_start != 0);
 
-      /* Zero means that the timer is not ready */
-
-      if (g_premp_start[cpu] == 0)
-        {
-          g_premp_start[cpu] = tcb->premp_start;
-        }
+      critmon_premp_begin(tcb, cpu);
     }
   else if (g_premp_start[cpu] != 0)
     {
       /* Check for the global max elapsed time */
 
-      elapsed            = up_critmon_gettime() - g_premp_start[cpu];
+      critmon_premp_global(cpu, up_critmon_gettime() - g_premp_start[cpu]);
       g_premp_start[cpu] = 0;
-
-      if (elapsed > g_premp_max[cpu])
-        {
-          g_premp_max[cpu] = elapsed;
-        }
     }
 
   /* Was this task in a critical section? */
@@ -265,22 +512,14 @@ void sched_critmon_resume(FAR struct tcb_s *tcb)
       tcb->crit_start = up_critmon_gettime();
       DEBUGASSERT(tcb->crit_start != 0);
 
-      if (g_crit_start[cpu] == 0)
-        {
-          g_crit_start[cpu] = tcb->crit_start;
-        }
+      critmon_crit_begin(tcb, cpu);
     }
   else if (g_crit_start[cpu] != 0)
     {
       /* Check for the global max elapsed time */
 
-      elapsed      = up_critmon_gettime() - g_crit_start[cpu];
+      critmon_crit_global(cpu, up_critmon_gettime() - g_crit_start[cpu]);
       g_crit_start[cpu] = 0;
-
-      if (elapsed > g_crit_max[cpu])
-        {
-          g_crit_max[cpu] = elapsed;
-        }
     }
 }
 
@@ -299,21 +538,14 @@ void sched_critmon_resume(FAR struct tcb_s *tcb)
 
 void sched_critmon_suspend(FAR struct tcb_s *tcb)
 {
-  uint32_t elapsed;
-
   /* Did this task disable preemption? */
 
   if (tcb->lockcount > 0)
     {
       /* Possibly re-enabling.. Check for the max elapsed time */
 
-      elapsed = up_critmon_gettime() - tcb->premp_start;
-
+      critmon_premp_thread(tcb, up_critmon_gettime() - tcb->premp_start);
       tcb->premp_start = 0;
-      if (elapsed > tcb->premp_max)
-        {
-          tcb->premp_max = elapsed;
-        }
     }
 
   /* Is this task in a critical section? */
@@ -322,14 +554,36 @@ void sched_critmon_suspend(FAR struct tcb_s *tcb)
     {
       /* Possibly leaving .. Check for the max elapsed time */
 
-      elapsed = up_critmon_gettime() - tcb->crit_start;
-
+      critmon_crit_thread(tcb, up_critmon_gettime() - tcb->crit_start);
       tcb->crit_start = 0;
-      if (elapsed > tcb->crit_max)
-        {
-          tcb->crit_max = elapsed;
-        }
     }
 }
 
+/****************************************************************************
+ * Name: sched_critmon_reset
+ *
+ * Description:
+ *   Clear the histograms and the worst offenders of all CPUs and of all
+ *   threads.  The maximum durations are not affected; they are reset when
+ *   they are read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+void sched_critmon_reset(void)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  memset(g_premp_hist, 0, sizeof(g_premp_hist));
+  memset(g_crit_hist, 0, sizeof(g_crit_hist));
+  memset(g_premp_worst, 0, sizeof(g_premp_worst));
+  memset(g_crit_worst, 0, sizeof(g_crit_worst));
+
+  sched_foreach(critmon_reset_tcb, NULL);
+  leave_critical_section(flags);
+}
 #endif
+
+#endif /* CONFIG_SCHED_CRITMONITOR */
@@ -0,0 +1,411 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kthread.h>
+#include <nuttx/sched_latency.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_NCPUS
+#  define LATENCY_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define LATENCY_NCPUS 1
+#endif
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#  define LATENCY_CLOCK CLOCK_MONOTONIC
+#else
+#  define LATENCY_CLOCK CLOCK_REALTIME
+#endif
+
+/* Durations of 4 seconds or more do not fit in 32 bits of nanoseconds */
+
+#define LATENCY_MAX_SEC 4
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Time of the most recent interrupt entry on each CPU */
+
+static uint32_t g_latency_irq[LATENCY_NCPUS];
+
+/* Statistics of each stage.  Protected by the critical section. */
+
+static struct latency_stat_s g_latency_stat[LATENCY_NSTAGES];
+
+/* The benchmark thread and its period in microseconds.  The thread exits
+ * when it finds that g_latency_pid no longer holds its own pid.
+ */
+
+static volatile pid_t g_latency_pid;
+static volatile uint32_t g_latency_period;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_ts2nsec
+ *
+ * Description:
+ *   Convert a duration to nanoseconds, saturating at UINT32_MAX.
+ *
+ ****************************************************************************/
+
+static uint32_t latency_ts2nsec(FAR const struct timespec *ts)
+{
+  if (ts->tv_sec >= LATENCY_MAX_SEC)
+    {
+      return UINT32_MAX;
+    }
+
+  return (uint32_t)ts->tv_sec * NSEC_PER_SEC + (uint32_t)ts->tv_nsec;
+}
+
+/****************************************************************************
+ * Name: latency_nsec
+ *
+ * Description:
+ *   Convert a duration in up_critmon_gettime() units to nanoseconds.
+ *
+ ****************************************************************************/
+
+static uint32_t latency_nsec(uint32_t elapsed)
+{
+  struct timespec ts;
+
+  up_critmon_convert(elapsed, &ts);
+  return latency_ts2nsec(&ts);
+}
+
+/****************************************************************************
+ * Name: latency_add
+ *
+ * Description:
+ *   Account one duration of a stage.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+static void latency_add(int stage, uint32_t nsec)
+{
+  FAR struct latency_stat_s *stat = &g_latency_stat[stage];
+  unsigned int bucket;
+  uint32_t tmp;
+
+  if (stat->count == 0 || nsec < stat->min)
+    {
+      stat->min = nsec;
+    }
+
+  if (nsec > stat->max)
+    {
+      stat->max = nsec;
+    }
+
+  stat->sum += nsec;
+  stat->count++;
+
+  /* The bucket is the index of the most significant bit set */
+
+  for (bucket = 0, tmp = nsec >> 1;
+       tmp != 0 && bucket < CONFIG_SCHED_LATENCY_NBUCKETS - 1;
+       tmp >>= 1)
+    {
+      bucket++;
+    }
+
+  stat->hist[bucket]++;
+}
+
+/****************************************************************************
+ * Name: latency_cyclic
+ *
+ * Description:
+ *   The periodic benchmark thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+
+static int latency_cyclic(int argc, FAR char *argv[])
+{
+  struct timespec next;
+  struct timespec now;
+  struct timespec delta;
+  irqstate_t flags;
+  uint32_t period;
+  pid_t me = getpid();
+
+  period = g_latency_period;
+  (void)clock_gettime(LATENCY_CLOCK, &next);
+
+  do
+    {
+      /* Advance the absolute wakeup time by one period */
+
+      next.tv_nsec += period * NSEC_PER_USEC;
+      if (next.tv_nsec >= NSEC_PER_SEC)
+        {
+          next.tv_nsec -= NSEC_PER_SEC;
+          next.tv_sec++;
+        }
+
+      (void)clock_nanosleep(LATENCY_CLOCK, TIMER_ABSTIME, &next, NULL);
+      (void)clock_gettime(LATENCY_CLOCK, &now);
+
+      /* Record how late we woke up */
+
+      clock_timespec_subtract(&now, &next, &delta);
+
+      flags = enter_critical_section();
+      latency_add(LATENCY_CYCLIC, latency_ts2nsec(&delta));
+      leave_critical_section(flags);
+    }
+  while (g_latency_pid == me);
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_latency_irq
+ ****************************************************************************/
+
+void sched_latency_irq(void)
+{
+  g_latency_irq[this_cpu()] = up_critmon_gettime();
+}
+
+/****************************************************************************
+ * Name: sched_latency_wakeup
+ ****************************************************************************/
+
+void sched_latency_wakeup(FAR struct tcb_s *tcb)
+{
+  /* Only a wakeup from an interrupt handler has an interrupt entry time */
+
+  tcb->lat_irq    = up_interrupt_context() ? g_latency_irq[this_cpu()] : 0;
+  tcb->lat_wakeup = up_critmon_gettime();
+  tcb->lat_switch = 0;
+}
+
+/****************************************************************************
+ * Name: sched_latency_switch
+ ****************************************************************************/
+
+void sched_latency_switch(FAR struct tcb_s *tcb)
+{
+  /* Only the first switch after the wakeup is of interest */
+
+  if (tcb->lat_wakeup != 0 && tcb->lat_switch == 0)
+    {
+      tcb->lat_switch = up_critmon_gettime();
+    }
+}
+
+/****************************************************************************
+ * Name: sched_latency_run
+ ****************************************************************************/
+
+void sched_latency_run(FAR struct tcb_s *tcb)
+{
+  uint32_t now;
+
+  /* Zero means that there was no wakeup or that the timer is not ready */
+
+  if (tcb->lat_wakeup == 0)
+    {
+      return;
+    }
+
+  now = up_critmon_gettime();
+
+  if (tcb->lat_irq != 0)
+    {
+      latency_add(LATENCY_IRQ_WAKEUP,
+                  latency_nsec(tcb->lat_wakeup - tcb->lat_irq));
+      latency_add(LATENCY_IRQ_RUN, latency_nsec(now - tcb->lat_irq));
+    }
+
+  if (tcb->lat_switch != 0)
+    {
+      latency_add(LATENCY_WAKEUP_SWITCH,
+                  latency_nsec(tcb->lat_switch - tcb->lat_wakeup));
+      latency_add(LATENCY_SWITCH_RUN, latency_nsec(now - tcb->lat_switch));
+    }
+
+  tcb->lat_irq    = 0;
+  tcb->lat_wakeup = 0;
+  tcb->lat_switch = 0;
+}
+
+/****************************************************************************
+ * Name: sched_latency_snapshot
+ ****************************************************************************/
+
+void sched_latency_snapshot(FAR struct latency_stat_s *stats)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memcpy(stats, g_latency_stat, sizeof(g_latency_stat));
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: sched_latency_reset
+ ****************************************************************************/
+
+void sched_latency_reset(void)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memset(g_latency_stat, 0, sizeof(g_latency_stat));
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: sched_latency_start
+ ****************************************************************************/
+
+int sched_latency_start(uint32_t period, int priority)
+{
+#ifdef CONFIG_SCHED_TICKLESS
+  int ret;
+
+  if (period == 0 || period >= USEC_PER_SEC ||
+      priority < SCHED_PRIORITY_MIN || priority > SCHED_PRIORITY_MAX)
+    {
+      return -EINVAL;
+    }
+
+  /* Keep the new thread from running before its pid is known */
+
+  sched_lock();
+  if (g_latency_pid != 0)
+    {
+      ret = -EBUSY;
+      goto errout;
+    }
+
+  g_latency_period = period;
+
+  ret = kthread_create("latency", priority, CONFIG_SCHED_LATENCY_STACKSIZE,
+                       latency_cyclic, NULL);
+  if (ret < 0)
+    {
+      g_latency_period = 0;
+      goto errout;
+    }
+
+  g_latency_pid = (pid_t)ret;
+  ret = OK;
+
+errout:
+  sched_unlock();
+  return ret;
+#else
+  /* With the periodic timer tick, the sleep and clock_gettime() both have
+   * only tick resolution, so the benchmark would measure the tick rather
+   * than the wakeup latency.
+   */
+
+  return -ENOSYS;
+#endif
+}
+
+/****************************************************************************
+ * Name: sched_latency_stop
+ ****************************************************************************/
+
+int sched_latency_stop(void)
+{
+  int ret = OK;
+
+  sched_lock();
+  if (g_latency_pid == 0)
+    {
+      ret = -ESRCH;
+    }
+
+  g_latency_pid    = 0;
+  g_latency_period = 0;
+  sched_unlock();
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sched_latency_period
+ ****************************************************************************/
+
+uint32_t sched_latency_period(void)
+{
+  return g_latency_period;
+}
+
+#endif /* CONFIG_SCHED_LATENCY */
@@ -40,10 +40,12 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
@@ -57,6 +59,25 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Offset to the timestamp in the common note header */
+
+#define NOTE_SYSTIME_OFFSET offsetof(struct note_common_s, nc_systime)
+
+/* With CONFIG_SCHED_NOTE_PERCPU, each buffer has a single writer (its CPU)
+ * and a single reader that never share a lock.  Each side publishes its
+ * own index with release semantics and reads the other side's index with
+ * acquire semantics so that the buffer contents are never accessed out of
+ * order with the index.
+ */
+
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+#  define NOTE_LOAD(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#  define NOTE_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else
+#  define NOTE_LOAD(p)     (*(p))
+#  define NOTE_STORE(p, v) do { *(p) = (v); } while (0)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -92,11 +113,22 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+/* There is one circular buffer per CPU.  Each CPU is the only writer of
+ * the head index of its own buffer.  The reader of the notes is the only
+ * writer of the tail indices.  g_note_readlock serializes readers only;
+ * it is never taken when a note is added.
+ */
+
+static struct note_info_s g_note_info[CONFIG_SMP_NCPUS];
+static volatile spinlock_t g_note_readlock;
+#else
 static struct note_info_s g_note_info;
 
 #ifdef CONFIG_SMP
 static volatile spinlock_t g_note_lock;
 #endif
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -148,7 +180,11 @@ static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
 static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
+#ifdef CONFIG_SCHED_NOTE_HIRES
+  uint32_t systime    = up_critmon_gettime();
+#else
   uint32_t systime    = (uint32_t)clock_systimer();
+#endif
 
   /* Save all of the common fields */
 
@@ -209,18 +245,19 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
  *   Length of data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   Length of data currently in circular buffer.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
-static unsigned int note_length(void)
+#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS) || \
+    defined(CONFIG_SCHED_NOTE_PERCPU)
+static unsigned int note_length(FAR struct note_info_s *info)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
+  unsigned int head = NOTE_LOAD(&info->ni_head);
+  unsigned int tail = NOTE_LOAD(&info->ni_tail);
 
   if (tail > head)
     {
@@ -238,17 +275,19 @@ static unsigned int note_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   We are within a critical section (or, with CONFIG_SCHED_NOTE_PERCPU,
+ *   we hold g_note_readlock).
  *
  ****************************************************************************/
 
-static void note_remove(void)
+#if !defined(CONFIG_SCHED_NOTE_PERCPU) || defined(CONFIG_SCHED_NOTE_GET)
+static void note_remove(FAR struct note_info_s *info)
 {
   FAR struct note_common_s *note;
   unsigned int tail;
@@ -256,21 +295,22 @@ static void note_remove(void)
 
   /* Get the tail index of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note   = (FAR struct note_common_s *)&info->ni_buffer[tail];
   length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+  DEBUGASSERT(length <= note_length(info));
 
   /* Increment the tail index to remove the entire note from the circular
    * buffer.
    */
 
-  g_note_info.ni_tail = note_next(tail, length);
+  NOTE_STORE(&info->ni_tail, note_next(tail, length));
 }
+#endif
 
 /****************************************************************************
  * Name: note_add
@@ -289,6 +329,61 @@ static void note_remove(void)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+static void note_add(FAR const uint8_t *note, uint8_t notelen)
+{
+  FAR struct note_info_s *info;
+  irqstate_t flags;
+  unsigned int head;
+  int cpu;
+
+  /* Disabling local interrupts is sufficient:  No other CPU ever adds a
+   * note to this CPU's buffer.
+   */
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+
+  /* Ignore notes that are not in the set of monitored CPUs */
+
+  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << cpu)) == 0)
+    {
+      /* Not in the set of monitored CPUs.  Do not log the note. */
+
+      up_irq_restore(flags);
+      return;
+    }
+
+  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
+  info = &g_note_info[cpu];
+
+  /* The tail index belongs to the reader.  If the note will not fit, then
+   * discard the new note rather than removing the oldest one.
+   */
+
+  if (notelen >= CONFIG_SCHED_NOTE_BUFSIZE - note_length(info))
+    {
+      up_irq_restore(flags);
+      return;
+    }
+
+  /* Copy the note to the head of the circular buffer */
+
+  head = info->ni_head;
+  while (notelen > 0)
+    {
+      info->ni_buffer[head] = *note++;
+      head = note_next(head, 1);
+      notelen--;
+    }
+
+  /* Publish the new head index only after the note content is visible */
+
+  NOTE_STORE(&info->ni_head, head);
+
+  up_irq_restore(flags);
+}
+#else
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
   unsigned int head;
@@ -328,7 +423,7 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
         {
           /* Yes, then remove the note at the tail index */
 
-          note_remove();
+          note_remove(&g_note_info);
         }
 
       /* Save the next byte at the head index */
@@ -346,6 +441,90 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
   up_irq_restore(flags);
 #endif
 }
+#endif /* CONFIG_SCHED_NOTE_PERCPU */
+
+/****************************************************************************
+ * Name: note_systime
+ *
+ * Description:
+ *   Return the timestamp of the note at the tail of the circular buffer.
+ *   The note header may wrap around the end of the buffer.
+ *
+ * Input Parameters:
+ *   info - The circular buffer
+ *
+ * Returned Value:
+ *   The timestamp of the oldest note in the buffer.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_NOTE_GET) && defined(CONFIG_SCHED_NOTE_PERCPU)
+static uint32_t note_systime(FAR struct note_info_s *info)
+{
+  unsigned int ndx = note_next(info->ni_tail, NOTE_SYSTIME_OFFSET);
+  uint32_t systime = 0;
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      systime |= (uint32_t)info->ni_buffer[ndx] << (8 * i);
+      ndx      = note_next(ndx, 1);
+    }
+
+  return systime;
+}
+#endif
+
+/****************************************************************************
+ * Name: note_oldest
+ *
+ * Description:
+ *   Select the circular buffer that holds the oldest note so that notes
+ *   from all CPUs are returned in time order.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The buffer holding the oldest note or NULL if all buffers are empty.
+ *
+ * Assumptions:
+ *   We hold g_note_readlock.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_NOTE_GET) && defined(CONFIG_SCHED_NOTE_PERCPU)
+static FAR struct note_info_s *note_oldest(void)
+{
+  FAR struct note_info_s *oldest = NULL;
+  uint32_t oldtime = 0;
+  uint32_t systime;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct note_info_s *info = &g_note_info[cpu];
+
+      /* The acquire load of the head index pairs with the release store in
+       * note_add() so the note bytes are not read ahead of the index.
+       */
+
+      if (NOTE_LOAD(&info->ni_head) != info->ni_tail)
+        {
+          /* Timestamps wrap around so compare the signed difference */
+
+          systime = note_systime(info);
+          if (oldest == NULL || (int32_t)(systime - oldtime) < 0)
+            {
+              oldest  = info;
+              oldtime = systime;
+            }
+        }
+    }
+
+  return oldest;
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -609,6 +788,7 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
+  FAR struct note_info_s *info;
   FAR struct note_common_s *note;
   irqstate_t flags;
   unsigned int remaining;
@@ -617,11 +797,26 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
   size_t circlen;
 
   DEBUGASSERT(buffer != NULL);
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  flags = up_irq_save();
+  spin_lock_wo_note(&g_note_readlock);
+
+  /* Get the buffer holding the oldest note */
+
+  info = note_oldest();
+  if (info == NULL)
+    {
+      notelen = 0;
+      goto errout_with_csection;
+    }
+#else
   flags = enter_critical_section();
+  info  = &g_note_info;
+#endif
 
   /* Verify that the circular buffer is not empty */
 
-  circlen = note_length();
+  circlen = note_length(info);
   if (circlen <= 0)
     {
       notelen = 0;
@@ -630,12 +825,12 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 
   /* Get the index to the tail of the circular buffer */
 
-  tail    = g_note_info.ni_tail;
+  tail    = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note    = (FAR struct note_common_s *)&info->ni_buffer[tail];
   notelen = note->nc_length;
   DEBUGASSERT(notelen <= circlen);
 
@@ -645,7 +840,7 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Remove the large note so that we do not get constipated. */
 
-      note_remove();
+      note_remove(info);
 
       /* and return an error */
 
@@ -660,7 +855,7 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Copy the next byte at the tail index */
 
-      *buffer++ = g_note_info.ni_buffer[tail];
+      *buffer++ = info->ni_buffer[tail];
 
       /* Adjust indices and counts */
 
@@ -668,10 +863,19 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
       remaining--;
     }
 
-  g_note_info.ni_tail = tail;
+  /* Release the space only after the note has been copied out so that the
+   * writer cannot overwrite it while it is still being read.
+   */
+
+  NOTE_STORE(&info->ni_tail, tail);
 
 errout_with_csection:
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  spin_unlock_wo_note(&g_note_readlock);
+  up_irq_restore(flags);
+#else
   leave_critical_section(flags);
+#endif
   return notelen;
 }
 #endif
@@ -694,17 +898,33 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
+  FAR struct note_info_s *info;
   FAR struct note_common_s *note;
   irqstate_t flags;
   unsigned int tail;
   ssize_t notelen;
   size_t circlen;
 
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  flags = up_irq_save();
+  spin_lock_wo_note(&g_note_readlock);
+
+  /* Get the buffer holding the oldest note */
+
+  info = note_oldest();
+  if (info == NULL)
+    {
+      notelen = 0;
+      goto errout_with_csection;
+    }
+#else
   flags = enter_critical_section();
+  info  = &g_note_info;
+#endif
 
   /* Verify that the circular buffer is not empty */
 
-  circlen = note_length();
+  circlen = note_length(info);
   if (circlen <= 0)
     {
       notelen = 0;
@@ -713,17 +933,22 @@ ssize_t sched_note_size(void)
 
   /* Get the index to the tail of the circular buffer */
 
-  tail = g_note_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
+  note    = (FAR struct note_common_s *)&info->ni_buffer[tail];
   notelen = note->nc_length;
   DEBUGASSERT(notelen <= circlen);
 
 errout_with_csection:
+#ifdef CONFIG_SCHED_NOTE_PERCPU
+  spin_unlock_wo_note(&g_note_readlock);
+  up_irq_restore(flags);
+#else
   leave_critical_section(flags);
+#endif
   return notelen;
 }
 #endif
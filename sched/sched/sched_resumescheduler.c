@@ -44,6 +44,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/sched_latency.h>
 
 #include "irq/irq.h"
 #include "sched/sched.h"
@@ -104,6 +105,8 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb)
   sched_note_resume(tcb);
 #endif
 
+  sched_latency_switch(tcb);
+
 #ifdef CONFIG_SMP
   /* NOTE: The following logic for adjusting global IRQ controls were
    * derived from sched_addreadytorun() and sched_removedreadytorun()
@@ -47,6 +47,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/sched_latency.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -163,6 +164,7 @@ int nxsem_post(FAR sem_t *sem)
 
               /* Restart the waiting task. */
 
+              sched_latency_wakeup(stcb);
               up_unblock_task(stcb);
             }
 #if 0 /* REVISIT:  This can fire on IOB throttle semaphore */
@@ -202,6 +204,10 @@ int nxsem_post(FAR sem_t *sem)
  *   This function unlocks the semaphore referenced by sem by performing the
  *   semaphore unlock operation on that semaphore.
  *
+ *   When CONFIG_SEM_FASTPATH is selected, this is sem_post_slow() which is
+ *   called from the C library sem_post() only when the semaphore has waiters
+ *   or uses priority inheritance.
+ *
  *   If the semaphore value resulting from this operation is positive, then
  *   no tasks were blocked waiting for the semaphore to become unlocked; the
  *   semaphore is simply incremented.
@@ -223,7 +229,11 @@ int nxsem_post(FAR sem_t *sem)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SEM_FASTPATH
+int sem_post_slow(FAR sem_t *sem)
+#else
 int sem_post(FAR sem_t *sem)
+#endif
 {
   int ret;
 
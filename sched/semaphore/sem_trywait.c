@@ -133,6 +133,10 @@ int nxsem_trywait(FAR sem_t *sem)
  *   currently not locked.  Otherwise, it locks the semaphore.  In either
  *   case, the call returns without blocking.
  *
+ *   When CONFIG_SEM_FASTPATH is selected, this is sem_trywait_slow() which is
+ *   called from the C library sem_trywait() only when the semaphore is not
+ *   available or uses priority inheritance.
+ *
  * Input Parameters:
  *   sem - the semaphore descriptor
  *
@@ -146,7 +150,11 @@ int nxsem_trywait(FAR sem_t *sem)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SEM_FASTPATH
+int sem_trywait_slow(FAR sem_t *sem)
+#else
 int sem_trywait(FAR sem_t *sem)
+#endif
 {
   int ret;
 
@@ -47,6 +47,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/sched_latency.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -170,6 +171,7 @@ int nxsem_wait(FAR sem_t *sem)
 
           DEBUGASSERT(NULL != rtcb->flink);
           up_block_task(rtcb, TSTATE_WAIT_SEM);
+          sched_latency_run(rtcb);
 
           /* When we resume at this point, either (1) the semaphore has been
            * assigned to this thread of execution, or (2) the semaphore wait
@@ -222,6 +224,10 @@ int nxsem_wait(FAR sem_t *sem)
  *   the semaphore value is (<=) zero, then the calling task will not return
  *   until it successfully acquires the lock.
  *
+ *   When CONFIG_SEM_FASTPATH is selected, this is sem_wait_slow() which is
+ *   called from the C library sem_wait() only when the semaphore is not
+ *   available or uses priority inheritance.
+ *
  * Input Parameters:
  *   sem - Semaphore descriptor.
  *
@@ -235,7 +241,11 @@ int nxsem_wait(FAR sem_t *sem)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SEM_FASTPATH
+int sem_wait_slow(FAR sem_t *sem)
+#else
 int sem_wait(FAR sem_t *sem)
+#endif
 {
   int errcode;
   int ret;
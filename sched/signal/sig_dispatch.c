@@ -49,6 +49,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/sched_latency.h>
 
 #include "sched/sched.h"
 #include "group/group.h"
@@ -328,6 +329,7 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
         {
           memcpy(&stcb->sigunbinfo, info, sizeof(siginfo_t));
           stcb->sigwaitmask = NULL_SIGNAL_SET;
+          sched_latency_wakeup(stcb);
           up_unblock_task(stcb);
           leave_critical_section(flags);
         }
@@ -371,6 +373,7 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
         {
           memcpy(&stcb->sigunbinfo, info, sizeof(siginfo_t));
           stcb->sigwaitmask = NULL_SIGNAL_SET;
+          sched_latency_wakeup(stcb);
           up_unblock_task(stcb);
         }
 
@@ -54,6 +54,7 @@
 #include <nuttx/wdog.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/sched_latency.h>
 
 #include "sched/sched.h"
 #include "signal/signal.h"
@@ -135,6 +136,7 @@ static void nxsig_timeout(int argc, wdparm_t itcb)
       u.wtcb->sigunbinfo.si_pid             = 0;  /* Not applicable */
       u.wtcb->sigunbinfo.si_status          = OK;
 #endif
+      sched_latency_wakeup(u.wtcb);
       up_unblock_task(u.wtcb);
     }
 
@@ -391,6 +393,7 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
       /* We are running again, clear the sigwaitmask */
 
+      sched_latency_run(rtcb);
       rtcb->sigwaitmask = NULL_SIGNAL_SET;
 
       /* When we awaken, the cause will be in the TCB.  Get the signal number
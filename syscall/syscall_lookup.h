@@ -62,10 +62,17 @@ SYSCALL_LOOKUP(uname,                      1, STUB_uname)
 /* Semaphores */
 
 SYSCALL_LOOKUP(sem_destroy,                1, STUB_sem_destroy)
+#ifdef CONFIG_SEM_FASTPATH
+SYSCALL_LOOKUP(sem_post_slow,              1, STUB_sem_post_slow)
+SYSCALL_LOOKUP(sem_timedwait,              2, STUB_sem_timedwait)
+SYSCALL_LOOKUP(sem_trywait_slow,           1, STUB_sem_trywait_slow)
+SYSCALL_LOOKUP(sem_wait_slow,              1, STUB_sem_wait_slow)
+#else
 SYSCALL_LOOKUP(sem_post,                   1, STUB_sem_post)
 SYSCALL_LOOKUP(sem_timedwait,              2, STUB_sem_timedwait)
 SYSCALL_LOOKUP(sem_trywait,                1, STUB_sem_trywait)
 SYSCALL_LOOKUP(sem_wait,                   1, STUB_sem_wait)
+#endif
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 SYSCALL_LOOKUP(sem_setprotocol,            2, STUB_sem_setprotocol)
@@ -307,8 +314,13 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1, STUB_pthread_mutex_destroy)
   SYSCALL_LOOKUP(pthread_mutex_init,       2, STUB_pthread_mutex_init)
   SYSCALL_LOOKUP(pthread_mutex_timedlock,  2, STUB_pthread_mutex_timedlock)
+#ifdef CONFIG_SEM_FASTPATH
+  SYSCALL_LOOKUP(pthread_mutex_trylock_slow, 1, STUB_pthread_mutex_trylock_slow)
+  SYSCALL_LOOKUP(pthread_mutex_unlock_slow, 1, STUB_pthread_mutex_unlock_slow)
+#else
   SYSCALL_LOOKUP(pthread_mutex_trylock,    1, STUB_pthread_mutex_trylock)
   SYSCALL_LOOKUP(pthread_mutex_unlock,     1, STUB_pthread_mutex_unlock)
+#endif
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1, STUB_pthread_mutex_consistent)
 #endif
@@ -373,7 +385,9 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(listen,                   2, STUB_listen)
   SYSCALL_LOOKUP(recv,                     4, STUB_recv)
   SYSCALL_LOOKUP(recvfrom,                 6, STUB_recvfrom)
+  SYSCALL_LOOKUP(recvmmsg,                 5, STUB_recvmmsg)
   SYSCALL_LOOKUP(send,                     4, STUB_send)
+  SYSCALL_LOOKUP(sendmmsg,                 4, STUB_sendmmsg)
   SYSCALL_LOOKUP(sendto,                   6, STUB_sendto)
   SYSCALL_LOOKUP(setsockopt,               5, STUB_setsockopt)
   SYSCALL_LOOKUP(socket,                   3, STUB_socket)
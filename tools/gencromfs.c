@@ -129,6 +129,21 @@
 #define LZF_NEXT(v,p)      (((v) << 8) | p[2])
 #define LZF_NDX(h)         ((((h ^ (h << 5)) >> (3*8 - LZF_HLOG)) - h*5) & (LZF_HSIZE - 1))
 
+/* LZ4 blocks use the same header as LZF_TYPE1_HDR but a different type */
+
+#define CROMFS_LZ4_HDR     2
+
+#define LZ4_HLOG           12
+#define LZ4_HSIZE          (1 << LZ4_HLOG)
+#define LZ4_MINMATCH       4
+#define LZ4_LASTLITERALS   5          /* Last bytes are always literals */
+#define LZ4_MFLIMIT        12         /* No match may start after this */
+#define LZ4_MAXOFFSET      65535
+
+#define LZ4_READ32(p)      ((uint32_t)(p)[0] | (uint32_t)(p)[1] << 8 | \
+                            (uint32_t)(p)[2] << 16 | (uint32_t)(p)[3] << 24)
+#define LZ4_NDX(v)         (((v) * 2654435761u) >> (32 - LZ4_HLOG))
+
 #define LZF_MAX_LIT        (1 <<  5)
 #define LZF_MAX_OFF        (1 << LZF_HLOG)
 #define LZF_MAX_REF        ((1 << 8) + (1 << 3))
@@ -219,7 +234,7 @@ union lzf_result_u
   struct
   {
     uint8_t lzf_magic[2];     /* [0]='Z', [1]='V' */
-    uint8_t lzf_type;         /* LZF_TYPE1_HDR */
+    uint8_t lzf_type;         /* LZF_TYPE1_HDR or CROMFS_LZ4_HDR */
     uint8_t lzf_clen[2];      /* Compressed data length (big-endian) */
     uint8_t lzf_ulen[2];      /* Uncompressed data length (big-endian) */
     uint8_t lzf_buffer[LZF_BUFSIZE + 16];
@@ -230,6 +245,10 @@ union lzf_result_u
 
 static uint8_t *g_lzf_hashtab[LZF_HSIZE];
 
+/* LZ4 hash table */
+
+static const uint8_t *g_lz4_hashtab[LZ4_HSIZE];
+
 /* Type of the callback from traverse_directory() */
 
 typedef int (*traversal_callback_t)(const char *dirpath, const char *name,
@@ -242,6 +261,7 @@ typedef int (*traversal_callback_t)(const char *dirpath, const char *name,
 static char *g_progname;       /* Name of this program */
 static char *g_dirname;        /* Source directory path */
 static char *g_outname;        /* Output file path */
+static bool g_lz4;             /* True: Compress blocks with LZ4, not LZF */
 
 static FILE *g_outstream;      /* Main output stream */
 static FILE *g_tmpstream;      /* Temporary file output stream */
@@ -278,6 +298,10 @@ static void dump_hexbuffer(FILE *stream, const void *buffer, unsigned int nbytes
 static void dump_nextline(FILE *stream);
 static size_t lzf_compress(const uint8_t *inbuffer, unsigned int inlen,
                            union lzf_result_u *result);
+static uint8_t *lz4_putlength(uint8_t *outptr, uint8_t *outend,
+                              unsigned int len);
+static size_t lz4_compress(const uint8_t *inbuffer, unsigned int inlen,
+                           union lzf_result_u *result);
 static uint16_t get_mode(mode_t mode);
 #ifdef HOST_TGTSWAP
 static inline uint16_t tgt_uint16(uint16_t a);
@@ -306,7 +330,12 @@ static int  traverse_directory(const char *dirpath,
 
 static void show_usage(void)
 {
-  fprintf(stderr, "USAGE: %s <dir-path> <out-file>\n", g_progname);
+  fprintf(stderr, "USAGE: %s [-l] <dir-path> <out-file>\n", g_progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  -l  Compress data blocks with LZ4 rather than LZF.  "
+                  "Requires\n");
+  fprintf(stderr, "      CONFIG_FS_CROMFS_LZ4 in the target "
+                  "configuration.\n");
   exit(1);
 }
 
@@ -842,6 +871,179 @@ genhdr:
   return retlen;
 }
 
+/* Emit the extension bytes of an LZ4 literal or match length that did not
+ * fit in the 4-bit field of the token.  Returns NULL on output overflow.
+ */
+
+static uint8_t *lz4_putlength(uint8_t *outptr, uint8_t *outend,
+                              unsigned int len)
+{
+  for (; ; )
+    {
+      if (outptr >= outend)
+        {
+          return NULL;
+        }
+
+      if (len < 255)
+        {
+          *outptr++ = (uint8_t)len;
+          return outptr;
+        }
+
+      *outptr++ = 255;
+      len      -= 255;
+    }
+}
+
+/* Compress one block in the LZ4 block format using a simple, greedy,
+ * single-probe hash matcher.  If the result is not smaller than the input,
+ * an uncompressed LZF_TYPE0_HDR block is generated instead.
+ */
+
+static size_t lz4_compress(const uint8_t *inbuffer, unsigned int inlen,
+                           union lzf_result_u *result)
+{
+  const uint8_t *inptr  = inbuffer;
+  const uint8_t *inend  = inbuffer + inlen;
+  const uint8_t *anchor = inbuffer;
+  uint8_t *outptr = result->compressed.lzf_buffer;
+  uint8_t *outend = outptr + inlen;
+  uint8_t *token;
+  unsigned int litlen;
+  unsigned int cs;
+
+  memset(g_lz4_hashtab, 0, sizeof(g_lz4_hashtab));
+
+  if (inlen > LZ4_MFLIMIT)
+    {
+      const uint8_t *mflimit    = inend - LZ4_MFLIMIT;
+      const uint8_t *matchlimit = inend - LZ4_LASTLITERALS;
+
+      while (inptr < mflimit)
+        {
+          const uint8_t *ref;
+          const uint8_t *mptr;
+          uint32_t seq = LZ4_READ32(inptr);
+          unsigned int hval = LZ4_NDX(seq);
+          unsigned int matchlen;
+          unsigned int offset;
+
+          ref = g_lz4_hashtab[hval];
+          g_lz4_hashtab[hval] = inptr;
+
+          if (ref == NULL || inptr - ref > LZ4_MAXOFFSET ||
+              LZ4_READ32(ref) != seq)
+            {
+              inptr++;
+              continue;
+            }
+
+          /* Found a match.  Extend it as far as permitted */
+
+          offset = inptr - ref;
+          mptr   = inptr + LZ4_MINMATCH;
+          ref   += LZ4_MINMATCH;
+
+          while (mptr < matchlimit && *mptr == *ref)
+            {
+              mptr++;
+              ref++;
+            }
+
+          matchlen = mptr - inptr - LZ4_MINMATCH;
+          litlen   = inptr - anchor;
+
+          /* Token, literals, offset, and match length */
+
+          if (outptr >= outend)
+            {
+              goto uncompressed;
+            }
+
+          token  = outptr++;
+          *token = (litlen >= 15 ? 15 : litlen) << 4;
+          if (litlen >= 15 &&
+              (outptr = lz4_putlength(outptr, outend, litlen - 15)) == NULL)
+            {
+              goto uncompressed;
+            }
+
+          if (outptr + litlen + 2 > outend)
+            {
+              goto uncompressed;
+            }
+
+          memcpy(outptr, anchor, litlen);
+          outptr    += litlen;
+          *outptr++  = offset & 0xff;
+          *outptr++  = offset >> 8;
+
+          *token    |= matchlen >= 15 ? 15 : matchlen;
+          if (matchlen >= 15 &&
+              (outptr = lz4_putlength(outptr, outend, matchlen - 15)) == NULL)
+            {
+              goto uncompressed;
+            }
+
+          inptr  = mptr;
+          anchor = inptr;
+        }
+    }
+
+  /* The final sequence holds only the remaining literals */
+
+  litlen = inend - anchor;
+  if (outptr >= outend)
+    {
+      goto uncompressed;
+    }
+
+  token  = outptr++;
+  *token = (litlen >= 15 ? 15 : litlen) << 4;
+  if (litlen >= 15 &&
+      (outptr = lz4_putlength(outptr, outend, litlen - 15)) == NULL)
+    {
+      goto uncompressed;
+    }
+
+  if (outptr + litlen >= outend)
+    {
+      goto uncompressed;
+    }
+
+  memcpy(outptr, anchor, litlen);
+  outptr += litlen;
+
+  /* Write compressed header */
+
+  cs = outptr - (uint8_t *)result->compressed.lzf_buffer;
+
+  result->compressed.lzf_magic[0]   = 'Z';
+  result->compressed.lzf_magic[1]   = 'V';
+  result->compressed.lzf_type       = CROMFS_LZ4_HDR;
+  result->compressed.lzf_clen[0]    = cs >> 8;
+  result->compressed.lzf_clen[1]    = cs & 0xff;
+  result->compressed.lzf_ulen[0]    = inlen >> 8;
+  result->compressed.lzf_ulen[1]    = inlen & 0xff;
+  return cs + LZF_TYPE1_HDR_SIZE;
+
+uncompressed:
+
+  /* Write uncompressed header*/
+
+  result->uncompressed.lzf_magic[0] = 'Z';
+  result->uncompressed.lzf_magic[1] = 'V';
+  result->uncompressed.lzf_type     = LZF_TYPE0_HDR;
+  result->uncompressed.lzf_len[0]   = inlen >> 8;
+  result->uncompressed.lzf_len[1]   = inlen & 0xff;
+
+  /* Copy uncompressed data into the result buffer */
+
+  memcpy(result->uncompressed.lzf_buffer, inbuffer, inlen);
+  return inlen + LZF_TYPE0_HDR_SIZE;
+}
+
 static uint16_t get_mode(mode_t mode)
 {
   uint16_t ret = 0;
@@ -1069,7 +1271,15 @@ static void gen_file(const char *path, const char *name, mode_t mode,
 
           /* Compress the chunk */
 
-          blklen = lzf_compress(iobuffer, nread, &result);
+          if (g_lz4)
+            {
+              blklen = lz4_compress(iobuffer, nread, &result);
+            }
+          else
+            {
+              blklen = lzf_compress(iobuffer, nread, &result);
+            }
+
           if (result.cmn.lzf_type == LZF_TYPE0_HDR)
             {
               clen = nread;
@@ -1280,6 +1490,13 @@ int main(int argc, char **argv, char **envp)
   ptr = strrchr(argv[0], '/');
   g_progname = ptr == NULL ? argv[0] : ptr + 1;
 
+  if (argc > 1 && strcmp(argv[1], "-l") == 0)
+    {
+      g_lz4 = true;
+      argc--;
+      argv++;
+    }
+
   if (argc != 3)
     {
       fprintf(stderr, "Unexpected number of arguments\n");
@@ -1329,6 +1546,17 @@ int main(int argc, char **argv, char **envp)
       (void)traverse_directory(g_dirname, process_direntry, NULL);
     }
 
+  /* The node count must fit in cv_nnodes, and 0xffff is reserved by the
+   * target to mark the end of a directory hash chain.
+   */
+
+  if (g_nnodes >= 0xffff)
+    {
+      fprintf(stderr, "ERROR: Too many nodes: %u (limit is 65534)\n",
+              g_nnodes);
+      exit(1);
+    }
+
   /* Now append the volume header to output file */
 
   fprintf(g_outstream, "/* CROMFS image */\n\n");
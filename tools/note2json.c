@@ -0,0 +1,453 @@
+/****************************************************************************
+ * tools/note2json.c
+ *
+ *   Copyright (C) 2018 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These must agree with include/nuttx/sched_note.h */
+
+#define NOTE_STREAM_MAGIC     "NXNT"
+#define NOTE_STREAM_VERSION   1
+#define NOTE_STREAM_HDRSIZE   16
+
+#define NOTE_STREAM_SMP       (1 << 0)
+#define NOTE_STREAM_BIGENDIAN (1 << 1)
+
+#define NOTE_START            0
+#define NOTE_STOP             1
+#define NOTE_SUSPEND          2
+#define NOTE_RESUME           3
+#define NOTE_CPU_START        4
+#define NOTE_CPU_STARTED      5
+#define NOTE_CPU_PAUSE        6
+#define NOTE_CPU_PAUSED       7
+#define NOTE_CPU_RESUME       8
+#define NOTE_CPU_RESUMED      9
+#define NOTE_PREEMPT_LOCK     10
+#define NOTE_PREEMPT_UNLOCK   11
+#define NOTE_CSECTION_ENTER   12
+#define NOTE_CSECTION_LEAVE   13
+#define NOTE_SPINLOCK_LOCK    14
+#define NOTE_SPINLOCK_LOCKED  15
+#define NOTE_SPINLOCK_UNLOCK  16
+#define NOTE_SPINLOCK_ABORT   17
+#define NOTE_NTYPES           18
+
+#define MAX_CPUS              32
+#define MAX_PIDS              65536
+#define MAX_NAME              32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct note_stream_s
+{
+  unsigned int flags;           /* NOTE_STREAM_* flags */
+  unsigned int ncpus;           /* Number of CPUs */
+  unsigned int ptrsize;         /* Size of a target pointer */
+  unsigned int hdrsize;         /* Size of the common note header */
+  double tickus;                /* Duration of one timestamp count in us */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct note_stream_s g_stream;
+static char *g_names[MAX_PIDS];
+static int g_running[MAX_CPUS];
+static uint32_t g_lastraw;
+static int64_t g_time;
+static int g_havetime;
+static int g_first = 1;
+
+static const char *g_typenames[NOTE_NTYPES] =
+{
+  "start", "stop", "suspend", "resume",
+  "cpu_start", "cpu_started", "cpu_pause", "cpu_paused",
+  "cpu_resume", "cpu_resumed", "preempt_lock", "preempt_unlock",
+  "csection_enter", "csection_leave", "spinlock_lock", "spinlock_locked",
+  "spinlock_unlock", "spinlock_abort"
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
+{
+  fprintf(stderr, "USAGE: %s <note-file> <json-file>\n", progname);
+  fprintf(stderr, "\nWhere:\n");
+  fprintf(stderr, "  <note-file> is a binary file read from /dev/note\n");
+  fprintf(stderr, "  <json-file> is the Chrome trace JSON file to create\n");
+}
+
+static uint64_t get_le(const uint8_t *src, int nbytes)
+{
+  uint64_t value = 0;
+  int i;
+
+  for (i = nbytes - 1; i >= 0; i--)
+    {
+      value = (value << 8) | src[i];
+    }
+
+  return value;
+}
+
+static uint64_t get_ptr(const uint8_t *src)
+{
+  uint64_t value = 0;
+  unsigned int i;
+
+  if ((g_stream.flags & NOTE_STREAM_BIGENDIAN) == 0)
+    {
+      return get_le(src, g_stream.ptrsize);
+    }
+
+  for (i = 0; i < g_stream.ptrsize; i++)
+    {
+      value = (value << 8) | src[i];
+    }
+
+  return value;
+}
+
+static int read_header(FILE *instream)
+{
+  uint8_t hdr[NOTE_STREAM_HDRSIZE];
+  uint64_t tickfs;
+
+  if (fread(hdr, 1, NOTE_STREAM_HDRSIZE, instream) != NOTE_STREAM_HDRSIZE ||
+      memcmp(hdr, NOTE_STREAM_MAGIC, 4) != 0)
+    {
+      fprintf(stderr, "ERROR: Not a note stream\n");
+      return -1;
+    }
+
+  if (hdr[4] != NOTE_STREAM_VERSION)
+    {
+      fprintf(stderr, "ERROR: Unsupported version %u\n", hdr[4]);
+      return -1;
+    }
+
+  g_stream.flags   = hdr[5];
+  g_stream.ncpus   = hdr[6];
+  g_stream.ptrsize = hdr[7];
+  g_stream.hdrsize = (g_stream.flags & NOTE_STREAM_SMP) != 0 ? 10 : 9;
+
+  if (g_stream.ncpus < 1 || g_stream.ncpus > MAX_CPUS ||
+      g_stream.ptrsize < 1 || g_stream.ptrsize > 8)
+    {
+      fprintf(stderr, "ERROR: Bad stream header\n");
+      return -1;
+    }
+
+  tickfs          = get_le(&hdr[8], 8);
+  g_stream.tickus = (double)tickfs / 1.0e9;
+  return 0;
+}
+
+static const char *task_name(unsigned int pid, char *buffer)
+{
+  if (g_names[pid] != NULL)
+    {
+      return g_names[pid];
+    }
+
+  snprintf(buffer, MAX_NAME, "pid %u", pid);
+  return buffer;
+}
+
+static void put_event(FILE *outstream, const char *name, const char *ph,
+                      unsigned int cpu, double ts, const char *args)
+{
+  fprintf(outstream, "%s\n    {\"name\": \"%s\", \"ph\": \"%s\", "
+          "\"pid\": 0, \"tid\": %u, \"ts\": %.3f",
+          g_first ? "" : ",", name, ph, cpu, ts);
+
+  if (strcmp(ph, "i") == 0)
+    {
+      fprintf(outstream, ", \"s\": \"t\"");
+    }
+
+  if (args != NULL)
+    {
+      fprintf(outstream, ", \"args\": {%s}", args);
+    }
+
+  fprintf(outstream, "}");
+  g_first = 0;
+}
+
+static void put_note(FILE *outstream, const uint8_t *note, unsigned int len)
+{
+  char namebuf[MAX_NAME];
+  char label[MAX_NAME + 8];
+  char args[128];
+  const char *name;
+  unsigned int type;
+  unsigned int prio;
+  unsigned int cpu;
+  unsigned int pid;
+  unsigned int off;
+  uint32_t raw;
+  double ts;
+
+  type = note[1];
+  prio = note[2];
+  cpu  = 0;
+  off  = 3;
+
+  if ((g_stream.flags & NOTE_STREAM_SMP) != 0)
+    {
+      cpu = note[off++];
+      if (cpu >= g_stream.ncpus)
+        {
+          cpu = 0;
+        }
+    }
+
+  pid  = (unsigned int)get_le(&note[off], 2);
+  raw  = (uint32_t)get_le(&note[off + 2], 4);
+
+  /* The timestamp wraps around.  Accumulate the signed difference from the
+   * previous note so that small reorderings between CPUs are tolerated.
+   */
+
+  if (!g_havetime)
+    {
+      g_lastraw  = raw;
+      g_havetime = 1;
+    }
+
+  g_time   += (int32_t)(raw - g_lastraw);
+  g_lastraw = raw;
+  ts        = (double)g_time * g_stream.tickus;
+
+  name = task_name(pid, namebuf);
+  snprintf(args, sizeof(args), "\"pid\": %u, \"priority\": %u", pid, prio);
+
+  switch (type)
+    {
+      case NOTE_START:
+        if (len > g_stream.hdrsize)
+          {
+            unsigned int namelen = len - g_stream.hdrsize;
+            unsigned int i;
+
+            free(g_names[pid]);
+            g_names[pid] = malloc(namelen + 1);
+            if (g_names[pid] != NULL)
+              {
+                memcpy(g_names[pid], &note[g_stream.hdrsize], namelen);
+                g_names[pid][namelen] = '\0';
+
+                /* Don't let the name break the JSON string */
+
+                for (i = 0; i < namelen; i++)
+                  {
+                    if (g_names[pid][i] == '"' || g_names[pid][i] == '\\')
+                      {
+                        g_names[pid][i] = '_';
+                      }
+                  }
+
+                name = g_names[pid];
+              }
+          }
+
+        snprintf(label, sizeof(label), "start %s", name);
+        put_event(outstream, label, "i", cpu, ts, args);
+        break;
+
+      case NOTE_RESUME:
+        if (g_running[cpu])
+          {
+            put_event(outstream, "", "E", cpu, ts, NULL);
+          }
+
+        put_event(outstream, name, "B", cpu, ts, args);
+        g_running[cpu] = 1;
+        break;
+
+      case NOTE_SUSPEND:
+        if (g_running[cpu])
+          {
+            put_event(outstream, "", "E", cpu, ts, NULL);
+            g_running[cpu] = 0;
+          }
+        break;
+
+      case NOTE_SPINLOCK_LOCK:
+      case NOTE_SPINLOCK_LOCKED:
+      case NOTE_SPINLOCK_UNLOCK:
+      case NOTE_SPINLOCK_ABORT:
+        off = (g_stream.hdrsize + g_stream.ptrsize - 1) &
+              ~(g_stream.ptrsize - 1);
+        if (off + g_stream.ptrsize <= len)
+          {
+            snprintf(args, sizeof(args),
+                     "\"pid\": %u, \"spinlock\": \"0x%llx\"", pid,
+                     (unsigned long long)get_ptr(&note[off]));
+          }
+
+        put_event(outstream, g_typenames[type], "i", cpu, ts, args);
+        break;
+
+      default:
+        if (type < NOTE_NTYPES)
+          {
+            put_event(outstream, g_typenames[type], "i", cpu, ts, args);
+          }
+        else
+          {
+            fprintf(stderr, "WARNING: Unknown note type %u\n", type);
+          }
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv, char **envp)
+{
+  FILE *instream;
+  FILE *outstream;
+  uint8_t note[256];
+  unsigned int cpu;
+  int len;
+  int ret = 1;
+
+  if (argc != 3)
+    {
+      fprintf(stderr, "ERROR:  Two arguments expected\n");
+      show_usage(argv[0]);
+      return 1;
+    }
+
+  /* Open the note file read-only */
+
+  instream = fopen(argv[1], "rb");
+  if (instream == NULL)
+    {
+      fprintf(stderr, "ERROR:  Failed to open %s for reading\n", argv[1]);
+      return 1;
+    }
+
+  if (read_header(instream) < 0)
+    {
+      goto errout_with_instream;
+    }
+
+  /* Open the JSON file write-only */
+
+  outstream = fopen(argv[2], "w");
+  if (outstream == NULL)
+    {
+      fprintf(stderr, "ERROR:  Failed to open %s for writing\n", argv[2]);
+      goto errout_with_instream;
+    }
+
+  /* Each CPU is shown as a thread of a single "NuttX" process */
+
+  fprintf(outstream, "{\n  \"displayTimeUnit\": \"ns\",\n"
+          "  \"traceEvents\": [\n"
+          "    {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, "
+          "\"args\": {\"name\": \"NuttX\"}}");
+
+  for (cpu = 0; cpu < g_stream.ncpus; cpu++)
+    {
+      fprintf(outstream, ",\n    {\"name\": \"thread_name\", \"ph\": \"M\", "
+              "\"pid\": 0, \"tid\": %u, \"args\": {\"name\": \"CPU%u\"}}",
+              cpu, cpu);
+    }
+
+  g_first = 0;
+
+  /* Then convert each note.  The first byte of each note is its length. */
+
+  while ((len = fgetc(instream)) != EOF)
+    {
+      if ((unsigned int)len < g_stream.hdrsize)
+        {
+          fprintf(stderr, "ERROR:  Bad note length %d\n", len);
+          goto errout_with_outstream;
+        }
+
+      note[0] = (uint8_t)len;
+      if (fread(&note[1], 1, len - 1, instream) != (size_t)(len - 1))
+        {
+          fprintf(stderr, "WARNING:  Truncated note\n");
+          break;
+        }
+
+      put_note(outstream, note, len);
+    }
+
+  /* Close any open slices */
+
+  for (cpu = 0; cpu < g_stream.ncpus; cpu++)
+    {
+      if (g_running[cpu])
+        {
+          put_event(outstream, "", "E", cpu,
+                    (double)g_time * g_stream.tickus, NULL);
+        }
+    }
+
+  fprintf(outstream, "\n  ]\n}\n");
+  ret = 0;
+
+errout_with_outstream:
+  fclose(outstream);
+
+errout_with_instream:
+  fclose(instream);
+  return ret;
+}